@@ -32,6 +32,7 @@
 #include "log/oskar_log.h"
 #include "telescope/station/element/oskar_element.h"
 #include "utility/oskar_dir.h"
+#include "utility/oskar_file_exists.h"
 #include "utility/oskar_get_error_string.h"
 #include "utility/oskar_version_string.h"
 
@@ -39,14 +40,22 @@
 #include <iomanip>
 #include <cmath>
 #include <cstdio>
+#include <vector>
 
 using namespace oskar;
 using std::string;
+using std::vector;
 
 static const char app[] = "oskar_fit_element_data";
 
 static string construct_element_pathname(string output_dir,
         int port, int element_type_index, double frequency_hz);
+static bool read_cache(oskar_Element* element, oskar_Log* log,
+        const vector<string>& cache_paths, const vector<int>& ports,
+        double frequency_hz);
+static void write_cache(const oskar_Element* element, oskar_Log* log,
+        const string& cache_dir, const vector<string>& cache_paths,
+        const vector<int>& ports, double frequency_hz);
 
 int main(int argc, char** argv)
 {
@@ -102,6 +111,7 @@ int main(int argc, char** argv)
     string input_cst_file = s->to_string("input_cst_file", &e);
     string input_scalar_file = s->to_string("input_scalar_file", &e);
     string output_dir = s->to_string("output_directory", &e);
+    string cache_dir = s->to_string("cache_directory", &e);
     string pol_type = s->to_string("pol_type", &e);
     // string coordinate_system = s->to_string("coordinate_system", &e);
     int element_type_index = s->to_int("element_type_index", &e);
@@ -129,31 +139,44 @@ int main(int argc, char** argv)
     // Load the CST text file for the correct port, if specified (X=1, Y=2).
     if (!input_cst_file.empty())
     {
+        vector<int> ports;
+        vector<string> cache_paths;
+        if (port == 0)
+        {
+            ports.push_back(1);
+            ports.push_back(2);
+        }
+        else
+            ports.push_back(port);
+        for (size_t i = 0; i < ports.size() && !cache_dir.empty(); ++i)
+        {
+            char* path = oskar_element_fit_cache_path(cache_dir.c_str(),
+                    input_cst_file.c_str(), ports[i], frequency_hz,
+                    average_fractional_error,
+                    average_fractional_error_factor_increase,
+                    ignore_at_pole, ignore_below_horizon, &e);
+            if (path) cache_paths.push_back(string(path));
+            free(path);
+        }
         oskar_log_line(log, 'M', ' ');
         oskar_log_message(log, 'M', 0, "Loading CST element pattern: %s",
                 input_cst_file.c_str());
-        oskar_element_load_cst(element, log, port, frequency_hz,
-                input_cst_file.c_str(), average_fractional_error,
-                average_fractional_error_factor_increase,
-                ignore_at_pole, ignore_below_horizon, &e);
-
-        // Construct the output file name based on the settings.
-        if (port == 0)
+        if (!read_cache(element, log, cache_paths, ports, frequency_hz))
         {
-            string output = construct_element_pathname(output_dir, 1,
-                    element_type_index, frequency_hz);
-            oskar_element_write(element, log, output.c_str(), 1,
-                    frequency_hz, &e);
-            output = construct_element_pathname(output_dir, 2,
-                    element_type_index, frequency_hz);
-            oskar_element_write(element, log, output.c_str(), 2,
-                    frequency_hz, &e);
+            oskar_element_load_cst(element, log, port, frequency_hz,
+                    input_cst_file.c_str(), average_fractional_error,
+                    average_fractional_error_factor_increase,
+                    ignore_at_pole, ignore_below_horizon, &e);
+            if (!e) write_cache(element, log, cache_dir, cache_paths,
+                    ports, frequency_hz);
         }
-        else
+
+        // Construct the output file name based on the settings.
+        for (size_t i = 0; i < ports.size(); ++i)
         {
-            string output = construct_element_pathname(output_dir, port,
+            string output = construct_element_pathname(output_dir, ports[i],
                     element_type_index, frequency_hz);
-            oskar_element_write(element, log, output.c_str(), port,
+            oskar_element_write(element, log, output.c_str(), ports[i],
                     frequency_hz, &e);
         }
     }
@@ -161,12 +184,29 @@ int main(int argc, char** argv)
     // Load the scalar text file, if specified.
     if (!input_scalar_file.empty())
     {
+        vector<int> ports(1, 0);
+        vector<string> cache_paths;
+        if (!cache_dir.empty())
+        {
+            char* path = oskar_element_fit_cache_path(cache_dir.c_str(),
+                    input_scalar_file.c_str(), 0, frequency_hz,
+                    average_fractional_error,
+                    average_fractional_error_factor_increase,
+                    ignore_at_pole, ignore_below_horizon, &e);
+            if (path) cache_paths.push_back(string(path));
+            free(path);
+        }
         oskar_log_message(log, 'M', 0, "Loading scalar element pattern: %s",
                 input_scalar_file.c_str());
-        oskar_element_load_scalar(element, log, frequency_hz,
-                input_scalar_file.c_str(), average_fractional_error,
-                average_fractional_error_factor_increase,
-                ignore_at_pole, ignore_below_horizon, &e);
+        if (!read_cache(element, log, cache_paths, ports, frequency_hz))
+        {
+            oskar_element_load_scalar(element, log, frequency_hz,
+                    input_scalar_file.c_str(), average_fractional_error,
+                    average_fractional_error_factor_increase,
+                    ignore_at_pole, ignore_below_horizon, &e);
+            if (!e) write_cache(element, log, cache_dir, cache_paths,
+                    ports, frequency_hz);
+        }
 
         // Construct the output file name based on the settings.
         string output = construct_element_pathname(output_dir, 0,
@@ -216,3 +256,43 @@ static string construct_element_pathname(string output_dir,
     return p;
 }
 
+static bool read_cache(oskar_Element* element, oskar_Log* log,
+        const vector<string>& cache_paths, const vector<int>& ports,
+        double frequency_hz)
+{
+    int status = 0;
+    if (cache_paths.empty()) return false;
+    for (size_t i = 0; i < cache_paths.size(); ++i)
+        if (!oskar_file_exists(cache_paths[i].c_str())) return false;
+    for (size_t i = 0; i < cache_paths.size(); ++i)
+    {
+        oskar_log_message(log, 'M', 1, "Using cached coefficients: %s",
+                cache_paths[i].c_str());
+        oskar_element_read(element, cache_paths[i].c_str(), ports[i],
+                frequency_hz, &status);
+    }
+    if (status)
+        oskar_log_warning(log, "Failed to read cache (%s); fitting again.",
+                oskar_get_error_string(status));
+    return !status;
+}
+
+static void write_cache(const oskar_Element* element, oskar_Log* log,
+        const string& cache_dir, const vector<string>& cache_paths,
+        const vector<int>& ports, double frequency_hz)
+{
+    int status = 0;
+    if (cache_paths.empty()) return;
+    if (!oskar_dir_mkpath(cache_dir.c_str()))
+    {
+        oskar_log_warning(log, "Unable to create cache directory '%s'.",
+                cache_dir.c_str());
+        return;
+    }
+    for (size_t i = 0; i < cache_paths.size(); ++i)
+        oskar_element_write(element, log, cache_paths[i].c_str(), ports[i],
+                frequency_hz, &status);
+    if (status)
+        oskar_log_warning(log, "Failed to write cache (%s).",
+                oskar_get_error_string(status));
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2018, The University of Oxford
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the University of Oxford nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "apps/oskar_option_parser.h"
+#include "log/oskar_log.h"
+#include "sky/oskar_sky.h"
+#include "utility/oskar_get_error_string.h"
+#include "utility/oskar_version_string.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+int main(int argc, char** argv)
+{
+    int error = 0;
+
+    oskar::OptionParser opt("oskar_sky_model_to_columnar",
+            oskar_version_string());
+    opt.set_description("Converts an OSKAR sky model to the columnar binary "
+            "format, which can be memory-mapped so that very large sky "
+            "models open almost instantly. The file can be used anywhere "
+            "an OSKAR sky model file is accepted.");
+    opt.add_required("input file", "The input OSKAR sky model file "
+            "(text or binary).");
+    opt.add_required("output file", "The output columnar sky model file.");
+    opt.add_flag("-c", "Maximum number of sources in each chunk of the "
+            "chunk directory.", 1, "16384");
+    opt.add_flag("-s", "Sort sources by position, so that each chunk "
+            "covers a small region of sky.");
+    opt.add_flag("--single", "Store the data in single precision. "
+            "Binary input files are always stored in their own precision.");
+    if (!opt.check_options(argc, argv)) return EXIT_FAILURE;
+
+    // Parse command line.
+    int max_chunk_size = 16384;
+    opt.get("-c")->getInt(max_chunk_size);
+    int type = opt.is_set("--single") ? OSKAR_SINGLE : OSKAR_DOUBLE;
+
+    // Load the sky model, trying the binary format first.
+    oskar_Sky* sky = oskar_sky_read(opt.get_arg(0), OSKAR_CPU, &error);
+    if (error)
+    {
+        error = 0;
+        sky = oskar_sky_load(opt.get_arg(0), type, &error);
+    }
+
+    // Sort and write out the sky model.
+    if (opt.is_set("-s"))
+        oskar_sky_sort_by_position(sky, &error);
+    oskar_sky_write_columnar(opt.get_arg(1), sky, max_chunk_size, &error);
+    if (error)
+    {
+        oskar_log_error(0, oskar_get_error_string(error));
+        oskar_sky_free(sky, &error);
+        return error;
+    }
+
+    oskar_sky_free(sky, &error);
+    return 0;
+}
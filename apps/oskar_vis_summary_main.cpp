@@ -150,14 +150,14 @@ int main(int argc, char **argv)
             xc_m2.x = 0.0;
             xc_m2.y = 0.0;
 
-            // Create a visibility block to read into.
+            // Create a visibility block to map the data into.
             oskar_VisBlock* blk = oskar_vis_block_create_from_header(OSKAR_CPU,
                     hdr, &status);
 
             // Loop over blocks.
             for (int b = 0; b < num_blocks; ++b)
             {
-                oskar_vis_block_read(blk, hdr, h, b, &status);
+                oskar_vis_block_map(blk, hdr, h, b, 1, &status);
                 if (status)
                 {
                     oskar_log_error(log, "Error reading block %d: %s",
@@ -0,0 +1,45 @@
+# - Find FFTW3
+#==============================================================================
+# Find the native FFTW3 includes and libraries, in double and single precision.
+#
+#  FFTW3_INCLUDE_DIR     - where to find fftw3.h
+#  FFTW3_LIBRARIES       - List of libraries when using FFTW3.
+#  FFTW3_FOUND           - True if FFTW3 found.
+#  FFTW3_THREADS_FOUND   - True if the FFTW3 threads libraries were found.
+#==============================================================================
+
+find_path(FFTW3_INCLUDE_DIR fftw3.h
+    HINTS ${FFTW3_INC_DIR}
+    PATHS ENV FFTW3_INCLUDE_PATH)
+find_library(FFTW3_LIBRARY_DOUBLE NAMES fftw3
+    HINTS ${FFTW3_LIB_DIR}
+    PATHS ENV FFTW3_LIBRARY_PATH)
+find_library(FFTW3_LIBRARY_SINGLE NAMES fftw3f
+    HINTS ${FFTW3_LIB_DIR}
+    PATHS ENV FFTW3_LIBRARY_PATH)
+
+# Prefer the OpenMP version of the threads libraries, if available.
+find_library(FFTW3_THREADS_LIBRARY_DOUBLE NAMES fftw3_omp fftw3_threads
+    HINTS ${FFTW3_LIB_DIR}
+    PATHS ENV FFTW3_LIBRARY_PATH)
+find_library(FFTW3_THREADS_LIBRARY_SINGLE NAMES fftw3f_omp fftw3f_threads
+    HINTS ${FFTW3_LIB_DIR}
+    PATHS ENV FFTW3_LIBRARY_PATH)
+mark_as_advanced(FFTW3_INCLUDE_DIR FFTW3_LIBRARY_DOUBLE FFTW3_LIBRARY_SINGLE
+    FFTW3_THREADS_LIBRARY_DOUBLE FFTW3_THREADS_LIBRARY_SINGLE)
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(FFTW3 DEFAULT_MSG
+    FFTW3_LIBRARY_DOUBLE FFTW3_LIBRARY_SINGLE FFTW3_INCLUDE_DIR)
+
+set(FFTW3_LIBRARIES)
+set(FFTW3_THREADS_FOUND FALSE)
+if (FFTW3_FOUND)
+    if (FFTW3_THREADS_LIBRARY_DOUBLE AND FFTW3_THREADS_LIBRARY_SINGLE)
+        set(FFTW3_THREADS_FOUND TRUE)
+        list(APPEND FFTW3_LIBRARIES
+            ${FFTW3_THREADS_LIBRARY_DOUBLE} ${FFTW3_THREADS_LIBRARY_SINGLE})
+    endif()
+    list(APPEND FFTW3_LIBRARIES
+        ${FFTW3_LIBRARY_DOUBLE} ${FFTW3_LIBRARY_SINGLE})
+endif()
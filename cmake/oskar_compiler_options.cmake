@@ -262,6 +262,9 @@ if (BUILD_INFO)
     if (CASACORE_FOUND)
         message(STATUS "CASACORE      : ${CASACORE_LIBRARIES}")
     endif()
+    if (FFTW3_FOUND)
+        message(STATUS "FFTW3         : ${FFTW3_LIBRARIES}")
+    endif()
     message(STATUS "C++ compiler  : ${CMAKE_CXX_COMPILER}")
     message(STATUS "C compiler    : ${CMAKE_C_COMPILER}")
     if (DEFINED NVCC_COMPILER_BINDIR)
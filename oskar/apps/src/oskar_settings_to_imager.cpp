@@ -87,6 +87,8 @@ oskar_Imager* oskar_settings_to_imager(oskar::SettingsTree* s,
     oskar_imager_set_size(h, s->to_int("size", status), status);
     oskar_imager_set_channel_snapshots(h,
             s->to_int("channel_snapshots", status));
+    oskar_imager_set_max_plane_memory_mb(h,
+            s->to_double("max_plane_memory_mb", status));
     oskar_imager_set_freq_min_hz(h, s->to_double("freq_min_hz", status));
     oskar_imager_set_freq_max_hz(h, s->to_double("freq_max_hz", status));
     oskar_imager_set_time_min_utc(h, s->to_double("time_min_utc", status));
@@ -109,8 +111,12 @@ oskar_Imager* oskar_settings_to_imager(oskar::SettingsTree* s,
         oskar_imager_set_num_w_planes(h,
                 s->to_int("wproj/num_w_planes", status));
     oskar_imager_set_fft_on_gpu(h, s->to_int("fft/use_gpu", status));
+    oskar_imager_set_fft_backend(h,
+            s->to_string("fft/backend", status), status);
     oskar_imager_set_generate_w_kernels_on_gpu(h,
             s->to_int("wproj/generate_w_kernels_on_gpu", status));
+    oskar_imager_set_w_kernel_cache_dir(h,
+            s->to_string("wproj/kernel_cache_dir", status));
     if (s->first_letter("direction", status) == 'R')
         oskar_imager_set_direction(h,
                 s->to_double("direction/ra_deg", status),
@@ -47,11 +47,15 @@ oskar_Interferometer* oskar_settings_to_interferometer(oskar::SettingsTree* s,
     oskar_interferometer_set_log(h, log);
     oskar_interferometer_set_max_sources_per_chunk(h,
             s->to_int("max_sources_per_chunk", status));
+    oskar_interferometer_set_spatially_coherent_chunks(h,
+            s->to_int("spatially_coherent_chunks", status));
     oskar_interferometer_set_settings_path(h, s->file_name());
     if (!s->to_int("use_gpus", status))
         oskar_interferometer_set_gpus(h, 0, 0, status);
     else
     {
+        if (s->to_int("use_opencl", status))
+            oskar_interferometer_set_use_opencl(h, 1, status);
         if (s->starts_with("cuda_device_ids", "all", status))
             oskar_interferometer_set_gpus(h, -1, 0, status);
         else
@@ -102,6 +106,10 @@ oskar_Interferometer* oskar_settings_to_interferometer(oskar::SettingsTree* s,
             s->to_string("correlation_type", status), status);
     oskar_interferometer_set_max_times_per_block(h,
             s->to_int("max_time_samples_per_block", status));
+    oskar_interferometer_set_station_beam_cache_tolerance(h,
+            s->to_double("station_beam_cache_tolerance_sec", status), status);
+    oskar_interferometer_set_station_beam_cache_max_memory_mb(h,
+            s->to_double("station_beam_cache_max_memory_mb", status), status);
     oskar_interferometer_set_output_vis_file(h,
             s->to_string("oskar_vis_filename", status));
     oskar_interferometer_set_output_measurement_set(h,
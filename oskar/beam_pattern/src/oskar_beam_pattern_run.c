@@ -255,6 +255,8 @@ static void* run_blocks(void* arg)
     if (thread_id == 0)
         write_chunks(h, cp, tp, fp, h->i_global & 1, status);
 
+    /* Release memory handles cached by this thread. */
+    oskar_mem_pool_clear();
     return 0;
 }
 
@@ -93,6 +93,8 @@ size_t oskar_binary_tag_payload_size(const oskar_Binary* handle,
  * The tag is specified as a standard tag, using a group ID and a tag ID
  * that are both given as bytes.
  *
+ * The lookup uses a hash index of all tags, so it takes constant time.
+ *
  * @param[in] handle        Binary data handle.
  * @param[in] data_type     Type of the memory. If 0, the type is not checked.
  * @param[in] id_group      Tag group identifier.
@@ -138,6 +140,10 @@ int oskar_binary_query_ext(const oskar_Binary* handle,
  * @details
  * This function sets the index at which to start search query.
  *
+ * Queries return the first matching tag at or after this index.
+ * Tags are looked up using a hash index built when the file is opened,
+ * so setting this is not needed for performance.
+ *
  * @param[in] handle        Binary data handle.
  * @param[in] start         Index at which to start search query.
  * @param[in,out] status    Status return code.
@@ -187,6 +187,40 @@ OSKAR_BINARY_EXPORT
 void oskar_binary_read_ext_int(oskar_Binary* handle, const char* name_group,
         const char* name_tag, int user_index, int* value, int* status);
 
+/**
+ * @brief Returns a pointer to the payload of a chunk in a mapped file.
+ *
+ * @details
+ * This function returns a pointer to the payload of a chunk, without
+ * copying it. The whole file is mapped into memory the first time this
+ * is called, and stays mapped until the handle is freed.
+ *
+ * The mapping is private: the payload may be modified, but changes are
+ * never written back to the file.
+ *
+ * If \p check_crc is set, the CRC code of the chunk (if present) is
+ * checked the first time the chunk is mapped, which reads the whole payload.
+ * Each chunk is checked at most once per handle: later calls for the same
+ * chunk return the pointer without reading the payload again, even if the
+ * mapped data have since been modified.
+ * If \p check_crc is not set, the payload is not read by this function,
+ * so pages of the file are only loaded when the data are used.
+ *
+ * If the file cannot be mapped (for example, on systems that do not support
+ * it), a null pointer is returned without setting an error, and
+ * oskar_binary_read_block() should be used instead.
+ *
+ * @param[in,out] handle   Binary file handle.
+ * @param[in] chunk_index  Sequence index of the chunk's tag in the file.
+ * @param[in] check_crc    If set, check the CRC code of the chunk.
+ * @param[in,out] status   Status return code.
+ *
+ * @return Pointer to the payload, or NULL if the file cannot be mapped.
+ */
+OSKAR_BINARY_EXPORT
+void* oskar_binary_map_block(oskar_Binary* handle, int chunk_index,
+        int check_crc, int* status);
+
 #ifdef __cplusplus
 }
 #endif
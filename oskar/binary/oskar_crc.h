@@ -104,6 +104,10 @@ void oskar_crc_free(oskar_CRC* data);
  * http://web.archive.org/web/20121011093914/http://www.intel.com/technology/comms/perfnet/download/CRC_generators.pdf
  * http://create.stephan-brumme.com/crc32/
  *
+ * For CRC-32C, the CRC instructions in SSE 4.2 (or ARMv8, if enabled
+ * at compile time) are used instead if the CPU supports them.
+ * The results are identical.
+ *
  * @param[in] crc_data  Pointer to CRC data table, which defines the type.
  * @param[in] crc       CRC code to update.
  * @param[in] data      Pointer to data block to use.
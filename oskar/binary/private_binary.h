@@ -171,6 +171,11 @@ typedef struct oskar_BinaryTag oskar_BinaryTag;
 struct oskar_Binary
 {
     FILE* stream;               /* File stream handle. */
+    char* filename;             /* Path of the file. */
+    char* map_data;             /* Start of file mapping, if mapped. */
+    size_t map_size;            /* Size of file mapping, in bytes. */
+    int map_failed;             /* True if the file could not be mapped. */
+    char* map_crc_checked;      /* Per chunk: true once CRC code checked. */
     int bin_version;            /* Binary format version number. */
     int query_search_start;     /* Index at which to start search query. */
     char open_mode;             /* Mode in which file was opened (read/write). */
@@ -190,6 +195,11 @@ struct oskar_Binary
     unsigned long* crc;         /* CRC-32C code. */
     unsigned long* crc_header;  /* CRC-32C code of payload identifier. */
 
+    /* Hash index of tags, for fast queries. */
+    int num_buckets;            /* Number of hash buckets (a power of 2). */
+    int* bucket_start;          /* First tag in each bucket, or -1. */
+    int* bucket_next;           /* Next tag in the same bucket, or -1. */
+
     /* Data tables used for CRC computation. */
     oskar_CRC* crc_data;
 };
@@ -199,6 +209,88 @@ struct oskar_Binary
 typedef struct oskar_Binary oskar_Binary;
 #endif /* OSKAR_BINARY_TYPEDEF_ */
 
+/*
+ * A file opened in write mode ends with an index record when it is closed.
+ * This is an extended tag (group "oskar_binary", tag "tag_index", type char)
+ * so that it can be skipped by readers that do not know about it.
+ * The payload contains the serialised tag table, to allow the file to be
+ * opened without scanning every tag. All values are little-endian.
+ *
+ * For each tag in the file before the record, a 40-byte entry:
+ *
+ * Offset  Length  Description
+ * ----------------------------------------------------------------------------
+ *  0       1      1 if the tag is extended, else 0.
+ *  1       1      Data type.
+ *  2       1      Group ID, or group name length for an extended tag.
+ *  3       1      Tag ID, or tag name length for an extended tag.
+ *  4       4      User index.
+ *  8       8      Payload offset from start of file.
+ * 16       8      Payload size in bytes.
+ * 24       8      Block size in bytes.
+ * 32       4      CRC-32C code of chunk (0 if not present).
+ * 36       4      CRC-32C code of tag header and names.
+ *
+ * These are followed by the group and tag names of each extended tag,
+ * including null terminators, and finally a 20-byte trailer:
+ *
+ *  0       8      Offset of the record tag from start of file.
+ *  8       4      Number of entries.
+ * 12       8      The ASCII string "OSKARIDX", without trailing zero.
+ *
+ * The record is used only if it is the last chunk in the file and its
+ * CRC code is correct; otherwise, the tags are found by scanning the file.
+ * Index records are never included in the tag table, so they are not
+ * counted or found by queries.
+ */
+
+/*
+ * Writes the index record at the current end of a file opened for writing.
+ */
+void oskar_binary_index_record_write(oskar_Binary* handle, int* status);
+
+/*
+ * Loads the tag table from the index record, if present and valid.
+ * Returns 1 if the table was loaded, or 0 if the file must be scanned.
+ */
+int oskar_binary_index_record_read(oskar_Binary* handle);
+
+/*
+ * Returns 1 if the extended tag names are those of an index record, else 0.
+ */
+int oskar_binary_index_record_match(const char* name_group,
+        const char* name_tag);
+
+/*
+ * Unmaps the file, if it is mapped.
+ */
+void oskar_binary_unmap(oskar_Binary* handle);
+
+/*
+ * Resizes the tag table arrays to hold the given number of tags.
+ */
+void oskar_binary_resize(oskar_Binary* handle, int m);
+
+/*
+ * Builds the hash index of all tags in the handle.
+ * Tags in each bucket are kept in the order in which they appear in the file,
+ * so a query can return the first match at or after the search start index.
+ */
+void oskar_binary_index_create(oskar_Binary* handle);
+
+/*
+ * Frees the hash index.
+ */
+void oskar_binary_index_free(oskar_Binary* handle);
+
+/*
+ * Returns the hash bucket for a tag identifier.
+ * For extended tags, the group and tag names are also used.
+ */
+int oskar_binary_index_bucket(const oskar_Binary* handle, int extended,
+        int id_group, int id_tag, const char* name_group,
+        const char* name_tag, int user_index);
+
 #ifdef __cplusplus
 }
 #endif
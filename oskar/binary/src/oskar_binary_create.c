@@ -39,7 +39,6 @@ extern "C" {
 
 #define MIN(X,Y) ((X) < (Y) ? (X) : (Y))
 
-static void oskar_binary_resize(oskar_Binary* handle, int m);
 static void oskar_binary_read_header(FILE* stream, oskar_BinaryHeader* header,
         int* status);
 static void oskar_binary_write_header(FILE* stream, oskar_BinaryHeader* header,
@@ -99,6 +98,12 @@ oskar_Binary* oskar_binary_create(const char* filename, char mode, int* status)
     handle = (oskar_Binary*) malloc(sizeof(oskar_Binary));
     handle->stream = stream;
     handle->open_mode = mode;
+    handle->filename = (char*) malloc(1 + strlen(filename));
+    if (handle->filename) strcpy(handle->filename, filename);
+    handle->map_data = 0;
+    handle->map_size = 0;
+    handle->map_failed = 0;
+    handle->map_crc_checked = 0;
     handle->query_search_start = 0;
 
     /* Create the CRC lookup tables. */
@@ -118,6 +123,9 @@ oskar_Binary* oskar_binary_create(const char* filename, char mode, int* status)
     handle->block_size_bytes = 0;
     handle->crc = 0;
     handle->crc_header = 0;
+    handle->num_buckets = 0;
+    handle->bucket_start = 0;
+    handle->bucket_next = 0;
 
     /* Store the contents of the header for later use. */
     handle->bin_version = header.bin_version;
@@ -126,6 +134,22 @@ oskar_Binary* oskar_binary_create(const char* filename, char mode, int* status)
     if (mode == 'w')
         return handle;
 
+    /* Try to load the tags from the index record, and go back to the first
+     * tag to scan the file if it is not usable. */
+    if (mode == 'r')
+    {
+        if (oskar_binary_index_record_read(handle))
+        {
+            oskar_binary_index_create(handle);
+            return handle;
+        }
+        if (fseek(stream, (long) sizeof(oskar_BinaryHeader), SEEK_SET))
+        {
+            *status = OSKAR_ERR_BINARY_SEEK_FAIL;
+            return handle;
+        }
+    }
+
     /* Read all tags in the stream. */
     for (i = 0;; ++i)
     {
@@ -263,6 +287,26 @@ oskar_Binary* oskar_binary_create(const char* filename, char mode, int* status)
                     handle->name_group[i], tag.group.bytes);
             crc = oskar_crc_update(handle->crc_data, crc,
                     handle->name_tag[i], tag.tag.bytes);
+
+            /* Skip over index records, which are not part of the table. */
+            if (handle->name_group[i][tag.group.bytes - 1] == 0 &&
+                    handle->name_tag[i][tag.tag.bytes - 1] == 0 &&
+                    oskar_binary_index_record_match(handle->name_group[i],
+                            handle->name_tag[i]))
+            {
+                free(handle->name_group[i]);
+                free(handle->name_tag[i]);
+                handle->name_group[i] = 0;
+                handle->name_tag[i] = 0;
+                if (fseek(stream, (long int) handle->block_size_bytes[i] -
+                        (tag.group.bytes + tag.tag.bytes), SEEK_CUR))
+                {
+                    *status = OSKAR_ERR_BINARY_FILE_INVALID;
+                    break;
+                }
+                --i;
+                continue;
+            }
         }
 
         /* Store the current stream pointer as the payload offset. */
@@ -293,10 +337,13 @@ oskar_Binary* oskar_binary_create(const char* filename, char mode, int* status)
         handle->num_chunks = i + 1;
     }
 
+    /* Build the hash index of all tags. */
+    oskar_binary_index_create(handle);
+
     return handle;
 }
 
-static void oskar_binary_resize(oskar_Binary* handle, int m)
+void oskar_binary_resize(oskar_Binary* handle, int m)
 {
     handle->extended = (int*) realloc(handle->extended, m * sizeof(int));
     handle->data_type = (int*) realloc(handle->data_type, m * sizeof(int));
@@ -41,9 +41,18 @@ void oskar_binary_free(oskar_Binary* handle)
     /* Check if structure exists. */
     if (!handle) return;
 
-    /* Close the file. */
+    /* Write the index record and close the file. */
     if (handle->stream)
+    {
+        int status = 0;
+        if (handle->open_mode == 'w')
+            oskar_binary_index_record_write(handle, &status);
         fclose(handle->stream);
+    }
+
+    /* Unmap the file. */
+    oskar_binary_unmap(handle);
+    free(handle->filename);
 
     /* Free string data. */
     for (i = 0; i < handle->num_chunks; ++i)
@@ -65,6 +74,7 @@ void oskar_binary_free(oskar_Binary* handle)
     free(handle->block_size_bytes);
     free(handle->crc);
     free(handle->crc_header);
+    oskar_binary_index_free(handle);
 
     /* Free the CRC data. */
     oskar_crc_free(handle->crc_data);
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2018, The University of Oxford
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the University of Oxford nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "binary/oskar_binary.h"
+#include "binary/private_binary.h"
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FNV_OFFSET 2166136261u
+#define FNV_PRIME 16777619u
+
+static unsigned int hash_int(unsigned int h, int value)
+{
+    int i;
+    for (i = 0; i < 4; ++i)
+    {
+        h ^= (unsigned int) ((value >> (8 * i)) & 0xFF);
+        h *= FNV_PRIME;
+    }
+    return h;
+}
+
+static unsigned int hash_str(unsigned int h, const char* str)
+{
+    if (!str) return h;
+    for (; *str; ++str)
+    {
+        h ^= (unsigned int) (unsigned char) *str;
+        h *= FNV_PRIME;
+    }
+    return h;
+}
+
+int oskar_binary_index_bucket(const oskar_Binary* handle, int extended,
+        int id_group, int id_tag, const char* name_group,
+        const char* name_tag, int user_index)
+{
+    unsigned int h = FNV_OFFSET;
+    h = hash_int(h, extended);
+    if (extended)
+    {
+        h = hash_str(h, name_group);
+        h = hash_int(h, 0);
+        h = hash_str(h, name_tag);
+    }
+    else
+    {
+        h = hash_int(h, id_group);
+        h = hash_int(h, id_tag);
+    }
+    h = hash_int(h, user_index);
+    return (int) (h & (unsigned int) (handle->num_buckets - 1));
+}
+
+void oskar_binary_index_create(oskar_Binary* handle)
+{
+    int i, b;
+    oskar_binary_index_free(handle);
+    if (handle->num_chunks <= 0) return;
+
+    /* Use a power-of-two number of buckets, at least twice the tag count. */
+    handle->num_buckets = 16;
+    while (handle->num_buckets < 2 * handle->num_chunks)
+        handle->num_buckets *= 2;
+    handle->bucket_start = (int*) malloc(handle->num_buckets * sizeof(int));
+    handle->bucket_next = (int*) malloc(handle->num_chunks * sizeof(int));
+    if (!handle->bucket_start || !handle->bucket_next)
+    {
+        oskar_binary_index_free(handle);
+        return;
+    }
+    for (b = 0; b < handle->num_buckets; ++b)
+        handle->bucket_start[b] = -1;
+
+    /* Insert tags in reverse, so each bucket lists them in file order. */
+    for (i = handle->num_chunks - 1; i >= 0; --i)
+    {
+        b = oskar_binary_index_bucket(handle, handle->extended[i],
+                handle->id_group[i], handle->id_tag[i],
+                handle->name_group[i], handle->name_tag[i],
+                handle->user_index[i]);
+        handle->bucket_next[i] = handle->bucket_start[b];
+        handle->bucket_start[b] = i;
+    }
+}
+
+void oskar_binary_index_free(oskar_Binary* handle)
+{
+    free(handle->bucket_start);
+    free(handle->bucket_next);
+    handle->bucket_start = 0;
+    handle->bucket_next = 0;
+    handle->num_buckets = 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
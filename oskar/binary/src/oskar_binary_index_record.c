@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2018, The University of Oxford
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the University of Oxford nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "binary/oskar_binary.h"
+#include "binary/private_binary.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RECORD_GROUP "oskar_binary"
+#define RECORD_TAG "tag_index"
+#define RECORD_MAGIC "OSKARIDX"
+#define ENTRY_SIZE 40
+#define TRAILER_SIZE 20
+
+static void put_uint(unsigned char* p, size_t value, int num_bytes)
+{
+    int i;
+    for (i = 0; i < num_bytes; ++i, value >>= 8)
+        p[i] = (unsigned char) (value & 0xFF);
+}
+
+static size_t get_uint(const unsigned char* p, int num_bytes)
+{
+    size_t value = 0;
+    int i;
+    for (i = num_bytes - 1; i >= 0; --i)
+        value = (value << 8) | p[i];
+    return value;
+}
+
+static void clear_tags(oskar_Binary* handle)
+{
+    int i;
+    for (i = 0; i < handle->num_chunks; ++i)
+    {
+        free(handle->name_group[i]);
+        free(handle->name_tag[i]);
+    }
+    handle->num_chunks = 0;
+}
+
+void oskar_binary_index_record_write(oskar_Binary* handle, int* status)
+{
+    int i, num_tags;
+    size_t bytes = TRAILER_SIZE;
+    long record_start;
+    unsigned char *buffer, *p;
+    if (*status || !handle->stream) return;
+
+    /* Get the size of the record payload. */
+    num_tags = handle->num_chunks;
+    for (i = 0; i < num_tags; ++i)
+    {
+        bytes += ENTRY_SIZE;
+        if (handle->extended[i])
+            bytes += handle->id_group[i] + handle->id_tag[i];
+    }
+    buffer = (unsigned char*) calloc(bytes, 1);
+    if (!buffer)
+    {
+        *status = OSKAR_ERR_BINARY_MEMORY_NOT_ALLOCATED;
+        return;
+    }
+
+    /* Serialise the tag table as little-endian values. */
+    for (i = 0, p = buffer; i < num_tags; ++i, p += ENTRY_SIZE)
+    {
+        p[0] = (unsigned char) handle->extended[i];
+        p[1] = (unsigned char) handle->data_type[i];
+        p[2] = (unsigned char) handle->id_group[i];
+        p[3] = (unsigned char) handle->id_tag[i];
+        put_uint(p + 4, (size_t) (unsigned int) handle->user_index[i], 4);
+        put_uint(p + 8, (size_t) handle->payload_offset_bytes[i], 8);
+        put_uint(p + 16, handle->payload_size_bytes[i], 8);
+        put_uint(p + 24, handle->block_size_bytes[i], 8);
+        put_uint(p + 32, (size_t) handle->crc[i], 4);
+        put_uint(p + 36, (size_t) handle->crc_header[i], 4);
+    }
+    for (i = 0; i < num_tags; ++i)
+    {
+        if (!handle->extended[i]) continue;
+        memcpy(p, handle->name_group[i], handle->id_group[i]);
+        p += handle->id_group[i];
+        memcpy(p, handle->name_tag[i], handle->id_tag[i]);
+        p += handle->id_tag[i];
+    }
+
+    /* Write the trailer, which points back to the start of the record. */
+    fflush(handle->stream);
+    record_start = ftell(handle->stream);
+    if (record_start < 0)
+    {
+        free(buffer);
+        *status = OSKAR_ERR_BINARY_SEEK_FAIL;
+        return;
+    }
+    put_uint(p, (size_t) record_start, 8);
+    put_uint(p + 8, (size_t) num_tags, 4);
+    memcpy(p + 12, RECORD_MAGIC, 8);
+
+    /* Write the record as a normal extended tag,
+     * so that it is ignored by readers that do not know about it. */
+    oskar_binary_write_ext(handle, OSKAR_CHAR, RECORD_GROUP, RECORD_TAG, 0,
+            bytes, buffer, status);
+    free(buffer);
+}
+
+int oskar_binary_index_record_match(const char* name_group,
+        const char* name_tag)
+{
+    return !strcmp(name_group, RECORD_GROUP) && !strcmp(name_tag, RECORD_TAG);
+}
+
+int oskar_binary_index_record_read(oskar_Binary* handle)
+{
+    oskar_BinaryTag tag;
+    unsigned char trailer[TRAILER_SIZE], *buffer = 0, *p, *names;
+    const size_t lgroup = sizeof(RECORD_GROUP), ltag = sizeof(RECORD_TAG);
+    size_t block_size = 0, payload_size, name_bytes = 0, record_start;
+    unsigned long crc, crc_file;
+    long file_size;
+    int i, num_tags;
+
+    /* Read the trailer at the end of the file. */
+    if (fseek(handle->stream, 0, SEEK_END)) return 0;
+    file_size = ftell(handle->stream);
+    if (file_size < (long) (sizeof(oskar_BinaryHeader) + sizeof(tag) +
+            lgroup + ltag + TRAILER_SIZE + 4))
+        return 0;
+    if (fseek(handle->stream, -(TRAILER_SIZE + 4), SEEK_END)) return 0;
+    if (fread(trailer, TRAILER_SIZE, 1, handle->stream) != 1) return 0;
+    if (memcmp(trailer + 12, RECORD_MAGIC, 8)) return 0;
+    record_start = get_uint(trailer, 8);
+    num_tags = (int) get_uint(trailer + 8, 4);
+    if (record_start < sizeof(oskar_BinaryHeader) ||
+            record_start >= (size_t) file_size || num_tags < 0)
+        return 0;
+
+    /* Check the record tag, which must end at the end of the file. */
+    if (fseek(handle->stream, (long) record_start, SEEK_SET)) return 0;
+    if (fread(&tag, sizeof(tag), 1, handle->stream) != 1) return 0;
+    block_size = get_uint((const unsigned char*) tag.size_bytes, 8);
+    if (tag.magic[0] != 'T' || tag.magic[2] != 'G' ||
+            tag.flags != ((1 << 7) | (1 << 6)) ||
+            tag.data_type != OSKAR_CHAR ||
+            tag.group.bytes != lgroup || tag.tag.bytes != ltag ||
+            get_uint((const unsigned char*) tag.user_index, 4) != 0 ||
+            record_start + sizeof(tag) + block_size != (size_t) file_size ||
+            block_size < lgroup + ltag + 4)
+        return 0;
+    payload_size = block_size - lgroup - ltag - 4;
+    if (payload_size < TRAILER_SIZE + (size_t) num_tags * ENTRY_SIZE)
+        return 0;
+
+    /* Read the rest of the record in one go, and check its CRC code. */
+    buffer = (unsigned char*) malloc(block_size);
+    if (!buffer) return 0;
+    if (fread(buffer, block_size, 1, handle->stream) != 1 ||
+            memcmp(buffer, RECORD_GROUP, lgroup) ||
+            memcmp(buffer + lgroup, RECORD_TAG, ltag))
+    {
+        free(buffer);
+        return 0;
+    }
+    crc = oskar_crc_compute(handle->crc_data, &tag, sizeof(tag));
+    crc = oskar_crc_update(handle->crc_data, crc, buffer, lgroup + ltag);
+    crc_file = (unsigned long) get_uint(buffer + block_size - 4, 4);
+    p = buffer + lgroup + ltag;
+    if (crc_file != oskar_crc_update(handle->crc_data, crc, p, payload_size))
+    {
+        free(buffer);
+        return 0;
+    }
+
+    /* Unpack the tag table. The record tag itself is not included,
+     * so the table is the same as it would be after a full scan. */
+    oskar_binary_resize(handle, num_tags > 0 ? num_tags : 1);
+    names = p + (size_t) num_tags * ENTRY_SIZE;
+    for (i = 0; i < num_tags; ++i, p += ENTRY_SIZE)
+    {
+        handle->extended[i] = p[0] ? 1 : 0;
+        handle->data_type[i] = (int) p[1];
+        handle->id_group[i] = (int) p[2];
+        handle->id_tag[i] = (int) p[3];
+        handle->user_index[i] = (int) (unsigned int) get_uint(p + 4, 4);
+        handle->payload_offset_bytes[i] = (long) get_uint(p + 8, 8);
+        handle->payload_size_bytes[i] = get_uint(p + 16, 8);
+        handle->block_size_bytes[i] = get_uint(p + 24, 8);
+        handle->crc[i] = (unsigned long) get_uint(p + 32, 4);
+        handle->crc_header[i] = (unsigned long) get_uint(p + 36, 4);
+        handle->name_group[i] = 0;
+        handle->name_tag[i] = 0;
+        handle->num_chunks = i + 1;
+        if (handle->payload_offset_bytes[i] < (long) sizeof(oskar_BinaryHeader)
+                || handle->payload_offset_bytes[i] +
+                handle->payload_size_bytes[i] > record_start)
+            break;
+        if (handle->extended[i])
+        {
+            const size_t len = (size_t) (p[2] + p[3]);
+            if (p[2] == 0 || p[3] == 0 || name_bytes + len > payload_size -
+                    TRAILER_SIZE - (size_t) num_tags * ENTRY_SIZE ||
+                    names[name_bytes + p[2] - 1] ||
+                    names[name_bytes + len - 1])
+                break;
+            handle->name_group[i] = (char*) malloc(p[2]);
+            handle->name_tag[i] = (char*) malloc(p[3]);
+            memcpy(handle->name_group[i], names + name_bytes, p[2]);
+            memcpy(handle->name_tag[i], names + name_bytes + p[2], p[3]);
+            name_bytes += len;
+        }
+    }
+    free(buffer);
+    if (i < num_tags)
+    {
+        clear_tags(handle);
+        return 0;
+    }
+    return 1;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -63,7 +63,24 @@ int oskar_binary_query(const oskar_Binary* handle,
     if (*status) return 0;
 
     /* Find the tag in the index. */
-    for (i = handle->query_search_start; i < handle->num_chunks; ++i)
+    if (handle->bucket_start)
+    {
+        i = handle->bucket_start[oskar_binary_index_bucket(handle, 0,
+                (int) id_group, (int) id_tag, 0, 0, user_index)];
+        for (; i >= 0; i = handle->bucket_next[i])
+        {
+            if (i >= handle->query_search_start &&
+                    !(handle->extended[i]) &&
+                    ((handle->data_type[i] == (int) data_type) ||
+                            (!data_type)) &&
+                    handle->id_group[i] == (int) id_group &&
+                    handle->id_tag[i] == (int) id_tag &&
+                    handle->user_index[i] == user_index)
+                break;
+        }
+        if (i < 0) i = handle->num_chunks;
+    }
+    else for (i = handle->query_search_start; i < handle->num_chunks; ++i)
     {
         if (!(handle->extended[i]) &&
                 ((handle->data_type[i] == (int) data_type) || (!data_type)) &&
@@ -106,7 +123,24 @@ int oskar_binary_query_ext(const oskar_Binary* handle,
     }
 
     /* Find the tag in the index. */
-    for (i = handle->query_search_start; i < handle->num_chunks; ++i)
+    if (handle->bucket_start)
+    {
+        i = handle->bucket_start[oskar_binary_index_bucket(handle, 1,
+                lgroup, ltag, name_group, name_tag, user_index)];
+        for (; i >= 0; i = handle->bucket_next[i])
+        {
+            if (i >= handle->query_search_start &&
+                    handle->extended[i] &&
+                    ((handle->data_type[i] == (int) data_type) ||
+                            (!data_type)) &&
+                    handle->user_index[i] == user_index &&
+                    !strcmp(name_group, handle->name_group[i]) &&
+                    !strcmp(name_tag, handle->name_tag[i]))
+                break;
+        }
+        if (i < 0) i = handle->num_chunks;
+    }
+    else for (i = handle->query_search_start; i < handle->num_chunks; ++i)
     {
         if (handle->extended[i] &&
                 ((handle->data_type[i] == (int) data_type) || (!data_type)) &&
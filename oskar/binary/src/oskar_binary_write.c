@@ -36,13 +36,49 @@
 extern "C" {
 #endif
 
+static void record_tag(oskar_Binary* handle, int extended, int data_type,
+        int id_group, int id_tag, const char* name_group,
+        const char* name_tag, int user_index, long payload_offset,
+        size_t payload_size, size_t block_size, unsigned long crc_header,
+        unsigned long crc)
+{
+    const int i = handle->num_chunks;
+
+    /* Only files opened for writing get an index record. */
+    if (handle->open_mode != 'w') return;
+    if (i % 10 == 0)
+        oskar_binary_resize(handle, i + 10);
+    handle->extended[i] = extended;
+    handle->data_type[i] = data_type;
+    handle->id_group[i] = id_group;
+    handle->id_tag[i] = id_tag;
+    handle->name_group[i] = 0;
+    handle->name_tag[i] = 0;
+    if (extended)
+    {
+        handle->name_group[i] = (char*) malloc(id_group);
+        handle->name_tag[i] = (char*) malloc(id_tag);
+        memcpy(handle->name_group[i], name_group, id_group);
+        memcpy(handle->name_tag[i], name_tag, id_tag);
+    }
+    handle->user_index[i] = user_index;
+    handle->payload_offset_bytes[i] = payload_offset;
+    handle->payload_size_bytes[i] = payload_size;
+    handle->block_size_bytes[i] = block_size;
+    handle->crc[i] = crc;
+    handle->crc_header[i] = crc_header;
+    handle->num_chunks = i + 1;
+}
+
 void oskar_binary_write(oskar_Binary* handle, unsigned char data_type,
         unsigned char id_group, unsigned char id_tag, int user_index,
         size_t data_size, const void* data, int* status)
 {
     oskar_BinaryTag tag;
     size_t block_size;
-    unsigned long crc = 0;
+    unsigned long crc = 0, crc_header = 0;
+    long payload_offset;
+    const int index = user_index;
 
     /* Check if safe to proceed. */
     if (*status) return;
@@ -108,7 +144,13 @@ void oskar_binary_write(oskar_Binary* handle, unsigned char data_type,
 
     /* Tag is complete at this point, so calculate CRC. */
     crc = oskar_crc_compute(handle->crc_data, &tag, sizeof(oskar_BinaryTag));
+    crc_header = crc;
     crc = oskar_crc_update(handle->crc_data, crc, data, data_size);
+
+    /* Add the tag to the index record. */
+    payload_offset = ftell(handle->stream) + (long) sizeof(oskar_BinaryTag);
+    record_tag(handle, 0, data_type, id_group, id_tag, 0, 0, index,
+            payload_offset, data_size, data_size + 4, crc_header, crc);
     if (oskar_endian() != OSKAR_LITTLE_ENDIAN)
         oskar_endian_swap(&crc, sizeof(unsigned long));
 
@@ -155,7 +197,9 @@ void oskar_binary_write_ext(oskar_Binary* handle, unsigned char data_type,
 {
     oskar_BinaryTag tag;
     size_t block_size, lgroup, ltag;
-    unsigned long crc = 0;
+    unsigned long crc = 0, crc_header = 0;
+    long payload_offset;
+    const int index = user_index;
 
     /* Check if safe to proceed. */
     if (*status) return;
@@ -233,7 +277,15 @@ void oskar_binary_write_ext(oskar_Binary* handle, unsigned char data_type,
     crc = oskar_crc_compute(handle->crc_data, &tag, sizeof(oskar_BinaryTag));
     crc = oskar_crc_update(handle->crc_data, crc, name_group, tag.group.bytes);
     crc = oskar_crc_update(handle->crc_data, crc, name_tag, tag.tag.bytes);
+    crc_header = crc;
     crc = oskar_crc_update(handle->crc_data, crc, data, data_size);
+
+    /* Add the tag to the index record. */
+    payload_offset = ftell(handle->stream) + (long) (sizeof(oskar_BinaryTag) +
+            tag.group.bytes + tag.tag.bytes);
+    record_tag(handle, 1, data_type, tag.group.bytes, tag.tag.bytes,
+            name_group, name_tag, index, payload_offset, data_size,
+            data_size + tag.group.bytes + tag.tag.bytes + 4, crc_header, crc);
     if (oskar_endian() != OSKAR_LITTLE_ENDIAN)
         oskar_endian_swap(&crc, sizeof(unsigned long));
 
@@ -31,10 +31,39 @@
 #include <stdlib.h>
 #include <string.h>
 
+/* Select the CRC-32C instructions to use, if any. */
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <nmmintrin.h>
+#define CRC32C_HW 1
+#define CRC32C_TARGET __attribute__((target("sse4.2")))
+#define CRC32C_U8(C, P) _mm_crc32_u8((C), *(P))
+#define CRC32C_U64(C, V) ((unsigned int) _mm_crc32_u64((C), (V)))
+#elif defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#include <nmmintrin.h>
+#define CRC32C_HW 1
+#define CRC32C_TARGET
+#define CRC32C_U8(C, P) _mm_crc32_u8((C), *(P))
+#define CRC32C_U64(C, V) ((unsigned int) _mm_crc32_u64((C), (V)))
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32) && \
+        !defined(__AARCH64EB__)
+#include <arm_acle.h>
+#define CRC32C_HW 1
+#define CRC32C_TARGET
+#define CRC32C_U8(C, P) __crc32cb((C), *(P))
+#define CRC32C_U64(C, V) __crc32cd((C), (V))
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#ifdef CRC32C_HW
+/* Block lengths, in bytes, for three-way interleaved CRC computation. */
+#define CRC32C_LONG 8192
+#define CRC32C_SHORT 256
+#endif
+
 struct oskar_CRC
 {
     int type;
@@ -42,12 +71,153 @@ struct oskar_CRC
     unsigned long init;
     unsigned long xorout;
     unsigned long t[8][256];
+#ifdef CRC32C_HW
+    int use_hw;
+    unsigned int shift_long[4][256];
+    unsigned int shift_short[4][256];
+#endif
 };
 #ifndef OSKAR_CRC_TYPEDEF_
 #define OSKAR_CRC_TYPEDEF_
 typedef struct oskar_CRC oskar_CRC;
 #endif /* OSKAR_CRC_TYPEDEF_ */
 
+#ifdef CRC32C_HW
+
+static int crc32c_hw_available(void)
+{
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    return __builtin_cpu_supports("sse4.2") ? 1 : 0;
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 20)) ? 1 : 0;
+#else
+    return 1;
+#endif
+}
+
+/* Multiplies a vector by a 32 x 32 matrix over GF(2). */
+static unsigned int gf2_times(const unsigned int* mat, unsigned int vec)
+{
+    unsigned int sum = 0;
+    for (; vec; vec >>= 1, ++mat)
+        if (vec & 1) sum ^= *mat;
+    return sum;
+}
+
+/* Fills the tables used to shift a CRC value past a block of zero bytes. */
+static void crc32c_shift_tables(unsigned long poly, size_t num_bytes,
+        unsigned int table[4][256])
+{
+    unsigned int op[32], sq[32], tmp[32], row = 1;
+    int i, k;
+
+    /* Operator for one zero bit, in the reflected bit order. */
+    sq[0] = (unsigned int) poly;
+    for (i = 1; i < 32; ++i, row <<= 1)
+        sq[i] = row;
+
+    /* Square it three times to get the operator for one zero byte. */
+    for (k = 0; k < 3; ++k)
+    {
+        for (i = 0; i < 32; ++i) tmp[i] = gf2_times(sq, sq[i]);
+        memcpy(sq, tmp, sizeof(tmp));
+    }
+
+    /* Raise it to the power num_bytes, by repeated squaring. */
+    for (i = 0, row = 1; i < 32; ++i, row <<= 1)
+        op[i] = row;
+    for (; num_bytes; num_bytes >>= 1)
+    {
+        if (num_bytes & 1)
+        {
+            for (i = 0; i < 32; ++i) tmp[i] = gf2_times(sq, op[i]);
+            memcpy(op, tmp, sizeof(tmp));
+        }
+        for (i = 0; i < 32; ++i) tmp[i] = gf2_times(sq, sq[i]);
+        memcpy(sq, tmp, sizeof(tmp));
+    }
+
+    /* Tabulate the operator for each byte of the CRC value. */
+    for (k = 0; k < 4; ++k)
+        for (i = 0; i < 256; ++i)
+            table[k][i] = gf2_times(op, (unsigned int) i << (8 * k));
+}
+
+static unsigned int crc32c_shift(const unsigned int table[4][256],
+        unsigned int crc)
+{
+    return table[0][crc & 0xFF] ^ table[1][(crc >> 8) & 0xFF] ^
+            table[2][(crc >> 16) & 0xFF] ^ table[3][crc >> 24];
+}
+
+/*
+ * Updates a raw (not inverted) CRC-32C value using hardware instructions.
+ * Long buffers are processed as three interleaved streams to hide the
+ * latency of the CRC instruction, and the results are combined by shifting
+ * the earlier ones past the later blocks.
+ */
+CRC32C_TARGET
+static unsigned int crc32c_hw(const oskar_CRC* crc_data, unsigned int crc,
+        const unsigned char* p, size_t num_bytes)
+{
+    unsigned long long v0, v1, v2;
+    unsigned int crc1, crc2;
+    const unsigned char* end = p + num_bytes;
+    const unsigned char* block_end;
+
+    /* Align to an 8-byte boundary. */
+    while (p < end && ((size_t) p & 7))
+        crc = CRC32C_U8(crc, p++);
+
+    /* Process blocks of three long streams, then three short streams. */
+    while ((size_t) (end - p) >= 3 * CRC32C_LONG)
+    {
+        crc1 = crc2 = 0;
+        for (block_end = p + CRC32C_LONG; p < block_end; p += 8)
+        {
+            memcpy(&v0, p, 8);
+            memcpy(&v1, p + CRC32C_LONG, 8);
+            memcpy(&v2, p + 2 * CRC32C_LONG, 8);
+            crc = CRC32C_U64(crc, v0);
+            crc1 = CRC32C_U64(crc1, v1);
+            crc2 = CRC32C_U64(crc2, v2);
+        }
+        crc = crc32c_shift(crc_data->shift_long, crc) ^ crc1;
+        crc = crc32c_shift(crc_data->shift_long, crc) ^ crc2;
+        p += 2 * CRC32C_LONG;
+    }
+    while ((size_t) (end - p) >= 3 * CRC32C_SHORT)
+    {
+        crc1 = crc2 = 0;
+        for (block_end = p + CRC32C_SHORT; p < block_end; p += 8)
+        {
+            memcpy(&v0, p, 8);
+            memcpy(&v1, p + CRC32C_SHORT, 8);
+            memcpy(&v2, p + 2 * CRC32C_SHORT, 8);
+            crc = CRC32C_U64(crc, v0);
+            crc1 = CRC32C_U64(crc1, v1);
+            crc2 = CRC32C_U64(crc2, v2);
+        }
+        crc = crc32c_shift(crc_data->shift_short, crc) ^ crc1;
+        crc = crc32c_shift(crc_data->shift_short, crc) ^ crc2;
+        p += 2 * CRC32C_SHORT;
+    }
+
+    /* Process the remaining 8-byte words, then the remaining bytes. */
+    for (; (size_t) (end - p) >= 8; p += 8)
+    {
+        memcpy(&v0, p, 8);
+        crc = CRC32C_U64(crc, v0);
+    }
+    while (p < end)
+        crc = CRC32C_U8(crc, p++);
+    return crc;
+}
+
+#endif /* CRC32C_HW */
+
 
 oskar_CRC* oskar_crc_create(int type)
 {
@@ -57,6 +227,7 @@ oskar_CRC* oskar_crc_create(int type)
     /* Create the data structure. */
     d = (oskar_CRC*) malloc(sizeof(oskar_CRC));
     d->type = type;
+    d->poly = d->init = d->xorout = 0;
 
     /* Set the polynomial, initial and post-XOR values based on type. */
     /* Always need the "reversed" form of the polynomial for this generator. */
@@ -104,6 +275,16 @@ oskar_CRC* oskar_crc_create(int type)
         }
     }
 
+#ifdef CRC32C_HW
+    /* Use the CRC-32C instructions, if supported by the CPU. */
+    d->use_hw = (type == OSKAR_CRC_32C) ? crc32c_hw_available() : 0;
+    if (d->use_hw)
+    {
+        crc32c_shift_tables(d->poly, CRC32C_LONG, d->shift_long);
+        crc32c_shift_tables(d->poly, CRC32C_SHORT, d->shift_short);
+    }
+#endif
+
     return d;
 }
 
@@ -121,6 +302,11 @@ unsigned long oskar_crc_update(const oskar_CRC* crc_data, unsigned long crc,
     /* Use 8-byte chunks. */
     if (crc != crc_data->init) crc ^= crc_data->xorout;
     byte = (const unsigned char*) data;
+#ifdef CRC32C_HW
+    if (crc_data->use_hw)
+        return crc32c_hw(crc_data, (unsigned int) crc, byte, num_bytes) ^
+                crc_data->xorout;
+#endif
     if (oskar_endian() == OSKAR_LITTLE_ENDIAN)
     {
         while (num_bytes >= 8)
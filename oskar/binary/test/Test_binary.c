@@ -27,6 +27,7 @@
  */
 
 #include "binary/oskar_binary.h"
+#include "binary/oskar_crc.h"
 
 #include <math.h>
 #include <stdio.h>
@@ -48,6 +49,57 @@
     }
 
 
+static unsigned long crc32c_bitwise(const unsigned char* data, size_t len)
+{
+    unsigned long crc = 0xFFFFFFFFuL;
+    int j;
+    while (len--)
+    {
+        crc ^= *data++;
+        for (j = 0; j < 8; ++j)
+            crc = (crc >> 1) ^ ((crc & 1) ? 0x82F63B78uL : 0);
+    }
+    return crc ^ 0xFFFFFFFFuL;
+}
+
+static void test_crc(void)
+{
+    const size_t lengths[] = {0, 1, 7, 8, 9, 63, 767, 768, 769, 1000,
+            24575, 24576, 24577, 60000};
+    const size_t num_bytes = 60003;
+    unsigned char* data;
+    oskar_CRC* crc_data;
+    size_t i, j, offset;
+
+    /* Check the standard test value. */
+    crc_data = oskar_crc_create(OSKAR_CRC_32C);
+    ASSERT_INT_EQ((int) 0xE3069283uL,
+            (int) oskar_crc_compute(crc_data, "123456789", 9));
+
+    /* Check lengths and alignments used by the different code paths. */
+    data = (unsigned char*) malloc(num_bytes);
+    for (i = 0; i < num_bytes; ++i)
+        data[i] = (unsigned char) ((i * 2654435761uL) >> 13);
+    for (offset = 0; offset < 3; ++offset)
+    {
+        for (i = 0; i < sizeof(lengths) / sizeof(size_t); ++i)
+        {
+            unsigned long crc;
+            const unsigned char* p = data + offset;
+            ASSERT_INT_EQ((int) crc32c_bitwise(p, lengths[i]),
+                    (int) oskar_crc_compute(crc_data, p, lengths[i]));
+
+            /* Check that updating in two parts gives the same result. */
+            j = lengths[i] / 3;
+            crc = oskar_crc_compute(crc_data, p, j);
+            crc = oskar_crc_update(crc_data, crc, p + j, lengths[i] - j);
+            ASSERT_INT_EQ((int) crc32c_bitwise(p, lengths[i]), (int) crc);
+        }
+    }
+    free(data);
+    oskar_crc_free(crc_data);
+}
+
 int main(void)
 {
     const char filename[] = "temp_test_binary_file.dat";
@@ -176,9 +228,64 @@ int main(void)
     oskar_binary_free(h);
     ASSERT_INT_EQ(0, status);
 
+    /* Write many tags, including repeated ones, and query them in reverse. */
+    h = oskar_binary_create(filename, 'w', &status);
+    for (i = 0; i < 1000; ++i)
+    {
+        oskar_binary_write_int(h, 1, 2, i, i, &status);
+        oskar_binary_write_ext_int(h, "group", "tag", i, 2 * i, &status);
+        oskar_binary_write_int(h, 3, 4, 0, i, &status);
+    }
+    ASSERT_INT_EQ(0, status);
+    oskar_binary_free(h);
+    h = oskar_binary_create(filename, 'r', &status);
+    ASSERT_INT_EQ(3000, oskar_binary_num_tags(h));
+    ASSERT_INT_EQ(-1, oskar_binary_query_ext(h, 0, "oskar_binary",
+            "tag_index", 0, 0, &status));
+    ASSERT_INT_EQ((int) OSKAR_ERR_BINARY_TAG_NOT_FOUND, status);
+    status = 0;
+    for (i = 999; i >= 0; --i)
+    {
+        oskar_binary_read_ext_int(h, "group", "tag", i, &a, &status);
+        ASSERT_INT_EQ(2 * i, a);
+        oskar_binary_read_int(h, 1, 2, i, &b, &status);
+        ASSERT_INT_EQ(i, b);
+        ASSERT_INT_EQ(3 * i, oskar_binary_query(h, 0, 1, 2, i, 0, &status));
+    }
+    ASSERT_INT_EQ(0, status);
+
+    /* Check that the search start selects the first match after it. */
+    oskar_binary_read_int(h, 3, 4, 0, &c, &status);
+    ASSERT_INT_EQ(0, c);
+    oskar_binary_set_query_search_start(h, 1500, &status);
+    oskar_binary_read_int(h, 3, 4, 0, &c, &status);
+    ASSERT_INT_EQ(500, c);
+    ASSERT_INT_EQ(0, status);
+    oskar_binary_free(h);
+
+    /* Append a tag, so the index record is stale and the file is scanned. */
+    h = oskar_binary_create(filename, 'a', &status);
+    oskar_binary_write_int(h, 5, 6, 7, 8, &status);
+    oskar_binary_free(h);
+    h = oskar_binary_create(filename, 'r', &status);
+    ASSERT_INT_EQ(3001, oskar_binary_num_tags(h));
+    ASSERT_INT_EQ(-1, oskar_binary_query_ext(h, 0, "oskar_binary",
+            "tag_index", 0, 0, &status));
+    ASSERT_INT_EQ((int) OSKAR_ERR_BINARY_TAG_NOT_FOUND, status);
+    status = 0;
+    oskar_binary_read_int(h, 5, 6, 7, &c, &status);
+    ASSERT_INT_EQ(8, c);
+    oskar_binary_read_ext_int(h, "group", "tag", 999, &c, &status);
+    ASSERT_INT_EQ(1998, c);
+    ASSERT_INT_EQ(0, status);
+    oskar_binary_free(h);
+
     /* Remove the file. */
     remove(filename);
 
+    /* Check CRC codes. */
+    test_crc();
+
     printf("PASS: Test_binary OK.\n");
     return 0;
 }
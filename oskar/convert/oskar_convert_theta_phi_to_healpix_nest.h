@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2018, The University of Oxford
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the University of Oxford nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef OSKAR_CONVERT_THETA_PHI_TO_HEALPIX_NEST_H_
+#define OSKAR_CONVERT_THETA_PHI_TO_HEALPIX_NEST_H_
+
+/**
+ * @file oskar_convert_theta_phi_to_healpix_nest.h
+ */
+
+#include <oskar_global.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief
+ * Converts spherical angles to a Healpix pixel ID in the NESTED scheme.
+ *
+ * @details
+ * nside must be a power of 2 in the range (1   <= nside <= 8192)
+ * theta must be in the range (0.0 <= theta <= pi )
+ *
+ * Pixel IDs in the NESTED scheme follow a space-filling curve,
+ * so nearby positions usually have nearby pixel IDs.
+ */
+OSKAR_EXPORT
+void oskar_convert_theta_phi_to_healpix_nest(long nside, double theta,
+        double phi, long *ipix);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OSKAR_CONVERT_THETA_PHI_TO_HEALPIX_NEST_H_ */
@@ -29,6 +29,7 @@
 #include "convert/oskar_convert_ecef_to_station_uvw.h"
 #include "convert/oskar_convert_ecef_to_station_uvw_cuda.h"
 #include "utility/oskar_device_utils.h"
+#include "utility/oskar_cl_utils.h"
 #include "convert/private_convert_ecef_to_station_uvw_inline.h"
 
 #include <math.h>
@@ -209,6 +210,79 @@ void oskar_convert_ecef_to_station_uvw(int num_stations, const oskar_Mem* x,
             *status = OSKAR_ERR_BAD_DATA_TYPE;
         }
     }
+    else if (location & OSKAR_CL)
+    {
+#ifdef OSKAR_HAVE_OPENCL
+        cl_kernel k = 0;
+        cl_int error, num;
+        cl_uint i, arg = 0;
+        size_t global_size, local_size;
+        double trig[4];
+        if (type == OSKAR_SINGLE)
+            k = oskar_cl_kernel("convert_ecef_to_station_uvw_float");
+        else if (type == OSKAR_DOUBLE)
+            k = oskar_cl_kernel("convert_ecef_to_station_uvw_double");
+        else
+        {
+            *status = OSKAR_ERR_BAD_DATA_TYPE;
+            return;
+        }
+        if (!k)
+        {
+            *status = OSKAR_ERR_FUNCTION_NOT_AVAILABLE;
+            return;
+        }
+
+        /* Set kernel arguments. */
+        trig[0] = sin(ha0_rad);
+        trig[1] = cos(ha0_rad);
+        trig[2] = sin(dec0_rad);
+        trig[3] = cos(dec0_rad);
+        num = (cl_int) num_stations;
+        error = clSetKernelArg(k, arg++, sizeof(cl_int), &num);
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer_const(x, status));
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer_const(y, status));
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer_const(z, status));
+        for (i = 0; i < 4; ++i)
+        {
+            if (type == OSKAR_SINGLE)
+            {
+                const cl_float t = (cl_float) trig[i];
+                error |= clSetKernelArg(k, arg++, sizeof(cl_float), &t);
+            }
+            else
+            {
+                const cl_double t = (cl_double) trig[i];
+                error |= clSetKernelArg(k, arg++, sizeof(cl_double), &t);
+            }
+        }
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer(u, status));
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer(v, status));
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer(w, status));
+        if (*status) return;
+        if (error != CL_SUCCESS)
+        {
+            *status = OSKAR_ERR_INVALID_ARGUMENT;
+            return;
+        }
+
+        /* Launch kernel on current command queue. */
+        local_size = oskar_cl_is_gpu() ? 256 : 128;
+        global_size = ((num + local_size - 1) / local_size) * local_size;
+        error = clEnqueueNDRangeKernel(oskar_cl_command_queue(), k, 1, NULL,
+                &global_size, &local_size, 0, NULL, NULL);
+        if (error != CL_SUCCESS)
+            *status = OSKAR_ERR_KERNEL_LAUNCH_FAILURE;
+#else
+        *status = OSKAR_ERR_OPENCL_NOT_AVAILABLE;
+#endif
+    }
     else
     {
         *status = OSKAR_ERR_BAD_LOCATION;
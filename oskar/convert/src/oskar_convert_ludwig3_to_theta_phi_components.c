@@ -29,6 +29,7 @@
 #include "convert/oskar_convert_ludwig3_to_theta_phi_components.h"
 #include "convert/oskar_convert_ludwig3_to_theta_phi_components_cuda.h"
 #include "utility/oskar_device_utils.h"
+#include "utility/oskar_cl_utils.h"
 #include "convert/private_convert_ludwig3_to_theta_phi_components_inline.h"
 
 #ifdef __cplusplus
@@ -81,7 +82,55 @@ void oskar_convert_ludwig3_to_theta_phi_components(oskar_Mem* vec,
     location = oskar_mem_location(phi);
 
     /* Convert vector representation from Ludwig-3 to spherical. */
-    if (type == OSKAR_SINGLE)
+    if (location & OSKAR_CL)
+    {
+#ifdef OSKAR_HAVE_OPENCL
+        cl_kernel k = 0;
+        cl_int error, num, off, str;
+        cl_uint arg = 0;
+        size_t global_size, local_size;
+        if (type == OSKAR_DOUBLE)
+            k = oskar_cl_kernel(
+                    "convert_ludwig3_to_theta_phi_components_double");
+        else
+            k = oskar_cl_kernel(
+                    "convert_ludwig3_to_theta_phi_components_float");
+        if (!k)
+        {
+            *status = OSKAR_ERR_FUNCTION_NOT_AVAILABLE;
+            return;
+        }
+
+        /* Set kernel arguments. */
+        off = (cl_int) offset;
+        str = (cl_int) stride;
+        num = (cl_int) num_points;
+        error = clSetKernelArg(k, arg++, sizeof(cl_int), &num);
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer_const(phi, status));
+        error |= clSetKernelArg(k, arg++, sizeof(cl_int), &off);
+        error |= clSetKernelArg(k, arg++, sizeof(cl_int), &str);
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer(vec, status));
+        if (*status) return;
+        if (error != CL_SUCCESS)
+        {
+            *status = OSKAR_ERR_INVALID_ARGUMENT;
+            return;
+        }
+
+        /* Launch kernel on current command queue. */
+        local_size = oskar_cl_is_gpu() ? 256 : 128;
+        global_size = ((num + local_size - 1) / local_size) * local_size;
+        error = clEnqueueNDRangeKernel(oskar_cl_command_queue(), k, 1, NULL,
+                &global_size, &local_size, 0, NULL, NULL);
+        if (error != CL_SUCCESS)
+            *status = OSKAR_ERR_KERNEL_LAUNCH_FAILURE;
+#else
+        *status = OSKAR_ERR_OPENCL_NOT_AVAILABLE;
+#endif
+    }
+    else if (type == OSKAR_SINGLE)
     {
         float2 *h_theta, *v_phi;
         const float *phi_;
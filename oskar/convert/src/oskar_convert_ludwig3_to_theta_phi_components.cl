@@ -0,0 +1,18 @@
+/* Copyright (c) 2018, The University of Oxford. See LICENSE file. */
+
+kernel void convert_ludwig3_to_theta_phi_components_REAL(const int num_points,
+        global const REAL* restrict phi, const int offset, const int stride,
+        global REAL2* restrict vec)
+{
+    REAL sin_p, cos_p;
+    const int i = get_global_id(0);
+    if (i >= num_points) return;
+    const int i_out = offset + i * stride;
+    sin_p = sincos(phi[i], &cos_p);
+    const REAL2 h = vec[i_out];
+    const REAL2 v = vec[i_out + 1];
+    vec[i_out].x = h.x * cos_p + v.x * sin_p;
+    vec[i_out].y = h.y * cos_p + v.y * sin_p;
+    vec[i_out + 1].x = -h.x * sin_p + v.x * cos_p;
+    vec[i_out + 1].y = -h.y * sin_p + v.y * cos_p;
+}
@@ -29,6 +29,7 @@
 #include "convert/oskar_convert_relative_directions_to_enu_directions.h"
 #include "convert/oskar_convert_relative_directions_to_enu_directions_cuda.h"
 #include "convert/oskar_convert_relative_directions_to_enu_directions_inline.h"
+#include "utility/oskar_cl_utils.h"
 #include <math.h>
 
 #ifdef __cplusplus
@@ -130,7 +131,79 @@ void oskar_convert_relative_directions_to_enu_directions(
     }
 
     /* Switch on type and location. */
-    if (type == OSKAR_DOUBLE)
+    if (location & OSKAR_CL)
+    {
+#ifdef OSKAR_HAVE_OPENCL
+        cl_kernel k = 0;
+        cl_int error, num;
+        cl_uint i, arg = 0;
+        size_t global_size, local_size;
+        double par[6];
+        if (type == OSKAR_DOUBLE)
+            k = oskar_cl_kernel(
+                    "convert_relative_directions_to_enu_directions_double");
+        else
+            k = oskar_cl_kernel(
+                    "convert_relative_directions_to_enu_directions_float");
+        if (!k)
+        {
+            *status = OSKAR_ERR_FUNCTION_NOT_AVAILABLE;
+            return;
+        }
+
+        /* Set kernel arguments. */
+        num = (cl_int) num_points;
+        error = clSetKernelArg(k, arg++, sizeof(cl_int), &num);
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer_const(l, status));
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer_const(m, status));
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer_const(n, status));
+        par[0] = sin(ha0);
+        par[1] = cos(ha0);
+        par[2] = sin(dec0);
+        par[3] = cos(dec0);
+        par[4] = sin(lat);
+        par[5] = cos(lat);
+        for (i = 0; i < 6; ++i)
+        {
+            if (type == OSKAR_DOUBLE)
+            {
+                const cl_double t = (cl_double) par[i];
+                error |= clSetKernelArg(k, arg++, sizeof(cl_double), &t);
+            }
+            else
+            {
+                const cl_float t = (cl_float) par[i];
+                error |= clSetKernelArg(k, arg++, sizeof(cl_float), &t);
+            }
+        }
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer(x, status));
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer(y, status));
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer(z, status));
+        if (*status) return;
+        if (error != CL_SUCCESS)
+        {
+            *status = OSKAR_ERR_INVALID_ARGUMENT;
+            return;
+        }
+
+        /* Launch kernel on current command queue. */
+        local_size = oskar_cl_is_gpu() ? 256 : 128;
+        global_size = ((num + local_size - 1) / local_size) * local_size;
+        error = clEnqueueNDRangeKernel(oskar_cl_command_queue(), k, 1, NULL,
+                &global_size, &local_size, 0, NULL, NULL);
+        if (error != CL_SUCCESS)
+            *status = OSKAR_ERR_KERNEL_LAUNCH_FAILURE;
+#else
+        *status = OSKAR_ERR_OPENCL_NOT_AVAILABLE;
+#endif
+    }
+    else if (type == OSKAR_DOUBLE)
     {
         double *x_, *y_, *z_;
         const double *l_, *m_, *n_;
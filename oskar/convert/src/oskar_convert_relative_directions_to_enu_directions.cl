@@ -0,0 +1,22 @@
+/* Copyright (c) 2018, The University of Oxford. See LICENSE file. */
+
+kernel void convert_relative_directions_to_enu_directions_REAL(
+        const int num_points, global const REAL* restrict l,
+        global const REAL* restrict m, global const REAL* restrict n,
+        const REAL sin_ha0, const REAL cos_ha0, const REAL sin_dec0,
+        const REAL cos_dec0, const REAL sin_lat, const REAL cos_lat,
+        global REAL* restrict x, global REAL* restrict y,
+        global REAL* restrict z)
+{
+    const int i = get_global_id(0);
+    if (i >= num_points) return;
+    const REAL l_ = l[i], m_ = m[i], n_ = n[i];
+    REAL t;
+    x[i] = l_ * cos_ha0 + m_ * sin_ha0 * sin_dec0 - n_ * sin_ha0 * cos_dec0;
+    t = sin_lat * cos_ha0;
+    y[i] = -l_ * sin_lat * sin_ha0 + m_ * (cos_lat * cos_dec0 + t * sin_dec0) +
+            n_ * (cos_lat * sin_dec0 - t * cos_dec0);
+    t = cos_lat * cos_ha0;
+    z[i] = l_ * cos_lat * sin_ha0 + m_ * (sin_lat * cos_dec0 - t * sin_dec0) +
+            n_ * (sin_lat * sin_dec0 + t * cos_dec0);
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2018, The University of Oxford
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the University of Oxford nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "convert/oskar_convert_theta_phi_to_healpix_nest.h"
+#include "math/oskar_cmath.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Interleaves the bits of x and y, with x in the even bits. */
+static long xy_to_pix(long x, long y)
+{
+    long i, pix = 0;
+    for (i = 0; i < 16; ++i)
+    {
+        pix |= ((x >> i) & 1L) << (2 * i);
+        pix |= ((y >> i) & 1L) << (2 * i + 1);
+    }
+    return pix;
+}
+
+void oskar_convert_theta_phi_to_healpix_nest(long nside, double theta,
+        double phi, long *ipix)
+{
+    long face, ix, iy, jp, jm;
+    double z, za, tt;
+
+    /* Get longitude into correct range. */
+    while (phi >= 2.0 * M_PI)
+        phi -= 2.0 * M_PI;
+    while (phi < 0.0)
+        phi += 2.0 * M_PI;
+
+    z = cos(theta);
+    za = fabs(z);
+    tt = phi / (0.5 * M_PI); /* In range [0, 4). */
+
+    if (za <= 2.0/3.0)
+    {
+        /* Equatorial region. */
+        long ifp, ifm;
+        const double t1 = nside * (0.5 + tt), t2 = nside * (z * 0.75);
+
+        /* Indices of ascending and descending edge lines. */
+        jp = (long)(t1 - t2);
+        jm = (long)(t1 + t2);
+
+        /* Find the base pixel (face). */
+        ifp = jp / nside;
+        ifm = jm / nside;
+        if (ifp == ifm)
+            face = (ifp == 4) ? 4 : ifp + 4;
+        else if (ifp < ifm)
+            face = ifp;
+        else
+            face = ifm + 8;
+        ix = jm & (nside - 1);
+        iy = nside - (jp & (nside - 1)) - 1;
+    }
+    else
+    {
+        /* North and south polar caps. */
+        long ntt;
+        double tp, tmp;
+        ntt = (long)tt;
+        if (ntt >= 4) ntt = 3;
+        tp = tt - ntt;
+        tmp = nside * sqrt(3.0 * (1.0 - za));
+
+        /* Indices of increasing and decreasing edge lines. */
+        jp = (long)(tp * tmp);
+        jm = (long)((1.0 - tp) * tmp);
+        if (jp >= nside) jp = nside - 1;
+        if (jm >= nside) jm = nside - 1;
+        if (z >= 0.0)
+        {
+            face = ntt;
+            ix = nside - jm - 1;
+            iy = nside - jp - 1;
+        }
+        else
+        {
+            face = ntt + 8;
+            ix = jp;
+            iy = jm;
+        }
+    }
+
+    /* Return pixel index. */
+    *ipix = face * nside * nside + xy_to_pix(ix, iy);
+}
+
+#ifdef __cplusplus
+}
+#endif
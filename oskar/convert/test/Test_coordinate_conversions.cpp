@@ -29,9 +29,11 @@
 #include <gtest/gtest.h>
 
 #include "convert/oskar_convert_cirs_relative_directions_to_enu_directions.h"
+#include "convert/oskar_convert_healpix_ring_to_theta_phi.h"
 #include "convert/oskar_convert_lon_lat_to_relative_directions.h"
 #include "convert/oskar_convert_lon_lat_to_xyz.h"
 #include "convert/oskar_convert_relative_directions_to_lon_lat.h"
+#include "convert/oskar_convert_theta_phi_to_healpix_nest.h"
 #include "convert/oskar_convert_xyz_to_lon_lat.h"
 #include "math/oskar_cmath.h"
 #include "math/oskar_evaluate_image_lm_grid.h"
@@ -355,3 +357,35 @@ TEST(coordinate_conversions, cirs_relative_directions_to_enu_directions)
         oskar_mem_free(z_gpu, &status);
     }
 }
+
+TEST(coordinate_conversions, theta_phi_to_healpix_nest)
+{
+    // Every pixel centre must map to a different pixel.
+    long nside = 16, npix = 12 * nside * nside;
+    int* count = (int*)calloc(npix, sizeof(int));
+    for (long i = 0; i < npix; ++i)
+    {
+        long ipix = -1;
+        double theta = 0.0, phi = 0.0;
+        oskar_convert_healpix_ring_to_theta_phi_d(nside, i, &theta, &phi);
+        oskar_convert_theta_phi_to_healpix_nest(nside, theta, phi, &ipix);
+        ASSERT_GE(ipix, 0);
+        ASSERT_LT(ipix, npix);
+        count[ipix]++;
+    }
+    for (long i = 0; i < npix; ++i)
+        EXPECT_EQ(1, count[i]);
+    free(count);
+
+    // Check that pixels are nested at the next resolution.
+    srand(1);
+    for (int i = 0; i < 10000; ++i)
+    {
+        long p1 = 0, p2 = 0;
+        double theta = acos(2.0 * rand() / (double)RAND_MAX - 1.0);
+        double phi = 2.0 * M_PI * rand() / (double)RAND_MAX;
+        oskar_convert_theta_phi_to_healpix_nest(nside, theta, phi, &p1);
+        oskar_convert_theta_phi_to_healpix_nest(2 * nside, theta, phi, &p2);
+        EXPECT_EQ(p1, p2 / 4);
+    }
+}
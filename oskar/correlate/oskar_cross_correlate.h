@@ -72,6 +72,44 @@ void oskar_cross_correlate(oskar_Mem* vis, int n_sources,
         const oskar_Telescope* tel, const oskar_Mem* u, const oskar_Mem* v,
         const oskar_Mem* w, double gast, double frequency_hz, int* status);
 
+/**
+ * @brief Forms visibilities, applying the interferometer phase on the fly.
+ *
+ * @details
+ * This function is equivalent to evaluating Jones K using
+ * oskar_evaluate_jones_K(), joining it with the supplied Jones matrices
+ * and then calling oskar_cross_correlate(), except that the interferometer
+ * phase is evaluated inside the correlator, so the joined Jones matrices
+ * are never stored.
+ *
+ * Sources with Stokes I values outside the range given by
+ * \p source_min_jy (exclusive) and \p source_max_jy (inclusive)
+ * are ignored.
+ *
+ * This is currently available only for matrix (polarised) Jones data
+ * in CPU memory.
+ *
+ * @param[out] vis           Output visibility amplitudes.
+ * @param[in]  n_sources     Number of sources to use.
+ * @param[in]  jones         Set of Jones matrices, excluding Jones K.
+ * @param[in]  sky           Sky model.
+ * @param[in]  tel           Telescope model.
+ * @param[in]  u             Station u coordinates, in metres.
+ * @param[in]  v             Station v coordinates, in metres.
+ * @param[in]  w             Station w coordinates, in metres.
+ * @param[in]  gast          Greenwich apparent sidereal time, in radians.
+ * @param[in]  frequency_hz  Current observation frequency, in Hz.
+ * @param[in]  source_min_jy Minimum allowed source flux, in Jy.
+ * @param[in]  source_max_jy Maximum allowed source flux, in Jy.
+ * @param[in,out] status     Status return code.
+ */
+OSKAR_EXPORT
+void oskar_cross_correlate_fused(oskar_Mem* vis, int n_sources,
+        const oskar_Jones* jones, const oskar_Sky* sky,
+        const oskar_Telescope* tel, const oskar_Mem* u, const oskar_Mem* v,
+        const oskar_Mem* w, double gast, double frequency_hz,
+        double source_min_jy, double source_max_jy, int* status);
+
 #ifdef __cplusplus
 }
 #endif
@@ -242,6 +242,452 @@ void oskar_cross_correlate_gaussian_omp_d(
         double inv_wavelength, double frac_bandwidth, double time_int_sec,
         double gha0_rad, double dec0_rad, double4c* vis);
 
+/**
+ * @brief
+ * Correlate function applying interferometer phase, for point sources
+ * (single precision).
+ *
+ * @details
+ * Forms visibilities on all baselines by correlating Jones matrices for pairs
+ * of stations and summing along the source dimension.
+ *
+ * The interferometer phase (Jones K) is evaluated on the fly and applied to
+ * the supplied Jones matrices, which should therefore not include it.
+ * Sources for which the filter value is outside the allowed range are
+ * ignored, as in oskar_evaluate_jones_K().
+ *
+ * Note that the station x, y, z coordinates must be in the ECEF frame.
+ *
+ * @param[in] num_sources    Number of sources.
+ * @param[in] num_stations   Number of stations.
+ * @param[in] jones          Matrix of Jones matrices to correlate.
+ * @param[in] I              Source Stokes I values, in Jy.
+ * @param[in] Q              Source Stokes Q values, in Jy.
+ * @param[in] U              Source Stokes U values, in Jy.
+ * @param[in] V              Source Stokes V values, in Jy.
+ * @param[in] l              Source l-direction cosines from phase centre.
+ * @param[in] m              Source m-direction cosines from phase centre.
+ * @param[in] n              Source n-direction cosines from phase centre.
+ * @param[in] station_u      Station u-coordinates, in metres.
+ * @param[in] station_v      Station v-coordinates, in metres.
+ * @param[in] station_w      Station w-coordinates, in metres.
+ * @param[in] station_x      Station x-coordinates, in metres.
+ * @param[in] station_y      Station y-coordinates, in metres.
+ * @param[in] uv_min_lambda  Minimum allowed UV length, in wavelengths.
+ * @param[in] uv_max_lambda  Maximum allowed UV length, in wavelengths.
+ * @param[in] inv_wavelength Inverse of the wavelength, in metres.
+ * @param[in] frac_bandwidth Bandwidth divided by frequency.
+ * @param[in] time_int_sec   Time averaging interval, in seconds.
+ * @param[in] gha0_rad       Greenwich Hour Angle of phase centre, in radians.
+ * @param[in] dec0_rad       Declination of phase centre, in radians.
+ * @param[in] wavenumber     Wavenumber (2 pi / wavelength).
+ * @param[in] source_filter  Per-source values used for filtering.
+ * @param[in] filter_min     Minimum allowed filter value (exclusive).
+ * @param[in] filter_max     Maximum allowed filter value (inclusive).
+ * @param[in,out] vis        Modified output complex visibilities.
+ */
+OSKAR_EXPORT
+void oskar_cross_correlate_fused_point_omp_f(
+        int num_sources, int num_stations, const float4c* jones,
+        const float* I, const float* Q,
+        const float* U, const float* V,
+        const float* l, const float* m,
+        const float* n, const float* station_u,
+        const float* station_v, const float* station_w,
+        const float* station_x, const float* station_y,
+        float uv_min_lambda, float uv_max_lambda, float inv_wavelength,
+        float frac_bandwidth, float time_int_sec, float gha0_rad,
+        float dec0_rad, float wavenumber,
+        const float* source_filter, float filter_min, float filter_max,
+        float4c* vis);
+
+/**
+ * @brief
+ * Correlate function applying interferometer phase, for point sources
+ * (double precision).
+ *
+ * @details
+ * Forms visibilities on all baselines by correlating Jones matrices for pairs
+ * of stations and summing along the source dimension.
+ *
+ * The interferometer phase (Jones K) is evaluated on the fly and applied to
+ * the supplied Jones matrices, which should therefore not include it.
+ * Sources for which the filter value is outside the allowed range are
+ * ignored, as in oskar_evaluate_jones_K().
+ *
+ * Note that the station x, y, z coordinates must be in the ECEF frame.
+ *
+ * @param[in] num_sources    Number of sources.
+ * @param[in] num_stations   Number of stations.
+ * @param[in] jones          Matrix of Jones matrices to correlate.
+ * @param[in] I              Source Stokes I values, in Jy.
+ * @param[in] Q              Source Stokes Q values, in Jy.
+ * @param[in] U              Source Stokes U values, in Jy.
+ * @param[in] V              Source Stokes V values, in Jy.
+ * @param[in] l              Source l-direction cosines from phase centre.
+ * @param[in] m              Source m-direction cosines from phase centre.
+ * @param[in] n              Source n-direction cosines from phase centre.
+ * @param[in] station_u      Station u-coordinates, in metres.
+ * @param[in] station_v      Station v-coordinates, in metres.
+ * @param[in] station_w      Station w-coordinates, in metres.
+ * @param[in] station_x      Station x-coordinates, in metres.
+ * @param[in] station_y      Station y-coordinates, in metres.
+ * @param[in] uv_min_lambda  Minimum allowed UV length, in wavelengths.
+ * @param[in] uv_max_lambda  Maximum allowed UV length, in wavelengths.
+ * @param[in] inv_wavelength Inverse of the wavelength, in metres.
+ * @param[in] frac_bandwidth Bandwidth divided by frequency.
+ * @param[in] time_int_sec   Time averaging interval, in seconds.
+ * @param[in] gha0_rad       Greenwich Hour Angle of phase centre, in radians.
+ * @param[in] dec0_rad       Declination of phase centre, in radians.
+ * @param[in] wavenumber     Wavenumber (2 pi / wavelength).
+ * @param[in] source_filter  Per-source values used for filtering.
+ * @param[in] filter_min     Minimum allowed filter value (exclusive).
+ * @param[in] filter_max     Maximum allowed filter value (inclusive).
+ * @param[in,out] vis        Modified output complex visibilities.
+ */
+OSKAR_EXPORT
+void oskar_cross_correlate_fused_point_omp_d(
+        int num_sources, int num_stations, const double4c* jones,
+        const double* I, const double* Q,
+        const double* U, const double* V,
+        const double* l, const double* m,
+        const double* n, const double* station_u,
+        const double* station_v, const double* station_w,
+        const double* station_x, const double* station_y,
+        double uv_min_lambda, double uv_max_lambda, double inv_wavelength,
+        double frac_bandwidth, double time_int_sec, double gha0_rad,
+        double dec0_rad, double wavenumber,
+        const double* source_filter, double filter_min, double filter_max,
+        double4c* vis);
+
+/**
+ * @brief
+ * Correlate function applying interferometer phase, for Gaussian sources
+ * (single precision).
+ *
+ * @details
+ * Forms visibilities on all baselines by correlating Jones matrices for pairs
+ * of stations and summing along the source dimension.
+ *
+ * The interferometer phase (Jones K) is evaluated on the fly and applied to
+ * the supplied Jones matrices, which should therefore not include it.
+ * Sources for which the filter value is outside the allowed range are
+ * ignored, as in oskar_evaluate_jones_K().
+ *
+ * Gaussian parameters a, b, and c are assumed to be evaluated when the
+ * sky model is loaded.
+ *
+ * Note that the station x, y coordinates must be in the ECEF frame.
+ *
+ * @param[in] num_sources    Number of sources.
+ * @param[in] num_stations   Number of stations.
+ * @param[in] jones          Matrix of Jones matrices to correlate.
+ * @param[in] I              Source Stokes I values, in Jy.
+ * @param[in] Q              Source Stokes Q values, in Jy.
+ * @param[in] U              Source Stokes U values, in Jy.
+ * @param[in] V              Source Stokes V values, in Jy.
+ * @param[in] l              Source l-direction cosines from phase centre.
+ * @param[in] m              Source m-direction cosines from phase centre.
+ * @param[in] n              Source n-direction cosines from phase centre.
+ * @param[in] a              Source Gaussian parameter a.
+ * @param[in] b              Source Gaussian parameter b.
+ * @param[in] c              Source Gaussian parameter c.
+ * @param[in] station_u      Station u-coordinates, in metres.
+ * @param[in] station_v      Station v-coordinates, in metres.
+ * @param[in] station_w      Station w-coordinates, in metres.
+ * @param[in] station_x      Station x-coordinates, in metres.
+ * @param[in] station_y      Station y-coordinates, in metres.
+ * @param[in] uv_min_lambda  Minimum allowed UV length, in wavelengths.
+ * @param[in] uv_max_lambda  Maximum allowed UV length, in wavelengths.
+ * @param[in] inv_wavelength Inverse of the wavelength, in metres.
+ * @param[in] frac_bandwidth Bandwidth divided by frequency.
+ * @param[in] time_int_sec   Time averaging interval, in seconds.
+ * @param[in] gha0_rad       Greenwich Hour Angle of phase centre, in radians.
+ * @param[in] dec0_rad       Declination of phase centre, in radians.
+ * @param[in] wavenumber     Wavenumber (2 pi / wavelength).
+ * @param[in] source_filter  Per-source values used for filtering.
+ * @param[in] filter_min     Minimum allowed filter value (exclusive).
+ * @param[in] filter_max     Maximum allowed filter value (inclusive).
+ * @param[in,out] vis        Modified output complex visibilities.
+ */
+OSKAR_EXPORT
+void oskar_cross_correlate_fused_gaussian_omp_f(
+        int num_sources, int num_stations, const float4c* jones,
+        const float* I, const float* Q,
+        const float* U, const float* V,
+        const float* l, const float* m,
+        const float* n, const float* a,
+        const float* b, const float* c,
+        const float* station_u, const float* station_v,
+        const float* station_w, const float* station_x,
+        const float* station_y, float uv_min_lambda, float uv_max_lambda,
+        float inv_wavelength, float frac_bandwidth, float time_int_sec,
+        float gha0_rad, float dec0_rad, float wavenumber,
+        const float* source_filter, float filter_min, float filter_max,
+        float4c* vis);
+
+/**
+ * @brief
+ * Correlate function applying interferometer phase, for Gaussian sources
+ * (double precision).
+ *
+ * @details
+ * Forms visibilities on all baselines by correlating Jones matrices for pairs
+ * of stations and summing along the source dimension.
+ *
+ * The interferometer phase (Jones K) is evaluated on the fly and applied to
+ * the supplied Jones matrices, which should therefore not include it.
+ * Sources for which the filter value is outside the allowed range are
+ * ignored, as in oskar_evaluate_jones_K().
+ *
+ * Gaussian parameters a, b, and c are assumed to be evaluated when the
+ * sky model is loaded.
+ *
+ * Note that the station x, y coordinates must be in the ECEF frame.
+ *
+ * @param[in] num_sources    Number of sources.
+ * @param[in] num_stations   Number of stations.
+ * @param[in] jones          Matrix of Jones matrices to correlate.
+ * @param[in] I              Source Stokes I values, in Jy.
+ * @param[in] Q              Source Stokes Q values, in Jy.
+ * @param[in] U              Source Stokes U values, in Jy.
+ * @param[in] V              Source Stokes V values, in Jy.
+ * @param[in] l              Source l-direction cosines from phase centre.
+ * @param[in] m              Source m-direction cosines from phase centre.
+ * @param[in] n              Source n-direction cosines from phase centre.
+ * @param[in] a              Source Gaussian parameter a.
+ * @param[in] b              Source Gaussian parameter b.
+ * @param[in] c              Source Gaussian parameter c.
+ * @param[in] station_u      Station u-coordinates, in metres.
+ * @param[in] station_v      Station v-coordinates, in metres.
+ * @param[in] station_w      Station w-coordinates, in metres.
+ * @param[in] station_x      Station x-coordinates, in metres.
+ * @param[in] station_y      Station y-coordinates, in metres.
+ * @param[in] uv_min_lambda  Minimum allowed UV length, in wavelengths.
+ * @param[in] uv_max_lambda  Maximum allowed UV length, in wavelengths.
+ * @param[in] inv_wavelength Inverse of the wavelength, in metres.
+ * @param[in] frac_bandwidth Bandwidth divided by frequency.
+ * @param[in] time_int_sec   Time averaging interval, in seconds.
+ * @param[in] gha0_rad       Greenwich Hour Angle of phase centre, in radians.
+ * @param[in] dec0_rad       Declination of phase centre, in radians.
+ * @param[in] wavenumber     Wavenumber (2 pi / wavelength).
+ * @param[in] source_filter  Per-source values used for filtering.
+ * @param[in] filter_min     Minimum allowed filter value (exclusive).
+ * @param[in] filter_max     Maximum allowed filter value (inclusive).
+ * @param[in,out] vis        Modified output complex visibilities.
+ */
+OSKAR_EXPORT
+void oskar_cross_correlate_fused_gaussian_omp_d(
+        int num_sources, int num_stations, const double4c* jones,
+        const double* I, const double* Q,
+        const double* U, const double* V,
+        const double* l, const double* m,
+        const double* n, const double* a,
+        const double* b, const double* c,
+        const double* station_u, const double* station_v,
+        const double* station_w, const double* station_x,
+        const double* station_y, double uv_min_lambda, double uv_max_lambda,
+        double inv_wavelength, double frac_bandwidth, double time_int_sec,
+        double gha0_rad, double dec0_rad, double wavenumber,
+        const double* source_filter, double filter_min, double filter_max,
+        double4c* vis);
+
+/**
+ * @brief
+ * Correlate function for point sources, with status code
+ * (single precision).
+ *
+ * @details
+ * Same as oskar_cross_correlate_point_omp_f(), but sets \p status to
+ * OSKAR_ERR_MEMORY_ALLOC_FAILURE if scratch memory cannot be allocated.
+ * The visibilities are not modified if \p status is set.
+ */
+OSKAR_EXPORT
+void oskar_cross_correlate_point_omp_status_f(
+        int num_sources, int num_stations, const float4c* jones,
+        const float* I, const float* Q,
+        const float* U, const float* V,
+        const float* l, const float* m,
+        const float* n, const float* station_u,
+        const float* station_v, const float* station_w,
+        const float* station_x, const float* station_y,
+        float uv_min_lambda, float uv_max_lambda, float inv_wavelength,
+        float frac_bandwidth, float time_int_sec, float gha0_rad,
+        float dec0_rad, float4c* vis, int* status);
+
+/**
+ * @brief
+ * Correlate function for point sources, with status code
+ * (double precision).
+ *
+ * @details
+ * Same as oskar_cross_correlate_point_omp_d(), but sets \p status to
+ * OSKAR_ERR_MEMORY_ALLOC_FAILURE if scratch memory cannot be allocated.
+ * The visibilities are not modified if \p status is set.
+ */
+OSKAR_EXPORT
+void oskar_cross_correlate_point_omp_status_d(
+        int num_sources, int num_stations, const double4c* jones,
+        const double* I, const double* Q,
+        const double* U, const double* V,
+        const double* l, const double* m,
+        const double* n, const double* station_u,
+        const double* station_v, const double* station_w,
+        const double* station_x, const double* station_y,
+        double uv_min_lambda, double uv_max_lambda, double inv_wavelength,
+        double frac_bandwidth, double time_int_sec, double gha0_rad,
+        double dec0_rad, double4c* vis, int* status);
+
+/**
+ * @brief
+ * Correlate function for Gaussian sources, with status code
+ * (single precision).
+ *
+ * @details
+ * Same as oskar_cross_correlate_gaussian_omp_f(), but sets \p status to
+ * OSKAR_ERR_MEMORY_ALLOC_FAILURE if scratch memory cannot be allocated.
+ * The visibilities are not modified if \p status is set.
+ */
+OSKAR_EXPORT
+void oskar_cross_correlate_gaussian_omp_status_f(
+        int num_sources, int num_stations, const float4c* jones,
+        const float* I, const float* Q,
+        const float* U, const float* V,
+        const float* l, const float* m,
+        const float* n, const float* a,
+        const float* b, const float* c,
+        const float* station_u, const float* station_v,
+        const float* station_w, const float* station_x,
+        const float* station_y, float uv_min_lambda, float uv_max_lambda,
+        float inv_wavelength, float frac_bandwidth, float time_int_sec,
+        float gha0_rad, float dec0_rad, float4c* vis, int* status);
+
+/**
+ * @brief
+ * Correlate function for Gaussian sources, with status code
+ * (double precision).
+ *
+ * @details
+ * Same as oskar_cross_correlate_gaussian_omp_d(), but sets \p status to
+ * OSKAR_ERR_MEMORY_ALLOC_FAILURE if scratch memory cannot be allocated.
+ * The visibilities are not modified if \p status is set.
+ */
+OSKAR_EXPORT
+void oskar_cross_correlate_gaussian_omp_status_d(
+        int num_sources, int num_stations, const double4c* jones,
+        const double* I, const double* Q,
+        const double* U, const double* V,
+        const double* l, const double* m,
+        const double* n, const double* a,
+        const double* b, const double* c,
+        const double* station_u, const double* station_v,
+        const double* station_w, const double* station_x,
+        const double* station_y, double uv_min_lambda, double uv_max_lambda,
+        double inv_wavelength, double frac_bandwidth, double time_int_sec,
+        double gha0_rad, double dec0_rad, double4c* vis, int* status);
+
+/**
+ * @brief
+ * Correlate function applying interferometer phase, for point sources,
+ * with status code (single precision).
+ *
+ * @details
+ * Same as oskar_cross_correlate_fused_point_omp_f(), but sets \p status to
+ * OSKAR_ERR_MEMORY_ALLOC_FAILURE if scratch memory cannot be allocated.
+ * The visibilities are not modified if \p status is set.
+ */
+OSKAR_EXPORT
+void oskar_cross_correlate_fused_point_omp_status_f(
+        int num_sources, int num_stations, const float4c* jones,
+        const float* I, const float* Q,
+        const float* U, const float* V,
+        const float* l, const float* m,
+        const float* n, const float* station_u,
+        const float* station_v, const float* station_w,
+        const float* station_x, const float* station_y,
+        float uv_min_lambda, float uv_max_lambda, float inv_wavelength,
+        float frac_bandwidth, float time_int_sec, float gha0_rad,
+        float dec0_rad, float wavenumber,
+        const float* source_filter, float filter_min, float filter_max,
+        float4c* vis, int* status);
+
+/**
+ * @brief
+ * Correlate function applying interferometer phase, for point sources,
+ * with status code (double precision).
+ *
+ * @details
+ * Same as oskar_cross_correlate_fused_point_omp_d(), but sets \p status to
+ * OSKAR_ERR_MEMORY_ALLOC_FAILURE if scratch memory cannot be allocated.
+ * The visibilities are not modified if \p status is set.
+ */
+OSKAR_EXPORT
+void oskar_cross_correlate_fused_point_omp_status_d(
+        int num_sources, int num_stations, const double4c* jones,
+        const double* I, const double* Q,
+        const double* U, const double* V,
+        const double* l, const double* m,
+        const double* n, const double* station_u,
+        const double* station_v, const double* station_w,
+        const double* station_x, const double* station_y,
+        double uv_min_lambda, double uv_max_lambda, double inv_wavelength,
+        double frac_bandwidth, double time_int_sec, double gha0_rad,
+        double dec0_rad, double wavenumber,
+        const double* source_filter, double filter_min, double filter_max,
+        double4c* vis, int* status);
+
+/**
+ * @brief
+ * Correlate function applying interferometer phase, for Gaussian sources,
+ * with status code (single precision).
+ *
+ * @details
+ * Same as oskar_cross_correlate_fused_gaussian_omp_f(), but sets \p status to
+ * OSKAR_ERR_MEMORY_ALLOC_FAILURE if scratch memory cannot be allocated.
+ * The visibilities are not modified if \p status is set.
+ */
+OSKAR_EXPORT
+void oskar_cross_correlate_fused_gaussian_omp_status_f(
+        int num_sources, int num_stations, const float4c* jones,
+        const float* I, const float* Q,
+        const float* U, const float* V,
+        const float* l, const float* m,
+        const float* n, const float* a,
+        const float* b, const float* c,
+        const float* station_u, const float* station_v,
+        const float* station_w, const float* station_x,
+        const float* station_y, float uv_min_lambda, float uv_max_lambda,
+        float inv_wavelength, float frac_bandwidth, float time_int_sec,
+        float gha0_rad, float dec0_rad, float wavenumber,
+        const float* source_filter, float filter_min, float filter_max,
+        float4c* vis, int* status);
+
+/**
+ * @brief
+ * Correlate function applying interferometer phase, for Gaussian sources,
+ * with status code (double precision).
+ *
+ * @details
+ * Same as oskar_cross_correlate_fused_gaussian_omp_d(), but sets \p status to
+ * OSKAR_ERR_MEMORY_ALLOC_FAILURE if scratch memory cannot be allocated.
+ * The visibilities are not modified if \p status is set.
+ */
+OSKAR_EXPORT
+void oskar_cross_correlate_fused_gaussian_omp_status_d(
+        int num_sources, int num_stations, const double4c* jones,
+        const double* I, const double* Q,
+        const double* U, const double* V,
+        const double* l, const double* m,
+        const double* n, const double* a,
+        const double* b, const double* c,
+        const double* station_u, const double* station_v,
+        const double* station_w, const double* station_x,
+        const double* station_y, double uv_min_lambda, double uv_max_lambda,
+        double inv_wavelength, double frac_bandwidth, double time_int_sec,
+        double gha0_rad, double dec0_rad, double wavenumber,
+        const double* source_filter, double filter_min, double filter_max,
+        double4c* vis, int* status);
+
 #ifdef __cplusplus
 }
 #endif
@@ -31,6 +31,7 @@
 #include "correlate/oskar_auto_correlate_omp.h"
 #include "correlate/oskar_auto_correlate_scalar_cuda.h"
 #include "correlate/oskar_auto_correlate_scalar_omp.h"
+#include "utility/oskar_cl_utils.h"
 #include "utility/oskar_device_utils.h"
 
 #ifdef __cplusplus
@@ -176,6 +177,64 @@ void oskar_auto_correlate(oskar_Mem* vis, int n_sources,
         oskar_device_check_error(status);
 #else
         *status = OSKAR_ERR_CUDA_NOT_AVAILABLE;
+#endif
+    }
+    else if (location & OSKAR_CL)
+    {
+#ifdef OSKAR_HAVE_OPENCL
+        cl_kernel k = 0;
+        cl_int is_matrix, error, num, num_st;
+        cl_uint arg = 0;
+        size_t global_size, local_size;
+        is_matrix = oskar_type_is_matrix(jones_type);
+        if (base_type == OSKAR_DOUBLE)
+            k = oskar_cl_kernel(is_matrix ?
+                    "auto_correlate_double" : "auto_correlate_scalar_double");
+        else
+            k = oskar_cl_kernel(is_matrix ?
+                    "auto_correlate_float" : "auto_correlate_scalar_float");
+        if (!k)
+        {
+            *status = OSKAR_ERR_FUNCTION_NOT_AVAILABLE;
+            return;
+        }
+
+        /* Set kernel arguments. */
+        num = (cl_int) n_sources;
+        num_st = (cl_int) n_stations;
+        error = clSetKernelArg(k, arg++, sizeof(cl_int), &num);
+        error |= clSetKernelArg(k, arg++, sizeof(cl_int), &num_st);
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer_const(J, status));
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer_const(I, status));
+        if (is_matrix)
+        {
+            error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                    oskar_mem_cl_buffer_const(Q, status));
+            error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                    oskar_mem_cl_buffer_const(U, status));
+            error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                    oskar_mem_cl_buffer_const(V, status));
+        }
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer(vis, status));
+        if (*status) return;
+        if (error != CL_SUCCESS)
+        {
+            *status = OSKAR_ERR_INVALID_ARGUMENT;
+            return;
+        }
+
+        /* Launch kernel on current command queue, one item per station. */
+        local_size = oskar_cl_is_gpu() ? 256 : 128;
+        global_size = ((num_st + local_size - 1) / local_size) * local_size;
+        error = clEnqueueNDRangeKernel(oskar_cl_command_queue(), k, 1, NULL,
+                &global_size, &local_size, 0, NULL, NULL);
+        if (error != CL_SUCCESS)
+            *status = OSKAR_ERR_KERNEL_LAUNCH_FAILURE;
+#else
+        *status = OSKAR_ERR_OPENCL_NOT_AVAILABLE;
 #endif
     }
     else
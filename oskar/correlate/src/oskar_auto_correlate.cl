@@ -0,0 +1,98 @@
+/* Copyright (c) 2018, The University of Oxford. See LICENSE file. */
+
+/* Returns J * B * J^H, where B is the source brightness matrix. */
+REAL8 oskar_acorr_jbjh_REAL(const REAL8 J, const REAL I, const REAL Q,
+        const REAL U, const REAL V)
+{
+    REAL8 m, r;
+    const REAL b_a = I + Q, b_d = I - Q;
+
+    /* Multiply Jones matrix with (Hermitian) source brightness matrix. */
+    m.s0 = J.s0 * b_a + J.s2 * U + J.s3 * V;
+    m.s1 = J.s1 * b_a + J.s3 * U - J.s2 * V;
+    m.s2 = J.s0 * U - J.s1 * V + J.s2 * b_d;
+    m.s3 = J.s1 * U + J.s0 * V + J.s3 * b_d;
+    m.s4 = J.s4 * b_a + J.s6 * U + J.s7 * V;
+    m.s5 = J.s5 * b_a + J.s7 * U - J.s6 * V;
+    m.s6 = J.s4 * U - J.s5 * V + J.s6 * b_d;
+    m.s7 = J.s5 * U + J.s4 * V + J.s7 * b_d;
+
+    /* Multiply result with Hermitian transpose of Jones matrix. */
+    r.s0 = m.s0 * J.s0 + m.s1 * J.s1 + m.s2 * J.s2 + m.s3 * J.s3;
+    r.s1 = m.s1 * J.s0 - m.s0 * J.s1 + m.s3 * J.s2 - m.s2 * J.s3;
+    r.s2 = m.s0 * J.s4 + m.s1 * J.s5 + m.s2 * J.s6 + m.s3 * J.s7;
+    r.s3 = m.s1 * J.s4 - m.s0 * J.s5 + m.s3 * J.s6 - m.s2 * J.s7;
+    r.s4 = m.s4 * J.s0 + m.s5 * J.s1 + m.s6 * J.s2 + m.s7 * J.s3;
+    r.s5 = m.s5 * J.s0 - m.s4 * J.s1 + m.s7 * J.s2 - m.s6 * J.s3;
+    r.s6 = m.s4 * J.s4 + m.s5 * J.s5 + m.s6 * J.s6 + m.s7 * J.s7;
+    r.s7 = m.s5 * J.s4 - m.s4 * J.s5 + m.s7 * J.s6 - m.s6 * J.s7;
+    return r;
+}
+
+/* Adds VAL to SUM using Kahan summation. */
+#define OSKAR_ACORR_KAHAN_SUM(SUM, VAL, GUARD) {                           \
+        const REAL y__ = VAL - GUARD;                                      \
+        const REAL t__ = SUM + y__;                                        \
+        GUARD = (t__ - SUM) - y__;                                         \
+        SUM = t__; }
+
+kernel void auto_correlate_REAL(const int num_sources,
+        const int num_stations, global const REAL8* restrict jones,
+        global const REAL* restrict source_I,
+        global const REAL* restrict source_Q,
+        global const REAL* restrict source_U,
+        global const REAL* restrict source_V,
+        global REAL8* restrict vis)
+{
+    REAL8 sum, guard;
+    const int s = get_global_id(0); /* Station index. */
+    if (s >= num_stations) return;
+    global const REAL8* restrict jones_station = &jones[s * num_sources];
+    sum.s0 = sum.s1 = sum.s2 = sum.s3 = (REAL) 0;
+    sum.s4 = sum.s5 = sum.s6 = sum.s7 = (REAL) 0;
+    guard = sum;
+
+    /* Loop over sources. */
+    for (int i = 0; i < num_sources; ++i)
+    {
+        const REAL8 m = oskar_acorr_jbjh_REAL(jones_station[i],
+                source_I[i], source_Q[i], source_U[i], source_V[i]);
+        OSKAR_ACORR_KAHAN_SUM(sum.s0, m.s0, guard.s0)
+        OSKAR_ACORR_KAHAN_SUM(sum.s2, m.s2, guard.s2)
+        OSKAR_ACORR_KAHAN_SUM(sum.s3, m.s3, guard.s3)
+        OSKAR_ACORR_KAHAN_SUM(sum.s4, m.s4, guard.s4)
+        OSKAR_ACORR_KAHAN_SUM(sum.s5, m.s5, guard.s5)
+        OSKAR_ACORR_KAHAN_SUM(sum.s6, m.s6, guard.s6)
+    }
+
+    /* Add result to the station visibility.
+     * The imaginary parts of the diagonal terms are left blank. */
+    REAL8 out = vis[s];
+    out.s0 += sum.s0;
+    out.s2 += sum.s2; out.s3 += sum.s3;
+    out.s4 += sum.s4; out.s5 += sum.s5;
+    out.s6 += sum.s6;
+    vis[s] = out;
+}
+
+kernel void auto_correlate_scalar_REAL(const int num_sources,
+        const int num_stations, global const REAL2* restrict jones,
+        global const REAL* restrict source_I,
+        global REAL2* restrict vis)
+{
+    REAL sum = (REAL) 0, guard = (REAL) 0;
+    const int s = get_global_id(0); /* Station index. */
+    if (s >= num_stations) return;
+    global const REAL2* restrict jones_station = &jones[s * num_sources];
+
+    /* Loop over sources. */
+    for (int i = 0; i < num_sources; ++i)
+    {
+        const REAL2 t = jones_station[i];
+        const REAL val = (t.x * t.x + t.y * t.y) * source_I[i];
+        OSKAR_ACORR_KAHAN_SUM(sum, val, guard)
+    }
+    vis[s].x += sum;
+}
+
+#undef OSKAR_ACORR_KAHAN_SUM
@@ -31,6 +31,8 @@
 #include "correlate/oskar_cross_correlate_omp.h"
 #include "correlate/oskar_cross_correlate_scalar_cuda.h"
 #include "correlate/oskar_cross_correlate_scalar_omp.h"
+#include "math/oskar_cmath.h"
+#include "utility/oskar_cl_utils.h"
 #include "utility/oskar_device_utils.h"
 
 #include <float.h>
@@ -40,13 +42,53 @@
 extern "C" {
 #endif
 
+static void cross_correlate(oskar_Mem* vis, int n_sources,
+        const oskar_Jones* jones, const oskar_Sky* sky,
+        const oskar_Telescope* tel, const oskar_Mem* u, const oskar_Mem* v,
+        const oskar_Mem* w, double gast, double frequency_hz,
+        const oskar_Mem* filter, double filter_min, double filter_max,
+        int* status);
+
 void oskar_cross_correlate(oskar_Mem* vis, int n_sources,
         const oskar_Jones* jones, const oskar_Sky* sky,
         const oskar_Telescope* tel, const oskar_Mem* u, const oskar_Mem* v,
         const oskar_Mem* w, double gast, double frequency_hz, int* status)
+{
+    cross_correlate(vis, n_sources, jones, sky, tel, u, v, w,
+            gast, frequency_hz, 0, 0.0, 0.0, status);
+}
+
+void oskar_cross_correlate_fused(oskar_Mem* vis, int n_sources,
+        const oskar_Jones* jones, const oskar_Sky* sky,
+        const oskar_Telescope* tel, const oskar_Mem* u, const oskar_Mem* v,
+        const oskar_Mem* w, double gast, double frequency_hz,
+        double source_min_jy, double source_max_jy, int* status)
+{
+    if (*status) return;
+    if (oskar_sky_mem_location(sky) != OSKAR_CPU)
+    {
+        *status = OSKAR_ERR_BAD_LOCATION;
+        return;
+    }
+    if (!oskar_type_is_matrix(oskar_jones_type(jones)))
+    {
+        *status = OSKAR_ERR_BAD_DATA_TYPE;
+        return;
+    }
+    cross_correlate(vis, n_sources, jones, sky, tel, u, v, w,
+            gast, frequency_hz, oskar_sky_I_const(sky),
+            source_min_jy, source_max_jy, status);
+}
+
+static void cross_correlate(oskar_Mem* vis, int n_sources,
+        const oskar_Jones* jones, const oskar_Sky* sky,
+        const oskar_Telescope* tel, const oskar_Mem* u, const oskar_Mem* v,
+        const oskar_Mem* w, double gast, double frequency_hz,
+        const oskar_Mem* filter, double filter_min, double filter_max,
+        int* status)
 {
     int jones_type, base_type, location, n_stations, use_extended;
-    double inv_wavelength, frac_bandwidth, time_avg, gha0, dec0;
+    double inv_wavelength, frac_bandwidth, time_avg, gha0, dec0, wavenumber;
     double uv_filter_max, uv_filter_min;
     const oskar_Mem *J, *a, *b, *c, *l, *m, *n, *I, *Q, *U, *V, *x, *y;
 
@@ -60,6 +102,7 @@ void oskar_cross_correlate(oskar_Mem* vis, int n_sources,
     /* Get bandwidth-smearing terms. */
     frequency_hz = fabs(frequency_hz);
     inv_wavelength = frequency_hz / 299792458.0;
+    wavenumber = 2.0 * M_PI * frequency_hz / 299792458.0;
     frac_bandwidth = oskar_telescope_channel_bandwidth_hz(tel) / frequency_hz;
 
     /* Get time-average smearing term and Greenwich hour angle. */
@@ -155,50 +198,102 @@ void oskar_cross_correlate(oskar_Mem* vis, int n_sources,
             switch (oskar_mem_type(vis))
             {
             case OSKAR_SINGLE_COMPLEX_MATRIX:
-                oskar_cross_correlate_gaussian_omp_f(
-                        n_sources, n_stations,
-                        oskar_mem_float4c_const(J, status),
-                        oskar_mem_float_const(I, status),
-                        oskar_mem_float_const(Q, status),
-                        oskar_mem_float_const(U, status),
-                        oskar_mem_float_const(V, status),
-                        oskar_mem_float_const(l, status),
-                        oskar_mem_float_const(m, status),
-                        oskar_mem_float_const(n, status),
-                        oskar_mem_float_const(a, status),
-                        oskar_mem_float_const(b, status),
-                        oskar_mem_float_const(c, status),
-                        oskar_mem_float_const(u, status),
-                        oskar_mem_float_const(v, status),
-                        oskar_mem_float_const(w, status),
-                        oskar_mem_float_const(x, status),
-                        oskar_mem_float_const(y, status),
-                        uv_filter_min, uv_filter_max, inv_wavelength,
-                        frac_bandwidth, time_avg, gha0, dec0,
-                        oskar_mem_float4c(vis, status));
+                if (filter)
+                    oskar_cross_correlate_fused_gaussian_omp_status_f(
+                            n_sources, n_stations,
+                            oskar_mem_float4c_const(J, status),
+                            oskar_mem_float_const(I, status),
+                            oskar_mem_float_const(Q, status),
+                            oskar_mem_float_const(U, status),
+                            oskar_mem_float_const(V, status),
+                            oskar_mem_float_const(l, status),
+                            oskar_mem_float_const(m, status),
+                            oskar_mem_float_const(n, status),
+                            oskar_mem_float_const(a, status),
+                            oskar_mem_float_const(b, status),
+                            oskar_mem_float_const(c, status),
+                            oskar_mem_float_const(u, status),
+                            oskar_mem_float_const(v, status),
+                            oskar_mem_float_const(w, status),
+                            oskar_mem_float_const(x, status),
+                            oskar_mem_float_const(y, status),
+                            uv_filter_min, uv_filter_max, inv_wavelength,
+                            frac_bandwidth, time_avg, gha0, dec0,
+                            wavenumber,
+                            oskar_mem_float_const(filter, status),
+                            filter_min, filter_max,
+                            oskar_mem_float4c(vis, status), status);
+                else
+                    oskar_cross_correlate_gaussian_omp_status_f(
+                            n_sources, n_stations,
+                            oskar_mem_float4c_const(J, status),
+                            oskar_mem_float_const(I, status),
+                            oskar_mem_float_const(Q, status),
+                            oskar_mem_float_const(U, status),
+                            oskar_mem_float_const(V, status),
+                            oskar_mem_float_const(l, status),
+                            oskar_mem_float_const(m, status),
+                            oskar_mem_float_const(n, status),
+                            oskar_mem_float_const(a, status),
+                            oskar_mem_float_const(b, status),
+                            oskar_mem_float_const(c, status),
+                            oskar_mem_float_const(u, status),
+                            oskar_mem_float_const(v, status),
+                            oskar_mem_float_const(w, status),
+                            oskar_mem_float_const(x, status),
+                            oskar_mem_float_const(y, status),
+                            uv_filter_min, uv_filter_max, inv_wavelength,
+                            frac_bandwidth, time_avg, gha0, dec0,
+                            oskar_mem_float4c(vis, status), status);
                 break;
             case OSKAR_DOUBLE_COMPLEX_MATRIX:
-                oskar_cross_correlate_gaussian_omp_d(
-                        n_sources, n_stations,
-                        oskar_mem_double4c_const(J, status),
-                        oskar_mem_double_const(I, status),
-                        oskar_mem_double_const(Q, status),
-                        oskar_mem_double_const(U, status),
-                        oskar_mem_double_const(V, status),
-                        oskar_mem_double_const(l, status),
-                        oskar_mem_double_const(m, status),
-                        oskar_mem_double_const(n, status),
-                        oskar_mem_double_const(a, status),
-                        oskar_mem_double_const(b, status),
-                        oskar_mem_double_const(c, status),
-                        oskar_mem_double_const(u, status),
-                        oskar_mem_double_const(v, status),
-                        oskar_mem_double_const(w, status),
-                        oskar_mem_double_const(x, status),
-                        oskar_mem_double_const(y, status),
-                        uv_filter_min, uv_filter_max, inv_wavelength,
-                        frac_bandwidth, time_avg, gha0, dec0,
-                        oskar_mem_double4c(vis, status));
+                if (filter)
+                    oskar_cross_correlate_fused_gaussian_omp_status_d(
+                            n_sources, n_stations,
+                            oskar_mem_double4c_const(J, status),
+                            oskar_mem_double_const(I, status),
+                            oskar_mem_double_const(Q, status),
+                            oskar_mem_double_const(U, status),
+                            oskar_mem_double_const(V, status),
+                            oskar_mem_double_const(l, status),
+                            oskar_mem_double_const(m, status),
+                            oskar_mem_double_const(n, status),
+                            oskar_mem_double_const(a, status),
+                            oskar_mem_double_const(b, status),
+                            oskar_mem_double_const(c, status),
+                            oskar_mem_double_const(u, status),
+                            oskar_mem_double_const(v, status),
+                            oskar_mem_double_const(w, status),
+                            oskar_mem_double_const(x, status),
+                            oskar_mem_double_const(y, status),
+                            uv_filter_min, uv_filter_max, inv_wavelength,
+                            frac_bandwidth, time_avg, gha0, dec0,
+                            wavenumber,
+                            oskar_mem_double_const(filter, status),
+                            filter_min, filter_max,
+                            oskar_mem_double4c(vis, status), status);
+                else
+                    oskar_cross_correlate_gaussian_omp_status_d(
+                            n_sources, n_stations,
+                            oskar_mem_double4c_const(J, status),
+                            oskar_mem_double_const(I, status),
+                            oskar_mem_double_const(Q, status),
+                            oskar_mem_double_const(U, status),
+                            oskar_mem_double_const(V, status),
+                            oskar_mem_double_const(l, status),
+                            oskar_mem_double_const(m, status),
+                            oskar_mem_double_const(n, status),
+                            oskar_mem_double_const(a, status),
+                            oskar_mem_double_const(b, status),
+                            oskar_mem_double_const(c, status),
+                            oskar_mem_double_const(u, status),
+                            oskar_mem_double_const(v, status),
+                            oskar_mem_double_const(w, status),
+                            oskar_mem_double_const(x, status),
+                            oskar_mem_double_const(y, status),
+                            uv_filter_min, uv_filter_max, inv_wavelength,
+                            frac_bandwidth, time_avg, gha0, dec0,
+                            oskar_mem_double4c(vis, status), status);
                 break;
             case OSKAR_SINGLE_COMPLEX:
                 oskar_cross_correlate_scalar_gaussian_omp_f(
@@ -250,44 +345,90 @@ void oskar_cross_correlate(oskar_Mem* vis, int n_sources,
             switch (oskar_mem_type(vis))
             {
             case OSKAR_SINGLE_COMPLEX_MATRIX:
-                oskar_cross_correlate_point_omp_f(
-                        n_sources, n_stations,
-                        oskar_mem_float4c_const(J, status),
-                        oskar_mem_float_const(I, status),
-                        oskar_mem_float_const(Q, status),
-                        oskar_mem_float_const(U, status),
-                        oskar_mem_float_const(V, status),
-                        oskar_mem_float_const(l, status),
-                        oskar_mem_float_const(m, status),
-                        oskar_mem_float_const(n, status),
-                        oskar_mem_float_const(u, status),
-                        oskar_mem_float_const(v, status),
-                        oskar_mem_float_const(w, status),
-                        oskar_mem_float_const(x, status),
-                        oskar_mem_float_const(y, status),
-                        uv_filter_min, uv_filter_max, inv_wavelength,
-                        frac_bandwidth, time_avg, gha0, dec0,
-                        oskar_mem_float4c(vis, status));
+                if (filter)
+                    oskar_cross_correlate_fused_point_omp_status_f(
+                            n_sources, n_stations,
+                            oskar_mem_float4c_const(J, status),
+                            oskar_mem_float_const(I, status),
+                            oskar_mem_float_const(Q, status),
+                            oskar_mem_float_const(U, status),
+                            oskar_mem_float_const(V, status),
+                            oskar_mem_float_const(l, status),
+                            oskar_mem_float_const(m, status),
+                            oskar_mem_float_const(n, status),
+                            oskar_mem_float_const(u, status),
+                            oskar_mem_float_const(v, status),
+                            oskar_mem_float_const(w, status),
+                            oskar_mem_float_const(x, status),
+                            oskar_mem_float_const(y, status),
+                            uv_filter_min, uv_filter_max, inv_wavelength,
+                            frac_bandwidth, time_avg, gha0, dec0,
+                            wavenumber,
+                            oskar_mem_float_const(filter, status),
+                            filter_min, filter_max,
+                            oskar_mem_float4c(vis, status), status);
+                else
+                    oskar_cross_correlate_point_omp_status_f(
+                            n_sources, n_stations,
+                            oskar_mem_float4c_const(J, status),
+                            oskar_mem_float_const(I, status),
+                            oskar_mem_float_const(Q, status),
+                            oskar_mem_float_const(U, status),
+                            oskar_mem_float_const(V, status),
+                            oskar_mem_float_const(l, status),
+                            oskar_mem_float_const(m, status),
+                            oskar_mem_float_const(n, status),
+                            oskar_mem_float_const(u, status),
+                            oskar_mem_float_const(v, status),
+                            oskar_mem_float_const(w, status),
+                            oskar_mem_float_const(x, status),
+                            oskar_mem_float_const(y, status),
+                            uv_filter_min, uv_filter_max, inv_wavelength,
+                            frac_bandwidth, time_avg, gha0, dec0,
+                            oskar_mem_float4c(vis, status), status);
                 break;
             case OSKAR_DOUBLE_COMPLEX_MATRIX:
-                oskar_cross_correlate_point_omp_d(
-                        n_sources, n_stations,
-                        oskar_mem_double4c_const(J, status),
-                        oskar_mem_double_const(I, status),
-                        oskar_mem_double_const(Q, status),
-                        oskar_mem_double_const(U, status),
-                        oskar_mem_double_const(V, status),
-                        oskar_mem_double_const(l, status),
-                        oskar_mem_double_const(m, status),
-                        oskar_mem_double_const(n, status),
-                        oskar_mem_double_const(u, status),
-                        oskar_mem_double_const(v, status),
-                        oskar_mem_double_const(w, status),
-                        oskar_mem_double_const(x, status),
-                        oskar_mem_double_const(y, status),
-                        uv_filter_min, uv_filter_max, inv_wavelength,
-                        frac_bandwidth, time_avg, gha0, dec0,
-                        oskar_mem_double4c(vis, status));
+                if (filter)
+                    oskar_cross_correlate_fused_point_omp_status_d(
+                            n_sources, n_stations,
+                            oskar_mem_double4c_const(J, status),
+                            oskar_mem_double_const(I, status),
+                            oskar_mem_double_const(Q, status),
+                            oskar_mem_double_const(U, status),
+                            oskar_mem_double_const(V, status),
+                            oskar_mem_double_const(l, status),
+                            oskar_mem_double_const(m, status),
+                            oskar_mem_double_const(n, status),
+                            oskar_mem_double_const(u, status),
+                            oskar_mem_double_const(v, status),
+                            oskar_mem_double_const(w, status),
+                            oskar_mem_double_const(x, status),
+                            oskar_mem_double_const(y, status),
+                            uv_filter_min, uv_filter_max, inv_wavelength,
+                            frac_bandwidth, time_avg, gha0, dec0,
+                            wavenumber,
+                            oskar_mem_double_const(filter, status),
+                            filter_min, filter_max,
+                            oskar_mem_double4c(vis, status), status);
+                else
+                    oskar_cross_correlate_point_omp_status_d(
+                            n_sources, n_stations,
+                            oskar_mem_double4c_const(J, status),
+                            oskar_mem_double_const(I, status),
+                            oskar_mem_double_const(Q, status),
+                            oskar_mem_double_const(U, status),
+                            oskar_mem_double_const(V, status),
+                            oskar_mem_double_const(l, status),
+                            oskar_mem_double_const(m, status),
+                            oskar_mem_double_const(n, status),
+                            oskar_mem_double_const(u, status),
+                            oskar_mem_double_const(v, status),
+                            oskar_mem_double_const(w, status),
+                            oskar_mem_double_const(x, status),
+                            oskar_mem_double_const(y, status),
+                            uv_filter_min, uv_filter_max, inv_wavelength,
+                            frac_bandwidth, time_avg, gha0, dec0,
+                            oskar_mem_double4c(vis, status), status);
                 break;
             case OSKAR_SINGLE_COMPLEX:
                 oskar_cross_correlate_scalar_point_omp_f(
@@ -513,6 +654,110 @@ void oskar_cross_correlate(oskar_Mem* vis, int n_sources,
         oskar_device_check_error(status);
 #else
         *status = OSKAR_ERR_CUDA_NOT_AVAILABLE;
+#endif
+    }
+    else if (location & OSKAR_CL)
+    {
+#ifdef OSKAR_HAVE_OPENCL
+        cl_kernel k = 0;
+        cl_int is_matrix, error, num, num_st, ext;
+        cl_uint i, arg = 0;
+        size_t global_size, local_size;
+        double par[7];
+        is_matrix = oskar_type_is_matrix(jones_type);
+        if (base_type == OSKAR_DOUBLE)
+            k = oskar_cl_kernel(is_matrix ?
+                    "cross_correlate_double" : "cross_correlate_scalar_double");
+        else
+            k = oskar_cl_kernel(is_matrix ?
+                    "cross_correlate_float" : "cross_correlate_scalar_float");
+        if (!k)
+        {
+            *status = OSKAR_ERR_FUNCTION_NOT_AVAILABLE;
+            return;
+        }
+
+        /* Set kernel arguments. */
+        num = (cl_int) n_sources;
+        num_st = (cl_int) n_stations;
+        ext = (cl_int) use_extended;
+        error = clSetKernelArg(k, arg++, sizeof(cl_int), &num);
+        error |= clSetKernelArg(k, arg++, sizeof(cl_int), &num_st);
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer_const(J, status));
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer_const(I, status));
+        if (is_matrix)
+        {
+            error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                    oskar_mem_cl_buffer_const(Q, status));
+            error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                    oskar_mem_cl_buffer_const(U, status));
+            error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                    oskar_mem_cl_buffer_const(V, status));
+        }
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer_const(l, status));
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer_const(m, status));
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer_const(n, status));
+        error |= clSetKernelArg(k, arg++, sizeof(cl_int), &ext);
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer_const(a, status));
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer_const(b, status));
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer_const(c, status));
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer_const(u, status));
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer_const(v, status));
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer_const(w, status));
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer_const(x, status));
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer_const(y, status));
+        par[0] = uv_filter_min;
+        par[1] = uv_filter_max;
+        par[2] = inv_wavelength;
+        par[3] = frac_bandwidth;
+        par[4] = time_avg;
+        par[5] = gha0;
+        par[6] = dec0;
+        for (i = 0; i < 7; ++i)
+        {
+            if (base_type == OSKAR_DOUBLE)
+            {
+                const cl_double t = (cl_double) par[i];
+                error |= clSetKernelArg(k, arg++, sizeof(cl_double), &t);
+            }
+            else
+            {
+                const cl_float t = (cl_float) par[i];
+                error |= clSetKernelArg(k, arg++, sizeof(cl_float), &t);
+            }
+        }
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer(vis, status));
+        if (*status) return;
+        if (error != CL_SUCCESS)
+        {
+            *status = OSKAR_ERR_INVALID_ARGUMENT;
+            return;
+        }
+
+        /* Launch kernel on current command queue, one item per baseline. */
+        num = (cl_int) oskar_telescope_num_baselines(tel);
+        local_size = oskar_cl_is_gpu() ? 256 : 128;
+        global_size = ((num + local_size - 1) / local_size) * local_size;
+        error = clEnqueueNDRangeKernel(oskar_cl_command_queue(), k, 1, NULL,
+                &global_size, &local_size, 0, NULL, NULL);
+        if (error != CL_SUCCESS)
+            *status = OSKAR_ERR_KERNEL_LAUNCH_FAILURE;
+#else
+        *status = OSKAR_ERR_OPENCL_NOT_AVAILABLE;
 #endif
     }
     else
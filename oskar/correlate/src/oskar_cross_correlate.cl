@@ -0,0 +1,244 @@
+/* Copyright (c) 2018, The University of Oxford. See LICENSE file. */
+
+/* Returns sinc(x) = sin(x) / x. */
+REAL oskar_xcorr_sinc_REAL(const REAL x)
+{
+    return (x == (REAL) 0) ? (REAL) 1 : sin(x) / x;
+}
+
+/* Returns Jp * B * Jq^H, where B is the source brightness matrix. */
+REAL8 oskar_xcorr_jbjh_REAL(const REAL8 P, const REAL8 Q_, const REAL I,
+        const REAL Q, const REAL U, const REAL V)
+{
+    REAL8 m, r;
+    const REAL b_a = I + Q, b_d = I - Q;
+
+    /* Multiply first Jones matrix with (Hermitian) brightness matrix. */
+    m.s0 = P.s0 * b_a + P.s2 * U + P.s3 * V;
+    m.s1 = P.s1 * b_a + P.s3 * U - P.s2 * V;
+    m.s2 = P.s0 * U - P.s1 * V + P.s2 * b_d;
+    m.s3 = P.s1 * U + P.s0 * V + P.s3 * b_d;
+    m.s4 = P.s4 * b_a + P.s6 * U + P.s7 * V;
+    m.s5 = P.s5 * b_a + P.s7 * U - P.s6 * V;
+    m.s6 = P.s4 * U - P.s5 * V + P.s6 * b_d;
+    m.s7 = P.s5 * U + P.s4 * V + P.s7 * b_d;
+
+    /* Multiply result with Hermitian transpose of second Jones matrix. */
+    r.s0 = m.s0 * Q_.s0 + m.s1 * Q_.s1 + m.s2 * Q_.s2 + m.s3 * Q_.s3;
+    r.s1 = m.s1 * Q_.s0 - m.s0 * Q_.s1 + m.s3 * Q_.s2 - m.s2 * Q_.s3;
+    r.s2 = m.s0 * Q_.s4 + m.s1 * Q_.s5 + m.s2 * Q_.s6 + m.s3 * Q_.s7;
+    r.s3 = m.s1 * Q_.s4 - m.s0 * Q_.s5 + m.s3 * Q_.s6 - m.s2 * Q_.s7;
+    r.s4 = m.s4 * Q_.s0 + m.s5 * Q_.s1 + m.s6 * Q_.s2 + m.s7 * Q_.s3;
+    r.s5 = m.s5 * Q_.s0 - m.s4 * Q_.s1 + m.s7 * Q_.s2 - m.s6 * Q_.s3;
+    r.s6 = m.s4 * Q_.s4 + m.s5 * Q_.s5 + m.s6 * Q_.s6 + m.s7 * Q_.s7;
+    r.s7 = m.s5 * Q_.s4 - m.s4 * Q_.s5 + m.s7 * Q_.s6 - m.s6 * Q_.s7;
+    return r;
+}
+
+/* Finds the station indices of a baseline, and evaluates the terms
+ * needed for the baseline filter and the smearing functions.
+ * Returns 0 if the baseline is outside the filter range. */
+int oskar_xcorr_baseline_REAL(int b, const int num_stations,
+        global const REAL* restrict station_u,
+        global const REAL* restrict station_v,
+        global const REAL* restrict station_w,
+        global const REAL* restrict station_x,
+        global const REAL* restrict station_y,
+        const REAL uv_min_lambda, const REAL uv_max_lambda,
+        const REAL inv_wavelength, const REAL frac_bandwidth,
+        const REAL time_int_sec, const REAL gha0_rad, const REAL dec0_rad,
+        int* p, int* q, REAL* uu, REAL* vv, REAL* ww,
+        REAL* uu2, REAL* vv2, REAL* uuvv, REAL* du, REAL* dv, REAL* dw)
+{
+    REAL uv_len, f;
+    int SQ = 0;
+
+    /* Invert the baseline index (stations p > q). */
+    while (b >= num_stations - 1 - SQ)
+    {
+        b -= num_stations - 1 - SQ;
+        SQ++;
+    }
+    const int SP = SQ + 1 + b;
+    *p = SP;
+    *q = SQ;
+
+    /* Evaluate per-baseline terms. */
+    *uu = (station_u[SP] - station_u[SQ]) * inv_wavelength;
+    *vv = (station_v[SP] - station_v[SQ]) * inv_wavelength;
+    *ww = (station_w[SP] - station_w[SQ]) * inv_wavelength;
+    *uu2 = *uu * *uu;
+    *vv2 = *vv * *vv;
+    *uuvv = 2 * *uu * *vv;
+    uv_len = sqrt(*uu2 + *vv2);
+    if (uv_len < uv_min_lambda || uv_len > uv_max_lambda) return 0;
+    f = ((REAL) 3.14159265358979323846264338327950288) * frac_bandwidth;
+    *uu *= f;
+    *vv *= f;
+    *ww *= f;
+
+    /* Evaluate baseline deltas for time-average smearing. */
+    *du = *dv = *dw = (REAL) 0;
+    if (time_int_sec != (REAL) 0)
+    {
+        REAL xx, yy, rot_angle, temp, sin_HA, cos_HA, sin_Dec, cos_Dec;
+        sin_HA = sincos(gha0_rad, &cos_HA);
+        sin_Dec = sincos(dec0_rad, &cos_Dec);
+        temp = ((REAL) 3.14159265358979323846264338327950288) * inv_wavelength;
+        xx = (station_x[SP] - station_x[SQ]) * temp;
+        yy = (station_y[SP] - station_y[SQ]) * temp;
+        rot_angle = ((REAL) 7.272205217e-5) * time_int_sec;
+        temp = (xx * sin_HA + yy * cos_HA) * rot_angle;
+        *du = (xx * cos_HA - yy * sin_HA) * rot_angle;
+        *dv = temp * sin_Dec;
+        *dw = -temp * cos_Dec;
+    }
+    return 1;
+}
+
+/* Returns the smearing term for the given source. */
+REAL oskar_xcorr_smearing_REAL(const int i, const int use_extended,
+        global const REAL* restrict source_l,
+        global const REAL* restrict source_m,
+        global const REAL* restrict source_n,
+        global const REAL* restrict source_a,
+        global const REAL* restrict source_b,
+        global const REAL* restrict source_c,
+        const REAL uu, const REAL vv, const REAL ww,
+        const REAL uu2, const REAL vv2, const REAL uuvv,
+        const REAL du, const REAL dv, const REAL dw,
+        const REAL frac_bandwidth, const REAL time_int_sec)
+{
+    REAL smearing = (REAL) 1;
+    if (use_extended)
+        smearing = exp(-(source_a[i] * uu2 + source_b[i] * uuvv +
+                source_c[i] * vv2));
+    if (frac_bandwidth != (REAL) 0 || time_int_sec != (REAL) 0)
+    {
+        const REAL l = source_l[i];
+        const REAL m = source_m[i];
+        const REAL n = source_n[i] - (REAL) 1;
+        if (frac_bandwidth != (REAL) 0)
+            smearing *= oskar_xcorr_sinc_REAL(uu * l + vv * m + ww * n);
+        if (time_int_sec != (REAL) 0)
+            smearing *= oskar_xcorr_sinc_REAL(du * l + dv * m + dw * n);
+    }
+    return smearing;
+}
+
+kernel void cross_correlate_REAL(const int num_sources,
+        const int num_stations, global const REAL8* restrict jones,
+        global const REAL* restrict source_I,
+        global const REAL* restrict source_Q,
+        global const REAL* restrict source_U,
+        global const REAL* restrict source_V,
+        global const REAL* restrict source_l,
+        global const REAL* restrict source_m,
+        global const REAL* restrict source_n,
+        const int use_extended,
+        global const REAL* restrict source_a,
+        global const REAL* restrict source_b,
+        global const REAL* restrict source_c,
+        global const REAL* restrict station_u,
+        global const REAL* restrict station_v,
+        global const REAL* restrict station_w,
+        global const REAL* restrict station_x,
+        global const REAL* restrict station_y,
+        const REAL uv_min_lambda, const REAL uv_max_lambda,
+        const REAL inv_wavelength, const REAL frac_bandwidth,
+        const REAL time_int_sec, const REAL gha0_rad, const REAL dec0_rad,
+        global REAL8* restrict vis)
+{
+    int SP, SQ;
+    REAL uu, vv, ww, uu2, vv2, uuvv, du, dv, dw;
+    REAL8 sum;
+    const int b = get_global_id(0); /* Baseline index. */
+    if (b >= num_stations * (num_stations - 1) / 2) return;
+    if (!oskar_xcorr_baseline_REAL(b, num_stations,
+            station_u, station_v, station_w, station_x, station_y,
+            uv_min_lambda, uv_max_lambda, inv_wavelength, frac_bandwidth,
+            time_int_sec, gha0_rad, dec0_rad, &SP, &SQ,
+            &uu, &vv, &ww, &uu2, &vv2, &uuvv, &du, &dv, &dw))
+        return;
+    global const REAL8* restrict station_p = &jones[SP * num_sources];
+    global const REAL8* restrict station_q = &jones[SQ * num_sources];
+    sum.s0 = sum.s1 = sum.s2 = sum.s3 = (REAL) 0;
+    sum.s4 = sum.s5 = sum.s6 = sum.s7 = (REAL) 0;
+
+    /* Loop over sources. */
+    for (int i = 0; i < num_sources; ++i)
+    {
+        const REAL smearing = oskar_xcorr_smearing_REAL(i, use_extended,
+                source_l, source_m, source_n, source_a, source_b, source_c,
+                uu, vv, ww, uu2, vv2, uuvv, du, dv, dw,
+                frac_bandwidth, time_int_sec);
+        const REAL8 m = oskar_xcorr_jbjh_REAL(station_p[i], station_q[i],
+                source_I[i], source_Q[i], source_U[i], source_V[i]);
+        sum.s0 += m.s0 * smearing; sum.s1 += m.s1 * smearing;
+        sum.s2 += m.s2 * smearing; sum.s3 += m.s3 * smearing;
+        sum.s4 += m.s4 * smearing; sum.s5 += m.s5 * smearing;
+        sum.s6 += m.s6 * smearing; sum.s7 += m.s7 * smearing;
+    }
+
+    /* Add result to the baseline visibility. */
+    REAL8 out = vis[b];
+    out.s0 += sum.s0; out.s1 += sum.s1;
+    out.s2 += sum.s2; out.s3 += sum.s3;
+    out.s4 += sum.s4; out.s5 += sum.s5;
+    out.s6 += sum.s6; out.s7 += sum.s7;
+    vis[b] = out;
+}
+
+kernel void cross_correlate_scalar_REAL(const int num_sources,
+        const int num_stations, global const REAL2* restrict jones,
+        global const REAL* restrict source_I,
+        global const REAL* restrict source_l,
+        global const REAL* restrict source_m,
+        global const REAL* restrict source_n,
+        const int use_extended,
+        global const REAL* restrict source_a,
+        global const REAL* restrict source_b,
+        global const REAL* restrict source_c,
+        global const REAL* restrict station_u,
+        global const REAL* restrict station_v,
+        global const REAL* restrict station_w,
+        global const REAL* restrict station_x,
+        global const REAL* restrict station_y,
+        const REAL uv_min_lambda, const REAL uv_max_lambda,
+        const REAL inv_wavelength, const REAL frac_bandwidth,
+        const REAL time_int_sec, const REAL gha0_rad, const REAL dec0_rad,
+        global REAL2* restrict vis)
+{
+    int SP, SQ;
+    REAL uu, vv, ww, uu2, vv2, uuvv, du, dv, dw;
+    REAL sum_re = (REAL) 0, sum_im = (REAL) 0;
+    const int b = get_global_id(0); /* Baseline index. */
+    if (b >= num_stations * (num_stations - 1) / 2) return;
+    if (!oskar_xcorr_baseline_REAL(b, num_stations,
+            station_u, station_v, station_w, station_x, station_y,
+            uv_min_lambda, uv_max_lambda, inv_wavelength, frac_bandwidth,
+            time_int_sec, gha0_rad, dec0_rad, &SP, &SQ,
+            &uu, &vv, &ww, &uu2, &vv2, &uuvv, &du, &dv, &dw))
+        return;
+    global const REAL2* restrict station_p = &jones[SP * num_sources];
+    global const REAL2* restrict station_q = &jones[SQ * num_sources];
+
+    /* Loop over sources. */
+    for (int i = 0; i < num_sources; ++i)
+    {
+        const REAL smearing = source_I[i] * oskar_xcorr_smearing_REAL(i,
+                use_extended, source_l, source_m, source_n,
+                source_a, source_b, source_c,
+                uu, vv, ww, uu2, vv2, uuvv, du, dv, dw,
+                frac_bandwidth, time_int_sec);
+
+        /* Multiply Jones scalars (second one conjugated) and accumulate. */
+        const REAL2 p = station_p[i], q = station_q[i];
+        sum_re += (p.x * q.x + p.y * q.y) * smearing;
+        sum_im += (p.y * q.x - p.x * q.y) * smearing;
+    }
+
+    /* Add result to the baseline visibility. */
+    vis[b].x += sum_re;
+    vis[b].y += sum_im;
+}
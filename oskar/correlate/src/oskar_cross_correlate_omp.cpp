@@ -30,6 +30,22 @@
 #include "correlate/oskar_cross_correlate_omp.h"
 #include "math/oskar_add_inline.h"
 #include "math/oskar_kahan_sum.h"
+#include "math/oskar_sincos_inline.h"
+
+#include <cstdlib>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+static inline void xcorr_sincos(float x, float* s, float* c)
+{
+    oskar_sincos_f(x, s, c);
+}
+
+static inline void xcorr_sincos(double x, double* s, double* c)
+{
+    oskar_sincos_d(x, s, c);
+}
 
 template<typename T1, typename T2>
 struct is_same
@@ -45,6 +61,17 @@ struct is_same<T,T>
     typedef is_same<T,T> type;
 };
 
+/* Number of stations along each side of a baseline tile. */
+#define XCORR_TILE_STATIONS 8
+
+/* Number of sources in each block of the structure-of-arrays Jones buffer.
+ * A tile then needs 2 * 8 * 8 * 128 values (64 kB in single precision). */
+#define XCORR_SOURCE_BLOCK 128
+
+/* Index of a component in the structure-of-arrays Jones buffer. */
+#define XCORR_SOA(STATION, COMPONENT) \
+        (((STATION) * 8 + (COMPONENT)) * XCORR_SOURCE_BLOCK)
+
 template
 <
 // Compile-time parameters.
@@ -77,99 +104,294 @@ void oskar_xcorr_omp(
         const REAL                  time_int_sec,
         const REAL                  gha0_rad,
         const REAL                  dec0_rad,
-        REAL8*             restrict vis)
+        const REAL                  wavenumber,
+        const REAL*  const restrict source_filter,
+        const REAL                  source_filter_min,
+        const REAL                  source_filter_max,
+        REAL8*             restrict vis,
+        int*                        status)
 {
-    // Loop over stations.
-#pragma omp parallel for schedule(dynamic, 1)
-    for (int SQ = 0; SQ < num_stations; ++SQ)
-    {
-        // Pointer to source vector for station q.
-        const REAL8* const station_q = &jones[SQ * num_sources];
-
-        // Loop over baselines for this station.
-        for (int SP = SQ + 1; SP < num_stations; ++SP)
-        {
-            REAL uv_len, uu, vv, ww, uu2, vv2, uuvv, du, dv, dw;
-            REAL8 m1, m2, sum, guard;
-            OSKAR_CLEAR_COMPLEX_MATRIX(REAL, sum)
-            OSKAR_CLEAR_COMPLEX_MATRIX(REAL, guard)
+    const int num_baselines = num_stations * (num_stations - 1) / 2;
+    const int num_station_tiles =
+            (num_stations + XCORR_TILE_STATIONS - 1) / XCORR_TILE_STATIONS;
+    const int num_tiles = num_station_tiles * (num_station_tiles + 1) / 2;
+    const int num_blocks =
+            (num_sources + XCORR_SOURCE_BLOCK - 1) / XCORR_SOURCE_BLOCK;
+    const size_t soa_size = num_stations * 8 * XCORR_SOURCE_BLOCK;
+    if (*status || num_sources == 0 || num_baselines == 0) return;
 
-            // Pointer to source vector for station p.
-            const REAL8* const station_p = &jones[SP * num_sources];
+    // If there are enough tiles of baselines to keep all threads busy,
+    // the threads share each block of sources. Otherwise (for small
+    // arrays), each thread takes its own blocks of sources, with private
+    // scratch space and sums that are added together at the end.
+    int num_threads = 1;
+#ifdef _OPENMP
+    if (!omp_in_parallel()) num_threads = omp_get_max_threads();
+#endif
+    const int split_sources = num_tiles < num_threads && num_blocks > 1;
+    const int num_streams = !split_sources ? 1 :
+            (num_blocks < num_threads ? num_blocks : num_threads);
+    const int num_team = split_sources ? 1 : num_threads;
 
-            // Get common baseline values.
-            OSKAR_BASELINE_TERMS(REAL, station_u[SP], station_u[SQ],
-                    station_v[SP], station_v[SQ], station_w[SP], station_w[SQ],
-                    uu, vv, ww, uu2, vv2, uuvv, uv_len);
-
-            // Apply the baseline length filter.
-            if (uv_len < uv_min_lambda || uv_len > uv_max_lambda) continue;
+    // Allocate scratch space for the transposed Jones blocks and the sums.
+    // Each stream of source blocks alternates between two Jones buffers.
+    REAL* soa = (REAL*) malloc(num_streams * 2 * soa_size * sizeof(REAL));
+    REAL8* sum = (REAL8*) calloc(num_streams * num_baselines, sizeof(REAL8));
+    REAL8* guard = is_same<REAL, float>::value ?
+            (REAL8*) calloc(num_streams * num_baselines, sizeof(REAL8)) : 0;
+    if (!soa || !sum || (is_same<REAL, float>::value && !guard))
+    {
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+        free(soa);
+        free(sum);
+        free(guard);
+        return;
+    }
 
-            // Compute the deltas for time-average smearing.
-            if (TIME_SMEARING)
-                OSKAR_BASELINE_DELTAS(REAL, station_x[SP], station_x[SQ],
-                        station_y[SP], station_y[SQ], du, dv, dw);
+#pragma omp parallel num_threads(num_streams)
+    {
+        int stream = 0;
+#ifdef _OPENMP
+        stream = omp_get_thread_num();
+#endif
+        REAL8* const sum_s = &sum[stream * num_baselines];
+        REAL8* const guard_s = guard ? &guard[stream * num_baselines] : 0;
+#pragma omp parallel num_threads(num_team)
+        {
+        // Loop over blocks of sources in this stream.
+        for (int k = 0; k * num_streams + stream < num_blocks; ++k)
+        {
+            const int s0 = (k * num_streams + stream) * XCORR_SOURCE_BLOCK;
+            const int n_src = (num_sources - s0 < XCORR_SOURCE_BLOCK) ?
+                    num_sources - s0 : XCORR_SOURCE_BLOCK;
+            REAL* const soa_k = &soa[(2 * stream + (k & 1)) * soa_size];
 
-            // Loop over sources.
-            for (int i = 0; i < num_sources; ++i)
+            // Transpose the Jones matrices for this block into
+            // structure-of-arrays order, so that sources are contiguous.
+            // If required, apply the interferometer phase (Jones K) here,
+            // so that it never needs to be stored.
+            // The implicit barrier at the end of this loop ensures the
+            // block is complete before it is used. It also ensures that
+            // all tiles of the block before last are finished, so the
+            // buffer being filled is no longer in use.
+#pragma omp for schedule(static)
+            for (int s = 0; s < num_stations; ++s)
             {
-                REAL smearing;
-                if (GAUSSIAN)
+                const REAL8* const restrict in = &jones[s * num_sources + s0];
+                REAL* const restrict out = &soa_k[XCORR_SOA(s, 0)];
+                const REAL us = wavenumber * station_u[s];
+                const REAL vs = wavenumber * station_v[s];
+                const REAL ws = wavenumber * station_w[s];
+                for (int i = 0; i < n_src; ++i)
                 {
-                    const REAL t = source_a[i] * uu2 + source_b[i] * uuvv +
-                            source_c[i] * vv2;
-                    smearing = exp((REAL) -t);
+                    REAL8 m1 = in[i];
+                    if (source_filter)
+                    {
+                        REAL2 k;
+                        const int j = s0 + i;
+                        if (source_filter[j] > source_filter_min &&
+                                source_filter[j] <= source_filter_max)
+                        {
+                            // Same as oskar_evaluate_jones_K().
+                            const REAL phase = us * source_l[j] +
+                                    vs * source_m[j] +
+                                    ws * (source_n[j] - (REAL) 1);
+                            xcorr_sincos(phase, &k.y, &k.x);
+                        }
+                        else
+                        {
+                            k.x = k.y = (REAL) 0;
+                        }
+                        OSKAR_MUL_COMPLEX_MATRIX_COMPLEX_SCALAR_IN_PLACE(
+                                REAL2, m1, k)
+                    }
+                    out[i] = m1.a.x;
+                    out[i + 1 * XCORR_SOURCE_BLOCK] = m1.a.y;
+                    out[i + 2 * XCORR_SOURCE_BLOCK] = m1.b.x;
+                    out[i + 3 * XCORR_SOURCE_BLOCK] = m1.b.y;
+                    out[i + 4 * XCORR_SOURCE_BLOCK] = m1.c.x;
+                    out[i + 5 * XCORR_SOURCE_BLOCK] = m1.c.y;
+                    out[i + 6 * XCORR_SOURCE_BLOCK] = m1.d.x;
+                    out[i + 7 * XCORR_SOURCE_BLOCK] = m1.d.y;
                 }
-                else
+            }
+
+            // Loop over tiles of baselines.
+            // Threads go on to fill the next block as soon as they run out
+            // of tiles, as it uses the other buffer.
+#pragma omp for schedule(dynamic, 1) nowait
+            for (int t = 0; t < num_tiles; ++t)
+            {
+                // Get the station tile indices (tile_q <= tile_p).
+                int tile_q = 0, tile_p = t;
+                while (tile_p >= num_station_tiles - tile_q)
                 {
-                    smearing = (REAL) 1;
+                    tile_p -= num_station_tiles - tile_q;
+                    tile_q++;
                 }
-                if (BANDWIDTH_SMEARING || TIME_SMEARING)
+                tile_p += tile_q;
+                const int q_start = tile_q * XCORR_TILE_STATIONS;
+                const int p_start = tile_p * XCORR_TILE_STATIONS;
+                int q_end = q_start + XCORR_TILE_STATIONS;
+                int p_end = p_start + XCORR_TILE_STATIONS;
+                if (q_end > num_stations) q_end = num_stations;
+                if (p_end > num_stations) p_end = num_stations;
+
+                // Loop over baselines in the tile.
+                for (int SQ = q_start; SQ < q_end; ++SQ)
                 {
-                    const REAL l = source_l[i];
-                    const REAL m = source_m[i];
-                    const REAL n = source_n[i] - (REAL) 1;
-                    if (BANDWIDTH_SMEARING)
+                    const REAL* const restrict q = &soa_k[XCORR_SOA(SQ, 0)];
+                    for (int SP = (SQ + 1 > p_start ? SQ + 1 : p_start);
+                            SP < p_end; ++SP)
                     {
-                        const REAL t = uu * l + vv * m + ww * n;
-                        smearing *= oskar_sinc<REAL>(t);
-                    }
-                    if (TIME_SMEARING)
-                    {
-                        const REAL t = du * l + dv * m + dw * n;
-                        smearing *= oskar_sinc<REAL>(t);
-                    }
-                }
+                        REAL uv_len, uu, vv, ww, uu2, vv2, uuvv, du, dv, dw;
+                        REAL a_re = 0, a_im = 0, b_re = 0, b_im = 0;
+                        REAL c_re = 0, c_im = 0, d_re = 0, d_im = 0;
+                        const REAL* const restrict p =
+                                &soa_k[XCORR_SOA(SP, 0)];
 
-                // Construct source brightness matrix.
-                OSKAR_CONSTRUCT_B(REAL, m2,
-                        source_I[i], source_Q[i], source_U[i], source_V[i])
+                        // Get common baseline values.
+                        OSKAR_BASELINE_TERMS(REAL,
+                                station_u[SP], station_u[SQ],
+                                station_v[SP], station_v[SQ],
+                                station_w[SP], station_w[SQ],
+                                uu, vv, ww, uu2, vv2, uuvv, uv_len);
 
-                // Multiply first Jones matrix with source brightness matrix.
-                OSKAR_LOAD_MATRIX(m1, station_p[i])
-                OSKAR_MUL_COMPLEX_MATRIX_HERMITIAN_IN_PLACE(REAL2, m1, m2)
+                        // Apply the baseline length filter.
+                        if (uv_len < uv_min_lambda || uv_len > uv_max_lambda)
+                            continue;
 
-                // Multiply result with second (Hermitian transposed) Jones matrix.
-                OSKAR_LOAD_MATRIX(m2, station_q[i])
-                OSKAR_MUL_COMPLEX_MATRIX_CONJUGATE_TRANSPOSE_IN_PLACE(REAL2, m1, m2)
+                        // Compute the deltas for time-average smearing.
+                        if (TIME_SMEARING)
+                            OSKAR_BASELINE_DELTAS(REAL,
+                                    station_x[SP], station_x[SQ],
+                                    station_y[SP], station_y[SQ], du, dv, dw);
 
-                // Multiply result by smearing term and accumulate.
-                if (is_same<REAL, float>::value)
-                {
-                    OSKAR_KAHAN_SUM_MULTIPLY_COMPLEX_MATRIX(
-                            REAL, sum, m1, smearing, guard)
-                }
-                else
-                {
-                    OSKAR_MUL_ADD_COMPLEX_MATRIX_SCALAR(sum, m1, smearing)
+                        // Loop over sources in the block.
+#pragma omp simd reduction(+:a_re,a_im,b_re,b_im,c_re,c_im,d_re,d_im)
+                        for (int i = 0; i < n_src; ++i)
+                        {
+                            REAL8 m1, m2;
+                            const int j = s0 + i;
+                            REAL smearing;
+                            if (GAUSSIAN)
+                            {
+                                const REAL t = source_a[j] * uu2 +
+                                        source_b[j] * uuvv +
+                                        source_c[j] * vv2;
+                                smearing = exp((REAL) -t);
+                            }
+                            else
+                            {
+                                smearing = (REAL) 1;
+                            }
+                            if (BANDWIDTH_SMEARING || TIME_SMEARING)
+                            {
+                                const REAL l = source_l[j];
+                                const REAL m = source_m[j];
+                                const REAL n = source_n[j] - (REAL) 1;
+                                if (BANDWIDTH_SMEARING)
+                                {
+                                    const REAL t = uu * l + vv * m + ww * n;
+                                    smearing *= oskar_sinc<REAL>(t);
+                                }
+                                if (TIME_SMEARING)
+                                {
+                                    const REAL t = du * l + dv * m + dw * n;
+                                    smearing *= oskar_sinc<REAL>(t);
+                                }
+                            }
+
+                            // Construct source brightness matrix.
+                            OSKAR_CONSTRUCT_B(REAL, m2, source_I[j],
+                                    source_Q[j], source_U[j], source_V[j])
+
+                            // Multiply first Jones matrix with source
+                            // brightness matrix.
+                            m1.a.x = p[i];
+                            m1.a.y = p[i + 1 * XCORR_SOURCE_BLOCK];
+                            m1.b.x = p[i + 2 * XCORR_SOURCE_BLOCK];
+                            m1.b.y = p[i + 3 * XCORR_SOURCE_BLOCK];
+                            m1.c.x = p[i + 4 * XCORR_SOURCE_BLOCK];
+                            m1.c.y = p[i + 5 * XCORR_SOURCE_BLOCK];
+                            m1.d.x = p[i + 6 * XCORR_SOURCE_BLOCK];
+                            m1.d.y = p[i + 7 * XCORR_SOURCE_BLOCK];
+                            OSKAR_MUL_COMPLEX_MATRIX_HERMITIAN_IN_PLACE(
+                                    REAL2, m1, m2)
+
+                            // Multiply result with second (Hermitian
+                            // transposed) Jones matrix.
+                            m2.a.x = q[i];
+                            m2.a.y = q[i + 1 * XCORR_SOURCE_BLOCK];
+                            m2.b.x = q[i + 2 * XCORR_SOURCE_BLOCK];
+                            m2.b.y = q[i + 3 * XCORR_SOURCE_BLOCK];
+                            m2.c.x = q[i + 4 * XCORR_SOURCE_BLOCK];
+                            m2.c.y = q[i + 5 * XCORR_SOURCE_BLOCK];
+                            m2.d.x = q[i + 6 * XCORR_SOURCE_BLOCK];
+                            m2.d.y = q[i + 7 * XCORR_SOURCE_BLOCK];
+                            OSKAR_MUL_COMPLEX_MATRIX_CONJUGATE_TRANSPOSE_IN_PLACE(
+                                    REAL2, m1, m2)
+
+                            // Multiply result by smearing term and accumulate.
+                            a_re += m1.a.x * smearing;
+                            a_im += m1.a.y * smearing;
+                            b_re += m1.b.x * smearing;
+                            b_im += m1.b.y * smearing;
+                            c_re += m1.c.x * smearing;
+                            c_im += m1.c.y * smearing;
+                            d_re += m1.d.x * smearing;
+                            d_im += m1.d.y * smearing;
+                        }
+
+                        // Add the partial sum for this block of sources.
+                        // Each baseline belongs to exactly one tile, and
+                        // a block is not started until the tiles of the
+                        // previous block are finished, so no
+                        // synchronisation is needed here.
+                        const int b = oskar_evaluate_baseline_index_inline(
+                                num_stations, SP, SQ);
+                        if (is_same<REAL, float>::value)
+                        {
+                            REAL8* const sb = &sum_s[b];
+                            REAL8* const gb = &guard_s[b];
+                            OSKAR_KAHAN_SUM(REAL, sb->a.x, a_re, gb->a.x)
+                            OSKAR_KAHAN_SUM(REAL, sb->a.y, a_im, gb->a.y)
+                            OSKAR_KAHAN_SUM(REAL, sb->b.x, b_re, gb->b.x)
+                            OSKAR_KAHAN_SUM(REAL, sb->b.y, b_im, gb->b.y)
+                            OSKAR_KAHAN_SUM(REAL, sb->c.x, c_re, gb->c.x)
+                            OSKAR_KAHAN_SUM(REAL, sb->c.y, c_im, gb->c.y)
+                            OSKAR_KAHAN_SUM(REAL, sb->d.x, d_re, gb->d.x)
+                            OSKAR_KAHAN_SUM(REAL, sb->d.y, d_im, gb->d.y)
+                        }
+                        else
+                        {
+                            REAL8* const sb = &sum_s[b];
+                            sb->a.x += a_re; sb->a.y += a_im;
+                            sb->b.x += b_re; sb->b.y += b_im;
+                            sb->c.x += c_re; sb->c.y += c_im;
+                            sb->d.x += d_re; sb->d.y += d_im;
+                        }
+                    }
                 }
             }
-
-            // Add result to the baseline visibility.
-            int i = oskar_evaluate_baseline_index_inline(num_stations, SP, SQ);
-            OSKAR_ADD_COMPLEX_MATRIX_IN_PLACE(vis[i], sum);
         }
+        }
+    }
+
+    // Add results to the baseline visibilities,
+    // in the same order each time.
+#pragma omp parallel for schedule(static) num_threads(num_threads)
+    for (int b = 0; b < num_baselines; ++b)
+    {
+        for (int i = 0; i < num_streams; ++i)
+            OSKAR_ADD_COMPLEX_MATRIX_IN_PLACE(vis[b],
+                    sum[i * num_baselines + b]);
     }
+
+    // Free scratch space.
+    free(soa);
+    free(sum);
+    free(guard);
 }
 
 #define XCORR_KERNEL(BS, TS, GAUSSIAN, REAL, REAL2, REAL8)                  \
@@ -179,7 +401,8 @@ void oskar_xcorr_omp(
                 d_station_u, d_station_v, d_station_w,                      \
                 d_station_x, d_station_y, uv_min_lambda, uv_max_lambda,     \
                 inv_wavelength, frac_bandwidth, time_int_sec,               \
-                gha0_rad, dec0_rad, d_vis);
+                gha0_rad, dec0_rad, wavenumber, d_filter,                   \
+                filter_min, filter_max, d_vis, status);
 
 #define XCORR_SELECT(GAUSSIAN, REAL, REAL2, REAL8)                          \
         if (frac_bandwidth == (REAL)0 && time_int_sec == (REAL)0)           \
@@ -191,7 +414,7 @@ void oskar_xcorr_omp(
         else if (frac_bandwidth != (REAL)0 && time_int_sec != (REAL)0)      \
             XCORR_KERNEL(true, true, GAUSSIAN, REAL, REAL2, REAL8)
 
-void oskar_cross_correlate_point_omp_f(
+void oskar_cross_correlate_point_omp_status_f(
         int num_sources, int num_stations, const float4c* d_jones,
         const float* d_I, const float* d_Q,
         const float* d_U, const float* d_V,
@@ -201,13 +424,82 @@ void oskar_cross_correlate_point_omp_f(
         const float* d_station_x, const float* d_station_y,
         float uv_min_lambda, float uv_max_lambda, float inv_wavelength,
         float frac_bandwidth, float time_int_sec, float gha0_rad,
-        float dec0_rad, float4c* d_vis)
+        float dec0_rad, float4c* d_vis, int* status)
+{
+    const float *d_a = 0, *d_b = 0, *d_c = 0, *d_filter = 0;
+    const float wavenumber = 0.f, filter_min = 0.f, filter_max = 0.f;
+    XCORR_SELECT(false, float, float2, float4c)
+}
+
+void oskar_cross_correlate_point_omp_status_d(
+        int num_sources, int num_stations, const double4c* d_jones,
+        const double* d_I, const double* d_Q,
+        const double* d_U, const double* d_V,
+        const double* d_l, const double* d_m, const double* d_n,
+        const double* d_station_u, const double* d_station_v,
+        const double* d_station_w,
+        const double* d_station_x, const double* d_station_y,
+        double uv_min_lambda, double uv_max_lambda, double inv_wavelength,
+        double frac_bandwidth, double time_int_sec, double gha0_rad,
+        double dec0_rad, double4c* d_vis, int* status)
+{
+    const double *d_a = 0, *d_b = 0, *d_c = 0, *d_filter = 0;
+    const double wavenumber = 0., filter_min = 0., filter_max = 0.;
+    XCORR_SELECT(false, double, double2, double4c)
+}
+
+void oskar_cross_correlate_gaussian_omp_status_f(
+        int num_sources, int num_stations, const float4c* d_jones,
+        const float* d_I, const float* d_Q,
+        const float* d_U, const float* d_V,
+        const float* d_l, const float* d_m, const float* d_n,
+        const float* d_a, const float* d_b, const float* d_c,
+        const float* d_station_u, const float* d_station_v,
+        const float* d_station_w, const float* d_station_x,
+        const float* d_station_y, float uv_min_lambda, float uv_max_lambda,
+        float inv_wavelength, float frac_bandwidth, float time_int_sec,
+        float gha0_rad, float dec0_rad, float4c* d_vis, int* status)
+{
+    const float* d_filter = 0;
+    const float wavenumber = 0.f, filter_min = 0.f, filter_max = 0.f;
+    XCORR_SELECT(true, float, float2, float4c)
+}
+
+void oskar_cross_correlate_gaussian_omp_status_d(
+        int num_sources, int num_stations, const double4c* d_jones,
+        const double* d_I, const double* d_Q,
+        const double* d_U, const double* d_V,
+        const double* d_l, const double* d_m, const double* d_n,
+        const double* d_a, const double* d_b, const double* d_c,
+        const double* d_station_u, const double* d_station_v,
+        const double* d_station_w, const double* d_station_x,
+        const double* d_station_y, double uv_min_lambda, double uv_max_lambda,
+        double inv_wavelength, double frac_bandwidth, double time_int_sec,
+        double gha0_rad, double dec0_rad, double4c* d_vis, int* status)
+{
+    const double* d_filter = 0;
+    const double wavenumber = 0., filter_min = 0., filter_max = 0.;
+    XCORR_SELECT(true, double, double2, double4c)
+}
+
+void oskar_cross_correlate_fused_point_omp_status_f(
+        int num_sources, int num_stations, const float4c* d_jones,
+        const float* d_I, const float* d_Q,
+        const float* d_U, const float* d_V,
+        const float* d_l, const float* d_m, const float* d_n,
+        const float* d_station_u, const float* d_station_v,
+        const float* d_station_w,
+        const float* d_station_x, const float* d_station_y,
+        float uv_min_lambda, float uv_max_lambda, float inv_wavelength,
+        float frac_bandwidth, float time_int_sec, float gha0_rad,
+        float dec0_rad, float wavenumber, const float* d_filter,
+        float filter_min, float filter_max, float4c* d_vis, int* status)
 {
     const float *d_a = 0, *d_b = 0, *d_c = 0;
     XCORR_SELECT(false, float, float2, float4c)
 }
 
-void oskar_cross_correlate_point_omp_d(
+void oskar_cross_correlate_fused_point_omp_status_d(
         int num_sources, int num_stations, const double4c* d_jones,
         const double* d_I, const double* d_Q,
         const double* d_U, const double* d_V,
@@ -217,12 +509,87 @@ void oskar_cross_correlate_point_omp_d(
         const double* d_station_x, const double* d_station_y,
         double uv_min_lambda, double uv_max_lambda, double inv_wavelength,
         double frac_bandwidth, double time_int_sec, double gha0_rad,
-        double dec0_rad, double4c* d_vis)
+        double dec0_rad, double wavenumber, const double* d_filter,
+        double filter_min, double filter_max, double4c* d_vis, int* status)
 {
     const double *d_a = 0, *d_b = 0, *d_c = 0;
     XCORR_SELECT(false, double, double2, double4c)
 }
 
+void oskar_cross_correlate_fused_gaussian_omp_status_f(
+        int num_sources, int num_stations, const float4c* d_jones,
+        const float* d_I, const float* d_Q,
+        const float* d_U, const float* d_V,
+        const float* d_l, const float* d_m, const float* d_n,
+        const float* d_a, const float* d_b, const float* d_c,
+        const float* d_station_u, const float* d_station_v,
+        const float* d_station_w, const float* d_station_x,
+        const float* d_station_y, float uv_min_lambda, float uv_max_lambda,
+        float inv_wavelength, float frac_bandwidth, float time_int_sec,
+        float gha0_rad, float dec0_rad, float wavenumber,
+        const float* d_filter, float filter_min, float filter_max,
+        float4c* d_vis, int* status)
+{
+    XCORR_SELECT(true, float, float2, float4c)
+}
+
+void oskar_cross_correlate_fused_gaussian_omp_status_d(
+        int num_sources, int num_stations, const double4c* d_jones,
+        const double* d_I, const double* d_Q,
+        const double* d_U, const double* d_V,
+        const double* d_l, const double* d_m, const double* d_n,
+        const double* d_a, const double* d_b, const double* d_c,
+        const double* d_station_u, const double* d_station_v,
+        const double* d_station_w, const double* d_station_x,
+        const double* d_station_y, double uv_min_lambda, double uv_max_lambda,
+        double inv_wavelength, double frac_bandwidth, double time_int_sec,
+        double gha0_rad, double dec0_rad, double wavenumber,
+        const double* d_filter, double filter_min, double filter_max,
+        double4c* d_vis, int* status)
+{
+    XCORR_SELECT(true, double, double2, double4c)
+}
+
+void oskar_cross_correlate_point_omp_f(
+        int num_sources, int num_stations, const float4c* d_jones,
+        const float* d_I, const float* d_Q,
+        const float* d_U, const float* d_V,
+        const float* d_l, const float* d_m, const float* d_n,
+        const float* d_station_u, const float* d_station_v,
+        const float* d_station_w,
+        const float* d_station_x, const float* d_station_y,
+        float uv_min_lambda, float uv_max_lambda, float inv_wavelength,
+        float frac_bandwidth, float time_int_sec, float gha0_rad,
+        float dec0_rad, float4c* d_vis)
+{
+    int status = 0;
+    oskar_cross_correlate_point_omp_status_f(num_sources, num_stations, d_jones,
+            d_I, d_Q, d_U, d_V, d_l, d_m, d_n, d_station_u, d_station_v,
+            d_station_w, d_station_x, d_station_y, uv_min_lambda, uv_max_lambda,
+            inv_wavelength, frac_bandwidth, time_int_sec, gha0_rad, dec0_rad,
+            d_vis, &status);
+}
+
+void oskar_cross_correlate_point_omp_d(
+        int num_sources, int num_stations, const double4c* d_jones,
+        const double* d_I, const double* d_Q,
+        const double* d_U, const double* d_V,
+        const double* d_l, const double* d_m, const double* d_n,
+        const double* d_station_u, const double* d_station_v,
+        const double* d_station_w,
+        const double* d_station_x, const double* d_station_y,
+        double uv_min_lambda, double uv_max_lambda, double inv_wavelength,
+        double frac_bandwidth, double time_int_sec, double gha0_rad,
+        double dec0_rad, double4c* d_vis)
+{
+    int status = 0;
+    oskar_cross_correlate_point_omp_status_d(num_sources, num_stations, d_jones,
+            d_I, d_Q, d_U, d_V, d_l, d_m, d_n, d_station_u, d_station_v,
+            d_station_w, d_station_x, d_station_y, uv_min_lambda, uv_max_lambda,
+            inv_wavelength, frac_bandwidth, time_int_sec, gha0_rad, dec0_rad,
+            d_vis, &status);
+}
+
 void oskar_cross_correlate_gaussian_omp_f(
         int num_sources, int num_stations, const float4c* d_jones,
         const float* d_I, const float* d_Q,
@@ -235,7 +602,12 @@ void oskar_cross_correlate_gaussian_omp_f(
         float inv_wavelength, float frac_bandwidth, float time_int_sec,
         float gha0_rad, float dec0_rad, float4c* d_vis)
 {
-    XCORR_SELECT(true, float, float2, float4c)
+    int status = 0;
+    oskar_cross_correlate_gaussian_omp_status_f(num_sources, num_stations,
+            d_jones, d_I, d_Q, d_U, d_V, d_l, d_m, d_n, d_a, d_b, d_c,
+            d_station_u, d_station_v, d_station_w, d_station_x, d_station_y,
+            uv_min_lambda, uv_max_lambda, inv_wavelength, frac_bandwidth,
+            time_int_sec, gha0_rad, dec0_rad, d_vis, &status);
 }
 
 void oskar_cross_correlate_gaussian_omp_d(
@@ -250,5 +622,100 @@ void oskar_cross_correlate_gaussian_omp_d(
         double inv_wavelength, double frac_bandwidth, double time_int_sec,
         double gha0_rad, double dec0_rad, double4c* d_vis)
 {
-    XCORR_SELECT(true, double, double2, double4c)
+    int status = 0;
+    oskar_cross_correlate_gaussian_omp_status_d(num_sources, num_stations,
+            d_jones, d_I, d_Q, d_U, d_V, d_l, d_m, d_n, d_a, d_b, d_c,
+            d_station_u, d_station_v, d_station_w, d_station_x, d_station_y,
+            uv_min_lambda, uv_max_lambda, inv_wavelength, frac_bandwidth,
+            time_int_sec, gha0_rad, dec0_rad, d_vis, &status);
+}
+
+void oskar_cross_correlate_fused_point_omp_f(
+        int num_sources, int num_stations, const float4c* d_jones,
+        const float* d_I, const float* d_Q,
+        const float* d_U, const float* d_V,
+        const float* d_l, const float* d_m, const float* d_n,
+        const float* d_station_u, const float* d_station_v,
+        const float* d_station_w,
+        const float* d_station_x, const float* d_station_y,
+        float uv_min_lambda, float uv_max_lambda, float inv_wavelength,
+        float frac_bandwidth, float time_int_sec, float gha0_rad,
+        float dec0_rad, float wavenumber, const float* d_filter,
+        float filter_min, float filter_max, float4c* d_vis)
+{
+    int status = 0;
+    oskar_cross_correlate_fused_point_omp_status_f(num_sources, num_stations,
+            d_jones, d_I, d_Q, d_U, d_V, d_l, d_m, d_n, d_station_u,
+            d_station_v, d_station_w, d_station_x, d_station_y, uv_min_lambda,
+            uv_max_lambda, inv_wavelength, frac_bandwidth, time_int_sec,
+            gha0_rad, dec0_rad, wavenumber, d_filter, filter_min, filter_max,
+            d_vis, &status);
+}
+
+void oskar_cross_correlate_fused_point_omp_d(
+        int num_sources, int num_stations, const double4c* d_jones,
+        const double* d_I, const double* d_Q,
+        const double* d_U, const double* d_V,
+        const double* d_l, const double* d_m, const double* d_n,
+        const double* d_station_u, const double* d_station_v,
+        const double* d_station_w,
+        const double* d_station_x, const double* d_station_y,
+        double uv_min_lambda, double uv_max_lambda, double inv_wavelength,
+        double frac_bandwidth, double time_int_sec, double gha0_rad,
+        double dec0_rad, double wavenumber, const double* d_filter,
+        double filter_min, double filter_max, double4c* d_vis)
+{
+    int status = 0;
+    oskar_cross_correlate_fused_point_omp_status_d(num_sources, num_stations,
+            d_jones, d_I, d_Q, d_U, d_V, d_l, d_m, d_n, d_station_u,
+            d_station_v, d_station_w, d_station_x, d_station_y, uv_min_lambda,
+            uv_max_lambda, inv_wavelength, frac_bandwidth, time_int_sec,
+            gha0_rad, dec0_rad, wavenumber, d_filter, filter_min, filter_max,
+            d_vis, &status);
+}
+
+void oskar_cross_correlate_fused_gaussian_omp_f(
+        int num_sources, int num_stations, const float4c* d_jones,
+        const float* d_I, const float* d_Q,
+        const float* d_U, const float* d_V,
+        const float* d_l, const float* d_m, const float* d_n,
+        const float* d_a, const float* d_b, const float* d_c,
+        const float* d_station_u, const float* d_station_v,
+        const float* d_station_w, const float* d_station_x,
+        const float* d_station_y, float uv_min_lambda, float uv_max_lambda,
+        float inv_wavelength, float frac_bandwidth, float time_int_sec,
+        float gha0_rad, float dec0_rad, float wavenumber,
+        const float* d_filter, float filter_min, float filter_max,
+        float4c* d_vis)
+{
+    int status = 0;
+    oskar_cross_correlate_fused_gaussian_omp_status_f(num_sources, num_stations,
+            d_jones, d_I, d_Q, d_U, d_V, d_l, d_m, d_n, d_a, d_b, d_c,
+            d_station_u, d_station_v, d_station_w, d_station_x, d_station_y,
+            uv_min_lambda, uv_max_lambda, inv_wavelength, frac_bandwidth,
+            time_int_sec, gha0_rad, dec0_rad, wavenumber, d_filter, filter_min,
+            filter_max, d_vis, &status);
+}
+
+void oskar_cross_correlate_fused_gaussian_omp_d(
+        int num_sources, int num_stations, const double4c* d_jones,
+        const double* d_I, const double* d_Q,
+        const double* d_U, const double* d_V,
+        const double* d_l, const double* d_m, const double* d_n,
+        const double* d_a, const double* d_b, const double* d_c,
+        const double* d_station_u, const double* d_station_v,
+        const double* d_station_w, const double* d_station_x,
+        const double* d_station_y, double uv_min_lambda, double uv_max_lambda,
+        double inv_wavelength, double frac_bandwidth, double time_int_sec,
+        double gha0_rad, double dec0_rad, double wavenumber,
+        const double* d_filter, double filter_min, double filter_max,
+        double4c* d_vis)
+{
+    int status = 0;
+    oskar_cross_correlate_fused_gaussian_omp_status_d(num_sources, num_stations,
+            d_jones, d_I, d_Q, d_U, d_V, d_l, d_m, d_n, d_a, d_b, d_c,
+            d_station_u, d_station_v, d_station_w, d_station_x, d_station_y,
+            uv_min_lambda, uv_max_lambda, inv_wavelength, frac_bandwidth,
+            time_int_sec, gha0_rad, dec0_rad, wavenumber, d_filter, filter_min,
+            filter_max, d_vis, &status);
 }
@@ -252,3 +252,31 @@ TEST_F(auto_correlate, scalar_singleCPU_doubleGPU)
             OSKAR_CPU, OSKAR_GPU, 0);
 }
 #endif
+
+#ifdef OSKAR_HAVE_OPENCL
+// OpenCL only. ///////////////////////////////////////////////////////////////
+
+TEST_F(auto_correlate, matrix_singleCL_singleCPU)
+{
+    runTest(OSKAR_SINGLE, OSKAR_SINGLE,
+            OSKAR_CL, OSKAR_CPU, 1);
+}
+
+TEST_F(auto_correlate, matrix_doubleCL_doubleCPU)
+{
+    runTest(OSKAR_DOUBLE, OSKAR_DOUBLE,
+            OSKAR_CL, OSKAR_CPU, 1);
+}
+
+TEST_F(auto_correlate, scalar_singleCL_singleCPU)
+{
+    runTest(OSKAR_SINGLE, OSKAR_SINGLE,
+            OSKAR_CL, OSKAR_CPU, 0);
+}
+
+TEST_F(auto_correlate, scalar_doubleCL_doubleCPU)
+{
+    runTest(OSKAR_DOUBLE, OSKAR_DOUBLE,
+            OSKAR_CL, OSKAR_CPU, 0);
+}
+#endif
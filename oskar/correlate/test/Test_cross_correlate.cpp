@@ -31,9 +31,13 @@
 #include "utility/oskar_timer.h"
 
 #include "correlate/oskar_cross_correlate.h"
+#include "interferometer/oskar_evaluate_jones_K.h"
 #include "utility/oskar_get_error_string.h"
 #include "math/oskar_kahan_sum.h"
 #include <cstdlib>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 // Comment out this line to disable benchmark timer printing.
  #define ALLOW_PRINTING 1
@@ -63,14 +67,16 @@ class cross_correlate : public ::testing::Test
 {
 protected:
     static const int num_sources = 277;
-    static const int num_stations = 50;
     static const double bandwidth;
+    int num_stations;
     oskar_Mem *u_, *v_, *w_;
     oskar_Telescope* tel;
     oskar_Sky* sky;
     oskar_Jones* jones;
 
 protected:
+    cross_correlate() : num_stations(50) {}
+
     void createTestData(int precision, int location, int matrix)
     {
         int status = 0, type;
@@ -223,10 +229,93 @@ protected:
                 time2 * 1000.0);
 #endif
     }
+
+    void runFusedTest(int prec, int extended, double time_average)
+    {
+        int num_baselines, status = 0, type;
+        oskar_Mem *vis1, *vis2;
+        oskar_Jones *K, *J;
+        double frequency = 100e6, min_jy = 1.2, max_jy = 1.8;
+
+        // Create test data and output arrays.
+        createTestData(prec, OSKAR_CPU, 1);
+        num_baselines = oskar_telescope_num_baselines(tel);
+        type = prec | OSKAR_COMPLEX | OSKAR_MATRIX;
+        vis1 = oskar_mem_create(type, OSKAR_CPU, num_baselines, &status);
+        vis2 = oskar_mem_create(type, OSKAR_CPU, num_baselines, &status);
+        oskar_mem_clear_contents(vis1, &status);
+        oskar_mem_clear_contents(vis2, &status);
+        oskar_sky_set_use_extended(sky, extended);
+        oskar_telescope_set_channel_bandwidth(tel, bandwidth);
+        oskar_telescope_set_time_average(tel, time_average);
+
+        // Evaluate Jones K, join it and correlate.
+        K = oskar_jones_create(prec | OSKAR_COMPLEX, OSKAR_CPU,
+                num_stations, num_sources, &status);
+        J = oskar_jones_create(type, OSKAR_CPU,
+                num_stations, num_sources, &status);
+        oskar_evaluate_jones_K(K, num_sources, oskar_sky_l_const(sky),
+                oskar_sky_m_const(sky), oskar_sky_n_const(sky), u_, v_, w_,
+                frequency, oskar_sky_I_const(sky), min_jy, max_jy, &status);
+        oskar_jones_join(J, K, jones, &status);
+        oskar_cross_correlate(vis1, num_sources, J, sky, tel,
+                u_, v_, w_, 1.0, frequency, &status);
+
+        // Correlate with Jones K applied inside the correlator.
+        oskar_cross_correlate_fused(vis2, num_sources, jones, sky, tel,
+                u_, v_, w_, 1.0, frequency, min_jy, max_jy, &status);
+        ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+        // Compare results.
+        check_values(vis2, vis1);
+
+        // Free memory.
+        oskar_jones_free(K, &status);
+        oskar_jones_free(J, &status);
+        oskar_mem_free(vis1, &status);
+        oskar_mem_free(vis2, &status);
+        destroyTestData();
+        ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    }
 };
 
 const double cross_correlate::bandwidth = 1e4;
 
+#ifdef _OPENMP
+// Check that the CPU version gives the same results for any number of
+// threads, including arrays small enough for the threads to be split over
+// blocks of sources rather than tiles of baselines.
+TEST_F(cross_correlate, matrix_threads_doubleCPU)
+{
+    const int stations[] = {5, 50}, max_threads = omp_get_max_threads();
+    for (int k = 0; k < 2; ++k)
+    {
+        int status = 0;
+        oskar_Mem* vis[2];
+        num_stations = stations[k];
+        for (int i = 0; i < 2; ++i)
+        {
+            omp_set_num_threads(i == 0 ? 1 : 4);
+            createTestData(OSKAR_DOUBLE, OSKAR_CPU, 1);
+            vis[i] = oskar_mem_create(OSKAR_DOUBLE_COMPLEX_MATRIX, OSKAR_CPU,
+                    oskar_telescope_num_baselines(tel), &status);
+            oskar_mem_clear_contents(vis[i], &status);
+            oskar_sky_set_use_extended(sky, 1);
+            oskar_telescope_set_channel_bandwidth(tel, bandwidth);
+            oskar_telescope_set_time_average(tel, 10.0);
+            oskar_cross_correlate(vis[i], oskar_sky_num_sources(sky), jones,
+                    sky, tel, u_, v_, w_, 1.0, 100e6, &status);
+            destroyTestData();
+        }
+        omp_set_num_threads(max_threads);
+        ASSERT_EQ(0, status) << oskar_get_error_string(status);
+        check_values(vis[1], vis[0]);
+        oskar_mem_free(vis[0], &status);
+        oskar_mem_free(vis[1], &status);
+    }
+}
+#endif
+
 // CPU only.
 TEST_F(cross_correlate, matrix_point_singleCPU_doubleCPU)
 {
@@ -542,6 +631,80 @@ TEST_F(cross_correlate, scalar_gaussian_timeSmearing_singleCPU_doubleGPU)
 }
 #endif
 
+#ifdef OSKAR_HAVE_OPENCL
+// OpenCL only. ///////////////////////////////////////////////////////////////
+
+TEST_F(cross_correlate, matrix_point_singleCL_singleCPU)
+{
+    runTest(OSKAR_SINGLE, OSKAR_SINGLE,
+            OSKAR_CL, OSKAR_CPU, 1, 0, 0.0);
+}
+
+TEST_F(cross_correlate, matrix_point_doubleCL_doubleCPU)
+{
+    runTest(OSKAR_DOUBLE, OSKAR_DOUBLE,
+            OSKAR_CL, OSKAR_CPU, 1, 0, 0.0);
+}
+
+TEST_F(cross_correlate, matrix_gaussian_timeSmearing_singleCL_singleCPU)
+{
+    runTest(OSKAR_SINGLE, OSKAR_SINGLE,
+            OSKAR_CL, OSKAR_CPU, 1, 1, 10.0);
+}
+
+TEST_F(cross_correlate, matrix_gaussian_timeSmearing_doubleCL_doubleCPU)
+{
+    runTest(OSKAR_DOUBLE, OSKAR_DOUBLE,
+            OSKAR_CL, OSKAR_CPU, 1, 1, 10.0);
+}
+
+TEST_F(cross_correlate, scalar_point_singleCL_singleCPU)
+{
+    runTest(OSKAR_SINGLE, OSKAR_SINGLE,
+            OSKAR_CL, OSKAR_CPU, 0, 0, 0.0);
+}
+
+TEST_F(cross_correlate, scalar_point_doubleCL_doubleCPU)
+{
+    runTest(OSKAR_DOUBLE, OSKAR_DOUBLE,
+            OSKAR_CL, OSKAR_CPU, 0, 0, 0.0);
+}
+
+TEST_F(cross_correlate, scalar_gaussian_timeSmearing_singleCL_singleCPU)
+{
+    runTest(OSKAR_SINGLE, OSKAR_SINGLE,
+            OSKAR_CL, OSKAR_CPU, 0, 1, 10.0);
+}
+
+TEST_F(cross_correlate, scalar_gaussian_timeSmearing_doubleCL_doubleCPU)
+{
+    runTest(OSKAR_DOUBLE, OSKAR_DOUBLE,
+            OSKAR_CL, OSKAR_CPU, 0, 1, 10.0);
+}
+#endif
+
+// FUSED VERSIONS /////////////////////////////////////////////////////////////
+
+TEST_F(cross_correlate, fused_point_single)
+{
+    runFusedTest(OSKAR_SINGLE, 0, 0.0);
+}
+
+TEST_F(cross_correlate, fused_point_double)
+{
+    runFusedTest(OSKAR_DOUBLE, 0, 0.0);
+}
+
+TEST_F(cross_correlate, fused_gaussian_timeSmearing_single)
+{
+    runFusedTest(OSKAR_SINGLE, 1, 10.0);
+}
+
+TEST_F(cross_correlate, fused_gaussian_timeSmearing_double)
+{
+    runFusedTest(OSKAR_DOUBLE, 1, 10.0);
+}
+
 #if 0
 TEST(KahanSum, sum)
 {
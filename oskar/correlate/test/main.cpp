@@ -28,11 +28,14 @@
 
 #include <gtest/gtest.h>
 #include "utility/oskar_device_utils.h"
+#include "utility/test/oskar_cl_test_utils.h"
 
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
+    oskar_cl_test_init();
     int val = RUN_ALL_TESTS();
     oskar_device_reset();
+    oskar_cl_free();
     return val;
 }
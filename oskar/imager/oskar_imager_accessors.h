@@ -88,6 +88,19 @@ int oskar_imager_channel_snapshots(const oskar_Imager* h);
 OSKAR_EXPORT
 int oskar_imager_coords_only(const oskar_Imager* h);
 
+/**
+ * @brief
+ * Returns the FFT library used for CPU transforms.
+ *
+ * @details
+ * Returns a string describing the FFT library used for CPU transforms,
+ * either "Auto", "FFTPACK", "Serial FFTPACK" or "FFTW".
+ *
+ * @param[in] h  Handle to imager.
+ */
+OSKAR_EXPORT
+const char* oskar_imager_fft_backend(const oskar_Imager* h);
+
 /**
  * @brief
  * Returns the flag specifying whether to use the GPU for FFTs.
@@ -187,6 +200,19 @@ const char* oskar_imager_image_type(const oskar_Imager* h);
 OSKAR_EXPORT
 char* const* oskar_imager_input_files(const oskar_Imager* h);
 
+/**
+ * @brief
+ * Returns the memory limit for image planes, in MB.
+ *
+ * @details
+ * Returns the memory limit for image planes, in MB.
+ * A value of 0 means no limit.
+ *
+ * @param[in] h  Handle to imager.
+ */
+OSKAR_EXPORT
+double oskar_imager_max_plane_memory_mb(const oskar_Imager* h);
+
 /**
  * @brief
  * Returns the Measurement Set column to use.
@@ -394,6 +420,27 @@ void oskar_imager_set_default_direction(oskar_Imager* h);
 OSKAR_EXPORT
 void oskar_imager_set_direction(oskar_Imager* h, double ra_deg, double dec_deg);
 
+/**
+ * @brief
+ * Sets the FFT library used for CPU transforms.
+ *
+ * @details
+ * Sets the FFT library used for CPU transforms,
+ * either "Auto", "FFTPACK", "Serial FFTPACK" or "FFTW".
+ * "Auto" uses FFTW if it is available, otherwise FFTPACK.
+ * "FFTPACK" uses multiple threads, while "Serial FFTPACK" uses only one.
+ * If OSKAR was compiled without FFTW, "FFTW" is replaced by "Auto"
+ * and a warning is written to the log.
+ * This has no effect on transforms done using the GPU.
+ *
+ * @param[in,out] h            Handle to imager.
+ * @param[in] type             FFT library type string, as above.
+ * @param[in,out] status       Status return code.
+ */
+OSKAR_EXPORT
+void oskar_imager_set_fft_backend(oskar_Imager* h, const char* type,
+        int* status);
+
 /**
  * @brief
  * Sets whether to use the GPU for FFTs.
@@ -570,6 +617,28 @@ void oskar_imager_set_input_files(oskar_Imager* h, int num_files,
 OSKAR_EXPORT
 void oskar_imager_set_log(oskar_Imager* h, oskar_Log* log);
 
+/**
+ * @brief
+ * Sets the memory limit for image planes, in MB.
+ *
+ * @details
+ * Sets the maximum amount of memory to use for image planes and
+ * weights grids when making an image cube using channel snapshots.
+ *
+ * If the planes for all channels would need more memory than this,
+ * oskar_imager_run() images the channels in groups that fit within the
+ * limit, and writes each group to the output FITS cube before starting
+ * on the next one. Only the visibility channels needed for each group
+ * are used.
+ *
+ * A value of 0 means no limit.
+ *
+ * @param[in,out] h          Handle to imager.
+ * @param[in]     value      Memory limit for image planes, in MB.
+ */
+OSKAR_EXPORT
+void oskar_imager_set_max_plane_memory_mb(oskar_Imager* h, double value);
+
 /**
  * @brief
  * Sets the data column to use from a Measurement Set.
@@ -767,6 +836,23 @@ void oskar_imager_set_vis_phase_centre(oskar_Imager* h,
 OSKAR_EXPORT
 void oskar_imager_set_num_w_planes(oskar_Imager* h, int value);
 
+/**
+ * @brief
+ * Sets the directory used to cache W-projection kernels.
+ *
+ * @details
+ * Sets the directory used to cache W-projection kernels between runs.
+ * Kernels are stored in files named according to a checksum of the
+ * parameters used to generate them, and are loaded instead of being
+ * regenerated if a matching file is found.
+ * A NULL or empty string disables the cache.
+ *
+ * @param[in,out] h            Handle to imager.
+ * @param[in] path             Path to cache directory.
+ */
+OSKAR_EXPORT
+void oskar_imager_set_w_kernel_cache_dir(oskar_Imager* h, const char* path);
+
 /**
  * @brief
  * Sets the visibility weighting scheme to use.
@@ -844,6 +930,19 @@ double oskar_imager_uv_filter_max(const oskar_Imager* h);
 OSKAR_EXPORT
 double oskar_imager_uv_filter_min(const oskar_Imager* h);
 
+/**
+ * @brief
+ * Returns the directory used to cache W-projection kernels.
+ *
+ * @details
+ * Returns the directory used to cache W-projection kernels,
+ * or NULL if the cache is disabled.
+ *
+ * @param[in] h  Handle to imager.
+ */
+OSKAR_EXPORT
+const char* oskar_imager_w_kernel_cache_dir(const oskar_Imager* h);
+
 /**
  * @brief
  * Returns the visibility weighting scheme.
@@ -51,6 +51,10 @@ extern "C" {
  * Copies of the image and/or grid planes can be returned if required
  * by supplying arrays as input arguments. Set these to NULL if not required.
  *
+ * If the imager is working through a cube in channel groups, this
+ * finalises and writes only the planes for the current group, which are
+ * then freed. The imager is reset after the last group has been written.
+ *
  * @param[in,out] h             Handle to imager.
  * @param[in] num_output_images Number of output image planes supplied.
  * @param[in] output_images     Array of image planes.
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2018, The University of Oxford
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the University of Oxford nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef OSKAR_PRIVATE_GRID_TILES_H_
+#define OSKAR_PRIVATE_GRID_TILES_H_
+
+/**
+ * @file private_grid_tiles.h
+ */
+
+#include <oskar_global.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Visibilities binned into tiles of the grid for parallel gridding.
+ *
+ * @details
+ * Each tile is a band of whole grid rows that is more than twice the
+ * maximum kernel support in height, so visibilities in alternate tiles
+ * never update the same grid cell. All the even tiles can therefore be
+ * gridded concurrently, followed by all the odd tiles.
+ *
+ * The tile size depends only on the grid size and kernel support, and the
+ * visibilities in each tile keep their original order, so the result does
+ * not depend on the number of threads.
+ */
+struct oskar_GridTiles
+{
+    int num_tiles;       /* Number of tiles. */
+    size_t* start;       /* Start of each tile in indices (num_tiles + 1). */
+    size_t* indices;     /* Visibility indices, in tile order. */
+    size_t* num_skipped; /* Visibilities skipped in each tile. */
+    double* norm;        /* Normalisation sum for each tile. */
+};
+typedef struct oskar_GridTiles oskar_GridTiles;
+
+/**
+ * @brief Bins visibilities into grid tiles (double precision).
+ *
+ * @details
+ * Returns 0 (and allocates nothing) if the grid is too small to be tiled
+ * or there are too few visibilities to make it worthwhile, in which case
+ * the visibilities should be gridded serially.
+ *
+ * The grid row of each visibility is found exactly as in the gridders.
+ *
+ * @param[out] tiles         Tiles to fill.
+ * @param[in] num_points     Number of visibility points.
+ * @param[in] vv             Visibility baseline vv coordinates, in wavelengths.
+ * @param[in] cell_size_rad  Cell size, in radians.
+ * @param[in] grid_size      Side length of grid.
+ * @param[in] max_support    Maximum kernel support size.
+ *
+ * @return The number of tiles.
+ */
+int oskar_grid_tiles_create_d(oskar_GridTiles* tiles, size_t num_points,
+        const double* vv, double cell_size_rad, int grid_size,
+        int max_support);
+
+/**
+ * @brief Bins visibilities into grid tiles (single precision).
+ *
+ * @details
+ * Returns 0 (and allocates nothing) if the grid is too small to be tiled
+ * or there are too few visibilities to make it worthwhile, in which case
+ * the visibilities should be gridded serially.
+ *
+ * The grid row of each visibility is found exactly as in the gridders.
+ *
+ * @param[out] tiles         Tiles to fill.
+ * @param[in] num_points     Number of visibility points.
+ * @param[in] vv             Visibility baseline vv coordinates, in wavelengths.
+ * @param[in] cell_size_rad  Cell size, in radians.
+ * @param[in] grid_size      Side length of grid.
+ * @param[in] max_support    Maximum kernel support size.
+ *
+ * @return The number of tiles.
+ */
+int oskar_grid_tiles_create_f(oskar_GridTiles* tiles, size_t num_points,
+        const float* vv, float cell_size_rad, int grid_size,
+        int max_support);
+
+/**
+ * @brief Accumulates per-tile results and frees the tiles.
+ *
+ * @details
+ * Adds the number of skipped visibilities and the normalisation sum of
+ * each tile to the totals, in tile order, and frees the tile arrays.
+ *
+ * @param[in,out] tiles        Tiles to free.
+ * @param[in,out] num_skipped  Total number of skipped visibilities.
+ * @param[in,out] norm         Grid normalisation factor.
+ */
+void oskar_grid_tiles_free(oskar_GridTiles* tiles, size_t* num_skipped,
+        double* norm);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OSKAR_PRIVATE_GRID_TILES_H_ */
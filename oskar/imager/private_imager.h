@@ -26,13 +26,10 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
-#ifdef OSKAR_HAVE_CUDA
-#include <cufft.h>
-#endif
-
 #include <fitsio.h>
 #include <mem/oskar_mem.h>
 #include <log/oskar_log.h>
+#include <math/oskar_fft.h>
 #include <utility/oskar_thread.h>
 #include <utility/oskar_timer.h>
 
@@ -57,7 +54,7 @@ struct oskar_Imager
     oskar_Timer *tmr_read, *tmr_write;
 
     /* Settings parameters. */
-    int imager_prec, num_devices, num_gpus, *gpu_ids, fft_on_gpu;
+    int imager_prec, num_devices, num_gpus, *gpu_ids, fft_on_gpu, fft_backend;
     int chan_snaps, im_type, num_im_channels, num_im_pols, pol_offset;
     int algorithm, image_size, use_stokes, support, oversample;
     int generate_w_kernels_on_gpu, set_cellsize, set_fov, weighting;
@@ -67,11 +64,13 @@ struct oskar_Imager
     double cellsize_rad, fov_deg, image_padding, im_centre_deg[2];
     double uv_filter_min, uv_filter_max;
     double time_min_utc, time_max_utc, freq_min_hz, freq_max_hz;
+    double max_plane_memory_mb;
 
     /* Visibility meta-data. */
     int num_sel_freqs;
     double *im_freqs, *sel_freqs;
     double vis_freq_start_hz, freq_inc_hz;
+    int chan_group_start, chan_group_size; /* Current channel group. */
 
     /* State. */
     int status, i_block;
@@ -90,16 +89,15 @@ struct oskar_Imager
 
     /* FFT imager data. */
     int grid_size;
-    oskar_Mem *conv_func, *corr_func, *fftpack_wsave, *fftpack_work;
-#ifdef OSKAR_HAVE_CUDA
-    cufftHandle cufft_plan;
-#endif
+    oskar_Mem *conv_func, *corr_func;
+    oskar_FFT* fft;
 
     /* W-projection imager data. */
     size_t ww_points;
     int num_w_planes, conv_size_half;
     double w_scale, ww_min, ww_max, ww_rms;
     oskar_Mem *w_kernels, *w_support, *w_kernels_compact, *w_kernel_start;
+    char* w_kernel_cache_dir;
 
     /* Memory allocated per GPU (array of DeviceData structures). */
     DeviceData* d;
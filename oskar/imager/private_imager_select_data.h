@@ -36,12 +36,18 @@
 extern "C" {
 #endif
 
+/*
+ * Visibility amplitudes are in (row, channel, polarisation) order if
+ * num_baselines is zero, or in the native visibility block order
+ * (time, channel, baseline, polarisation) if num_baselines is positive.
+ */
 void oskar_imager_select_data(
         const oskar_Imager* h,
         size_t num_rows,
         int start_chan,
         int end_chan,
         int num_pols,
+        int num_baselines,
         const oskar_Mem* uu_in,
         const oskar_Mem* vv_in,
         const oskar_Mem* ww_in,
@@ -27,6 +27,7 @@
  */
 
 #include "imager/oskar_grid_simple.h"
+#include "imager/private_grid_tiles.h"
 #include <math.h>
 #include <stdlib.h>
 
@@ -37,8 +38,9 @@ extern "C" {
 #define D_SUPPORT 3
 #define D_OVERSAMPLE 100
 
-static void oskar_grid_simple_default_d(
+static void grid_simple_default_d(
         const double* restrict conv_func,
+        const size_t* restrict indices,
         const size_t num_points,
         const double* restrict uu,
         const double* restrict vv,
@@ -50,16 +52,16 @@ static void oskar_grid_simple_default_d(
         double* restrict norm,
         double* restrict grid)
 {
-    size_t i;
+    size_t t;
     const int grid_centre = grid_size / 2;
     const double grid_scale = grid_size * cell_size_rad;
 
     /* Loop over visibilities. */
-    *num_skipped = 0;
-    for (i = 0; i < num_points; ++i)
+    for (t = 0; t < num_points; ++t)
     {
         double sum = 0.0;
         int j, k;
+        const size_t i = indices ? indices[t] : t;
 
         /* Convert UV coordinates to grid coordinates. */
         const double pos_u = -uu[i] * grid_scale;
@@ -106,8 +108,9 @@ static void oskar_grid_simple_default_d(
 }
 
 
-static void oskar_grid_simple_default_f(
+static void grid_simple_default_f(
         const float* restrict conv_func,
+        const size_t* restrict indices,
         const size_t num_points,
         const float* restrict uu,
         const float* restrict vv,
@@ -119,16 +122,16 @@ static void oskar_grid_simple_default_f(
         double* restrict norm,
         float* restrict grid)
 {
-    size_t i;
+    size_t t;
     const int grid_centre = grid_size / 2;
     const float grid_scale = grid_size * cell_size_rad;
 
     /* Loop over visibilities. */
-    *num_skipped = 0;
-    for (i = 0; i < num_points; ++i)
+    for (t = 0; t < num_points; ++t)
     {
         double sum = 0.0;
         int j, k;
+        const size_t i = indices ? indices[t] : t;
 
         /* Convert UV coordinates to grid coordinates. */
         const float pos_u = -uu[i] * grid_scale;
@@ -175,10 +178,11 @@ static void oskar_grid_simple_default_f(
 }
 
 
-void oskar_grid_simple_d(
+static void grid_simple_d(
         const int support,
         const int oversample,
         const double* restrict conv_func,
+        const size_t* restrict indices,
         const size_t num_points,
         const double* restrict uu,
         const double* restrict vv,
@@ -190,24 +194,16 @@ void oskar_grid_simple_d(
         double* restrict norm,
         double* restrict grid)
 {
-    size_t i;
+    size_t t;
     const int grid_centre = grid_size / 2;
     const double grid_scale = grid_size * cell_size_rad;
 
-    /* Use slightly more efficient version for default parameters. */
-    if (support == D_SUPPORT && oversample == D_OVERSAMPLE)
-    {
-        oskar_grid_simple_default_d(conv_func, num_points, uu, vv, vis,
-                weight, cell_size_rad, grid_size, num_skipped, norm, grid);
-        return;
-    }
-
     /* Loop over visibilities. */
-    *num_skipped = 0;
-    for (i = 0; i < num_points; ++i)
+    for (t = 0; t < num_points; ++t)
     {
         double sum = 0.0;
         int j, k;
+        const size_t i = indices ? indices[t] : t;
 
         /* Convert UV coordinates to grid coordinates. */
         const double pos_u = -uu[i] * grid_scale;
@@ -254,10 +250,11 @@ void oskar_grid_simple_d(
 }
 
 
-void oskar_grid_simple_f(
+static void grid_simple_f(
         const int support,
         const int oversample,
         const float* restrict conv_func,
+        const size_t* restrict indices,
         const size_t num_points,
         const float* restrict uu,
         const float* restrict vv,
@@ -269,24 +266,16 @@ void oskar_grid_simple_f(
         double* restrict norm,
         float* restrict grid)
 {
-    size_t i;
+    size_t t;
     const int grid_centre = grid_size / 2;
     const float grid_scale = grid_size * cell_size_rad;
 
-    /* Use slightly more efficient version for default parameters. */
-    if (support == D_SUPPORT && oversample == D_OVERSAMPLE)
-    {
-        oskar_grid_simple_default_f(conv_func, num_points, uu, vv, vis,
-                weight, cell_size_rad, grid_size, num_skipped, norm, grid);
-        return;
-    }
-
     /* Loop over visibilities. */
-    *num_skipped = 0;
-    for (i = 0; i < num_points; ++i)
+    for (t = 0; t < num_points; ++t)
     {
         double sum = 0.0;
         int j, k;
+        const size_t i = indices ? indices[t] : t;
 
         /* Convert UV coordinates to grid coordinates. */
         const float pos_u = -uu[i] * grid_scale;
@@ -332,6 +321,149 @@ void oskar_grid_simple_f(
     }
 }
 
+
+
+static void grid_points_d(
+        const int support,
+        const int oversample,
+        const double* restrict conv_func,
+        const size_t* restrict indices,
+        const size_t num_points,
+        const double* restrict uu,
+        const double* restrict vv,
+        const double* restrict vis,
+        const double* restrict weight,
+        const double cell_size_rad,
+        const int grid_size,
+        size_t* restrict num_skipped,
+        double* restrict norm,
+        double* restrict grid)
+{
+    /* Use slightly more efficient version for default parameters. */
+    if (support == D_SUPPORT && oversample == D_OVERSAMPLE)
+        grid_simple_default_d(conv_func, indices, num_points, uu, vv, vis,
+                weight, cell_size_rad, grid_size, num_skipped, norm, grid);
+    else
+        grid_simple_d(support, oversample, conv_func, indices, num_points,
+                uu, vv, vis, weight, cell_size_rad, grid_size,
+                num_skipped, norm, grid);
+}
+
+
+void oskar_grid_simple_d(
+        const int support,
+        const int oversample,
+        const double* restrict conv_func,
+        const size_t num_points,
+        const double* restrict uu,
+        const double* restrict vv,
+        const double* restrict vis,
+        const double* restrict weight,
+        const double cell_size_rad,
+        const int grid_size,
+        size_t* restrict num_skipped,
+        double* restrict norm,
+        double* restrict grid)
+{
+    oskar_GridTiles tiles;
+    int c, t;
+
+    /* Grid alternate tiles in parallel. */
+    *num_skipped = 0;
+    if (!oskar_grid_tiles_create_d(&tiles, num_points, vv, cell_size_rad,
+            grid_size, support))
+    {
+        grid_points_d(support, oversample, conv_func, 0, num_points,
+                uu, vv, vis, weight, cell_size_rad, grid_size,
+                num_skipped, norm, grid);
+        return;
+    }
+    for (c = 0; c < 2; ++c)
+    {
+#pragma omp parallel for schedule(dynamic)
+        for (t = c; t < tiles.num_tiles; t += 2)
+        {
+            const size_t start = tiles.start[t];
+            grid_points_d(support, oversample, conv_func,
+                    tiles.indices + start, tiles.start[t + 1] - start,
+                    uu, vv, vis, weight, cell_size_rad, grid_size,
+                    &tiles.num_skipped[t], &tiles.norm[t], grid);
+        }
+    }
+    oskar_grid_tiles_free(&tiles, num_skipped, norm);
+}
+
+
+static void grid_points_f(
+        const int support,
+        const int oversample,
+        const float* restrict conv_func,
+        const size_t* restrict indices,
+        const size_t num_points,
+        const float* restrict uu,
+        const float* restrict vv,
+        const float* restrict vis,
+        const float* restrict weight,
+        const float cell_size_rad,
+        const int grid_size,
+        size_t* restrict num_skipped,
+        double* restrict norm,
+        float* restrict grid)
+{
+    /* Use slightly more efficient version for default parameters. */
+    if (support == D_SUPPORT && oversample == D_OVERSAMPLE)
+        grid_simple_default_f(conv_func, indices, num_points, uu, vv, vis,
+                weight, cell_size_rad, grid_size, num_skipped, norm, grid);
+    else
+        grid_simple_f(support, oversample, conv_func, indices, num_points,
+                uu, vv, vis, weight, cell_size_rad, grid_size,
+                num_skipped, norm, grid);
+}
+
+
+void oskar_grid_simple_f(
+        const int support,
+        const int oversample,
+        const float* restrict conv_func,
+        const size_t num_points,
+        const float* restrict uu,
+        const float* restrict vv,
+        const float* restrict vis,
+        const float* restrict weight,
+        const float cell_size_rad,
+        const int grid_size,
+        size_t* restrict num_skipped,
+        double* restrict norm,
+        float* restrict grid)
+{
+    oskar_GridTiles tiles;
+    int c, t;
+
+    /* Grid alternate tiles in parallel. */
+    *num_skipped = 0;
+    if (!oskar_grid_tiles_create_f(&tiles, num_points, vv, cell_size_rad,
+            grid_size, support))
+    {
+        grid_points_f(support, oversample, conv_func, 0, num_points,
+                uu, vv, vis, weight, cell_size_rad, grid_size,
+                num_skipped, norm, grid);
+        return;
+    }
+    for (c = 0; c < 2; ++c)
+    {
+#pragma omp parallel for schedule(dynamic)
+        for (t = c; t < tiles.num_tiles; t += 2)
+        {
+            const size_t start = tiles.start[t];
+            grid_points_f(support, oversample, conv_func,
+                    tiles.indices + start, tiles.start[t + 1] - start,
+                    uu, vv, vis, weight, cell_size_rad, grid_size,
+                    &tiles.num_skipped[t], &tiles.norm[t], grid);
+        }
+    }
+    oskar_grid_tiles_free(&tiles, num_skipped, norm);
+}
+
 #ifdef __cplusplus
 }
 #endif
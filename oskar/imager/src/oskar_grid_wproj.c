@@ -27,6 +27,7 @@
  */
 
 #include "imager/oskar_grid_wproj.h"
+#include "imager/private_grid_tiles.h"
 #include <math.h>
 #include <stdlib.h>
 
@@ -34,12 +35,13 @@
 extern "C" {
 #endif
 
-void oskar_grid_wproj_d(
+static void grid_wproj_d(
         const size_t num_w_planes,
         const int* restrict support,
         const int oversample,
         const int conv_size_half,
         const double* restrict conv_func,
+        const size_t* restrict indices,
         const size_t num_points,
         const double* restrict uu,
         const double* restrict vv,
@@ -53,17 +55,17 @@ void oskar_grid_wproj_d(
         double* restrict norm,
         double* restrict grid)
 {
-    size_t i;
+    size_t t;
     const size_t kernel_dim = conv_size_half * conv_size_half;
     const int grid_centre = grid_size / 2;
     const double grid_scale = grid_size * cell_size_rad;
 
     /* Loop over visibilities. */
-    *num_skipped = 0;
-    for (i = 0; i < num_points; ++i)
+    for (t = 0; t < num_points; ++t)
     {
         double sum = 0.0;
         int j, k;
+        const size_t i = indices ? indices[t] : t;
 
         /* Convert UV coordinates to grid coordinates. */
         const double pos_u = -uu[i] * grid_scale;
@@ -123,12 +125,13 @@ void oskar_grid_wproj_d(
 }
 
 
-void oskar_grid_wproj_f(
+static void grid_wproj_f(
         const size_t num_w_planes,
         const int* restrict support,
         const int oversample,
         const int conv_size_half,
         const float* restrict conv_func,
+        const size_t* restrict indices,
         const size_t num_points,
         const float* restrict uu,
         const float* restrict vv,
@@ -142,17 +145,17 @@ void oskar_grid_wproj_f(
         double* restrict norm,
         float* restrict grid)
 {
-    size_t i;
+    size_t t;
     const size_t kernel_dim = conv_size_half * conv_size_half;
     const int grid_centre = grid_size / 2;
     const float grid_scale = grid_size * cell_size_rad;
 
     /* Loop over visibilities. */
-    *num_skipped = 0;
-    for (i = 0; i < num_points; ++i)
+    for (t = 0; t < num_points; ++t)
     {
         double sum = 0.0;
         int j, k;
+        const size_t i = indices ? indices[t] : t;
 
         /* Convert UV coordinates to grid coordinates. */
         const float pos_u = -uu[i] * grid_scale;
@@ -211,6 +214,110 @@ void oskar_grid_wproj_f(
     }
 }
 
+
+void oskar_grid_wproj_d(
+        const size_t num_w_planes,
+        const int* restrict support,
+        const int oversample,
+        const int conv_size_half,
+        const double* restrict conv_func,
+        const size_t num_points,
+        const double* restrict uu,
+        const double* restrict vv,
+        const double* restrict ww,
+        const double* restrict vis,
+        const double* restrict weight,
+        const double cell_size_rad,
+        const double w_scale,
+        const int grid_size,
+        size_t* restrict num_skipped,
+        double* restrict norm,
+        double* restrict grid)
+{
+    oskar_GridTiles tiles;
+    size_t w;
+    int c, t, max_support = 0;
+    for (w = 0; w < num_w_planes; ++w)
+        if (support[w] > max_support) max_support = support[w];
+
+    /* Grid alternate tiles in parallel. */
+    *num_skipped = 0;
+    if (!oskar_grid_tiles_create_d(&tiles, num_points, vv, cell_size_rad,
+            grid_size, max_support))
+    {
+        grid_wproj_d(num_w_planes, support, oversample, conv_size_half,
+                conv_func, 0, num_points, uu, vv, ww, vis, weight,
+                cell_size_rad, w_scale, grid_size, num_skipped, norm, grid);
+        return;
+    }
+    for (c = 0; c < 2; ++c)
+    {
+#pragma omp parallel for schedule(dynamic)
+        for (t = c; t < tiles.num_tiles; t += 2)
+        {
+            const size_t start = tiles.start[t];
+            grid_wproj_d(num_w_planes, support, oversample, conv_size_half,
+                    conv_func, tiles.indices + start,
+                    tiles.start[t + 1] - start, uu, vv, ww, vis, weight,
+                    cell_size_rad, w_scale, grid_size,
+                    &tiles.num_skipped[t], &tiles.norm[t], grid);
+        }
+    }
+    oskar_grid_tiles_free(&tiles, num_skipped, norm);
+}
+
+
+void oskar_grid_wproj_f(
+        const size_t num_w_planes,
+        const int* restrict support,
+        const int oversample,
+        const int conv_size_half,
+        const float* restrict conv_func,
+        const size_t num_points,
+        const float* restrict uu,
+        const float* restrict vv,
+        const float* restrict ww,
+        const float* restrict vis,
+        const float* restrict weight,
+        const float cell_size_rad,
+        const float w_scale,
+        const int grid_size,
+        size_t* restrict num_skipped,
+        double* restrict norm,
+        float* restrict grid)
+{
+    oskar_GridTiles tiles;
+    size_t w;
+    int c, t, max_support = 0;
+    for (w = 0; w < num_w_planes; ++w)
+        if (support[w] > max_support) max_support = support[w];
+
+    /* Grid alternate tiles in parallel. */
+    *num_skipped = 0;
+    if (!oskar_grid_tiles_create_f(&tiles, num_points, vv, cell_size_rad,
+            grid_size, max_support))
+    {
+        grid_wproj_f(num_w_planes, support, oversample, conv_size_half,
+                conv_func, 0, num_points, uu, vv, ww, vis, weight,
+                cell_size_rad, w_scale, grid_size, num_skipped, norm, grid);
+        return;
+    }
+    for (c = 0; c < 2; ++c)
+    {
+#pragma omp parallel for schedule(dynamic)
+        for (t = c; t < tiles.num_tiles; t += 2)
+        {
+            const size_t start = tiles.start[t];
+            grid_wproj_f(num_w_planes, support, oversample, conv_size_half,
+                    conv_func, tiles.indices + start,
+                    tiles.start[t + 1] - start, uu, vv, ww, vis, weight,
+                    cell_size_rad, w_scale, grid_size,
+                    &tiles.num_skipped[t], &tiles.norm[t], grid);
+        }
+    }
+    oskar_grid_tiles_free(&tiles, num_skipped, norm);
+}
+
 #ifdef __cplusplus
 }
 #endif
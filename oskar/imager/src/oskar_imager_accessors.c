@@ -80,6 +80,19 @@ int oskar_imager_coords_only(const oskar_Imager* h)
 }
 
 
+const char* oskar_imager_fft_backend(const oskar_Imager* h)
+{
+    switch (h->fft_backend)
+    {
+    case OSKAR_FFT_DEFAULT:          return "Auto";
+    case OSKAR_FFT_FFTPACK:          return "Serial FFTPACK";
+    case OSKAR_FFT_FFTPACK_THREADED: return "FFTPACK";
+    case OSKAR_FFT_FFTW:             return "FFTW";
+    default:                         return "";
+    }
+}
+
+
 int oskar_imager_fft_on_gpu(const oskar_Imager* h)
 {
     return h->fft_on_gpu;
@@ -142,6 +155,12 @@ char* const* oskar_imager_input_files(const oskar_Imager* h)
 }
 
 
+double oskar_imager_max_plane_memory_mb(const oskar_Imager* h)
+{
+    return h->max_plane_memory_mb;
+}
+
+
 const char* oskar_imager_ms_column(const oskar_Imager* h)
 {
     return h->ms_column;
@@ -320,6 +339,30 @@ void oskar_imager_set_fov(oskar_Imager* h, double fov_deg)
 }
 
 
+void oskar_imager_set_fft_backend(oskar_Imager* h, const char* type,
+        int* status)
+{
+    if (*status) return;
+    if (!strncmp(type, "A", 1) || !strncmp(type, "a", 1))
+        h->fft_backend = OSKAR_FFT_DEFAULT;
+    else if (!strncmp(type, "FFTP", 4) || !strncmp(type, "fftp", 4))
+        h->fft_backend = OSKAR_FFT_FFTPACK_THREADED;
+    else if (!strncmp(type, "S", 1) || !strncmp(type, "s", 1))
+        h->fft_backend = OSKAR_FFT_FFTPACK;
+    else if (!strncmp(type, "FFTW", 4) || !strncmp(type, "fftw", 4))
+    {
+#ifdef OSKAR_HAVE_FFTW
+        h->fft_backend = OSKAR_FFT_FFTW;
+#else
+        oskar_log_warning(h->log, "OSKAR was compiled without FFTW: "
+                "using FFTPACK instead.");
+        h->fft_backend = OSKAR_FFT_DEFAULT;
+#endif
+    }
+    else *status = OSKAR_ERR_INVALID_ARGUMENT;
+}
+
+
 void oskar_imager_set_fft_on_gpu(oskar_Imager* h, int value)
 {
     h->fft_on_gpu = value;
@@ -494,6 +537,12 @@ void oskar_imager_set_log(oskar_Imager* h, oskar_Log* log)
 }
 
 
+void oskar_imager_set_max_plane_memory_mb(oskar_Imager* h, double value)
+{
+    h->max_plane_memory_mb = value;
+}
+
+
 void oskar_imager_set_ms_column(oskar_Imager* h, const char* column,
         int* status)
 {
@@ -700,6 +749,20 @@ void oskar_imager_set_num_w_planes(oskar_Imager* h, int value)
 }
 
 
+void oskar_imager_set_w_kernel_cache_dir(oskar_Imager* h, const char* path)
+{
+    int len = 0;
+    free(h->w_kernel_cache_dir);
+    h->w_kernel_cache_dir = 0;
+    if (path) len = (int) strlen(path);
+    if (len > 0)
+    {
+        h->w_kernel_cache_dir = calloc(1 + len, 1);
+        strcpy(h->w_kernel_cache_dir, path);
+    }
+}
+
+
 void oskar_imager_set_weighting(oskar_Imager* h, const char* type, int* status)
 {
     if (!strncmp(type, "N", 1) || !strncmp(type, "n", 1))
@@ -744,6 +807,12 @@ double oskar_imager_uv_filter_min(const oskar_Imager* h)
 }
 
 
+const char* oskar_imager_w_kernel_cache_dir(const oskar_Imager* h)
+{
+    return h->w_kernel_cache_dir;
+}
+
+
 const char* oskar_imager_weighting(const oskar_Imager* h)
 {
     switch (h->weighting)
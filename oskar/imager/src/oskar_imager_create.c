@@ -79,6 +79,7 @@ oskar_Imager* oskar_imager_create(int imager_precision, int* status)
     oskar_imager_set_algorithm(h, "FFT", status);
     oskar_imager_set_image_type(h, "I", status);
     oskar_imager_set_weighting(h, "Natural", status);
+    oskar_imager_set_fft_backend(h, "Auto", status);
     oskar_imager_set_ms_column(h, "DATA", status);
     oskar_imager_set_default_direction(h);
     oskar_imager_set_generate_w_kernels_on_gpu(h, 1);
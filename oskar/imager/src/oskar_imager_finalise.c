@@ -26,18 +26,14 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
-#ifdef OSKAR_HAVE_CUDA
-#include <cufft.h>
-#endif
-
 #include "imager/private_imager.h"
 #include "imager/oskar_imager.h"
+#include "imager/private_imager_free_planes.h"
 
 #include "imager/oskar_grid_correction.h"
 #include "imager/oskar_grid_functions_pillbox.h"
 #include "imager/oskar_grid_functions_spheroidal.h"
-#include "math/oskar_fftpack_cfft.h"
-#include "math/oskar_fftpack_cfft_f.h"
+#include "math/oskar_fft.h"
 #include "math/oskar_fftphase.h"
 #include "mem/oskar_mem.h"
 #include "utility/oskar_device_utils.h"
@@ -61,9 +57,12 @@ void oskar_imager_finalise(oskar_Imager* h,
         int num_output_grids, oskar_Mem** output_grids, int* status)
 {
     size_t n;
-    int c, p, i, plane_size;
+    int c, p, i, i_out, plane_size;
     if (*status || !h->planes) return;
 
+    /* Get the index of the first output plane in the current group. */
+    i_out = h->chan_group_start * h->num_im_pols;
+
     /* Adjust normalisation if required. */
     if (h->scale_norm_with_num_input_files)
     {
@@ -72,13 +71,14 @@ void oskar_imager_finalise(oskar_Imager* h,
     }
 
     /* Copy grids to output grid planes if given. */
-    for (i = 0; (i < h->num_planes) && (i < num_output_grids); ++i)
+    for (i = 0; (i < h->num_planes) && (i_out + i < num_output_grids); ++i)
     {
-        if (!(output_grids[i]))
-            output_grids[i] = oskar_mem_create(oskar_mem_type(h->planes[i]),
+        oskar_Mem** grid = &output_grids[i_out + i];
+        if (!(*grid))
+            *grid = oskar_mem_create(oskar_mem_type(h->planes[i]),
                     OSKAR_CPU, 0, status);
-        oskar_mem_copy(output_grids[i], h->planes[i], status);
-        oskar_mem_scale_real(output_grids[i], 1.0 / h->plane_norm[i], status);
+        oskar_mem_copy(*grid, h->planes[i], status);
+        oskar_mem_scale_real(*grid, 1.0 / h->plane_norm[i], status);
     }
 
     /* Check if images are required. */
@@ -97,14 +97,16 @@ void oskar_imager_finalise(oskar_Imager* h,
         }
 
         /* Copy images to output image planes if given. */
-        for (i = 0; (i < h->num_planes) && (i < num_output_images); ++i)
+        for (i = 0; (i < h->num_planes) && (i_out + i < num_output_images);
+                ++i)
         {
-            if (!(output_images[i]))
-                output_images[i] = oskar_mem_create(h->imager_prec,
+            oskar_Mem** image = &output_images[i_out + i];
+            if (!(*image))
+                *image = oskar_mem_create(h->imager_prec,
                         OSKAR_CPU, n, status);
-            if (oskar_mem_length(output_images[i]) < n)
-                oskar_mem_realloc(output_images[i], n, status);
-            memcpy(oskar_mem_void(output_images[i]),
+            if (oskar_mem_length(*image) < n)
+                oskar_mem_realloc(*image, n, status);
+            memcpy(oskar_mem_void(*image),
                     oskar_mem_void_const(h->planes[i]),
                     n * oskar_mem_element_size(h->imager_prec));
         }
@@ -113,10 +115,20 @@ void oskar_imager_finalise(oskar_Imager* h,
         oskar_timer_resume(h->tmr_write);
         for (c = 0, i = 0; c < h->num_im_channels; ++c)
             for (p = 0; p < h->num_im_pols; ++p, ++i)
-                write_plane(h, h->planes[i], c, p, status);
+                write_plane(h, h->planes[i],
+                        h->chan_group_start + c, p, status);
         oskar_timer_pause(h->tmr_write);
     }
 
+    /* If there are more channel groups to image, free the planes
+     * for this group but keep everything else. */
+    if (h->chan_snaps && h->chan_group_size > 0 &&
+            h->chan_group_start + h->chan_group_size < h->num_sel_freqs)
+    {
+        oskar_imager_free_planes(h, status);
+        return;
+    }
+
     /* Record time taken. */
     if (h->log)
     {
@@ -218,61 +230,18 @@ void oskar_imager_finalise_plane(oskar_Imager* h,
         oskar_fftphase_cf(size, size, oskar_mem_float(plane, status));
 
     /* Call FFT. */
-#ifdef OSKAR_HAVE_CUDA
     if (h->fft_on_gpu && h->num_gpus > 0)
-    {
-        size_t work_size = 0;
-        oskar_Mem *plane_gpu = 0, *plane_ptr = 0;
         oskar_device_set(h->gpu_ids[0], status);
-        if (cufftGetSize(h->cufft_plan, &work_size) != CUFFT_SUCCESS)
-            cufftPlan2d(&h->cufft_plan, size, size,
-                    (h->imager_prec == OSKAR_DOUBLE) ? CUFFT_Z2Z : CUFFT_C2C);
-        plane_ptr = plane;
-        if (oskar_mem_location(plane) != OSKAR_GPU)
-        {
-            plane_gpu = oskar_mem_create_copy(plane, OSKAR_GPU, status);
-            plane_ptr = plane_gpu;
-        }
-        if (h->imager_prec == OSKAR_DOUBLE)
-            cufftExecZ2Z(h->cufft_plan, oskar_mem_void(plane_ptr),
-                    oskar_mem_void(plane_ptr), CUFFT_FORWARD);
-        else
-            cufftExecC2C(h->cufft_plan, oskar_mem_void(plane_ptr),
-                    oskar_mem_void(plane_ptr), CUFFT_FORWARD);
-        if (oskar_mem_location(plane) != OSKAR_GPU)
-            oskar_mem_copy(plane, plane_ptr, status);
-        oskar_mem_free(plane_gpu, status);
-    }
-    else
-#endif
+    if (!h->fft)
     {
-        if (!h->fftpack_work)
-            h->fftpack_work = oskar_mem_create(h->imager_prec, OSKAR_CPU,
-                    2 * num_cells, status);
-        if (!h->fftpack_wsave)
-        {
-            int len = 4 * size + 2 * (int)(log((double)size) / log(2.0)) + 8;
-            h->fftpack_wsave = oskar_mem_create(h->imager_prec, OSKAR_CPU,
-                    len, status);
-            if (h->imager_prec == OSKAR_DOUBLE)
-                oskar_fftpack_cfft2i(size, size,
-                        oskar_mem_double(h->fftpack_wsave, status));
-            else
-                oskar_fftpack_cfft2i_f(size, size,
-                        oskar_mem_float(h->fftpack_wsave, status));
-        }
-        if (h->imager_prec == OSKAR_DOUBLE)
-            oskar_fftpack_cfft2f(size, size, size,
-                    oskar_mem_double(plane, status),
-                    oskar_mem_double(h->fftpack_wsave, status),
-                    oskar_mem_double(h->fftpack_work, status));
-        else
-            oskar_fftpack_cfft2f_f(size, size, size,
-                    oskar_mem_float(plane, status),
-                    oskar_mem_float(h->fftpack_wsave, status),
-                    oskar_mem_float(h->fftpack_work, status));
-        oskar_mem_scale_real(plane, (double)num_cells, status);
+        const int fft_on_gpu = h->fft_on_gpu && h->num_gpus > 0;
+        h->fft = oskar_fft_create(h->imager_prec,
+                fft_on_gpu ? OSKAR_GPU : OSKAR_CPU, size,
+                fft_on_gpu ? OSKAR_FFT_DEFAULT : h->fft_backend, status);
+        oskar_log_message(h->log, 'M', 0, "Using %s for FFTs.",
+                oskar_fft_backend_name(h->fft));
     }
+    oskar_fft_exec(h->fft, plane, status);
 
     /* Generate grid correction function if required. */
     if (!h->corr_func)
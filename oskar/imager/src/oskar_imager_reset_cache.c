@@ -26,12 +26,9 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
-#ifdef OSKAR_HAVE_CUDA
-#include <cufft.h>
-#endif
-
 #include "imager/private_imager.h"
 #include "imager/oskar_imager_reset_cache.h"
+#include "imager/private_imager_free_planes.h"
 #include <fitsio.h>
 
 #include <stdlib.h>
@@ -46,23 +43,16 @@ void oskar_imager_reset_cache(oskar_Imager* h, int* status)
 
     /* Clear selected axes. */
     free(h->sel_freqs);
-    free(h->im_freqs);
     h->sel_freqs = 0;
-    h->im_freqs = 0;
     h->num_sel_freqs = 0;
-    h->num_im_channels = 0;
+    h->chan_group_start = 0;
+    h->chan_group_size = 0;
 
     /* Clear FFT caches. */
     oskar_mem_free(h->corr_func, status);
-    oskar_mem_free(h->fftpack_wsave, status);
-    oskar_mem_free(h->fftpack_work, status);
-#ifdef OSKAR_HAVE_CUDA
-    cufftDestroy(h->cufft_plan);
-    h->cufft_plan = 0;
-#endif
+    oskar_fft_free(h->fft);
     h->corr_func = 0;
-    h->fftpack_wsave = 0;
-    h->fftpack_work = 0;
+    h->fft = 0;
 
     /* Clear algorithm-specific caches. */
     oskar_mem_free(h->l, status); h->l = 0;
@@ -74,21 +64,8 @@ void oskar_imager_reset_cache(oskar_Imager* h, int* status)
     oskar_mem_free(h->w_kernels_compact, status); h->w_kernels_compact = 0;
     oskar_mem_free(h->w_kernel_start, status); h->w_kernel_start = 0;
 
-    /* Free the image planes. */
-    if (h->planes)
-        for (i = 0; i < h->num_planes; ++i)
-            oskar_mem_free(h->planes[i], status);
-    free(h->planes);
-    h->planes = 0;
-    free(h->plane_norm);
-    h->plane_norm = 0;
-
-    /* Free the weights grids if they exist. */
-    if (h->weights_grids)
-        for (i = 0; i < h->num_planes; ++i)
-            oskar_mem_free(h->weights_grids[i], status);
-    free(h->weights_grids);
-    h->weights_grids = 0;
+    /* Free the image planes and weights grids. */
+    oskar_imager_free_planes(h, status);
 
     /* Collapse temp arrays. */
     oskar_mem_realloc(h->uu_im, 0, status);
@@ -113,9 +90,6 @@ void oskar_imager_reset_cache(oskar_Imager* h, int* status)
         free(h->output_name[i]);
         h->output_name[i] = 0;
     }
-
-    /* Clear the number of image planes. */
-    h->num_planes = 0;
 }
 
 #ifdef __cplusplus
@@ -27,11 +27,13 @@
  */
 
 #include "imager/private_imager.h"
+#include "imager/private_imager_free_planes.h"
 #include "imager/private_imager_read_coords.h"
 #include "imager/private_imager_read_data.h"
 #include "imager/private_imager_read_dims.h"
 #include "imager/oskar_imager.h"
 
+#include <math.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -39,13 +41,18 @@
 extern "C" {
 #endif
 
+static void set_channel_group(oskar_Imager* h, int start, int size,
+        int* status);
+static void read_coords(oskar_Imager* h, int* status);
+static void read_data(oskar_Imager* h, int* status);
+static int num_channels_per_group(oskar_Imager* h);
 static int oskar_imager_is_ms(const char* filename);
 
 void oskar_imager_run(oskar_Imager* h,
         int num_output_images, oskar_Mem** output_images,
         int num_output_grids, oskar_Mem** output_grids, int* status)
 {
-    int i, num_files, percent_done = 0, percent_next = 10;
+    int i, num_files, group_size;
     const char* filename;
     if (*status) return;
 
@@ -100,30 +107,36 @@ void oskar_imager_run(oskar_Imager* h,
         return;
     }
 
-    /* Read baseline coordinates and weights if required. */
-    if (h->weighting == OSKAR_WEIGHTING_UNIFORM ||
-            h->algorithm == OSKAR_ALGORITHM_WPROJ)
+    /* Work out how many channels can be imaged at once. */
+    group_size = num_channels_per_group(h);
+    if (group_size < h->num_sel_freqs)
     {
-        oskar_imager_set_coords_only(h, 1);
+        h->chan_group_size = group_size;
         if (h->log)
-            oskar_log_section(h->log, 'M', "Reading coordinates...");
+            oskar_log_message(h->log, 'M', 0, "Imaging cube in groups of "
+                    "%d channel(s) to fit memory limit of %.1f MB",
+                    group_size, h->max_plane_memory_mb);
+    }
 
-        /* Loop over input files. */
-        for (i = 0; i < num_files; ++i)
+    /* Read baseline coordinates and weights if required.
+     * If imaging in channel groups, only get the W statistics here,
+     * from each group in turn: the grids of weights are made later. */
+    if (h->weighting == OSKAR_WEIGHTING_UNIFORM ||
+            h->algorithm == OSKAR_ALGORITHM_WPROJ)
+    {
+        if (h->chan_group_size == 0 || h->algorithm == OSKAR_ALGORITHM_WPROJ)
         {
-            /* Read coordinates and weights. */
-            if (*status) break;
-            filename = h->input_files[i];
+            oskar_imager_set_coords_only(h, 1);
             if (h->log)
-                oskar_log_message(h->log, 'M', 0, "Opening '%s'", filename);
-            if (oskar_imager_is_ms(filename))
-                oskar_imager_read_coords_ms(h, filename, i, num_files,
-                        &percent_done, &percent_next, status);
-            else
-                oskar_imager_read_coords_vis(h, filename, i, num_files,
-                        &percent_done, &percent_next, status);
+                oskar_log_section(h->log, 'M', "Reading coordinates...");
+            for (i = 0; i < h->num_sel_freqs; i += group_size)
+            {
+                set_channel_group(h, i, group_size, status);
+                read_coords(h, status);
+            }
+            set_channel_group(h, 0, group_size, status);
+            oskar_imager_set_coords_only(h, 0);
         }
-        oskar_imager_set_coords_only(h, 0);
     }
 
     /* Check for errors. */
@@ -151,38 +164,134 @@ void oskar_imager_run(oskar_Imager* h,
             oskar_log_message(h->log, 'M', 0, "Using %d W-planes.",
                     oskar_imager_num_w_planes(h));
         }
-        oskar_log_section(h->log, 'M', "Reading visibility data...");
     }
 
-    /* Loop over input files. */
-    percent_done = 0; percent_next = 10;
-    for (i = 0; i < num_files; ++i)
+    /* Loop over channel groups (only one, unless limited by memory). */
+    for (i = 0; i < h->num_sel_freqs; i += group_size)
     {
+        if (*status) break;
+        if (h->chan_group_size > 0)
+        {
+            set_channel_group(h, i, group_size, status);
+            if (h->log)
+                oskar_log_section(h->log, 'M', "Channel group %d to %d",
+                        h->chan_group_start,
+                        h->chan_group_start + h->chan_group_size - 1);
+
+            /* Make the grids of weights for this group if required.
+             * The algorithm has already been initialised, so this does
+             * not use oskar_imager_set_coords_only(), which would reset
+             * the W statistics. */
+            if (h->weighting == OSKAR_WEIGHTING_UNIFORM)
+            {
+                h->coords_only = 1;
+                if (h->log)
+                    oskar_log_section(h->log, 'M', "Reading coordinates...");
+                read_coords(h, status);
+                h->coords_only = 0;
+            }
+        }
+
         /* Read visibility data. */
+        if (h->log)
+            oskar_log_section(h->log, 'M', "Reading visibility data...");
+        read_data(h, status);
+
+        /* Check for errors. */
+        if (*status) break;
+
+        /* Finalise the planes for this group.
+         * This also resets the imager after the last group. */
+        if (h->log)
+            oskar_log_section(h->log, 'M', "Finalising %d image plane(s)...",
+                    h->num_planes);
+        oskar_imager_finalise(h, num_output_images, output_images,
+                num_output_grids, output_grids, status);
+        if (h->chan_group_size == 0) break;
+    }
+
+    /* Clean up if there was an error, or if the last group had no data. */
+    if (*status || h->chan_group_size > 0)
+        oskar_imager_reset_cache(h, status);
+}
+
+
+static void set_channel_group(oskar_Imager* h, int start, int size,
+        int* status)
+{
+    if (h->chan_group_size == 0) return;
+
+    /* Free any planes and weights grids from the previous group. */
+    oskar_imager_free_planes(h, status);
+    h->chan_group_start = start;
+    h->chan_group_size = size;
+    if (start + size > h->num_sel_freqs)
+        h->chan_group_size = h->num_sel_freqs - start;
+}
+
+
+static void read_coords(oskar_Imager* h, int* status)
+{
+    int i, percent_done = 0, percent_next = 10;
+    for (i = 0; i < h->num_files; ++i)
+    {
+        /* Read coordinates and weights. */
+        const char* filename = h->input_files[i];
         if (*status) break;
-        filename = h->input_files[i];
         if (h->log)
             oskar_log_message(h->log, 'M', 0, "Opening '%s'", filename);
         if (oskar_imager_is_ms(filename))
-            oskar_imager_read_data_ms(h, filename, i, num_files,
+            oskar_imager_read_coords_ms(h, filename, i, h->num_files,
                     &percent_done, &percent_next, status);
         else
-            oskar_imager_read_data_vis(h, filename, i, num_files,
+            oskar_imager_read_coords_vis(h, filename, i, h->num_files,
                     &percent_done, &percent_next, status);
     }
+}
 
-    /* Check for errors. */
-    if (*status)
+
+static void read_data(oskar_Imager* h, int* status)
+{
+    int i, percent_done = 0, percent_next = 10;
+    for (i = 0; i < h->num_files; ++i)
     {
-        oskar_imager_reset_cache(h, status);
-        return;
+        /* Read visibility data. */
+        const char* filename = h->input_files[i];
+        if (*status) break;
+        if (h->log)
+            oskar_log_message(h->log, 'M', 0, "Opening '%s'", filename);
+        if (oskar_imager_is_ms(filename))
+            oskar_imager_read_data_ms(h, filename, i, h->num_files,
+                    &percent_done, &percent_next, status);
+        else
+            oskar_imager_read_data_vis(h, filename, i, h->num_files,
+                    &percent_done, &percent_next, status);
     }
+}
 
-    if (h->log)
-        oskar_log_section(h->log, 'M', "Finalising %d image plane(s)...",
-                h->num_planes);
-    oskar_imager_finalise(h, num_output_images, output_images,
-            num_output_grids, output_grids, status);
+
+static int num_channels_per_group(oskar_Imager* h)
+{
+    int plane_size, num_channels;
+    double bytes_per_channel;
+    if (!h->chan_snaps || h->max_plane_memory_mb <= 0.0)
+        return h->num_sel_freqs;
+
+    /* Find the memory needed for the planes of one output channel. */
+    plane_size = oskar_imager_plane_size(h);
+    bytes_per_channel = (double) plane_size * plane_size *
+            oskar_mem_element_size(oskar_imager_plane_type(h));
+    if (h->weighting == OSKAR_WEIGHTING_UNIFORM)
+        bytes_per_channel += (double) plane_size * plane_size *
+                oskar_mem_element_size(h->imager_prec);
+    bytes_per_channel *= h->num_im_pols;
+
+    /* Fit as many channels as possible within the limit. */
+    num_channels = (int) floor(h->max_plane_memory_mb * 1024.0 * 1024.0 /
+            bytes_per_channel);
+    if (num_channels < 1) num_channels = 1;
+    if (num_channels > h->num_sel_freqs) num_channels = h->num_sel_freqs;
+    return num_channels;
 }
 
 
@@ -50,6 +50,10 @@
 extern "C" {
 #endif
 
+static void update(oskar_Imager* h, size_t num_rows, int start_chan,
+        int end_chan, int num_pols, int num_baselines, const oskar_Mem* uu,
+        const oskar_Mem* vv, const oskar_Mem* ww, const oskar_Mem* amps,
+        const oskar_Mem* weight, const oskar_Mem* time_centroid, int* status);
 static void oskar_imager_allocate_planes(oskar_Imager* h, int *status);
 static void oskar_imager_update_weights_grid(oskar_Imager* h,
         size_t num_points, const oskar_Mem* uu, const oskar_Mem* vv,
@@ -65,8 +69,6 @@ void oskar_imager_update_from_block(oskar_Imager* h,
     size_t num_rows;
     double time_start_mjd, time_inc_sec;
     oskar_Mem *weight = 0, *weight_ptr = 0, *time_centroid, *time_slice;
-    oskar_Mem *scratch = 0;
-    const oskar_Mem* ptr;
     if (*status) return;
 
     /* Check that cross-correlations exist. */
@@ -95,10 +97,6 @@ void oskar_imager_update_from_block(oskar_Imager* h,
             oskar_vis_header_phase_centre_dec_deg(header));
 
     /* Create scratch arrays. Weights are all 1. */
-    if (num_channels > 1)
-        scratch = oskar_mem_create(oskar_mem_type(
-                oskar_vis_block_cross_correlations_const(block)),
-                OSKAR_CPU, num_rows * num_channels, status);
     if (!weight)
     {
         size_t weight_len = num_rows * num_pols;
@@ -122,53 +120,15 @@ void oskar_imager_update_from_block(oskar_Imager* h,
                 0, num_baselines, status);
     }
 
-    /* Swap baseline and channel dimensions. */
-    ptr = oskar_vis_block_cross_correlations_const(block);
-#define SWAP_LOOP \
-        for (t = 0; t < num_times; ++t)                                  \
-            for (c = 0; c < num_channels; ++c)                           \
-                for (b = 0; b < num_baselines; ++b)                      \
-                    for (p = 0; p < num_pols; ++p)                       \
-                    {                                                    \
-                        k = (num_pols * (num_baselines *                 \
-                                (num_channels * t + c) + b) + p) << 1;   \
-                        l = (num_pols * (num_channels *                  \
-                                (num_baselines * t + b) + c) + p) << 1;  \
-                        out[l] = in[k];                                  \
-                        out[l + 1] = in[k + 1];                          \
-                    }
-        if (num_channels != 1)
-        {
-            int b, c, p;
-            size_t k, l;
-            if (oskar_mem_precision(ptr) == OSKAR_SINGLE)
-            {
-                const float *in;
-                float *out;
-                in  = oskar_mem_float_const(ptr, status);
-                out = oskar_mem_float(scratch, status);
-                SWAP_LOOP
-            }
-            else
-            {
-                const double *in;
-                double *out;
-                in  = oskar_mem_double_const(ptr, status);
-                out = oskar_mem_double(scratch, status);
-                SWAP_LOOP
-            }
-            ptr = scratch;
-        }
-#undef SWAP_LOOP
-
-    /* Update the imager with the data. */
-    oskar_imager_update(h, num_rows, start_chan, end_chan, num_pols,
+    /* Update the imager with the data.
+     * Channels are selected directly from the block, without reordering. */
+    update(h, num_rows, start_chan, end_chan, num_pols, num_baselines,
             oskar_vis_block_baseline_uu_metres_const(block),
             oskar_vis_block_baseline_vv_metres_const(block),
             oskar_vis_block_baseline_ww_metres_const(block),
-            ptr, weight_ptr, time_centroid, status);
+            oskar_vis_block_cross_correlations_const(block),
+            weight_ptr, time_centroid, status);
     oskar_mem_free(weight, status);
-    oskar_mem_free(scratch, status);
     oskar_mem_free(time_centroid, status);
     oskar_mem_free(time_slice, status);
 }
@@ -178,6 +138,16 @@ void oskar_imager_update(oskar_Imager* h, size_t num_rows, int start_chan,
         int end_chan, int num_pols, const oskar_Mem* uu, const oskar_Mem* vv,
         const oskar_Mem* ww, const oskar_Mem* amps, const oskar_Mem* weight,
         const oskar_Mem* time_centroid, int* status)
+{
+    update(h, num_rows, start_chan, end_chan, num_pols, 0,
+            uu, vv, ww, amps, weight, time_centroid, status);
+}
+
+
+static void update(oskar_Imager* h, size_t num_rows, int start_chan,
+        int end_chan, int num_pols, int num_baselines, const oskar_Mem* uu,
+        const oskar_Mem* vv, const oskar_Mem* ww, const oskar_Mem* amps,
+        const oskar_Mem* weight, const oskar_Mem* time_centroid, int* status)
 {
     int c, p, plane;
     size_t max_num_vis;
@@ -278,8 +248,8 @@ void oskar_imager_update(oskar_Imager* h, size_t num_rows, int start_chan,
                 pu = h->uu_tmp; pv = h->vv_tmp; pw = h->ww_tmp;
             }
             oskar_imager_select_data(h, num_rows, start_chan, end_chan,
-                    num_pols, u_in, v_in, w_in, amp_in, weight_in,
-                    time_centroid, h->im_freqs[c], p,
+                    num_pols, num_baselines, u_in, v_in, w_in, amp_in,
+                    weight_in, time_centroid, h->im_freqs[c], p,
                     &num_vis, pu, pv, pw, h->vis_im, h->weight_im,
                     h->time_im, status);
 
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2018, The University of Oxford
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the University of Oxford nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "imager/private_grid_tiles.h"
+#include <math.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Number of tiles to aim for, if the kernel support allows it. */
+#define TILES_PER_GRID 64
+
+/* Below this number of visibilities, tiling is not worthwhile. */
+#define MIN_POINTS 256
+
+static int allocate(oskar_GridTiles* tiles, size_t num_points, int grid_size,
+        int max_support, int* tile_height)
+{
+    tiles->start = tiles->indices = tiles->num_skipped = 0;
+    tiles->norm = 0;
+    *tile_height = (grid_size + TILES_PER_GRID - 1) / TILES_PER_GRID;
+    if (*tile_height < 2 * max_support + 1)
+        *tile_height = 2 * max_support + 1;
+    tiles->num_tiles = (grid_size + *tile_height - 1) / *tile_height;
+    if (tiles->num_tiles < 2 || num_points < MIN_POINTS)
+        return 0;
+    tiles->start = (size_t*) calloc(tiles->num_tiles + 1, sizeof(size_t));
+    tiles->indices = (size_t*) malloc(num_points * sizeof(size_t));
+    tiles->num_skipped = (size_t*) calloc(tiles->num_tiles, sizeof(size_t));
+    tiles->norm = (double*) calloc(tiles->num_tiles, sizeof(double));
+    if (!tiles->start || !tiles->indices || !tiles->num_skipped ||
+            !tiles->norm)
+    {
+        oskar_grid_tiles_free(tiles, 0, 0);
+        return 0;
+    }
+    return tiles->num_tiles;
+}
+
+/* Stable counting sort of visibility indices by tile. */
+static void sort(oskar_GridTiles* tiles, size_t num_points, int* tile)
+{
+    int t;
+    size_t i;
+    for (i = 0; i < num_points; ++i)
+        tiles->start[tile[i] + 1]++;
+    for (t = 0; t < tiles->num_tiles; ++t)
+        tiles->start[t + 1] += tiles->start[t];
+    for (i = 0; i < num_points; ++i)
+        tiles->indices[tiles->start[tile[i]]++] = i;
+    for (t = tiles->num_tiles; t > 0; --t)
+        tiles->start[t] = tiles->start[t - 1];
+    tiles->start[0] = 0;
+}
+
+int oskar_grid_tiles_create_d(oskar_GridTiles* tiles, size_t num_points,
+        const double* vv, double cell_size_rad, int grid_size,
+        int max_support)
+{
+    size_t i;
+    int tile_height, *tile;
+    const int grid_centre = grid_size / 2;
+    const double grid_scale = grid_size * cell_size_rad;
+    if (!allocate(tiles, num_points, grid_size, max_support, &tile_height))
+        return 0;
+    tile = (int*) malloc(num_points * sizeof(int));
+    if (!tile)
+    {
+        oskar_grid_tiles_free(tiles, 0, 0);
+        return 0;
+    }
+    for (i = 0; i < num_points; ++i)
+    {
+        const double pos_v = vv[i] * grid_scale;
+        const int grid_v = (int)round(pos_v) + grid_centre;
+        const int t = grid_v / tile_height;
+        tile[i] = t < 0 ? 0 : (t < tiles->num_tiles ? t : tiles->num_tiles - 1);
+    }
+    sort(tiles, num_points, tile);
+    free(tile);
+    return tiles->num_tiles;
+}
+
+int oskar_grid_tiles_create_f(oskar_GridTiles* tiles, size_t num_points,
+        const float* vv, float cell_size_rad, int grid_size,
+        int max_support)
+{
+    size_t i;
+    int tile_height, *tile;
+    const int grid_centre = grid_size / 2;
+    const float grid_scale = grid_size * cell_size_rad;
+    if (!allocate(tiles, num_points, grid_size, max_support, &tile_height))
+        return 0;
+    tile = (int*) malloc(num_points * sizeof(int));
+    if (!tile)
+    {
+        oskar_grid_tiles_free(tiles, 0, 0);
+        return 0;
+    }
+    for (i = 0; i < num_points; ++i)
+    {
+        const float pos_v = vv[i] * grid_scale;
+        const int grid_v = (int)roundf(pos_v) + grid_centre;
+        const int t = grid_v / tile_height;
+        tile[i] = t < 0 ? 0 : (t < tiles->num_tiles ? t : tiles->num_tiles - 1);
+    }
+    sort(tiles, num_points, tile);
+    free(tile);
+    return tiles->num_tiles;
+}
+
+void oskar_grid_tiles_free(oskar_GridTiles* tiles, size_t* num_skipped,
+        double* norm)
+{
+    int t;
+    if (num_skipped && norm)
+    {
+        for (t = 0; t < tiles->num_tiles; ++t)
+        {
+            *num_skipped += tiles->num_skipped[t];
+            *norm += tiles->norm[t];
+        }
+    }
+    free(tiles->start);
+    free(tiles->indices);
+    free(tiles->num_skipped);
+    free(tiles->norm);
+    tiles->start = tiles->indices = tiles->num_skipped = 0;
+    tiles->norm = 0;
+    tiles->num_tiles = 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
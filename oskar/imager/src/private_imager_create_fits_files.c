@@ -58,9 +58,14 @@ static void write_axis_header(fitsfile* fptr, int axis_id,
 
 void oskar_imager_create_fits_files(oskar_Imager* h, int* status)
 {
-    int i;
+    int i, num_channels;
+    double start_freq_hz;
     if (*status) return;
     if (!h->output_root) return;
+
+    /* The cube covers all channels, even if imaging a channel group. */
+    num_channels = h->chan_snaps ? h->num_sel_freqs : 1;
+    start_freq_hz = h->chan_snaps ? h->sel_freqs[0] : h->im_freqs[0];
     oskar_timer_resume(h->tmr_write);
     for (i = 0; i < h->num_im_pols; ++i)
     {
@@ -68,6 +73,9 @@ void oskar_imager_create_fits_files(oskar_Imager* h, int* status)
         char f[FILENAME_MAX];
         const char *a[] = {"I","Q","U","V"}, *b[] = {"XX","XY","YX","YY"};
 
+        /* Files for earlier channel groups are still open. */
+        if (h->fits_file[i]) continue;
+
         /* Construct filename based on image type. */
         switch (h->im_type)
         {
@@ -100,8 +108,8 @@ void oskar_imager_create_fits_files(oskar_Imager* h, int* status)
 
         fov_deg[0] = fov_deg[1] = h->fov_deg;
         h->fits_file[i] = create_fits_file(f, h->imager_prec, h->image_size,
-                h->image_size, h->num_im_channels, h->im_centre_deg, fov_deg,
-                h->im_freqs[0], h->freq_inc_hz, status);
+                h->image_size, num_channels, h->im_centre_deg, fov_deg,
+                start_freq_hz, h->freq_inc_hz, status);
         h->output_name[i] = (char*) realloc(h->output_name[i], 1 + strlen(f));
         strcpy(h->output_name[i], f);
     }
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2018, The University of Oxford
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the University of Oxford nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "imager/private_imager.h"
+#include "imager/private_imager_free_planes.h"
+
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void oskar_imager_free_planes(oskar_Imager* h, int* status)
+{
+    int i;
+
+    /* Free the image planes. */
+    if (h->planes)
+        for (i = 0; i < h->num_planes; ++i)
+            oskar_mem_free(h->planes[i], status);
+    free(h->planes);
+    h->planes = 0;
+    free(h->plane_norm);
+    h->plane_norm = 0;
+
+    /* Free the weights grids if they exist. */
+    if (h->weights_grids)
+        for (i = 0; i < h->num_planes; ++i)
+            oskar_mem_free(h->weights_grids[i], status);
+    free(h->weights_grids);
+    h->weights_grids = 0;
+
+    /* Clear the number of image planes. */
+    free(h->im_freqs);
+    h->im_freqs = 0;
+    h->num_im_channels = 0;
+    h->num_planes = 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2017, The University of Oxford
+ * Copyright (c) 2016-2018, The University of Oxford
  * All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
@@ -26,10 +26,6 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
-#ifdef OSKAR_HAVE_CUDA
-#include <cufft.h>
-#endif
-
 #include "imager/private_imager.h"
 #include "imager/oskar_imager.h"
 
@@ -38,15 +34,32 @@
 #include "imager/private_imager_init_wproj.h"
 #include "imager/oskar_grid_functions_spheroidal.h"
 #include "math/oskar_cmath.h"
-#include "math/oskar_fftpack_cfft.h"
-#include "math/oskar_fftpack_cfft_f.h"
+#include "math/oskar_fft.h"
 #include "utility/oskar_get_memory_usage.h"
 #include "utility/oskar_device_utils.h"
+#include "utility/oskar_dir.h"
+#include "utility/oskar_file_exists.h"
+#include "binary/oskar_binary.h"
+#include "binary/oskar_crc.h"
+#include "mem/oskar_binary_read_mem.h"
+#include "mem/oskar_binary_write_mem.h"
+#include "log/oskar_log.h"
 
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef OSKAR_OS_WIN
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -56,6 +69,9 @@ extern "C" {
 
 #define SAVE_KERNELS 0
 
+/* Tag group used in W-kernel cache files. */
+#define CACHE_GROUP "W_KERNEL_CACHE"
+
 #if SAVE_KERNELS
 #include <fitsio.h>
 
@@ -100,6 +116,13 @@ static void compact_kernels(const int num_w_planes, const int* support,
         const int oversample, const int conv_size_half,
         const oskar_Mem* kernels_in, oskar_Mem* kernels_out,
         int* compacted_kernel_start, int* status);
+static double store_kernel(const oskar_Mem* screen, int iw, int conv_size,
+        int conv_size_half, oskar_Mem* kernels);
+static char* cache_file_name(const char* dir, const char* key);
+static int load_kernels(oskar_Imager* h, const char* filename,
+        const char* key);
+static void save_kernels(const oskar_Imager* h, const char* filename,
+        const char* key, int* status);
 
 /*
  * W-kernel generation is based on CASA implementation
@@ -112,13 +135,8 @@ void oskar_imager_init_wproj(oskar_Imager* h, int* status)
     int conv_size, conv_size_half, inner, nearest;
     double l_max, max_conv_size, max_uvw, max_val, sampling, sum;
     double *maxes;
-#ifdef OSKAR_HAVE_CUDA
-    cufftHandle cufft_plan = 0;
-#endif
-    oskar_Mem *screen = 0, *screen_gpu = 0, *screen_ptr = 0;
     oskar_Mem *taper = 0, *taper_gpu = 0, *taper_ptr = 0;
-    oskar_Mem *wsave = 0, *work = 0;
-    char *ptr_out, *ptr_in, *fname = 0;
+    char key[256], *cache_file = 0, *fname = 0;
     if (*status) return;
 
     /* Get GCF padding oversample factor and imager precision. */
@@ -156,6 +174,29 @@ void oskar_imager_init_wproj(oskar_Imager* h, int* status)
     conv_size_half = conv_size / 2 - 1;
     h->conv_size_half = conv_size_half;
 
+    /* Get size of inner region of kernel and padded grid size. */
+    inner = conv_size / oversample;
+    l_max = sin(0.5 * h->fov_deg * M_PI/180.0);
+    sampling = (2.0 * l_max * oversample) / h->image_size;
+    sampling *= ((double) oskar_imager_plane_size(h)) / ((double) conv_size);
+
+    /* Load the kernels from the cache, if there is a matching file.
+     * The key contains every parameter used to generate the kernels. */
+    if (h->w_kernel_cache_dir)
+    {
+        sprintf(key, "prec=%d oversample=%d num_w_planes=%d conv_size=%d "
+                "inner=%d sampling=%.17g w_scale=%.17g", prec, oversample,
+                h->num_w_planes, conv_size, inner, sampling, h->w_scale);
+        cache_file = cache_file_name(h->w_kernel_cache_dir, key);
+        if (load_kernels(h, cache_file, key))
+        {
+            oskar_log_message(h->log, 'M', 0,
+                    "Loaded W-kernels from '%s'", cache_file);
+            free(cache_file);
+            return;
+        }
+    }
+
     /* Allocate kernels and support array. */
     oskar_mem_free(h->w_kernels, status);
     oskar_mem_free(h->w_support, status);
@@ -172,44 +213,10 @@ void oskar_imager_init_wproj(oskar_Imager* h, int* status)
             0, status);
     supp = oskar_mem_int(h->w_support, status);
     element_size = oskar_mem_element_size(oskar_mem_type(h->w_kernels));
-    if (*status) return;
-
-    /* Get size of inner region of kernel and padded grid size. */
-    inner = conv_size / oversample;
-    l_max = sin(0.5 * h->fov_deg * M_PI/180.0);
-    sampling = (2.0 * l_max * oversample) / h->image_size;
-    sampling *= ((double) oskar_imager_plane_size(h)) / ((double) conv_size);
-
-    /* Create scratch arrays and FFT plan for the phase screens. */
-    screen = oskar_mem_create(prec | OSKAR_COMPLEX,
-            OSKAR_CPU, conv_size * conv_size, status);
-    screen_ptr = screen;
-#ifdef OSKAR_HAVE_CUDA
-    if (h->generate_w_kernels_on_gpu && h->num_gpus > 0)
-    {
-        oskar_device_set(h->gpu_ids[0], status);
-        screen_gpu = oskar_mem_create(prec | OSKAR_COMPLEX,
-                OSKAR_GPU, conv_size * conv_size, status);
-        screen_ptr = screen_gpu;
-        if (prec == OSKAR_DOUBLE)
-            cufftPlan2d(&cufft_plan, conv_size, conv_size, CUFFT_Z2Z);
-        else
-            cufftPlan2d(&cufft_plan, conv_size, conv_size, CUFFT_C2C);
-    }
-    else
-#endif
+    if (*status)
     {
-        int len_save = 4 * conv_size +
-                2 * (int)(log((double)conv_size) / log(2.0)) + 8;
-        wsave = oskar_mem_create(prec, OSKAR_CPU, len_save, status);
-        work = oskar_mem_create(prec, OSKAR_CPU,
-                2 * conv_size * conv_size, status);
-        if (prec == OSKAR_DOUBLE)
-            oskar_fftpack_cfft2i(conv_size, conv_size,
-                    oskar_mem_double(wsave, status));
-        else
-            oskar_fftpack_cfft2i_f(conv_size, conv_size,
-                    oskar_mem_float(wsave, status));
+        free(cache_file);
+        return;
     }
 
     /* Generate 1D spheroidal tapering function to cover the inner region. */
@@ -244,86 +251,105 @@ void oskar_imager_init_wproj(oskar_Imager* h, int* status)
 #endif
 
     /* Evaluate kernels. */
-    ptr_in   = oskar_mem_char(screen);
-    copy_len = element_size * conv_size_half;
     maxes = (double*) calloc(h->num_w_planes, sizeof(double));
-    for (iw = 0; iw < h->num_w_planes; ++iw)
-    {
-        size_t in = 0, out = 0, offset;
-
-        /* Generate the tapered phase screen. */
-        oskar_imager_generate_w_phase_screen(iw, conv_size, inner, sampling,
-                h->w_scale, taper_ptr, screen_ptr, status);
-        if (*status) break;
-
-        /* Perform the FFT to get the kernel. No shifts are required. */
 #ifdef OSKAR_HAVE_CUDA
-        if (h->generate_w_kernels_on_gpu && h->num_gpus > 0)
+    if (h->generate_w_kernels_on_gpu && h->num_gpus > 0)
+    {
+        oskar_FFT* fft;
+        oskar_Mem *screen, *screen_gpu;
+        screen = oskar_mem_create(prec | OSKAR_COMPLEX,
+                OSKAR_CPU, conv_size * conv_size, status);
+        screen_gpu = oskar_mem_create(prec | OSKAR_COMPLEX,
+                OSKAR_GPU, conv_size * conv_size, status);
+        fft = oskar_fft_create(prec, OSKAR_GPU, conv_size,
+                OSKAR_FFT_DEFAULT, status);
+        for (iw = 0; iw < h->num_w_planes; ++iw)
         {
-            if (oskar_mem_precision(screen) == OSKAR_DOUBLE)
-                cufftExecZ2Z(cufft_plan, oskar_mem_void(screen_ptr),
-                        oskar_mem_void(screen_ptr), CUFFT_FORWARD);
-            else
-                cufftExecC2C(cufft_plan, oskar_mem_void(screen_ptr),
-                        oskar_mem_void(screen_ptr), CUFFT_FORWARD);
-            oskar_mem_copy(screen, screen_ptr, status);
+            /* Generate the tapered phase screen. */
+            oskar_imager_generate_w_phase_screen(iw, conv_size, inner,
+                    sampling, h->w_scale, taper_ptr, screen_gpu, status);
+            if (*status) break;
+
+            /* Perform the FFT to get the kernel. No shifts are required. */
+            oskar_fft_exec(fft, screen_gpu, status);
+            oskar_mem_copy(screen, screen_gpu, status);
+            if (*status) break;
+            maxes[iw] = store_kernel(screen, iw, conv_size, conv_size_half,
+                    h->w_kernels);
         }
-        else
+        oskar_fft_free(fft);
+        oskar_mem_free(screen, status);
+        oskar_mem_free(screen_gpu, status);
+    }
+    else
 #endif
+    {
+        int num_threads = 1;
+        oskar_FFT* fft;
+        fft = oskar_fft_create(prec, OSKAR_CPU, conv_size,
+                h->fft_backend, status);
+#ifdef _OPENMP
         {
-            if (oskar_mem_precision(screen_ptr) == OSKAR_DOUBLE)
-                oskar_fftpack_cfft2f(conv_size, conv_size, conv_size,
-                        oskar_mem_double(screen_ptr, status),
-                        oskar_mem_double(wsave, status),
-                        oskar_mem_double(work, status));
-            else
-                oskar_fftpack_cfft2f_f(conv_size, conv_size, conv_size,
-                        oskar_mem_float(screen_ptr, status),
-                        oskar_mem_float(wsave, status),
-                        oskar_mem_float(work, status));
-        }
-        if (*status) break;
-
-        /* Get the maximum (from the first element). */
-        if (oskar_mem_precision(screen) == OSKAR_DOUBLE)
-        {
-            const double* t = (const double*) oskar_mem_void_const(screen);
-            maxes[iw] = sqrt(t[0]*t[0] + t[1]*t[1]);
-        }
-        else
-        {
-            const float* t = (const float*) oskar_mem_void_const(screen);
-            maxes[iw] = sqrt(t[0]*t[0] + t[1]*t[1]);
+            /* Each thread needs its own screen and FFT work array,
+             * so limit the number of threads by the available memory. */
+            const size_t bytes_per_thread =
+                    2 * element_size * conv_size * conv_size;
+            const size_t max_threads =
+                    oskar_get_free_physical_memory() / 2 / bytes_per_thread;
+            num_threads = MIN(omp_get_max_threads(), h->num_w_planes);
+            if ((size_t) num_threads > max_threads)
+                num_threads = max_threads > 1 ? (int) max_threads : 1;
         }
+#endif
 
-        /* Save only the first quarter of the kernel; the rest is redundant. */
-        offset = iw * conv_size_half * conv_size_half * element_size;
-        ptr_out = oskar_mem_char(h->w_kernels) + offset;
-        for (iy = 0; iy < conv_size_half; ++iy)
+        /* Generate kernels for different W-planes concurrently.
+         * Each FFT then runs in the calling thread only. */
+#pragma omp parallel num_threads(num_threads)
         {
-            memcpy(ptr_out + out, ptr_in + in, copy_len);
-            in += conv_size * element_size;
-            out += copy_len;
+            int thread_status = *status, j;
+            oskar_Mem* screen;
+            screen = oskar_mem_create(prec | OSKAR_COMPLEX,
+                    OSKAR_CPU, conv_size * conv_size, &thread_status);
+#pragma omp for schedule(dynamic, 1)
+            for (j = 0; j < h->num_w_planes; ++j)
+            {
+                if (thread_status) continue;
+
+                /* Generate the tapered phase screen. */
+                oskar_imager_generate_w_phase_screen(j, conv_size, inner,
+                        sampling, h->w_scale, taper_ptr, screen,
+                        &thread_status);
+
+                /* Perform the FFT to get the kernel. No shifts required. */
+                oskar_fft_exec(fft, screen, &thread_status);
+                if (thread_status) continue;
+                maxes[j] = store_kernel(screen, j, conv_size, conv_size_half,
+                        h->w_kernels);
+            }
+            oskar_mem_free(screen, &thread_status);
+            if (thread_status)
+            {
+#pragma omp critical (init_wproj_status)
+                *status = thread_status;
+            }
         }
+        oskar_fft_free(fft);
     }
 
     /* Clean up. */
-#ifdef OSKAR_HAVE_CUDA
-    cufftDestroy(cufft_plan);
-#endif
-    oskar_mem_free(screen, status);
-    oskar_mem_free(screen_gpu, status);
     oskar_mem_free(taper, status);
     oskar_mem_free(taper_gpu, status);
-    oskar_mem_free(wsave, status);
-    oskar_mem_free(work, status);
 
     /* Normalise each plane by the maximum. */
-    if (*status) return;
     max_val = -INT_MAX;
     for (iw = 0; iw < h->num_w_planes; ++iw) max_val = MAX(max_val, maxes[iw]);
-    oskar_mem_scale_real(h->w_kernels, 1.0 / max_val, status);
     free(maxes);
+    if (*status)
+    {
+        free(cache_file);
+        return;
+    }
+    oskar_mem_scale_real(h->w_kernels, 1.0 / max_val, status);
 
     /* Find the support size of each kernel by stepping in from the edge. */
     for (iw = 0; iw < h->num_w_planes; ++iw)
@@ -456,6 +482,201 @@ void oskar_imager_init_wproj(oskar_Imager* h, int* status)
     compact_kernels(h->num_w_planes, supp, oversample, conv_size_half,
             h->w_kernels, h->w_kernels_compact,
             oskar_mem_int(h->w_kernel_start, status), status);
+
+    /* Save the kernels to the cache if required.
+     * Failure to do so is not an error. */
+    if (cache_file && !*status)
+    {
+        int cache_status = 0;
+        save_kernels(h, cache_file, key, &cache_status);
+        if (cache_status)
+            oskar_log_warning(h->log, "Unable to write W-kernel cache "
+                    "file '%s' (error code %d).", cache_file, cache_status);
+        else
+            oskar_log_message(h->log, 'M', 0,
+                    "Saved W-kernels to '%s'", cache_file);
+    }
+    free(cache_file);
+}
+
+static double store_kernel(const oskar_Mem* screen, int iw, int conv_size,
+        int conv_size_half, oskar_Mem* kernels)
+{
+    int iy;
+    double max_val;
+    size_t in = 0, out = 0, element_size, copy_len;
+    const char* ptr_in;
+    char* ptr_out;
+
+    /* Get the maximum (from the first element). */
+    if (oskar_mem_precision(screen) == OSKAR_DOUBLE)
+    {
+        const double* t = (const double*) oskar_mem_void_const(screen);
+        max_val = sqrt(t[0]*t[0] + t[1]*t[1]);
+    }
+    else
+    {
+        const float* t = (const float*) oskar_mem_void_const(screen);
+        max_val = sqrt(t[0]*t[0] + t[1]*t[1]);
+    }
+
+    /* Save only the first quarter of the kernel; the rest is redundant. */
+    element_size = oskar_mem_element_size(oskar_mem_type(screen));
+    copy_len = element_size * conv_size_half;
+    ptr_in = (const char*) oskar_mem_void_const(screen);
+    ptr_out = oskar_mem_char(kernels) +
+            ((size_t) iw) * conv_size_half * conv_size_half * element_size;
+    for (iy = 0; iy < conv_size_half; ++iy)
+    {
+        memcpy(ptr_out + out, ptr_in + in, copy_len);
+        in += conv_size * element_size;
+        out += copy_len;
+    }
+    return max_val;
+}
+
+static char* cache_file_name(const char* dir, const char* key)
+{
+    char name[64];
+    unsigned long crc;
+    oskar_CRC* crc_data;
+    crc_data = oskar_crc_create(OSKAR_CRC_32C);
+    crc = oskar_crc_compute(crc_data, key, strlen(key));
+    oskar_crc_free(crc_data);
+    sprintf(name, "oskar_w_kernels_%08lx.bin", crc);
+    return oskar_dir_get_path(dir, name);
+}
+
+static int load_kernels(oskar_Imager* h, const char* filename,
+        const char* key)
+{
+    int status = 0, conv_size_half = 0, type;
+    size_t i, num_planes, len, compact_len = 0, compact_bytes = 0;
+    oskar_Binary* file;
+    oskar_Mem* stored_key;
+
+    /* Open the file and check the key matches exactly. */
+    if (!oskar_file_exists(filename)) return 0;
+    file = oskar_binary_create(filename, 'r', &status);
+    stored_key = oskar_mem_create(OSKAR_CHAR, OSKAR_CPU, 0, &status);
+    oskar_binary_read_mem_ext(file, stored_key, CACHE_GROUP, "KEY", 0,
+            &status);
+    len = oskar_mem_length(stored_key);
+    if (!status && (len == 0 || oskar_mem_char(stored_key)[len - 1] ||
+            strcmp(oskar_mem_char(stored_key), key)))
+        status = OSKAR_ERR_BINARY_FILE_INVALID;
+    oskar_mem_free(stored_key, &status);
+
+    /* Read the kernels. */
+    type = h->imager_prec | OSKAR_COMPLEX;
+    num_planes = (size_t) h->num_w_planes;
+    oskar_mem_free(h->w_kernels, &status);
+    oskar_mem_free(h->w_support, &status);
+    oskar_mem_free(h->w_kernels_compact, &status);
+    oskar_mem_free(h->w_kernel_start, &status);
+    h->w_support = oskar_mem_create(OSKAR_INT, OSKAR_CPU, 0, &status);
+    h->w_kernel_start = oskar_mem_create(OSKAR_INT, OSKAR_CPU, 0, &status);
+    h->w_kernels = oskar_mem_create(type, OSKAR_CPU, 0, &status);
+    h->w_kernels_compact = oskar_mem_create(type, OSKAR_CPU, 0, &status);
+    oskar_binary_read_ext_int(file, CACHE_GROUP, "CONV_SIZE_HALF", 0,
+            &conv_size_half, &status);
+    oskar_binary_read_mem_ext(file, h->w_support, CACHE_GROUP,
+            "SUPPORT", 0, &status);
+    oskar_binary_read_mem_ext(file, h->w_kernel_start, CACHE_GROUP,
+            "KERNEL_START", 0, &status);
+    if (!status && (oskar_mem_length(h->w_support) != num_planes ||
+            oskar_mem_length(h->w_kernel_start) != num_planes))
+        status = OSKAR_ERR_BINARY_FILE_INVALID;
+
+    /* Check the compacted kernel starts and length match the support
+     * sizes, before reading the compacted kernels. */
+    if (!status)
+    {
+        const int* supp = oskar_mem_int_const(h->w_support, &status);
+        const int* start = oskar_mem_int_const(h->w_kernel_start, &status);
+        for (i = 0; i < num_planes; ++i)
+        {
+            size_t size;
+            if (supp[i] < 0 || supp[i] > conv_size_half ||
+                    (size_t) start[i] != compact_len)
+            {
+                status = OSKAR_ERR_BINARY_FILE_INVALID;
+                break;
+            }
+            size = (size_t) (h->oversample / 2) +
+                    (size_t) supp[i] * (size_t) h->oversample + 1;
+            compact_len += size * size;
+        }
+        oskar_binary_query_ext(file, (unsigned char) type, CACHE_GROUP,
+                "KERNELS_COMPACT", 0, &compact_bytes, &status);
+        if (!status && compact_bytes !=
+                compact_len * oskar_mem_element_size(type))
+            status = OSKAR_ERR_BINARY_FILE_INVALID;
+    }
+    oskar_binary_read_mem_ext(file, h->w_kernels, CACHE_GROUP,
+            "KERNELS", 0, &status);
+    oskar_binary_read_mem_ext(file, h->w_kernels_compact, CACHE_GROUP,
+            "KERNELS_COMPACT", 0, &status);
+    oskar_binary_free(file);
+    if (!status && (conv_size_half <= 0 ||
+            oskar_mem_length(h->w_kernels) != num_planes *
+            (size_t) conv_size_half * (size_t) conv_size_half ||
+            oskar_mem_length(h->w_kernels_compact) != compact_len))
+        status = OSKAR_ERR_BINARY_FILE_INVALID;
+    if (status)
+    {
+        oskar_log_warning(h->log, "Ignoring invalid W-kernel cache "
+                "file '%s' (error code %d).", filename, status);
+        return 0;
+    }
+    h->conv_size_half = conv_size_half;
+    return 1;
+}
+
+static void save_kernels(const oskar_Imager* h, const char* filename,
+        const char* key, int* status)
+{
+    char* temp_name;
+    unsigned long pid;
+    oskar_Binary* file;
+    if (*status) return;
+
+    /* Write to a temporary file first, so that a partially written
+     * file is never found by another process. */
+    if (!oskar_dir_exists(h->w_kernel_cache_dir) &&
+            !oskar_dir_mkpath(h->w_kernel_cache_dir))
+    {
+        *status = OSKAR_ERR_BINARY_OPEN_FAIL;
+        return;
+    }
+    /* The temporary name is unique to this process and imager, so that
+     * processes sharing the cache directory do not write the same file. */
+#ifdef OSKAR_OS_WIN
+    pid = (unsigned long) GetCurrentProcessId();
+#else
+    pid = (unsigned long) getpid();
+#endif
+    temp_name = (char*) calloc(strlen(filename) + 48, 1);
+    sprintf(temp_name, "%s.%lu.%lx.tmp", filename, pid,
+            (unsigned long) (size_t) h);
+    file = oskar_binary_create(temp_name, 'w', status);
+    oskar_binary_write_ext(file, OSKAR_CHAR, CACHE_GROUP, "KEY", 0,
+            strlen(key) + 1, key, status);
+    oskar_binary_write_ext_int(file, CACHE_GROUP, "CONV_SIZE_HALF", 0,
+            h->conv_size_half, status);
+    oskar_binary_write_mem_ext(file, h->w_support, CACHE_GROUP,
+            "SUPPORT", 0, 0, status);
+    oskar_binary_write_mem_ext(file, h->w_kernel_start, CACHE_GROUP,
+            "KERNEL_START", 0, 0, status);
+    oskar_binary_write_mem_ext(file, h->w_kernels, CACHE_GROUP,
+            "KERNELS", 0, 0, status);
+    oskar_binary_write_mem_ext(file, h->w_kernels_compact, CACHE_GROUP,
+            "KERNELS_COMPACT", 0, 0, status);
+    oskar_binary_free(file);
+    if (!*status && rename(temp_name, filename))
+        *status = OSKAR_ERR_BINARY_WRITE_FAIL;
+    if (*status) remove(temp_name);
+    free(temp_name);
 }
 
 static void compact_kernels(const int num_w_planes, const int* support,
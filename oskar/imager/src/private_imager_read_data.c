@@ -35,6 +35,7 @@
 #include "ms/oskar_measurement_set.h"
 #include "vis/oskar_vis_block.h"
 #include "vis/oskar_vis_header.h"
+#include "utility/oskar_thread.h"
 #include "utility/oskar_timer.h"
 
 #include <float.h>
@@ -46,99 +47,158 @@
 extern "C" {
 #endif
 
+/* Number of buffers used to overlap reading with gridding. */
+#define NUM_BUFFERS 2
+
+static void group_channel_range(const oskar_Imager* h, int num_channels,
+        int* start_chan, int* end_chan);
+static int get_stop(oskar_Mutex* mutex, const int* stop);
+static void set_stop(oskar_Mutex* mutex, int* stop);
+
+#ifndef OSKAR_NO_MS
+struct MSBuffer
+{
+    oskar_Mem *uvw, *u, *v, *w, *data, *weight, *time_centroid;
+    size_t block_size;
+};
+typedef struct MSBuffer MSBuffer;
+
+struct MSReader
+{
+    oskar_Imager* h;
+    oskar_MeasurementSet* ms;
+    oskar_Scheduler* scheduler;
+    oskar_Mem* scratch;
+    MSBuffer buf[NUM_BUFFERS];
+    size_t num_rows, num_baselines;
+    int start_chan, num_group_chans, num_blocks, stop;
+    int status[NUM_BUFFERS];
+};
+typedef struct MSReader MSReader;
+
+static void read_ms_block(MSReader* r, size_t start_row, MSBuffer* buf,
+        int* status);
+static void* read_ms_blocks(void* arg);
+#endif
+
+struct VisReader
+{
+    oskar_Imager* h;
+    oskar_Binary* vis_file;
+    oskar_VisHeader* header;
+    oskar_Scheduler* scheduler;
+    oskar_VisBlock* block[NUM_BUFFERS];
+    int use_block[NUM_BUFFERS];
+    int num_blocks, tags_per_block, group_start_chan, group_end_chan;
+    int stop, status[NUM_BUFFERS];
+};
+typedef struct VisReader VisReader;
+
+static void* read_vis_blocks(void* arg);
+
 void oskar_imager_read_data_ms(oskar_Imager* h, const char* filename,
         int i_file, int num_files, int* percent_done, int* percent_next,
         int* status)
 {
 #ifndef OSKAR_NO_MS
-    oskar_MeasurementSet* ms;
-    oskar_Mem *uvw, *u, *v, *w, *data, *weight, *time_centroid;
-    int num_channels, num_pols, num_stations, type;
-    size_t num_baselines, start_row, num_rows;
-    double *uvw_, *u_, *v_, *w_;
+    MSReader r;
+    oskar_Thread* thread;
+    int i, b, num_channels, num_pols, num_stations, type, end_chan;
+    int* num_tasks;
     if (*status) return;
 
     /* Read the header. */
-    ms = oskar_ms_open(filename);
-    if (!ms)
+    memset(&r, 0, sizeof(MSReader));
+    r.h = h;
+    r.ms = oskar_ms_open(filename);
+    if (!r.ms)
     {
         *status = OSKAR_ERR_FILE_IO;
         return;
     }
-    num_rows = (size_t) oskar_ms_num_rows(ms);
-    num_stations = (int) oskar_ms_num_stations(ms);
-    num_baselines = num_stations * (num_stations - 1) / 2;
-    num_pols = (int) oskar_ms_num_pols(ms);
-    num_channels = (int) oskar_ms_num_channels(ms);
+    r.num_rows = (size_t) oskar_ms_num_rows(r.ms);
+    num_stations = (int) oskar_ms_num_stations(r.ms);
+    r.num_baselines = num_stations * (num_stations - 1) / 2;
+    num_pols = (int) oskar_ms_num_pols(r.ms);
+    num_channels = (int) oskar_ms_num_channels(r.ms);
 
     /* Set visibility meta-data. */
     oskar_imager_set_vis_frequency(h,
-            oskar_ms_freq_start_hz(ms),
-            oskar_ms_freq_inc_hz(ms), num_channels);
+            oskar_ms_freq_start_hz(r.ms),
+            oskar_ms_freq_inc_hz(r.ms), num_channels);
     oskar_imager_set_vis_phase_centre(h,
-            oskar_ms_phase_centre_ra_rad(ms) * 180/M_PI,
-            oskar_ms_phase_centre_dec_rad(ms) * 180/M_PI);
-
-    /* Create arrays. */
-    uvw = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU, 3 * num_baselines, status);
-    u = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU, num_baselines, status);
-    v = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU, num_baselines, status);
-    w = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU, num_baselines, status);
-    weight = oskar_mem_create(OSKAR_SINGLE, OSKAR_CPU,
-            num_baselines * num_pols, status);
-    time_centroid = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU, num_baselines,
-            status);
-    uvw_ = oskar_mem_double(uvw, status);
-    u_ = oskar_mem_double(u, status);
-    v_ = oskar_mem_double(v, status);
-    w_ = oskar_mem_double(w, status);
+            oskar_ms_phase_centre_ra_rad(r.ms) * 180/M_PI,
+            oskar_ms_phase_centre_dec_rad(r.ms) * 180/M_PI);
+
+    /* Create arrays, with one set for each buffer. */
     type = OSKAR_SINGLE | OSKAR_COMPLEX;
     if (num_pols == 4) type |= OSKAR_MATRIX;
-    data = oskar_mem_create(type, OSKAR_CPU,
-            num_baselines * num_channels, status);
+    for (i = 0; i < NUM_BUFFERS; ++i)
+    {
+        MSBuffer* buf = &r.buf[i];
+        buf->uvw = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU,
+                3 * r.num_baselines, status);
+        buf->u = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU,
+                r.num_baselines, status);
+        buf->v = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU,
+                r.num_baselines, status);
+        buf->w = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU,
+                r.num_baselines, status);
+        buf->weight = oskar_mem_create(OSKAR_SINGLE, OSKAR_CPU,
+                r.num_baselines * num_pols, status);
+        buf->time_centroid = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU,
+                r.num_baselines, status);
+        buf->data = oskar_mem_create(type, OSKAR_CPU,
+                r.num_baselines * num_channels, status);
+    }
+
+    /* Get the channels needed for the current channel group. */
+    group_channel_range(h, num_channels, &r.start_chan, &end_chan);
+    r.num_group_chans = 1 + end_chan - r.start_chan;
+    if (r.num_group_chans < 1)
+        r.num_rows = 0; /* Nothing in this file is needed for the group. */
+    else if (r.num_group_chans != num_channels)
+        r.scratch = oskar_mem_create(type, OSKAR_CPU,
+                r.num_baselines * r.num_group_chans, status);
+    if (!*status && r.num_baselines > 0)
+        r.num_blocks = (int) ((r.num_rows + r.num_baselines - 1) /
+                r.num_baselines);
+
+    /* Start the reader thread.
+     * Blocks are read into alternate buffers by the reader thread,
+     * so that reading the next block overlaps with gridding this one.
+     * The reader waits before reusing a buffer until it has been
+     * released here. */
+    num_tasks = (int*) calloc(r.num_blocks + 1, sizeof(int));
+    r.scheduler = oskar_scheduler_create();
+    oskar_scheduler_reset(r.scheduler, 1, r.num_blocks, num_tasks);
+    free(num_tasks);
+    thread = oskar_thread_create(read_ms_blocks, (void*)&r, 0);
 
     /* Loop over visibility blocks. */
-    for (start_row = 0; start_row < num_rows; start_row += num_baselines)
+    for (b = 0; b < r.num_blocks; ++b)
     {
-        size_t allocated, required, block_size, i;
-        if (*status) break;
-
-        /* Read rows from Measurement Set. */
-        oskar_timer_resume(h->tmr_read);
-        block_size = num_rows - start_row;
-        if (block_size > num_baselines) block_size = num_baselines;
-        allocated = oskar_mem_length(uvw) *
-                oskar_mem_element_size(oskar_mem_type(uvw));
-        oskar_ms_read_column(ms, "UVW", start_row, block_size,
-                allocated, oskar_mem_void(uvw), &required, status);
-        allocated = oskar_mem_length(weight) *
-                oskar_mem_element_size(oskar_mem_type(weight));
-        oskar_ms_read_column(ms, "WEIGHT", start_row, block_size,
-                allocated, oskar_mem_void(weight), &required, status);
-        allocated = oskar_mem_length(time_centroid) *
-                oskar_mem_element_size(oskar_mem_type(time_centroid));
-        oskar_ms_read_column(ms, "TIME_CENTROID", start_row, block_size,
-                allocated, oskar_mem_void(time_centroid), &required, status);
-        allocated = oskar_mem_length(data) *
-                oskar_mem_element_size(oskar_mem_type(data));
-        oskar_ms_read_column(ms, h->ms_column, start_row, block_size,
-                allocated, oskar_mem_void(data), &required, status);
-        if (*status) break;
-
-        /* Split up baseline coordinates. */
-        for (i = 0; i < block_size; ++i)
+        const int i_buf = b % NUM_BUFFERS;
+        MSBuffer* buf = &r.buf[i_buf];
+
+        /* Wait for the block to be read. */
+        oskar_scheduler_wait_finished(r.scheduler, b);
+        if (!*status && r.status[i_buf]) *status = r.status[i_buf];
+        if (*status)
         {
-            u_[i] = uvw_[3*i + 0];
-            v_[i] = uvw_[3*i + 1];
-            w_[i] = uvw_[3*i + 2];
+            set_stop(h->mutex, &r.stop);
+            oskar_scheduler_release_block(r.scheduler, r.num_blocks - 1);
+            break;
         }
 
         /* Update the imager with the data. */
-        oskar_timer_pause(h->tmr_read);
-        oskar_imager_update(h, block_size, 0, num_channels - 1, num_pols,
-                u, v, w, data, weight, time_centroid, status);
+        oskar_imager_update(h, buf->block_size, r.start_chan, end_chan,
+                num_pols, buf->u, buf->v, buf->w, buf->data, buf->weight,
+                buf->time_centroid, status);
+        oskar_scheduler_release_block(r.scheduler, b);
         *percent_done = (int) round(100.0 * (
-                (start_row + block_size) / (double)(num_rows * num_files) +
+                (b * r.num_baselines + buf->block_size) /
+                (double)(r.num_rows * num_files) +
                 i_file / (double)num_files));
         if (h->log && percent_next && *percent_done >= *percent_next)
         {
@@ -146,14 +206,22 @@ void oskar_imager_read_data_ms(oskar_Imager* h, const char* filename,
             *percent_next = 10 + 10 * (*percent_done / 10);
         }
     }
-    oskar_mem_free(uvw, status);
-    oskar_mem_free(u, status);
-    oskar_mem_free(v, status);
-    oskar_mem_free(w, status);
-    oskar_mem_free(data, status);
-    oskar_mem_free(weight, status);
-    oskar_mem_free(time_centroid, status);
-    oskar_ms_close(ms);
+    oskar_thread_join(thread);
+    oskar_thread_free(thread);
+    oskar_scheduler_free(r.scheduler);
+    for (i = 0; i < NUM_BUFFERS; ++i)
+    {
+        MSBuffer* buf = &r.buf[i];
+        oskar_mem_free(buf->uvw, status);
+        oskar_mem_free(buf->u, status);
+        oskar_mem_free(buf->v, status);
+        oskar_mem_free(buf->w, status);
+        oskar_mem_free(buf->data, status);
+        oskar_mem_free(buf->weight, status);
+        oskar_mem_free(buf->time_centroid, status);
+    }
+    oskar_mem_free(r.scratch, status);
+    oskar_ms_close(r.ms);
 #else
     (void) filename;
     (void) i_file;
@@ -170,131 +238,84 @@ void oskar_imager_read_data_vis(oskar_Imager* h, const char* filename,
         int i_file, int num_files, int* percent_done, int* percent_next,
         int* status)
 {
-    oskar_Binary* vis_file;
-    oskar_VisBlock* block;
-    oskar_VisHeader* header;
-    oskar_Mem *weight, *time_centroid, *time_slice, *scratch = 0, *ptr;
-    int max_times_per_block, tags_per_block, i_block, num_blocks;
-    int num_times_tot, num_channels_tot, num_stations, num_baselines, num_pols;
-    double time_start_mjd, time_inc_sec;
+    VisReader r;
+    oskar_Thread* thread;
+    int i, i_block, max_times_per_block, num_times_tot, num_channels_tot;
+    int* num_tasks;
     if (*status) return;
 
     /* Read the header. */
-    vis_file = oskar_binary_create(filename, 'r', status);
-    header = oskar_vis_header_read(vis_file, status);
+    memset(&r, 0, sizeof(VisReader));
+    r.h = h;
+    r.vis_file = oskar_binary_create(filename, 'r', status);
+    r.header = oskar_vis_header_read(r.vis_file, status);
     if (*status)
     {
-        oskar_vis_header_free(header, status);
-        oskar_binary_free(vis_file);
+        oskar_vis_header_free(r.header, status);
+        oskar_binary_free(r.vis_file);
         return;
     }
-    max_times_per_block = oskar_vis_header_max_times_per_block(header);
-    tags_per_block = oskar_vis_header_num_tags_per_block(header);
-    num_times_tot = oskar_vis_header_num_times_total(header);
-    num_channels_tot = oskar_vis_header_num_channels_total(header);
-    num_stations = oskar_vis_header_num_stations(header);
-    num_baselines = num_stations * (num_stations - 1) / 2;
-    num_pols = oskar_type_is_matrix(oskar_vis_header_amp_type(header)) ? 4 : 1;
-    num_blocks = (num_times_tot + max_times_per_block - 1) /
+    max_times_per_block = oskar_vis_header_max_times_per_block(r.header);
+    r.tags_per_block = oskar_vis_header_num_tags_per_block(r.header);
+    num_times_tot = oskar_vis_header_num_times_total(r.header);
+    num_channels_tot = oskar_vis_header_num_channels_total(r.header);
+    r.num_blocks = (num_times_tot + max_times_per_block - 1) /
             max_times_per_block;
-    time_start_mjd = oskar_vis_header_time_start_mjd_utc(header) * 86400.0;
-    time_inc_sec = oskar_vis_header_time_inc_sec(header);
 
     /* Set visibility meta-data. */
     oskar_imager_set_vis_frequency(h,
-            oskar_vis_header_freq_start_hz(header),
-            oskar_vis_header_freq_inc_hz(header), num_channels_tot);
+            oskar_vis_header_freq_start_hz(r.header),
+            oskar_vis_header_freq_inc_hz(r.header), num_channels_tot);
     oskar_imager_set_vis_phase_centre(h,
-            oskar_vis_header_phase_centre_ra_deg(header),
-            oskar_vis_header_phase_centre_dec_deg(header));
-
-    /* Create scratch arrays. Weights are all 1. */
-    time_centroid = oskar_mem_create(OSKAR_DOUBLE,
-            OSKAR_CPU, num_baselines * max_times_per_block, status);
-    time_slice = oskar_mem_create_alias(0, 0, 0, status);
-    weight = oskar_mem_create(h->imager_prec,
-            OSKAR_CPU, num_baselines * num_pols * max_times_per_block, status);
-    oskar_mem_set_value_real(weight, 1.0, 0, 0, status);
-    if (num_channels_tot > 1)
-        scratch = oskar_mem_create(oskar_vis_header_amp_type(header), OSKAR_CPU,
-                num_baselines * num_channels_tot * max_times_per_block, status);
+            oskar_vis_header_phase_centre_ra_deg(r.header),
+            oskar_vis_header_phase_centre_dec_deg(r.header));
+    group_channel_range(h, num_channels_tot,
+            &r.group_start_chan, &r.group_end_chan);
+
+    /* Start the reader thread.
+     * Blocks are read into alternate buffers by the reader thread,
+     * so that reading the next block overlaps with gridding this one.
+     * The reader waits before reusing a buffer until it has been
+     * released here. */
+    for (i = 0; i < NUM_BUFFERS; ++i)
+        r.block[i] = oskar_vis_block_create_from_header(OSKAR_CPU,
+                r.header, status);
+    if (*status) r.num_blocks = 0;
+    num_tasks = (int*) calloc(r.num_blocks + 1, sizeof(int));
+    r.scheduler = oskar_scheduler_create();
+    oskar_scheduler_reset(r.scheduler, 1, r.num_blocks, num_tasks);
+    free(num_tasks);
+    thread = oskar_thread_create(read_vis_blocks, (void*)&r, 0);
 
     /* Loop over visibility blocks. */
-    block = oskar_vis_block_create_from_header(OSKAR_CPU, header, status);
-    for (i_block = 0; i_block < num_blocks; ++i_block)
+    for (i_block = 0; i_block < r.num_blocks; ++i_block)
     {
-        int t, num_times, num_channels, start_time, start_chan, end_chan;
-        size_t num_rows;
-        if (*status) break;
-
-        /* Read the visibility data. */
-        oskar_timer_resume(h->tmr_read);
-        oskar_binary_set_query_search_start(vis_file,
-                i_block * tags_per_block, status);
-        oskar_vis_block_read(block, header, vis_file, i_block, status);
-        start_time   = oskar_vis_block_start_time_index(block);
-        start_chan   = oskar_vis_block_start_channel_index(block);
-        num_times    = oskar_vis_block_num_times(block);
-        num_channels = oskar_vis_block_num_channels(block);
-        num_rows     = num_times * num_baselines;
-        end_chan     = start_chan + num_channels - 1;
-
-        /* Fill in the time centroid values. */
-        for (t = 0; t < num_times; ++t)
+        const int i_buf = i_block % NUM_BUFFERS;
+
+        /* Wait for the block to be read. */
+        oskar_scheduler_wait_finished(r.scheduler, i_block);
+        if (!*status && r.status[i_buf]) *status = r.status[i_buf];
+        if (*status)
         {
-            oskar_mem_set_alias(time_slice, time_centroid,
-                    t * num_baselines, num_baselines, status);
-            oskar_mem_set_value_real(time_slice,
-                    time_start_mjd + (start_time + t + 0.5) * time_inc_sec,
-                    0, num_baselines, status);
+            set_stop(h->mutex, &r.stop);
+            oskar_scheduler_release_block(r.scheduler, r.num_blocks - 1);
+            break;
         }
 
-        /* Swap baseline and channel dimensions. */
-        ptr = oskar_vis_block_cross_correlations(block);
-#define SWAP_LOOP \
-        for (t = 0; t < num_times; ++t)                                  \
-            for (c = 0; c < num_channels; ++c)                           \
-                for (b = 0; b < num_baselines; ++b)                      \
-                    for (p = 0; p < num_pols; ++p)                       \
-                    {                                                    \
-                        k = (num_pols * (num_baselines *                 \
-                                (num_channels * t + c) + b) + p) << 1;   \
-                        l = (num_pols * (num_channels *                  \
-                                (num_baselines * t + b) + c) + p) << 1;  \
-                        out[l] = in[k];                                  \
-                        out[l + 1] = in[k + 1];                          \
-                    }
-        if (num_channels != 1)
+        /* Skip the block if it has no channels in the current group. */
+        if (!r.use_block[i_buf])
         {
-            int b, c, p;
-            size_t k, l;
-            if (oskar_mem_precision(ptr) == OSKAR_SINGLE)
-            {
-                float *in, *out;
-                in  = oskar_mem_float(ptr, status);
-                out = oskar_mem_float(scratch, status);
-                SWAP_LOOP
-            }
-            else
-            {
-                double *in, *out;
-                in  = oskar_mem_double(ptr, status);
-                out = oskar_mem_double(scratch, status);
-                SWAP_LOOP
-            }
-            ptr = scratch;
+            oskar_scheduler_release_block(r.scheduler, i_block);
+            continue;
         }
-#undef SWAP_LOOP
 
-        /* Update the imager with the data. */
-        oskar_timer_pause(h->tmr_read);
-        oskar_imager_update(h, num_rows, start_chan, end_chan, num_pols,
-                oskar_vis_block_baseline_uu_metres(block),
-                oskar_vis_block_baseline_vv_metres(block),
-                oskar_vis_block_baseline_ww_metres(block),
-                ptr, weight, time_centroid, status);
+        /* Update the imager with the data.
+         * The block is used as it is, without swapping its baseline
+         * and channel dimensions. */
+        oskar_imager_update_from_block(h, r.header, r.block[i_buf], status);
+        oskar_scheduler_release_block(r.scheduler, i_block);
         *percent_done = (int) round(100.0 * (
-                (i_block + 1) / (double)(num_blocks * num_files) +
+                (i_block + 1) / (double)(r.num_blocks * num_files) +
                 i_file / (double)num_files));
         if (h->log && percent_next && *percent_done >= *percent_next)
         {
@@ -302,13 +323,188 @@ void oskar_imager_read_data_vis(oskar_Imager* h, const char* filename,
             *percent_next = 10 + 10 * (*percent_done / 10);
         }
     }
-    oskar_mem_free(scratch, status);
-    oskar_mem_free(weight, status);
-    oskar_mem_free(time_centroid, status);
-    oskar_mem_free(time_slice, status);
-    oskar_vis_block_free(block, status);
-    oskar_vis_header_free(header, status);
-    oskar_binary_free(vis_file);
+    oskar_thread_join(thread);
+    oskar_thread_free(thread);
+    oskar_scheduler_free(r.scheduler);
+    for (i = 0; i < NUM_BUFFERS; ++i)
+        oskar_vis_block_free(r.block[i], status);
+    oskar_vis_header_free(r.header, status);
+    oskar_binary_free(r.vis_file);
+}
+
+
+#ifndef OSKAR_NO_MS
+static void read_ms_block(MSReader* r, size_t start_row, MSBuffer* buf,
+        int* status)
+{
+    size_t allocated, required, block_size, i;
+    double *uvw_, *u_, *v_, *w_;
+    if (*status) return;
+
+    /* Read rows from Measurement Set. */
+    block_size = r->num_rows - start_row;
+    if (block_size > r->num_baselines) block_size = r->num_baselines;
+    buf->block_size = block_size;
+    allocated = oskar_mem_length(buf->uvw) *
+            oskar_mem_element_size(oskar_mem_type(buf->uvw));
+    oskar_ms_read_column(r->ms, "UVW", start_row, block_size,
+            allocated, oskar_mem_void(buf->uvw), &required, status);
+    allocated = oskar_mem_length(buf->weight) *
+            oskar_mem_element_size(oskar_mem_type(buf->weight));
+    oskar_ms_read_column(r->ms, "WEIGHT", start_row, block_size,
+            allocated, oskar_mem_void(buf->weight), &required, status);
+    allocated = oskar_mem_length(buf->time_centroid) *
+            oskar_mem_element_size(oskar_mem_type(buf->time_centroid));
+    oskar_ms_read_column(r->ms, "TIME_CENTROID", start_row, block_size,
+            allocated, oskar_mem_void(buf->time_centroid), &required, status);
+    if (!r->scratch)
+    {
+        allocated = oskar_mem_length(buf->data) *
+                oskar_mem_element_size(oskar_mem_type(buf->data));
+        oskar_ms_read_column(r->ms, r->h->ms_column, start_row, block_size,
+                allocated, oskar_mem_void(buf->data), &required, status);
+    }
+    else
+    {
+        /* Read only the channels in the group, and swap the
+         * channel and baseline dimensions back again. */
+        oskar_ms_read_vis_f(r->ms, start_row, r->start_chan,
+                r->num_group_chans, block_size, r->h->ms_column,
+                oskar_mem_float(r->scratch, status), status);
+        oskar_mem_transpose(r->scratch, buf->data, 1, r->num_group_chans,
+                block_size, 1, status);
+    }
+    if (*status) return;
+
+    /* Split up baseline coordinates. */
+    uvw_ = oskar_mem_double(buf->uvw, status);
+    u_ = oskar_mem_double(buf->u, status);
+    v_ = oskar_mem_double(buf->v, status);
+    w_ = oskar_mem_double(buf->w, status);
+    for (i = 0; i < block_size; ++i)
+    {
+        u_[i] = uvw_[3*i + 0];
+        v_[i] = uvw_[3*i + 1];
+        w_[i] = uvw_[3*i + 2];
+    }
+}
+
+
+static void* read_ms_blocks(void* arg)
+{
+    MSReader* r = (MSReader*) arg;
+    int b, status = 0;
+    for (b = 0; b < r->num_blocks; ++b)
+    {
+        const int i_buf = b % NUM_BUFFERS;
+
+        /* The buffer for this block was last used two blocks ago. */
+        oskar_scheduler_wait_released(r->scheduler, b - NUM_BUFFERS);
+        if (!status && !get_stop(r->h->mutex, &r->stop))
+        {
+            oskar_timer_resume(r->h->tmr_read);
+            read_ms_block(r, (size_t)b * r->num_baselines,
+                    &r->buf[i_buf], &status);
+            oskar_timer_pause(r->h->tmr_read);
+        }
+        r->status[i_buf] = status;
+        oskar_scheduler_finish_block(r->scheduler, b);
+    }
+    /* Release memory handles cached by this thread. */
+    oskar_mem_pool_clear();
+    return 0;
+}
+#endif
+
+
+static void* read_vis_blocks(void* arg)
+{
+    VisReader* r = (VisReader*) arg;
+    int i_block, status = 0;
+    for (i_block = 0; i_block < r->num_blocks; ++i_block)
+    {
+        int start_chan, end_chan, dim_start_and_size[6];
+        const int i_buf = i_block % NUM_BUFFERS;
+
+        /* The buffer for this block was last used two blocks ago. */
+        oskar_scheduler_wait_released(r->scheduler, i_block - NUM_BUFFERS);
+        r->use_block[i_buf] = 0;
+        r->status[i_buf] = status;
+        if (status || get_stop(r->h->mutex, &r->stop))
+        {
+            oskar_scheduler_finish_block(r->scheduler, i_block);
+            continue;
+        }
+
+        /* Skip the block if it has no channels in the current group. */
+        oskar_timer_resume(r->h->tmr_read);
+        oskar_binary_set_query_search_start(r->vis_file,
+                i_block * r->tags_per_block, &status);
+        oskar_binary_read(r->vis_file, OSKAR_INT,
+                OSKAR_TAG_GROUP_VIS_BLOCK,
+                OSKAR_VIS_BLOCK_TAG_DIM_START_AND_SIZE, i_block,
+                sizeof(dim_start_and_size), dim_start_and_size, &status);
+        start_chan = dim_start_and_size[1];
+        end_chan = start_chan + dim_start_and_size[3] - 1;
+        if (!status && start_chan <= r->group_end_chan &&
+                end_chan >= r->group_start_chan)
+        {
+            /* Map the visibility data, to avoid copying it. */
+            oskar_vis_block_map(r->block[i_buf], r->header, r->vis_file,
+                    i_block, 1, &status);
+            r->use_block[i_buf] = 1;
+        }
+        oskar_timer_pause(r->h->tmr_read);
+        r->status[i_buf] = status;
+        oskar_scheduler_finish_block(r->scheduler, i_block);
+    }
+    /* Release memory handles cached by this thread. */
+    oskar_mem_pool_clear();
+    return 0;
+}
+
+
+static int get_stop(oskar_Mutex* mutex, const int* stop)
+{
+    int value;
+    oskar_mutex_lock(mutex);
+    value = *stop;
+    oskar_mutex_unlock(mutex);
+    return value;
+}
+
+
+static void set_stop(oskar_Mutex* mutex, int* stop)
+{
+    oskar_mutex_lock(mutex);
+    *stop = 1;
+    oskar_mutex_unlock(mutex);
+}
+
+
+static void group_channel_range(const oskar_Imager* h, int num_channels,
+        int* start_chan, int* end_chan)
+{
+    const double df = h->freq_inc_hz != 0.0 ? h->freq_inc_hz : 1.0;
+    const double f0 = h->vis_freq_start_hz;
+    double f_first, f_last;
+    *start_chan = 0;
+    *end_chan = num_channels - 1;
+    if (!h->chan_snaps || h->chan_group_size <= 0) return;
+
+    /* Find the visibility channels that match the channel group. */
+    f_first = h->sel_freqs[h->chan_group_start];
+    f_last = h->sel_freqs[h->chan_group_start + h->chan_group_size - 1];
+    *start_chan = (int) round((f_first - f0) / df);
+    *end_chan = (int) round((f_last - f0) / df);
+    if (*start_chan > *end_chan)
+    {
+        int t = *start_chan;
+        *start_chan = *end_chan;
+        *end_chan = t;
+    }
+    if (*start_chan < 0) *start_chan = 0;
+    if (*end_chan > num_channels - 1) *end_chan = num_channels - 1;
 }
 
 #ifdef __cplusplus
@@ -40,9 +40,9 @@ extern "C" {
 
 static
 void copy_vis_pol(size_t num_rows, int num_channels, int num_pols,
-        int c, int p, const oskar_Mem* vis_in, const oskar_Mem* weight_in,
-        oskar_Mem* vis_out, oskar_Mem* weight_out, size_t out_offset,
-        int* status);
+        int num_baselines, int c, int p, const oskar_Mem* vis_in,
+        const oskar_Mem* weight_in, oskar_Mem* vis_out, oskar_Mem* weight_out,
+        size_t out_offset, int* status);
 
 void oskar_imager_select_data(
         const oskar_Imager* h,
@@ -50,6 +50,7 @@ void oskar_imager_select_data(
         int start_chan,
         int end_chan,
         int num_pols,
+        int num_baselines,
         const oskar_Mem* uu_in,
         const oskar_Mem* vv_in,
         const oskar_Mem* ww_in,
@@ -103,7 +104,7 @@ void oskar_imager_select_data(
         oskar_mem_scale_real(ww_out, inv_wavelength, status);
 
         /* Copy visibility data and weights if present. */
-        copy_vis_pol(num_rows, num_channels, num_pols,
+        copy_vis_pol(num_rows, num_channels, num_pols, num_baselines,
                 c - start_chan, p, vis_in, weight_in,
                 vis_out, weight_out, 0, status);
 
@@ -141,7 +142,7 @@ void oskar_imager_select_data(
             oskar_mem_scale_real(ww_, inv_wavelength, status);
 
             /* Copy visibility data and weights if present. */
-            copy_vis_pol(num_rows, num_channels, num_pols,
+            copy_vis_pol(num_rows, num_channels, num_pols, num_baselines,
                     c - start_chan, p, vis_in, weight_in,
                     vis_out, weight_out, *num_out, status);
 
@@ -164,12 +165,37 @@ void oskar_imager_select_data(
 
 
 void copy_vis_pol(size_t num_rows, int num_channels, int num_pols,
-        int c, int p, const oskar_Mem* vis_in, const oskar_Mem* weight_in,
-        oskar_Mem* vis_out, oskar_Mem* weight_out, size_t out_offset,
-        int* status)
+        int num_baselines, int c, int p, const oskar_Mem* vis_in,
+        const oskar_Mem* weight_in, oskar_Mem* vis_out, oskar_Mem* weight_out,
+        size_t out_offset, int* status)
 {
-    size_t r;
+    size_t b, r, t, offset, rows_per_time, row_stride, time_stride;
     if (*status) return;
+
+    /* Get the strides through the input visibility data,
+     * so that data can be selected without reordering it first. */
+    if (num_baselines > 0)
+    {
+        rows_per_time = num_baselines;
+        row_stride = num_pols;
+        time_stride = (size_t) num_pols * num_channels * num_baselines;
+        offset = (size_t) num_pols * num_baselines * c + p;
+    }
+    else
+    {
+        rows_per_time = num_rows;
+        row_stride = (size_t) num_pols * num_channels;
+        time_stride = 0;
+        offset = (size_t) num_pols * c + p;
+    }
+
+#define COPY_VIS \
+        for (r = 0, t = 0; r < num_rows; ++t)                            \
+        {                                                                \
+            const size_t start = t * time_stride + offset;               \
+            for (b = 0; b < rows_per_time && r < num_rows; ++b, ++r)     \
+                v_out[r] = v_in[start + b * row_stride];                 \
+        }
     if (oskar_mem_precision(vis_out) == OSKAR_SINGLE)
     {
         float* w_out;
@@ -185,8 +211,7 @@ void copy_vis_pol(size_t num_rows, int num_channels, int num_pols,
             const float2* v_in;
             v_out = oskar_mem_float2(vis_out, status) + out_offset;
             v_in = oskar_mem_float2_const(vis_in, status);
-            for (r = 0; r < num_rows; ++r)
-                v_out[r] = v_in[num_pols * (num_channels * r + c) + p];
+            COPY_VIS
         }
     }
     else
@@ -204,10 +229,10 @@ void copy_vis_pol(size_t num_rows, int num_channels, int num_pols,
             const double2* v_in;
             v_out = oskar_mem_double2(vis_out, status) + out_offset;
             v_in = oskar_mem_double2_const(vis_in, status);
-            for (r = 0; r < num_rows; ++r)
-                v_out[r] = v_in[num_pols * (num_channels * r + c) + p];
+            COPY_VIS
         }
     }
+#undef COPY_VIS
 }
 
 
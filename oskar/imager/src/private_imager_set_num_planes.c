@@ -45,14 +45,17 @@ void oskar_imager_set_num_planes(oskar_Imager* h, int* status)
         return;
     }
 
-    /* Set image meta-data. */
+    /* Set image meta-data.
+     * If imaging a channel group, use only the channels in the group. */
     h->num_im_channels = h->chan_snaps ? h->num_sel_freqs : 1;
+    if (h->chan_snaps && h->chan_group_size > 0)
+        h->num_im_channels = h->chan_group_size;
     h->im_freqs = (double*) realloc(h->im_freqs,
             h->num_im_channels * sizeof(double));
     if (h->chan_snaps)
     {
-        for (i = 0; i < h->num_sel_freqs; ++i)
-            h->im_freqs[i] = h->sel_freqs[i];
+        for (i = 0; i < h->num_im_channels; ++i)
+            h->im_freqs[i] = h->sel_freqs[h->chan_group_start + i];
     }
     else
     {
@@ -218,6 +218,8 @@ static void* run_blocks(void* arg)
         oskar_mem_add(t, t, d->block_cpu, block_size, status);
     }
     oskar_mem_free(t, status);
+    /* Release memory handles cached by this thread. */
+    oskar_mem_pool_clear();
     return 0;
 }
 
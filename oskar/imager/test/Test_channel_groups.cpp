@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2018, The University of Oxford
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the University of Oxford nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "binary/oskar_binary.h"
+#include "imager/oskar_imager.h"
+#include "math/oskar_cmath.h"
+#include "mem/oskar_mem.h"
+#include "utility/oskar_get_error_string.h"
+#include "vis/oskar_vis_block.h"
+#include "vis/oskar_vis_header.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+static const int num_stations = 6, num_channels = 12, num_times = 4;
+static const double freq_start_hz = 100e6, freq_inc_hz = 1e6;
+
+static void write_vis(const char* filename, int* status)
+{
+    // Two blocks, each of two time samples.
+    const int num_baselines = num_stations * (num_stations - 1) / 2;
+    const int max_times_per_block = 2;
+    const double l0 = 0.004, m0 = -0.002;
+    oskar_VisHeader* hdr = oskar_vis_header_create(OSKAR_SINGLE_COMPLEX,
+            OSKAR_SINGLE, max_times_per_block, num_times, num_channels,
+            num_channels, num_stations, 0, 1, status);
+    oskar_vis_header_set_phase_centre(hdr, 0, 10.0, -30.0);
+    oskar_vis_header_set_freq_start_hz(hdr, freq_start_hz);
+    oskar_vis_header_set_freq_inc_hz(hdr, freq_inc_hz);
+    oskar_vis_header_set_time_start_mjd_utc(hdr, 57000.5);
+    oskar_vis_header_set_time_inc_sec(hdr, 60.0);
+    oskar_VisBlock* blk = oskar_vis_block_create_from_header(OSKAR_CPU,
+            hdr, status);
+    oskar_Binary* file = oskar_vis_header_write(hdr, filename, status);
+    for (int b = 0; b < num_times / max_times_per_block; ++b)
+    {
+        oskar_vis_block_set_start_time_index(blk, b * max_times_per_block);
+        float2* amp = oskar_mem_float2(
+                oskar_vis_block_cross_correlations(blk), status);
+        float* uu = oskar_mem_float(
+                oskar_vis_block_baseline_uu_metres(blk), status);
+        float* vv = oskar_mem_float(
+                oskar_vis_block_baseline_vv_metres(blk), status);
+        float* ww = oskar_mem_float(
+                oskar_vis_block_baseline_ww_metres(blk), status);
+        if (*status) break;
+        for (int t = 0, i = 0; t < max_times_per_block; ++t)
+        {
+            const double angle = 0.05 * (b * max_times_per_block + t);
+            for (int s1 = 0; s1 < num_stations; ++s1)
+            {
+                for (int s2 = s1 + 1; s2 < num_stations; ++s2, ++i)
+                {
+                    const double x = 60.0 * (s2 - s1) + 12.0 * s1 * s1;
+                    const double y = 30.0 * (s2 * s2 - s1) - 15.0 * s1;
+                    uu[i] = (float) (x * cos(angle) - y * sin(angle));
+                    vv[i] = (float) (x * sin(angle) + y * cos(angle));
+                    ww[i] = (float) (0.1 * (s2 - s1));
+                }
+            }
+        }
+        for (int t = 0, i = 0; t < max_times_per_block; ++t)
+        {
+            for (int c = 0; c < num_channels; ++c)
+            {
+                const double wavenumber = 2.0 * M_PI *
+                        (freq_start_hz + c * freq_inc_hz) / 299792458.0;
+                for (int j = 0; j < num_baselines; ++j, ++i)
+                {
+                    const int k = t * num_baselines + j;
+                    const double phase = wavenumber *
+                            (uu[k] * l0 + vv[k] * m0);
+                    amp[i].x = (float) ((1.0 + 0.1 * c) * cos(phase));
+                    amp[i].y = (float) ((1.0 + 0.1 * c) * sin(phase));
+                }
+            }
+        }
+        oskar_vis_block_write(blk, file, b, status);
+    }
+    oskar_binary_free(file);
+    oskar_vis_block_free(blk, status);
+    oskar_vis_header_free(hdr, status);
+}
+
+static void make_cube(const char* vis_file, const char* root,
+        const char* weighting, double max_plane_memory_mb, int* status)
+{
+    // Select channels 2 to 10, so the cube does not start at channel 0.
+    oskar_Imager* im = oskar_imager_create(OSKAR_SINGLE, status);
+    oskar_imager_set_fov(im, 2.0);
+    oskar_imager_set_size(im, 64, status);
+    oskar_imager_set_weighting(im, weighting, status);
+    oskar_imager_set_channel_snapshots(im, 1);
+    oskar_imager_set_freq_min_hz(im, freq_start_hz + 1.5 * freq_inc_hz);
+    oskar_imager_set_freq_max_hz(im, freq_start_hz + 10.5 * freq_inc_hz);
+    oskar_imager_set_max_plane_memory_mb(im, max_plane_memory_mb);
+    oskar_imager_set_input_files(im, 1, &vis_file, status);
+    oskar_imager_set_output_root(im, root);
+    oskar_imager_run(im, 0, 0, 0, 0, status);
+    oskar_imager_free(im, status);
+}
+
+TEST(imager, channel_groups)
+{
+    const char* vis_file = "temp_test_imager_channel_groups.vis";
+    const char* weightings[] = {"Natural", "Uniform"};
+    int status = 0;
+    write_vis(vis_file, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+    for (int w = 0; w < 2; ++w)
+    {
+        // Image the whole cube at once, and in groups of at most 4
+        // channels (each channel needs 32 kB for its FFT plane,
+        // and 16 kB for its grid of weights if using uniform weighting).
+        make_cube(vis_file, "temp_test_cube_all", weightings[w], 0.0,
+                &status);
+        ASSERT_EQ(0, status) << oskar_get_error_string(status);
+        make_cube(vis_file, "temp_test_cube_groups", weightings[w],
+                w == 0 ? 0.13 : 0.19, &status);
+        ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+        // Compare the planes.
+        for (int c = 0; c < 9; ++c)
+        {
+            int size[2];
+            char* units = 0;
+            double crval[2], crpix[2], cellsize, time, freq[2], beam_area;
+            oskar_Mem* a = oskar_mem_read_fits_image_plane(
+                    "temp_test_cube_all_I.fits", 0, c, 0, size, crval, crpix,
+                    &cellsize, &time, &freq[0], &beam_area, &units, &status);
+            free(units);
+            units = 0;
+            oskar_Mem* b = oskar_mem_read_fits_image_plane(
+                    "temp_test_cube_groups_I.fits", 0, c, 0, size, crval,
+                    crpix, &cellsize, &time, &freq[1], &beam_area, &units,
+                    &status);
+            free(units);
+            ASSERT_EQ(0, status) << oskar_get_error_string(status);
+            EXPECT_DOUBLE_EQ(freq_start_hz + (c + 2) * freq_inc_hz, freq[0]);
+            EXPECT_DOUBLE_EQ(freq[0], freq[1]);
+            double max_val = 0.0, max_diff = 0.0;
+            const int num_pixels = size[0] * size[1];
+            const float* p_a = oskar_mem_float_const(a, &status);
+            const float* p_b = oskar_mem_float_const(b, &status);
+            for (int i = 0; i < num_pixels; ++i)
+            {
+                const double diff = fabs(p_a[i] - p_b[i]);
+                if (fabs(p_a[i]) > max_val) max_val = fabs(p_a[i]);
+                if (diff > max_diff) max_diff = diff;
+            }
+
+            // The source flux increases with channel index.
+            EXPECT_NEAR(1.0 + 0.1 * (c + 2), max_val, 0.15);
+            EXPECT_LE(max_diff, 1e-5 * max_val) << weightings[w] <<
+                    " weighting, plane " << c;
+            oskar_mem_free(a, &status);
+            oskar_mem_free(b, &status);
+        }
+    }
+    remove(vis_file);
+    remove("temp_test_cube_all_I.fits");
+    remove("temp_test_cube_groups_I.fits");
+}
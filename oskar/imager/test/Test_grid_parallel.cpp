@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2018, The University of Oxford
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the University of Oxford nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "imager/oskar_grid_simple.h"
+#include "imager/oskar_grid_wproj.h"
+#include "utility/test/oskar_omp_test_utils.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+using std::vector;
+
+static const int grid_size = 512;
+static const double cell_size_rad = 4e-5;
+
+static void make_vis(int num_vis, vector<double>& uu, vector<double>& vv,
+        vector<double>& ww, vector<double>& vis, vector<double>& weight)
+{
+    uu.resize(num_vis); vv.resize(num_vis); ww.resize(num_vis);
+    vis.resize(2 * num_vis); weight.resize(num_vis);
+    srand(1);
+    for (int i = 0; i < num_vis; ++i)
+    {
+        // Concentrate points near the centre, with some off the grid.
+        double r = 15000.0 * pow(rand() / (double)RAND_MAX, 2.0);
+        double a = 2.0 * M_PI * rand() / (double)RAND_MAX;
+        uu[i] = r * cos(a);
+        vv[i] = r * sin(a);
+        ww[i] = 400.0 * (rand() / (double)RAND_MAX - 0.5);
+        vis[2 * i] = rand() / (double)RAND_MAX - 0.5;
+        vis[2 * i + 1] = rand() / (double)RAND_MAX - 0.5;
+        weight[i] = 0.5 + rand() / (double)RAND_MAX;
+    }
+}
+
+static double max_abs_diff(const vector<double>& a, const vector<double>& b)
+{
+    double d = 0.0;
+    for (size_t i = 0; i < a.size(); ++i)
+        if (fabs(a[i] - b[i]) > d) d = fabs(a[i] - b[i]);
+    return d;
+}
+
+TEST(grid_parallel, simple)
+{
+    oskar_OmpNumThreads threads;
+    const int num_vis = 20000;
+    vector<double> uu, vv, ww, vis, weight;
+    make_vis(num_vis, uu, vv, ww, vis, weight);
+    for (int variant = 0; variant < 2; ++variant)
+    {
+        // Default and non-default kernel parameters.
+        const int support = variant ? 5 : 3;
+        const int oversample = variant ? 32 : 100;
+        vector<double> conv((support + 2) * oversample);
+        for (size_t i = 0; i < conv.size(); ++i)
+            conv[i] = exp(-(double)i / oversample);
+
+        vector<double> grid1(2 * grid_size * grid_size, 0.0);
+        vector<double> grid4(grid1), grid_ref(grid1);
+        size_t skipped1 = 0, skipped4 = 0, skipped_ref = 0;
+        double norm1 = 0.0, norm4 = 0.0, norm_ref = 0.0;
+        threads.set(1);
+        oskar_grid_simple_d(support, oversample, &conv[0], num_vis,
+                &uu[0], &vv[0], &vis[0], &weight[0], cell_size_rad,
+                grid_size, &skipped1, &norm1, &grid1[0]);
+        threads.set(4);
+        oskar_grid_simple_d(support, oversample, &conv[0], num_vis,
+                &uu[0], &vv[0], &vis[0], &weight[0], cell_size_rad,
+                grid_size, &skipped4, &norm4, &grid4[0]);
+
+        // Reference: grid one visibility at a time, in order.
+        for (int i = 0; i < num_vis; ++i)
+        {
+            size_t s = 0;
+            oskar_grid_simple_d(support, oversample, &conv[0], 1,
+                    &uu[i], &vv[i], &vis[2 * i], &weight[i], cell_size_rad,
+                    grid_size, &s, &norm_ref, &grid_ref[0]);
+            skipped_ref += s;
+        }
+
+        // Result must not depend on the number of threads.
+        EXPECT_EQ(skipped1, skipped4);
+        EXPECT_EQ(norm1, norm4);
+        EXPECT_EQ(0.0, max_abs_diff(grid1, grid4));
+
+        // Result must match serial gridding.
+        EXPECT_GT(skipped_ref, 0u);
+        EXPECT_LT(skipped_ref, (size_t)num_vis);
+        EXPECT_EQ(skipped_ref, skipped4);
+        EXPECT_NEAR(norm_ref, norm4, 1e-12 * norm_ref);
+        EXPECT_LT(max_abs_diff(grid_ref, grid4), 1e-12);
+    }
+}
+
+TEST(grid_parallel, wproj)
+{
+    oskar_OmpNumThreads threads;
+    const int num_vis = 20000, num_w_planes = 4, oversample = 4;
+    const int support[] = {3, 5, 7, 9};
+    const int conv_size_half = (support[num_w_planes - 1] + 1) * oversample;
+    const double w_scale = 0.05;
+    vector<double> uu, vv, ww, vis, weight;
+    make_vis(num_vis, uu, vv, ww, vis, weight);
+    vector<double> conv(2 * num_w_planes * conv_size_half * conv_size_half);
+    for (size_t i = 0; i < conv.size(); ++i)
+        conv[i] = rand() / (double)RAND_MAX - 0.5;
+
+    vector<double> grid1(2 * grid_size * grid_size, 0.0);
+    vector<double> grid4(grid1), grid_ref(grid1);
+    size_t skipped1 = 0, skipped4 = 0, skipped_ref = 0;
+    double norm1 = 0.0, norm4 = 0.0, norm_ref = 0.0;
+    threads.set(1);
+    oskar_grid_wproj_d(num_w_planes, support, oversample, conv_size_half,
+            &conv[0], num_vis, &uu[0], &vv[0], &ww[0], &vis[0], &weight[0],
+            cell_size_rad, w_scale, grid_size, &skipped1, &norm1, &grid1[0]);
+    threads.set(4);
+    oskar_grid_wproj_d(num_w_planes, support, oversample, conv_size_half,
+            &conv[0], num_vis, &uu[0], &vv[0], &ww[0], &vis[0], &weight[0],
+            cell_size_rad, w_scale, grid_size, &skipped4, &norm4, &grid4[0]);
+    for (int i = 0; i < num_vis; ++i)
+    {
+        size_t s = 0;
+        oskar_grid_wproj_d(num_w_planes, support, oversample, conv_size_half,
+                &conv[0], 1, &uu[i], &vv[i], &ww[i], &vis[2 * i], &weight[i],
+                cell_size_rad, w_scale, grid_size, &s, &norm_ref,
+                &grid_ref[0]);
+        skipped_ref += s;
+    }
+
+    EXPECT_EQ(skipped1, skipped4);
+    EXPECT_EQ(norm1, norm4);
+    EXPECT_EQ(0.0, max_abs_diff(grid1, grid4));
+    EXPECT_EQ(skipped_ref, skipped4);
+    EXPECT_NEAR(norm_ref, norm4, 1e-9 * fabs(norm_ref));
+    EXPECT_LT(max_abs_diff(grid_ref, grid4), 1e-11);
+}
@@ -110,3 +110,83 @@ TEST(imager, grid_sum)
     oskar_mem_free(weight, &status);
     oskar_mem_free(grid, &status);
 }
+
+TEST(imager, fft_backend)
+{
+    int status = 0, type = OSKAR_DOUBLE;
+    int size = 256, grid_size = size * size, num_vis = 1000;
+#ifdef OSKAR_HAVE_FFTW
+    const int num_backends = 3;
+#else
+    const int num_backends = 2;
+#endif
+    const char* backends[] = {"Serial FFTPACK", "FFTPACK", "FFTW"};
+    oskar_Mem* grids[3];
+
+    // Check the setting is stored and validated.
+    oskar_Imager* im = oskar_imager_create(type, &status);
+    EXPECT_STREQ("Auto", oskar_imager_fft_backend(im));
+    oskar_imager_set_fft_backend(im, "FFTPACK", &status);
+    EXPECT_STREQ("FFTPACK", oskar_imager_fft_backend(im));
+    oskar_imager_set_fft_backend(im, "Serial FFTPACK", &status);
+    EXPECT_STREQ("Serial FFTPACK", oskar_imager_fft_backend(im));
+    oskar_imager_set_fft_backend(im, "FFTW", &status);
+#ifdef OSKAR_HAVE_FFTW
+    EXPECT_STREQ("FFTW", oskar_imager_fft_backend(im));
+#else
+    EXPECT_STREQ("Auto", oskar_imager_fft_backend(im));
+#endif
+    EXPECT_EQ(0, status);
+    oskar_imager_set_fft_backend(im, "Unknown", &status);
+    EXPECT_EQ((int)OSKAR_ERR_INVALID_ARGUMENT, status);
+    oskar_imager_free(im, &status);
+    status = 0;
+
+    // Create visibility data.
+    oskar_Mem* uu = oskar_mem_create(type, OSKAR_CPU, num_vis, &status);
+    oskar_Mem* vv = oskar_mem_create(type, OSKAR_CPU, num_vis, &status);
+    oskar_Mem* ww = oskar_mem_create(type, OSKAR_CPU, num_vis, &status);
+    oskar_Mem* vis = oskar_mem_create(type | OSKAR_COMPLEX, OSKAR_CPU, num_vis,
+            &status);
+    oskar_Mem* weight = oskar_mem_create(type, OSKAR_CPU, num_vis, &status);
+    oskar_mem_random_gaussian(uu, 0, 1, 2, 3, 100.0, &status);
+    oskar_mem_random_gaussian(vv, 4, 5, 6, 7, 100.0, &status);
+    oskar_mem_set_value_real(vis, 1.0, 0, num_vis, &status);
+    oskar_mem_set_value_real(weight, 1.0, 0, num_vis, &status);
+
+    // Make the same image using each FFT library.
+    for (int i = 0; i < num_backends; ++i)
+    {
+        double plane_norm = 0.0;
+        im = oskar_imager_create(type, &status);
+        oskar_imager_set_fft_backend(im, backends[i], &status);
+        oskar_imager_set_fov(im, 5.0);
+        oskar_imager_set_size(im, size, &status);
+        grids[i] = oskar_mem_create(type | OSKAR_COMPLEX, OSKAR_CPU,
+                grid_size, &status);
+        oskar_imager_update_plane(im, num_vis, uu, vv, ww, vis, weight,
+                grids[i], &plane_norm, 0, &status);
+        oskar_imager_finalise_plane(im, grids[i], plane_norm, &status);
+        ASSERT_EQ(0, status);
+        EXPECT_STREQ(backends[i], oskar_imager_fft_backend(im));
+        oskar_imager_free(im, &status);
+    }
+
+    // Check the images are consistent with the serial FFTPACK image.
+    const double* a = oskar_mem_double_const(grids[0], &status);
+    for (int j = 1; j < num_backends; ++j)
+    {
+        const double* b = oskar_mem_double_const(grids[j], &status);
+        for (int i = 0; i < grid_size; ++i)
+            ASSERT_NEAR(a[i], b[i], 1e-10) << backends[j];
+    }
+
+    // Clean up.
+    oskar_mem_free(uu, &status);
+    oskar_mem_free(vv, &status);
+    oskar_mem_free(ww, &status);
+    oskar_mem_free(vis, &status);
+    oskar_mem_free(weight, &status);
+    for (int i = 0; i < num_backends; ++i)
+        oskar_mem_free(grids[i], &status);
+}
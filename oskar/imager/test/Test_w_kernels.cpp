@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2018, The University of Oxford
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the University of Oxford nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "imager/oskar_imager.h"
+#include "imager/private_imager.h"
+#include "utility/oskar_dir.h"
+#include "utility/oskar_get_error_string.h"
+#include "binary/oskar_binary.h"
+#include "mem/oskar_binary_read_mem.h"
+#include "mem/oskar_binary_write_mem.h"
+
+#include "utility/test/oskar_omp_test_utils.h"
+
+#include <cstdlib>
+#include <cstring>
+
+static oskar_Imager* create_imager(const char* cache_dir)
+{
+    int status = 0;
+    oskar_Imager* h = oskar_imager_create(OSKAR_DOUBLE, &status);
+    oskar_imager_set_algorithm(h, "W-projection", &status);
+    oskar_imager_set_fov(h, 4.0);
+    oskar_imager_set_size(h, 128, &status);
+    oskar_imager_set_num_w_planes(h, 24);
+    oskar_imager_set_w_kernel_cache_dir(h, cache_dir);
+    EXPECT_EQ(0, status) << oskar_get_error_string(status);
+    return h;
+}
+
+static void check_equal(const oskar_Imager* a, const oskar_Imager* b)
+{
+    int status = 0;
+    ASSERT_EQ(a->conv_size_half, b->conv_size_half);
+    EXPECT_FALSE(oskar_mem_different(a->w_support, b->w_support, 0, &status));
+    EXPECT_FALSE(oskar_mem_different(a->w_kernel_start, b->w_kernel_start, 0,
+            &status));
+    EXPECT_FALSE(oskar_mem_different(a->w_kernels, b->w_kernels, 0, &status));
+    EXPECT_FALSE(oskar_mem_different(a->w_kernels_compact,
+            b->w_kernels_compact, 0, &status));
+    EXPECT_EQ(0, status) << oskar_get_error_string(status);
+}
+
+TEST(w_kernels, parallel_and_cache)
+{
+    int status = 0;
+    const char* cache_dir = "temp_test_w_kernel_cache";
+
+    // Generate kernels using a single thread, without the cache.
+    oskar_OmpNumThreads threads;
+    threads.set(1);
+    oskar_Imager* ref = create_imager(0);
+    oskar_imager_check_init(ref, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    threads.set(threads.original() > 1 ? threads.original() : 4);
+
+    // Generate kernels using multiple threads, and save them to the cache.
+    oskar_dir_remove(cache_dir);
+    oskar_Imager* h = create_imager(cache_dir);
+    oskar_imager_check_init(h, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    check_equal(ref, h);
+    oskar_imager_free(h, &status);
+
+    // Load the kernels from the cache.
+    h = create_imager(cache_dir);
+    oskar_imager_check_init(h, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    check_equal(ref, h);
+    oskar_imager_free(h, &status);
+
+    // Check no temporary files are left in the cache directory.
+    int num_items = 0;
+    char** items = 0;
+    oskar_dir_items(cache_dir, 0, 1, 0, &num_items, &items);
+    ASSERT_EQ(1, num_items);
+    EXPECT_TRUE(strstr(items[0], ".tmp") == 0) << items[0];
+    char* cache_file = oskar_dir_get_path(cache_dir, items[0]);
+    free(items[0]);
+    free(items);
+
+    // Overwrite the cache file with one where the compacted kernels are
+    // too short, and check that it is ignored.
+    oskar_Binary* file = oskar_binary_create(cache_file, 'r', &status);
+    oskar_Mem* key = oskar_mem_create(OSKAR_CHAR, OSKAR_CPU, 0, &status);
+    oskar_binary_read_mem_ext(file, key, "W_KERNEL_CACHE", "KEY", 0, &status);
+    oskar_binary_free(file);
+    file = oskar_binary_create(cache_file, 'w', &status);
+    oskar_binary_write_mem_ext(file, key, "W_KERNEL_CACHE", "KEY", 0, 0,
+            &status);
+    oskar_binary_write_ext_int(file, "W_KERNEL_CACHE", "CONV_SIZE_HALF", 0,
+            ref->conv_size_half, &status);
+    oskar_binary_write_mem_ext(file, ref->w_support, "W_KERNEL_CACHE",
+            "SUPPORT", 0, 0, &status);
+    oskar_binary_write_mem_ext(file, ref->w_kernel_start, "W_KERNEL_CACHE",
+            "KERNEL_START", 0, 0, &status);
+    oskar_binary_write_mem_ext(file, ref->w_kernels, "W_KERNEL_CACHE",
+            "KERNELS", 0, 0, &status);
+    oskar_binary_write_mem_ext(file, ref->w_kernels_compact, "W_KERNEL_CACHE",
+            "KERNELS_COMPACT", 0,
+            oskar_mem_length(ref->w_kernels_compact) / 2, &status);
+    oskar_binary_free(file);
+    oskar_mem_free(key, &status);
+    free(cache_file);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    h = create_imager(cache_dir);
+    oskar_imager_check_init(h, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    check_equal(ref, h);
+    oskar_imager_free(h, &status);
+
+    // Check kernels are regenerated if parameters change.
+    h = create_imager(cache_dir);
+    oskar_imager_set_num_w_planes(h, 20);
+    oskar_imager_check_init(h, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    EXPECT_EQ(20, (int) oskar_mem_length(h->w_support));
+    oskar_imager_free(h, &status);
+    oskar_imager_free(ref, &status);
+    oskar_dir_remove(cache_dir);
+}
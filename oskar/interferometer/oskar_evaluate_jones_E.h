@@ -50,8 +50,10 @@ extern "C" {
  * Evaluates station beams for a telescope model at the specified source
  * positions, storing the results in the Jones matrix data structure.
  *
- * If all stations are marked as identical, the results for the first station
- * are copied into the results for the others.
+ * If station beam duplication is allowed, the beam is evaluated only for the
+ * first station in each class of identical stations (as found by
+ * oskar_telescope_analyse()), and the results are copied into the results
+ * for the other stations in the class.
  *
  * @param[out] E            Output set of Jones matrices.
  * @param[in]  num_points   Number of direction cosines given.
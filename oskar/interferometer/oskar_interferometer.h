@@ -156,6 +156,22 @@ OSKAR_EXPORT
 void oskar_interferometer_set_source_flux_range(oskar_Interferometer* h,
         double min_jy, double max_jy);
 
+OSKAR_EXPORT
+void oskar_interferometer_set_spatially_coherent_chunks(
+        oskar_Interferometer* h, int value);
+
+OSKAR_EXPORT
+void oskar_interferometer_set_station_beam_cache_tolerance(
+        oskar_Interferometer* h, double tolerance_sec, int* status);
+
+OSKAR_EXPORT
+void oskar_interferometer_set_station_beam_cache_max_memory_mb(
+        oskar_Interferometer* h, double value, int* status);
+
+OSKAR_EXPORT
+void oskar_interferometer_set_use_opencl(oskar_Interferometer* h, int value,
+        int* status);
+
 OSKAR_EXPORT
 void oskar_interferometer_set_zero_failed_gaussians(oskar_Interferometer* h,
         int value);
@@ -39,7 +39,7 @@ void oskar_evaluate_jones_E(oskar_Jones* E, int num_points, int coord_type,
         double gast, double frequency_hz, oskar_StationWork* work,
         int time_index, int* status)
 {
-    int i, num_stations;
+    int i, num_stations, num_sources, duplicate, use_scratch;
     oskar_Mem *E_st;
 
     /* Check if safe to proceed. */
@@ -53,47 +53,42 @@ void oskar_evaluate_jones_E(oskar_Jones* E, int num_points, int coord_type,
         return;
     }
 
-    /* Evaluate the station beams. */
-    E_st = oskar_mem_create_alias(0, 0, 0, status);
-    if (oskar_telescope_allow_station_beam_duplication(tel) &&
-            oskar_telescope_identical_stations(tel))
+    /* Evaluate the station beams.
+     * If station beam duplication is allowed, the beam is evaluated only
+     * for the first station in each class of identical stations, and
+     * copied to the others.
+     * OpenCL sub-buffers must be aligned to the device base address, so
+     * for OpenCL memory each beam is evaluated into a scratch buffer and
+     * copied to its offset in the Jones matrix block. */
+    num_sources = oskar_jones_num_sources(E);
+    use_scratch = oskar_jones_mem_location(E) & OSKAR_CL;
+    E_st = use_scratch ?
+            oskar_mem_create(oskar_jones_type(E), oskar_jones_mem_location(E),
+                    num_sources, status) :
+            oskar_mem_create_alias(0, 0, 0, status);
+    duplicate = oskar_telescope_allow_station_beam_duplication(tel);
+    for (i = 0; i < num_stations; ++i)
     {
-        /* Identical stations. */
-        oskar_Mem *E0; /* Pointer to row of E for station 0. */
-        const oskar_Station* station0;
-
-        /* Evaluate the beam pattern for station 0 */
-        E0 = oskar_mem_create_alias(0, 0, 0, status);
-        station0 = oskar_telescope_station_const(tel, 0);
-        oskar_jones_get_station_pointer(E0, E, 0, status);
-
-        oskar_evaluate_station_beam(E0, num_points, coord_type, x, y, z,
-                oskar_telescope_phase_centre_ra_rad(tel),
-                oskar_telescope_phase_centre_dec_rad(tel),
-                station0, work, time_index, frequency_hz, gast, status);
-
-        /* Copy E for station 0 into memory for other stations. */
-        for (i = 1; i < num_stations; ++i)
+        const int i_class = duplicate ?
+                oskar_telescope_station_class(tel, i) : i;
+        if (i_class != i)
         {
-            oskar_jones_get_station_pointer(E_st, E, i, status);
-            oskar_mem_copy_contents(E_st, E0, 0, 0,
-                    oskar_mem_length(E0), status);
+            /* Copy E from the first station in the class. */
+            oskar_mem_copy_contents(oskar_jones_mem(E), oskar_jones_mem(E),
+                    i * num_sources, i_class * num_sources, num_sources,
+                    status);
+            continue;
         }
-        oskar_mem_free(E0, status);
-    }
-    else
-    {
-        /* Different stations. */
-        for (i = 0; i < num_stations; ++i)
-        {
-            const oskar_Station* station;
-            station = oskar_telescope_station_const(tel, i);
+        if (!use_scratch)
             oskar_jones_get_station_pointer(E_st, E, i, status);
-            oskar_evaluate_station_beam(E_st, num_points, coord_type, x, y, z,
-                    oskar_telescope_phase_centre_ra_rad(tel),
-                    oskar_telescope_phase_centre_dec_rad(tel),
-                    station, work, time_index, frequency_hz, gast, status);
-        }
+        oskar_evaluate_station_beam(E_st, num_points, coord_type, x, y, z,
+                oskar_telescope_phase_centre_ra_rad(tel),
+                oskar_telescope_phase_centre_dec_rad(tel),
+                oskar_telescope_station_const(tel, i),
+                work, time_index, frequency_hz, gast, status);
+        if (use_scratch)
+            oskar_mem_copy_contents(oskar_jones_mem(E), E_st,
+                    i * num_sources, 0, num_sources, status);
     }
     oskar_mem_free(E_st, status);
 }
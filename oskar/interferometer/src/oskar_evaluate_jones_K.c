@@ -29,7 +29,9 @@
 #include "interferometer/oskar_evaluate_jones_K.h"
 #include "interferometer/oskar_evaluate_jones_K_cuda.h"
 #include "utility/oskar_device_utils.h"
+#include "utility/oskar_cl_utils.h"
 #include "math/oskar_cmath.h"
+#include "math/oskar_sincos_inline.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -57,30 +59,21 @@ void oskar_evaluate_jones_K_f(float2* jones, int num_sources, const float* l,
         ws = wavenumber * w[a];
 
         /* Loop over sources. */
+        #pragma omp simd
         for (s = 0; s < num_sources; ++s)
         {
-            float phase;
-            float2 weight;
+            float phase, re, im;
 
-            /* Calculate the source phase. */
-            if (source_filter[s] > source_filter_min &&
-                    source_filter[s] <= source_filter_max)
-            {
-                phase = us * l[s] + vs * m[s] + ws * (n[s] - 1.0f);
-                /* Double precision versions are converted to sincos() by the
-                 * compiler, so they're faster and more accurate
-                 * than sinf(), cosf(). */
-                weight.x = cos(phase);
-                weight.y = sin(phase);
-            }
-            else
-            {
-                weight.x = 0.0f;
-                weight.y = 0.0f;
-            }
+            /* Calculate the source phase, and zero it if filtered out. */
+            phase = us * l[s] + vs * m[s] + ws * (n[s] - 1.0f);
+            oskar_sincos_f(phase, &im, &re);
+            if (!(source_filter[s] > source_filter_min &&
+                    source_filter[s] <= source_filter_max))
+                re = im = 0.0f;
 
             /* Store the result. */
-            station_ptr[s] = weight;
+            station_ptr[s].x = re;
+            station_ptr[s].y = im;
         }
     }
 }
@@ -107,27 +100,21 @@ void oskar_evaluate_jones_K_d(double2* jones, int num_sources, const double* l,
         ws = wavenumber * w[a];
 
         /* Loop over sources. */
+        #pragma omp simd
         for (s = 0; s < num_sources; ++s)
         {
-            double phase;
-            double2 weight;
+            double phase, re, im;
 
-            /* Calculate the source phase. */
-            if (source_filter[s] > source_filter_min &&
-                    source_filter[s] <= source_filter_max)
-            {
-                phase = us * l[s] + vs * m[s] + ws * (n[s] - 1.0);
-                weight.x = cos(phase);
-                weight.y = sin(phase);
-            }
-            else
-            {
-                weight.x = 0.0;
-                weight.y = 0.0;
-            }
+            /* Calculate the source phase, and zero it if filtered out. */
+            phase = us * l[s] + vs * m[s] + ws * (n[s] - 1.0);
+            oskar_sincos_d(phase, &im, &re);
+            if (!(source_filter[s] > source_filter_min &&
+                    source_filter[s] <= source_filter_max))
+                re = im = 0.0;
 
             /* Store the result. */
-            station_ptr[s] = weight;
+            station_ptr[s].x = re;
+            station_ptr[s].y = im;
         }
     }
 }
@@ -250,6 +237,84 @@ void oskar_evaluate_jones_K(oskar_Jones* K, int num_sources,
                     source_filter_min, source_filter_max);
         }
     }
+    else if (location & OSKAR_CL)
+    {
+#ifdef OSKAR_HAVE_OPENCL
+        cl_kernel k = 0;
+        cl_int error, num, num_st;
+        cl_uint i, arg = 0;
+        size_t global_size, local_size;
+        double par[3];
+        if (jones_type == OSKAR_SINGLE_COMPLEX)
+            k = oskar_cl_kernel("evaluate_jones_K_float");
+        else if (jones_type == OSKAR_DOUBLE_COMPLEX)
+            k = oskar_cl_kernel("evaluate_jones_K_double");
+        else
+        {
+            *status = OSKAR_ERR_BAD_DATA_TYPE;
+            return;
+        }
+        if (!k)
+        {
+            *status = OSKAR_ERR_FUNCTION_NOT_AVAILABLE;
+            return;
+        }
+
+        /* Set kernel arguments. */
+        num_st = (cl_int) num_stations;
+        num = (cl_int) num_sources;
+        error = clSetKernelArg(k, arg++, sizeof(cl_int), &num);
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer_const(l, status));
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer_const(m, status));
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer_const(n, status));
+        error |= clSetKernelArg(k, arg++, sizeof(cl_int), &num_st);
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer_const(u, status));
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer_const(v, status));
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer_const(w, status));
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer_const(source_filter, status));
+        par[0] = wavenumber;
+        par[1] = source_filter_min;
+        par[2] = source_filter_max;
+        for (i = 0; i < 3; ++i)
+        {
+            if (base_type == OSKAR_DOUBLE)
+            {
+                const cl_double t = (cl_double) par[i];
+                error |= clSetKernelArg(k, arg++, sizeof(cl_double), &t);
+            }
+            else
+            {
+                const cl_float t = (cl_float) par[i];
+                error |= clSetKernelArg(k, arg++, sizeof(cl_float), &t);
+            }
+        }
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer(oskar_jones_mem(K), status));
+        if (*status) return;
+        if (error != CL_SUCCESS)
+        {
+            *status = OSKAR_ERR_INVALID_ARGUMENT;
+            return;
+        }
+
+        /* Launch kernel on current command queue. */
+        local_size = oskar_cl_is_gpu() ? 256 : 128;
+        global_size = ((num + local_size - 1) / local_size) * local_size;
+        error = clEnqueueNDRangeKernel(oskar_cl_command_queue(), k, 1, NULL,
+                &global_size, &local_size, 0, NULL, NULL);
+        if (error != CL_SUCCESS)
+            *status = OSKAR_ERR_KERNEL_LAUNCH_FAILURE;
+#else
+        *status = OSKAR_ERR_OPENCL_NOT_AVAILABLE;
+#endif
+    }
 }
 
 #ifdef __cplusplus
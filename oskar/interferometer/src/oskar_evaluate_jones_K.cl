@@ -0,0 +1,32 @@
+/* Copyright (c) 2018, The University of Oxford. See LICENSE file. */
+
+kernel void evaluate_jones_K_REAL(const int num_sources,
+        global const REAL* restrict l, global const REAL* restrict m,
+        global const REAL* restrict n, const int num_stations,
+        global const REAL* restrict u, global const REAL* restrict v,
+        global const REAL* restrict w,
+        global const REAL* restrict source_filter, const REAL wavenumber,
+        const REAL source_filter_min, const REAL source_filter_max,
+        global REAL2* restrict jones)
+{
+    REAL re, im;
+    const int s = get_global_id(0); /* Source index. */
+    if (s >= num_sources) return;
+    const REAL l_ = l[s], m_ = m[s], n_ = n[s] - (REAL) 1;
+    const REAL f = source_filter[s];
+    const int use = (f > source_filter_min && f <= source_filter_max);
+
+    /* Loop over stations. */
+    for (int a = 0; a < num_stations; ++a)
+    {
+        if (use)
+        {
+            const REAL phase = (wavenumber * u[a]) * l_ +
+                    (wavenumber * v[a]) * m_ + (wavenumber * w[a]) * n_;
+            im = sincos(phase, &re);
+        }
+        else
+            re = im = (REAL) 0;
+        jones[a * num_sources + s] = (REAL2)(re, im);
+    }
+}
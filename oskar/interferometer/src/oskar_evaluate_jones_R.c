@@ -33,6 +33,7 @@
 #include "interferometer/oskar_evaluate_jones_R_cuda.h"
 #include "sky/oskar_parallactic_angle.h"
 #include "utility/oskar_device_utils.h"
+#include "utility/oskar_cl_utils.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -231,20 +232,90 @@ void oskar_evaluate_jones_R(oskar_Jones* R, int num_sources,
             }
         }
     }
+    else if (location & OSKAR_CL)
+    {
+#ifdef OSKAR_HAVE_OPENCL
+        cl_kernel k = 0;
+        cl_int error, num, offset;
+        size_t global_size, local_size;
+        if (base_type == OSKAR_DOUBLE)
+            k = oskar_cl_kernel("evaluate_jones_R_double");
+        else
+            k = oskar_cl_kernel("evaluate_jones_R_float");
+        if (!k)
+        {
+            *status = OSKAR_ERR_FUNCTION_NOT_AVAILABLE;
+            oskar_mem_free(R_station, status);
+            return;
+        }
+        num = (cl_int) num_sources;
+        local_size = oskar_cl_is_gpu() ? 256 : 128;
+        global_size = ((num + local_size - 1) / local_size) * local_size;
+        for (i = 0; i < n; ++i)
+        {
+            const oskar_Station* station;
+            cl_uint arg = 0;
+
+            /* Get station data. */
+            station = oskar_telescope_station_const(telescope, i);
+            latitude = oskar_station_lat_rad(station);
+            lst = gast + oskar_station_lon_rad(station);
+
+            /* Set kernel arguments.
+             * The output is addressed by offset rather than by alias, as
+             * OpenCL sub-buffers must be aligned. */
+            offset = (cl_int) (i * oskar_jones_num_sources(R));
+            error = clSetKernelArg(k, arg++, sizeof(cl_int), &num);
+            error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                    oskar_mem_cl_buffer_const(ra_rad, status));
+            error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                    oskar_mem_cl_buffer_const(dec_rad, status));
+            if (base_type == OSKAR_DOUBLE)
+            {
+                const cl_double par[] = {cos(latitude), sin(latitude), lst};
+                error |= clSetKernelArg(k, arg++, sizeof(cl_double), &par[0]);
+                error |= clSetKernelArg(k, arg++, sizeof(cl_double), &par[1]);
+                error |= clSetKernelArg(k, arg++, sizeof(cl_double), &par[2]);
+            }
+            else
+            {
+                const cl_float par[] = {(cl_float) cos(latitude),
+                        (cl_float) sin(latitude), (cl_float) lst};
+                error |= clSetKernelArg(k, arg++, sizeof(cl_float), &par[0]);
+                error |= clSetKernelArg(k, arg++, sizeof(cl_float), &par[1]);
+                error |= clSetKernelArg(k, arg++, sizeof(cl_float), &par[2]);
+            }
+            error |= clSetKernelArg(k, arg++, sizeof(cl_int), &offset);
+            error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                    oskar_mem_cl_buffer(oskar_jones_mem(R), status));
+            if (*status) break;
+            if (error != CL_SUCCESS)
+            {
+                *status = OSKAR_ERR_INVALID_ARGUMENT;
+                break;
+            }
+
+            /* Launch kernel on current command queue. */
+            error = clEnqueueNDRangeKernel(oskar_cl_command_queue(), k, 1,
+                    NULL, &global_size, &local_size, 0, NULL, NULL);
+            if (error != CL_SUCCESS)
+            {
+                *status = OSKAR_ERR_KERNEL_LAUNCH_FAILURE;
+                break;
+            }
+        }
+#else
+        *status = OSKAR_ERR_OPENCL_NOT_AVAILABLE;
+#endif
+    }
 
     /* Copy data for station 0 to stations 1 to n, if using a common sky. */
     if (oskar_telescope_allow_station_beam_duplication(telescope))
     {
-        oskar_Mem* R0;
-        R0 = oskar_mem_create_alias(0, 0, 0, status);
-        oskar_jones_get_station_pointer(R0, R, 0, status);
+        const int num_sources_R = oskar_jones_num_sources(R);
         for (i = 1; i < num_stations; ++i)
-        {
-            oskar_jones_get_station_pointer(R_station, R, i, status);
-            oskar_mem_copy_contents(R_station, R0, 0, 0,
-                    oskar_mem_length(R0), status);
-        }
-        oskar_mem_free(R0, status);
+            oskar_mem_copy_contents(oskar_jones_mem(R), oskar_jones_mem(R),
+                    i * num_sources_R, 0, num_sources_R, status);
     }
     oskar_mem_free(R_station, status);
 }
@@ -0,0 +1,30 @@
+/* Copyright (c) 2018, The University of Oxford. See LICENSE file. */
+
+kernel void evaluate_jones_R_REAL(const int num_sources,
+        global const REAL* restrict ra_rad,
+        global const REAL* restrict dec_rad, const REAL cos_lat,
+        const REAL sin_lat, const REAL lst_rad, const int offset_out,
+        global REAL8* restrict jones)
+{
+    REAL sin_ha, cos_ha, sin_dec, cos_dec, sin_q, cos_q;
+    const int i = get_global_id(0);
+    if (i >= num_sources) return;
+
+    /* Compute the source hour angle and parallactic angle. */
+    sin_ha = sincos(lst_rad - ra_rad[i], &cos_ha); /* HA = LST - RA. */
+    sin_dec = sincos(dec_rad[i], &cos_dec);
+    const REAL y = cos_lat * sin_ha;
+    const REAL x = sin_lat * cos_dec - cos_lat * sin_dec * cos_ha;
+    sin_q = sincos(atan2(y, x), &cos_q);
+
+    /* Store the Jones matrix for the source. */
+    const int j = i + offset_out;
+    jones[j].s0 = cos_q;
+    jones[j].s1 = (REAL) 0;
+    jones[j].s2 = -sin_q;
+    jones[j].s3 = (REAL) 0;
+    jones[j].s4 = sin_q;
+    jones[j].s5 = (REAL) 0;
+    jones[j].s6 = cos_q;
+    jones[j].s7 = (REAL) 0;
+}
@@ -41,6 +41,7 @@
 #include "log/oskar_log.h"
 #include "sky/oskar_sky.h"
 #include "telescope/oskar_telescope.h"
+#include "utility/oskar_cl_utils.h"
 #include "utility/oskar_cuda_mem_log.h"
 #include "utility/oskar_device_utils.h"
 #include "utility/oskar_get_memory_usage.h"
@@ -65,7 +66,18 @@
 extern "C" {
 #endif
 
-/* Memory allocated per compute device (may be either CPU or GPU). */
+#define MAX_CHANNELS_PER_UNIT 64
+
+/* Station beams cached for one channel of a work unit. */
+struct BeamCacheEntry
+{
+    int chunk_index, time_index, channel_index;
+    unsigned long long int beam_key; /* Station types and pointing. */
+    oskar_Jones* E;
+};
+typedef struct BeamCacheEntry BeamCacheEntry;
+
+/* Memory allocated per compute device (may be CPU, CUDA or OpenCL). */
 struct DeviceData
 {
     /* Host memory. */
@@ -73,12 +85,21 @@ struct DeviceData
 
     /* Device memory. */
     int previous_chunk_index;
+    int previous_time_index;    /* Time of the current horizon clip. */
+    int fused;                  /* If set, Jones K is applied in correlator. */
     oskar_VisBlock* vis_block;  /* Device memory block. */
+    oskar_Mem* vis_slice;       /* Correlator output, if OpenCL device. */
     oskar_Mem *u, *v, *w;
     oskar_Sky* chunk;           /* The unmodified sky chunk being processed. */
     oskar_Sky* chunk_clip;      /* Copy of the chunk after horizon clipping. */
     oskar_Telescope* tel;       /* Telescope model, created as a copy. */
-    oskar_Jones *J, *R, *E, *K, *Z;
+    unsigned long long int beam_key; /* Station types and pointing. */
+    oskar_Jones *J, *R, *E, *K, *Z; /* J and K are not used if fused. */
+    oskar_Jones* K_inc;         /* Change in Jones K between channels. */
+    BeamCacheEntry* E_cache;    /* Station beam cache, if enabled. */
+    int num_E_cache;
+    unsigned long long int E_cache_hits, E_cache_misses;
+    unsigned long long int mem_heap_allocs, mem_reused;
     oskar_StationWork* station_work;
 
     /* Timers. */
@@ -97,21 +118,28 @@ struct oskar_Interferometer
 {
     /* Settings. */
     int prec, num_devices, num_gpus, *gpu_ids, num_channels, num_time_steps;
+    int gpu_location;           /* OSKAR_GPU (CUDA) or OSKAR_CL (OpenCL). */
+    int use_opencl;             /* If set, use OpenCL instead of CUDA. */
     int max_sources_per_chunk, max_times_per_block;
     int apply_horizon_clip, force_polarised_ms, zero_failed_gaussians;
-    int coords_only;
+    int coords_only, spatially_coherent_chunks;
     double freq_start_hz, freq_inc_hz, time_start_mjd_utc, time_inc_sec;
     double source_min_jy, source_max_jy;
+    double beam_cache_tol_sec, beam_cache_max_mb;
     char correlation_type, *vis_name, *ms_name, *settings_path;
 
     /* State. */
-    int init_sky, work_unit_index, status;
+    int init_sky, status;
+    int beam_cache_stale;       /* If set, cached beams are out of date. */
     oskar_Mutex* mutex;
-    oskar_Barrier* barrier;
+    oskar_Scheduler* scheduler;
 
     /* Sky model and telescope model. */
     int num_sources_total, num_sky_chunks;
     oskar_Sky** sky_chunks;
+    oskar_SkyIndex** sky_index; /* Spatial index of each chunk, or NULL. */
+    int *block_chunks;          /* Chunks to simulate in each block. */
+    int *num_block_chunks, num_chunks_skipped;
     oskar_Telescope* tel;
 
     /* Output data and file handles. */
@@ -134,11 +162,29 @@ typedef struct oskar_Interferometer oskar_Interferometer;
 
 /* Private method prototypes. */
 
+static void sim_block(oskar_Interferometer* h, int block_index,
+        int device_id, int* status);
+static void copy_block(oskar_Interferometer* h, int block_index,
+        int device_id, int* status);
 static void sim_baselines(oskar_Interferometer* h, DeviceData* d,
-        oskar_Sky* sky, int channel_index_block, int time_index_block,
-        int time_index_simulation, int* status);
+        oskar_Sky* sky, int channel_index_start, int num_channels_unit,
+        int time_index_block, int time_index_simulation, int* status);
+static oskar_Mem* vis_slice_get(DeviceData* d, oskar_Mem* alias,
+        oskar_Mem* block, size_t offset, size_t length, int* status);
+static void vis_slice_put(DeviceData* d, oskar_Mem* block, size_t offset,
+        size_t length, int* status);
+static int num_times_in_block(const oskar_Interferometer* h, int block_index);
+static int channels_per_unit(const oskar_Interferometer* h,
+        int num_times_block);
+static int beam_time_index(const oskar_Interferometer* h, int time_index);
+static int chunk_below_horizon(const oskar_Interferometer* h, int chunk_index,
+        int block_index);
+static void free_beam_cache(oskar_Interferometer* h, int* status);
+static unsigned long long int beam_key(const oskar_Telescope* tel);
 static void free_device_data(oskar_Interferometer* h, int* status);
+static void free_sky_index(oskar_Interferometer* h);
 static void set_up_device_data(oskar_Interferometer* h, int* status);
+static void set_gpu(const oskar_Interferometer* h, int i, int* status);
 static void set_up_vis_header(oskar_Interferometer* h, int* status);
 static void record_timing(oskar_Interferometer* h);
 static unsigned int disp_width(unsigned int value);
@@ -159,6 +205,23 @@ void oskar_interferometer_check_init(oskar_Interferometer* h, int* status)
         return;
     }
 
+    /* Check the station beams can be evaluated on OpenCL devices. */
+    if (h->num_gpus > 0 && h->gpu_location == OSKAR_CL)
+    {
+        int i;
+        for (i = 0; i < oskar_telescope_num_stations(h->tel); ++i)
+        {
+            if (oskar_station_type(oskar_telescope_station_const(h->tel, i))
+                    == OSKAR_STATION_TYPE_VLA_PBCOR)
+            {
+                oskar_log_error(h->log, "The VLA primary beam is not "
+                        "available on OpenCL devices.");
+                *status = OSKAR_ERR_FUNCTION_NOT_AVAILABLE;
+                return;
+            }
+        }
+    }
+
     /* Create the visibility header if required. */
     if (!h->header)
         set_up_vis_header(h, status);
@@ -181,6 +244,18 @@ void oskar_interferometer_check_init(oskar_Interferometer* h, int* status)
             oskar_sky_evaluate_gaussian_source_parameters(h->sky_chunks[i],
                     h->zero_failed_gaussians, ra0, dec0, &num_failed, status);
         }
+
+        /* Index each chunk, so it can be clipped without testing every
+         * source against every station. */
+        free_sky_index(h);
+        if (h->apply_horizon_clip && h->num_sky_chunks > 0)
+        {
+            h->sky_index = (oskar_SkyIndex**) calloc(h->num_sky_chunks,
+                    sizeof(oskar_SkyIndex*));
+            for (i = 0; i < h->num_sky_chunks; ++i)
+                h->sky_index[i] = oskar_sky_index_create(h->sky_chunks[i],
+                        status);
+        }
         if (num_failed > 0)
         {
             if (h->zero_failed_gaussians)
@@ -197,6 +272,9 @@ void oskar_interferometer_check_init(oskar_Interferometer* h, int* status)
 
     /* Check that each compute device has been set up. */
     set_up_device_data(h, status);
+
+    /* Set up the work units. */
+    oskar_interferometer_reset_work_unit_index(h);
 }
 
 
@@ -215,10 +293,11 @@ oskar_Interferometer* oskar_interferometer_create(int precision, int* status)
     h->tmr_write = oskar_timer_create(OSKAR_TIMER_NATIVE);
     h->temp      = oskar_mem_create(precision, OSKAR_CPU, 0, status);
     h->mutex     = oskar_mutex_create();
-    h->barrier   = oskar_barrier_create(0);
+    h->scheduler = oskar_scheduler_create();
 
     /* Set sensible defaults. */
     h->max_sources_per_chunk = 16384;
+    h->beam_cache_max_mb = 256.0;
     oskar_interferometer_set_gpus(h, -1, 0, status);
     oskar_interferometer_set_num_devices(h, -1);
     oskar_interferometer_set_correlation_type(h, "Cross-correlations", status);
@@ -302,19 +381,22 @@ void oskar_interferometer_free(oskar_Interferometer* h, int* status)
     int i;
     if (!h) return;
     oskar_interferometer_reset_cache(h, status);
-    for (i = 0; i < h->num_gpus; ++i)
+    for (i = 0; i < h->num_gpus && h->gpu_location == OSKAR_GPU; ++i)
     {
         oskar_device_set(h->gpu_ids[i], status);
         oskar_device_reset();
     }
+    free_sky_index(h);
     for (i = 0; i < h->num_sky_chunks; ++i)
         oskar_sky_free(h->sky_chunks[i], status);
+    free(h->block_chunks);
+    free(h->num_block_chunks);
     oskar_telescope_free(h->tel, status);
     oskar_mem_free(h->temp, status);
     oskar_timer_free(h->tmr_sim);
     oskar_timer_free(h->tmr_write);
     oskar_mutex_free(h->mutex);
-    oskar_barrier_free(h->barrier);
+    oskar_scheduler_free(h->scheduler);
     free(h->sky_chunks);
     free(h->gpu_ids);
     free(h->vis_name);
@@ -360,144 +442,84 @@ void oskar_interferometer_reset_cache(oskar_Interferometer* h, int* status)
 
 void oskar_interferometer_reset_work_unit_index(oskar_Interferometer* h)
 {
-    h->work_unit_index = 0;
-}
+    int b, num_blocks, *num_tasks;
 
-
-void oskar_interferometer_run_block(oskar_Interferometer* h, int block_index,
-        int device_id, int* status)
-{
-    double obs_start_mjd, dt_dump_days;
-    int i_active, time_index_start, time_index_end;
-    int num_channels, num_times_block, total_chunks, total_times;
-    DeviceData* d;
-    if (*status) return;
-
-    /* Check that initialisation has happened. We can't initialise here,
-     * as we're already multi-threaded at this point. */
-    if (!h->header)
-    {
-        *status = OSKAR_ERR_MEMORY_NOT_ALLOCATED;
-        oskar_log_error(h->log, "Simulator not initalised. "
-                "Call oskar_interferometer_check_init() first.");
-        return;
-    }
-
-    /* Set the GPU to use. (Supposed to be a very low-overhead call.) */
-    if (device_id >= 0 && device_id < h->num_gpus)
-        oskar_device_set(h->gpu_ids[device_id], status);
-
-    /* Clear the visibility block. */
-    i_active = block_index % 2; /* Index of the active buffer. */
-    d = &(h->d[device_id]);
-    oskar_timer_resume(d->tmr_compute);
-    oskar_vis_block_clear(d->vis_block, status);
-
-    /* Set the visibility block meta-data. */
-    total_chunks = h->num_sky_chunks;
-    num_channels = h->num_channels;
-    total_times = h->num_time_steps;
-    obs_start_mjd = h->time_start_mjd_utc;
-    dt_dump_days = h->time_inc_sec / 86400.0;
-    time_index_start = block_index * h->max_times_per_block;
-    time_index_end = time_index_start + h->max_times_per_block - 1;
-    if (time_index_end >= total_times)
-        time_index_end = total_times - 1;
-    num_times_block = 1 + time_index_end - time_index_start;
-
-    /* Set the number of active times in the block. */
-    oskar_vis_block_set_num_times(d->vis_block, num_times_block, status);
-    oskar_vis_block_set_start_time_index(d->vis_block, time_index_start);
-
-    /* Go though all possible work units in the block. A work unit is defined
-     * as the simulation for one time and one sky chunk. */
-    while (!h->coords_only)
+    /* A work unit is the simulation of one time, one sky chunk and
+     * a group of channels. Units are ordered by chunk, then time, then
+     * channel group, so that contiguous ranges of units share the same
+     * sky chunk. */
+    num_blocks = oskar_interferometer_num_vis_blocks(h);
+    num_tasks = (int*) calloc(num_blocks > 0 ? num_blocks : 1, sizeof(int));
+
+    /* Find the chunks to simulate in each block, leaving out any that
+     * are below the horizon of every station for the whole block. */
+    free(h->block_chunks);
+    free(h->num_block_chunks);
+    h->block_chunks = (int*) calloc(num_blocks * h->num_sky_chunks > 0 ?
+            num_blocks * h->num_sky_chunks : 1, sizeof(int));
+    h->num_block_chunks = (int*) calloc(num_blocks > 0 ? num_blocks : 1,
+            sizeof(int));
+    h->num_chunks_skipped = 0;
+    for (b = 0; b < num_blocks; ++b)
     {
-        oskar_Sky* sky;
-        int i_work_unit, i_chunk, i_time, i_channel, sim_time_idx;
-
-        oskar_mutex_lock(h->mutex);
-        i_work_unit = (h->work_unit_index)++;
-        oskar_mutex_unlock(h->mutex);
-        if ((i_work_unit >= num_times_block * total_chunks) || *status) break;
-
-        /* Convert slice index to chunk/time index. */
-        i_chunk      = i_work_unit / num_times_block;
-        i_time       = i_work_unit - i_chunk * num_times_block;
-        sim_time_idx = time_index_start + i_time;
-
-        /* Copy sky chunk to device only if different from the previous one. */
-        if (i_chunk != d->previous_chunk_index)
-        {
-            oskar_timer_resume(d->tmr_copy);
-            oskar_sky_copy(d->chunk, h->sky_chunks[i_chunk], status);
-            oskar_timer_pause(d->tmr_copy);
-        }
-        sky = h->apply_horizon_clip ? d->chunk_clip : d->chunk;
-
-        /* Apply horizon clip if required. */
-        if (h->apply_horizon_clip)
-        {
-            double gast, mjd;
-            mjd = obs_start_mjd + dt_dump_days * (sim_time_idx + 0.5);
-            gast = oskar_convert_mjd_to_gast_fast(mjd);
-            oskar_timer_resume(d->tmr_clip);
-            oskar_sky_horizon_clip(d->chunk_clip, d->chunk, d->tel, gast,
-                    d->station_work, status);
-            oskar_timer_pause(d->tmr_clip);
-        }
-
-        /* Simulate all baselines for all channels for this time and chunk. */
-        for (i_channel = 0; i_channel < num_channels; ++i_channel)
+        int i, n = 0;
+        const int num_times_block = num_times_in_block(h, b);
+        const int c = channels_per_unit(h, num_times_block);
+        for (i = 0; i < h->num_sky_chunks; ++i)
         {
-            if (*status) break;
-            if (h->log)
-            {
-                oskar_mutex_lock(h->mutex);
-                oskar_log_message(h->log, 'S', 1, "Time %*i/%i, "
-                        "Chunk %*i/%i, Channel %*i/%i [Device %i, %i sources]",
-                        disp_width(total_times), sim_time_idx + 1, total_times,
-                        disp_width(total_chunks), i_chunk + 1, total_chunks,
-                        disp_width(num_channels), i_channel + 1, num_channels,
-                        device_id, oskar_sky_num_sources(sky));
-                oskar_mutex_unlock(h->mutex);
-            }
-            sim_baselines(h, d, sky, i_channel, i_time, sim_time_idx, status);
+            if (chunk_below_horizon(h, i, b))
+                h->num_chunks_skipped++;
+            else
+                h->block_chunks[b * h->num_sky_chunks + n++] = i;
         }
-        d->previous_chunk_index = i_chunk;
+        h->num_block_chunks[b] = n;
+        num_tasks[b] = h->coords_only ? 0 :
+                num_times_block * n * ((h->num_channels + c - 1) / c);
     }
+    oskar_scheduler_reset(h->scheduler, h->num_devices, num_blocks, num_tasks);
+    free(num_tasks);
+}
 
-    /* Copy the visibility block to host memory. */
-    oskar_timer_resume(d->tmr_copy);
-    oskar_vis_block_copy(d->vis_block_cpu[i_active], d->vis_block, status);
-    oskar_timer_pause(d->tmr_copy);
-    oskar_timer_pause(d->tmr_compute);
+
+void oskar_interferometer_run_block(oskar_Interferometer* h, int block_index,
+        int device_id, int* status)
+{
+    sim_block(h, block_index, device_id, status);
+    copy_block(h, block_index, device_id, status);
 }
 
 
 struct ThreadArgs
 {
     oskar_Interferometer* h;
-    int num_threads, thread_id;
+    int thread_id;
 };
 typedef struct ThreadArgs ThreadArgs;
 
 static void* run_blocks(void* arg)
 {
     oskar_Interferometer* h;
-    int b, thread_id, device_id, num_blocks, num_threads, *status;
+    int b, thread_id, device_id, num_blocks, *status;
+    unsigned long long int heap_allocs0, reused0, heap_allocs1, reused1;
 
     /* Get thread function arguments. */
     h = ((ThreadArgs*)arg)->h;
-    num_threads = ((ThreadArgs*)arg)->num_threads;
     thread_id = ((ThreadArgs*)arg)->thread_id;
     device_id = thread_id - 1;
     status = &(h->status);
 
 #ifdef _OPENMP
-    /* Disable any nested parallelism. */
+    /* Disable any nested parallelism, and share the cores not used by
+     * GPU host threads between the CPU devices. */
     omp_set_nested(0);
     omp_set_num_threads(1);
+    if (device_id >= h->num_gpus)
+    {
+        const int num_cpu_devices = h->num_devices - h->num_gpus;
+        const int num_threads_cpu =
+                (oskar_get_num_procs() - h->num_gpus) / num_cpu_devices;
+        if (num_threads_cpu > 1) omp_set_num_threads(num_threads_cpu);
+    }
 #endif
 
     /* Loop over blocks of observation time, running simulation and file
@@ -508,39 +530,54 @@ static void* run_blocks(void* arg)
      * Thread 0 is used for file writes.
      * Threads 1 to n (mapped to compute devices) do the simulation.
      *
-     * Note that no write is launched on the first loop counter (as no
-     * data are ready yet) and no simulation is performed for the last loop
-     * counter (which corresponds to the last block + 1) as this iteration
-     * simply writes the last block.
+     * Work units within a block are shared using the work-stealing
+     * scheduler, and there is no barrier between blocks: a device that
+     * runs out of work in one block moves straight on to the next.
+     * A device waits only before copying its results into a host buffer
+     * that the writer has not yet released, and the writer waits only
+     * until all devices have finished the block it needs.
      */
     num_blocks = oskar_interferometer_num_vis_blocks(h);
-    for (b = 0; b < num_blocks + 1; ++b)
+    oskar_mem_pool_stats(&heap_allocs0, &reused0);
+    for (b = 0; b < num_blocks; ++b)
     {
-        if ((thread_id > 0 || num_threads == 1) && b < num_blocks)
-            oskar_interferometer_run_block(h, b, device_id, status);
-        if (thread_id == 0 && b > 0)
-        {
-            oskar_VisBlock* block;
-            block = oskar_interferometer_finalise_block(h, b - 1, status);
-            oskar_interferometer_write_block(h, block, b - 1, status);
-        }
-
-        /* Barrier 1: Reset work unit index and print status. */
-        oskar_barrier_wait(h->barrier);
         if (thread_id == 0)
         {
-            oskar_interferometer_reset_work_unit_index(h);
-            if (b < num_blocks && h->log && !*status)
+            oskar_VisBlock* block;
+            oskar_scheduler_wait_finished(h->scheduler, b);
+            block = oskar_interferometer_finalise_block(h, b, status);
+            oskar_interferometer_write_block(h, block, b, status);
+            if (h->log && !*status)
+            {
+                oskar_mutex_lock(h->mutex);
                 oskar_log_message(h->log, 'S', 0, "Block %*i/%i (%3.0f%%) "
                         "complete. Simulation time elapsed: %.3f s",
                         disp_width(num_blocks), b+1, num_blocks,
                         100.0 * (b+1) / (double)num_blocks,
                         oskar_timer_elapsed(h->tmr_sim));
+                oskar_mutex_unlock(h->mutex);
+            }
+            oskar_scheduler_release_block(h->scheduler, b);
         }
+        else
+        {
+            /* The host buffer for this block was last used two blocks ago. */
+            sim_block(h, b, device_id, status);
+            oskar_scheduler_wait_released(h->scheduler, b - 2);
+            copy_block(h, b, device_id, status);
+            oskar_scheduler_finish_block(h->scheduler, b);
+        }
+    }
 
-        /* Barrier 2: Synchronise before moving to the next block. */
-        oskar_barrier_wait(h->barrier);
+    /* Record memory allocation counts for the device,
+     * and release the memory handles cached by this thread. */
+    oskar_mem_pool_stats(&heap_allocs1, &reused1);
+    if (device_id >= 0)
+    {
+        h->d[device_id].mem_heap_allocs += heap_allocs1 - heap_allocs0;
+        h->d[device_id].mem_reused += reused1 - reused0;
     }
+    oskar_mem_pool_clear();
     return 0;
 }
 
@@ -573,13 +610,11 @@ void oskar_interferometer_run(oskar_Interferometer* h, int* status)
 
     /* Set up worker threads. */
     num_threads = h->num_devices + 1;
-    oskar_barrier_set_num_threads(h->barrier, num_threads);
     threads = (oskar_Thread**) calloc(num_threads, sizeof(oskar_Thread*));
     args = (ThreadArgs*) calloc(num_threads, sizeof(ThreadArgs));
     for (i = 0; i < num_threads; ++i)
     {
         args[i].h = h;
-        args[i].num_threads = num_threads;
         args[i].thread_id = i;
     }
 
@@ -588,7 +623,7 @@ void oskar_interferometer_run(oskar_Interferometer* h, int* status)
     {
         oskar_log_section(h->log, 'M', "Initial memory usage");
 #ifdef OSKAR_HAVE_CUDA
-        for (i = 0; i < h->num_gpus; ++i)
+        for (i = 0; i < h->num_gpus && h->gpu_location == OSKAR_GPU; ++i)
             oskar_cuda_mem_log(h->log, 0, h->gpu_ids[i]);
 #endif
         system_mem_log(h->log);
@@ -623,7 +658,7 @@ void oskar_interferometer_run(oskar_Interferometer* h, int* status)
     {
         oskar_log_section(h->log, 'M', "Final memory usage");
 #ifdef OSKAR_HAVE_CUDA
-        for (i = 0; i < h->num_gpus; ++i)
+        for (i = 0; i < h->num_gpus && h->gpu_location == OSKAR_GPU; ++i)
             oskar_cuda_mem_log(h->log, 0, h->gpu_ids[i]);
 #endif
         system_mem_log(h->log);
@@ -725,6 +760,16 @@ void oskar_interferometer_set_gpus(oskar_Interferometer* h, int num,
     free_device_data(h, status);
     num_gpus_avail = oskar_device_count(status);
     if (*status) return;
+
+    /* Use OpenCL devices only if requested. */
+    h->gpu_location = OSKAR_GPU;
+#ifdef OSKAR_HAVE_OPENCL
+    if (h->use_opencl)
+    {
+        num_gpus_avail = (int) oskar_cl_num_devices();
+        h->gpu_location = OSKAR_CL;
+    }
+#endif
     if (num < 0)
     {
         h->num_gpus = num_gpus_avail;
@@ -753,7 +798,7 @@ void oskar_interferometer_set_gpus(oskar_Interferometer* h, int num,
     }
     for (i = 0; i < h->num_gpus; ++i)
     {
-        oskar_device_set(h->gpu_ids[i], status);
+        set_gpu(h, i, status);
         if (*status) return;
     }
 }
@@ -774,6 +819,7 @@ void oskar_interferometer_set_log(oskar_Interferometer* h, oskar_Log* log)
 void oskar_interferometer_set_max_sources_per_chunk(oskar_Interferometer* h,
         int value)
 {
+    h->beam_cache_stale = 1;
     h->max_sources_per_chunk = value;
 }
 
@@ -781,6 +827,7 @@ void oskar_interferometer_set_max_sources_per_chunk(oskar_Interferometer* h,
 void oskar_interferometer_set_max_times_per_block(oskar_Interferometer* h,
         int value)
 {
+    h->beam_cache_stale = 1;
     h->max_times_per_block = value;
 }
 
@@ -801,6 +848,7 @@ void oskar_interferometer_set_num_devices(oskar_Interferometer* h, int value)
 void oskar_interferometer_set_observation_frequency(oskar_Interferometer* h,
         double start_hz, double inc_hz, int num_channels)
 {
+    h->beam_cache_stale = 1;
     h->freq_start_hz = start_hz;
     h->freq_inc_hz = inc_hz;
     h->num_channels = num_channels;
@@ -810,6 +858,7 @@ void oskar_interferometer_set_observation_frequency(oskar_Interferometer* h,
 void oskar_interferometer_set_observation_time(oskar_Interferometer* h,
         double time_start_mjd_utc, double inc_sec, int num_time_steps)
 {
+    h->beam_cache_stale = 1;
     h->time_start_mjd_utc = time_start_mjd_utc;
     h->time_inc_sec = inc_sec;
     h->num_time_steps = num_time_steps;
@@ -834,7 +883,9 @@ void oskar_interferometer_set_sky_model(oskar_Interferometer* h,
     int i;
     if (*status || !h || !sky) return;
 
-    /* Clear the old chunk set. */
+    /* Clear the old chunk set, and any beams cached for it. */
+    free_beam_cache(h, status);
+    free_sky_index(h);
     for (i = 0; i < h->num_sky_chunks; ++i)
         oskar_sky_free(h->sky_chunks[i], status);
     free(h->sky_chunks);
@@ -844,8 +895,21 @@ void oskar_interferometer_set_sky_model(oskar_Interferometer* h,
     /* Split up the sky model into chunks and store them. */
     h->num_sources_total = oskar_sky_num_sources(sky);
     if (h->num_sources_total > 0)
-        oskar_sky_append_to_set(&h->num_sky_chunks, &h->sky_chunks,
-                h->max_sources_per_chunk, sky, status);
+    {
+        if (h->spatially_coherent_chunks)
+        {
+            /* Sort a copy of the sky model, so each chunk covers a compact
+             * region that can be skipped when below the horizon. */
+            oskar_Sky* sorted = oskar_sky_create_copy(sky, OSKAR_CPU, status);
+            oskar_sky_sort_by_position(sorted, status);
+            oskar_sky_append_to_set(&h->num_sky_chunks, &h->sky_chunks,
+                    h->max_sources_per_chunk, sorted, status);
+            oskar_sky_free(sorted, status);
+        }
+        else
+            oskar_sky_append_to_set(&h->num_sky_chunks, &h->sky_chunks,
+                    h->max_sources_per_chunk, sky, status);
+    }
     h->init_sky = 0;
 
     /* Print summary data. */
@@ -874,6 +938,7 @@ void oskar_interferometer_set_telescope_model(oskar_Interferometer* h,
     }
 
     /* Remove any existing telescope model, and copy the new one. */
+    free_beam_cache(h, status);
     oskar_telescope_free(h->tel, status);
     h->tel = oskar_telescope_create_copy(model, OSKAR_CPU, status);
 
@@ -923,6 +988,49 @@ void oskar_interferometer_set_source_flux_range(oskar_Interferometer* h,
 }
 
 
+void oskar_interferometer_set_spatially_coherent_chunks(
+        oskar_Interferometer* h, int value)
+{
+    h->spatially_coherent_chunks = value;
+}
+
+
+void oskar_interferometer_set_station_beam_cache_tolerance(
+        oskar_Interferometer* h, double tolerance_sec, int* status)
+{
+    if (*status || !h) return;
+    free_beam_cache(h, status);
+    h->beam_cache_tol_sec = tolerance_sec;
+}
+
+
+void oskar_interferometer_set_station_beam_cache_max_memory_mb(
+        oskar_Interferometer* h, double value, int* status)
+{
+    if (*status || !h) return;
+    free_beam_cache(h, status);
+    h->beam_cache_max_mb = value;
+}
+
+
+void oskar_interferometer_set_use_opencl(oskar_Interferometer* h, int value,
+        int* status)
+{
+    if (*status || !h) return;
+#ifndef OSKAR_HAVE_OPENCL
+    if (value)
+    {
+        oskar_log_error(h->log, "OpenCL support is not available.");
+        *status = OSKAR_ERR_FUNCTION_NOT_AVAILABLE;
+        return;
+    }
+#endif
+    /* Select all devices of the requested kind. */
+    h->use_opencl = value;
+    oskar_interferometer_set_gpus(h, -1, 0, status);
+}
+
+
 void oskar_interferometer_set_zero_failed_gaussians(oskar_Interferometer* h,
         int value)
 {
@@ -958,13 +1066,257 @@ void oskar_interferometer_write_block(oskar_Interferometer* h,
 
 /* Private methods. */
 
+static void sim_block(oskar_Interferometer* h, int block_index,
+        int device_id, int* status)
+{
+    double obs_start_mjd, dt_dump_days;
+    int time_index_start, num_channels, num_times_block;
+    int total_chunks, total_times, i_task, channels_unit, num_groups;
+    DeviceData* d;
+    if (*status) return;
+
+    /* Check that initialisation has happened. We can't initialise here,
+     * as we're already multi-threaded at this point. */
+    if (!h->header)
+    {
+        *status = OSKAR_ERR_MEMORY_NOT_ALLOCATED;
+        oskar_log_error(h->log, "Simulator not initalised. "
+                "Call oskar_interferometer_check_init() first.");
+        return;
+    }
+
+    /* Set the GPU to use. (Supposed to be a very low-overhead call.) */
+    if (device_id >= 0 && device_id < h->num_gpus)
+        set_gpu(h, device_id, status);
+
+    /* Clear the visibility block. */
+    d = &(h->d[device_id]);
+    oskar_timer_resume(d->tmr_compute);
+    oskar_vis_block_clear(d->vis_block, status);
+
+    /* Set the visibility block meta-data. */
+    total_chunks = h->num_sky_chunks;
+    num_channels = h->num_channels;
+    total_times = h->num_time_steps;
+    obs_start_mjd = h->time_start_mjd_utc;
+    dt_dump_days = h->time_inc_sec / 86400.0;
+    time_index_start = block_index * h->max_times_per_block;
+    num_times_block = num_times_in_block(h, block_index);
+    channels_unit = channels_per_unit(h, num_times_block);
+    num_groups = (num_channels + channels_unit - 1) / channels_unit;
+
+    /* Set the number of active times in the block. */
+    oskar_vis_block_set_num_times(d->vis_block, num_times_block, status);
+    oskar_vis_block_set_start_time_index(d->vis_block, time_index_start);
+
+    /* Go though all the work units in the block given to this device.
+     * A work unit is defined as the simulation for one time, one sky chunk
+     * and a group of adjacent channels. */
+    while (!h->coords_only &&
+            oskar_scheduler_next(h->scheduler, device_id, block_index, &i_task))
+    {
+        oskar_Sky* sky;
+        int i_chunk, i_time, i_channel, sim_time_idx, clip_time_idx;
+        int new_chunk, n_c;
+        if (*status) break;
+
+        /* Convert work unit index to chunk/time/channel index. */
+        if (h->beam_cache_tol_sec > 0.0)
+        {
+            /* Visit times before channel groups to reuse cached beams. */
+            i_time    = i_task % num_times_block;
+            i_channel = ((i_task / num_times_block) % num_groups) *
+                    channels_unit;
+        }
+        else
+        {
+            i_channel = (i_task % num_groups) * channels_unit;
+            i_time    = (i_task / num_groups) % num_times_block;
+        }
+        i_chunk      = h->block_chunks[block_index * total_chunks +
+                i_task / (num_groups * num_times_block)];
+        sim_time_idx = time_index_start + i_time;
+        n_c = num_channels - i_channel;
+        if (n_c > channels_unit) n_c = channels_unit;
+
+        /* Copy sky chunk to device only if different from the previous one. */
+        new_chunk = (i_chunk != d->previous_chunk_index);
+        if (new_chunk)
+        {
+            oskar_timer_resume(d->tmr_copy);
+            oskar_sky_copy(d->chunk, h->sky_chunks[i_chunk], status);
+            oskar_timer_pause(d->tmr_copy);
+            d->previous_chunk_index = i_chunk;
+        }
+        sky = h->apply_horizon_clip ? d->chunk_clip : d->chunk;
+
+        /* Apply horizon clip if required, and not already done.
+         * If station beams are cached, the clip is done at the same time
+         * as the beam, so that the cached beams match the clipped sky. */
+        clip_time_idx = beam_time_index(h, sim_time_idx);
+        if (h->apply_horizon_clip &&
+                (new_chunk || clip_time_idx != d->previous_time_index))
+        {
+            double gast, mjd;
+            mjd = obs_start_mjd + dt_dump_days * (clip_time_idx + 0.5);
+            gast = oskar_convert_mjd_to_gast_fast(mjd);
+            oskar_timer_resume(d->tmr_clip);
+            oskar_sky_horizon_clip_index(d->chunk_clip, d->chunk,
+                    h->sky_index ? h->sky_index[i_chunk] : 0, d->tel, gast,
+                    d->station_work, status);
+            oskar_timer_pause(d->tmr_clip);
+            d->previous_time_index = clip_time_idx;
+        }
+
+        /* Simulate all baselines for this time, chunk and channel group. */
+        if (h->log)
+        {
+            oskar_mutex_lock(h->mutex);
+            if (n_c == 1)
+                oskar_log_message(h->log, 'S', 1, "Time %*i/%i, "
+                        "Chunk %*i/%i, Channel %*i/%i [Device %i, %i sources]",
+                        disp_width(total_times), sim_time_idx + 1, total_times,
+                        disp_width(total_chunks), i_chunk + 1, total_chunks,
+                        disp_width(num_channels), i_channel + 1, num_channels,
+                        device_id, oskar_sky_num_sources(sky));
+            else
+                oskar_log_message(h->log, 'S', 1, "Time %*i/%i, "
+                        "Chunk %*i/%i, Channels %*i-%*i/%i "
+                        "[Device %i, %i sources]",
+                        disp_width(total_times), sim_time_idx + 1, total_times,
+                        disp_width(total_chunks), i_chunk + 1, total_chunks,
+                        disp_width(num_channels), i_channel + 1,
+                        disp_width(num_channels), i_channel + n_c,
+                        num_channels, device_id, oskar_sky_num_sources(sky));
+            oskar_mutex_unlock(h->mutex);
+        }
+        sim_baselines(h, d, sky, i_channel, n_c, i_time, sim_time_idx,
+                status);
+    }
+    oskar_timer_pause(d->tmr_compute);
+}
+
+
+static void copy_block(oskar_Interferometer* h, int block_index,
+        int device_id, int* status)
+{
+    DeviceData* d;
+    if (*status) return;
+
+    /* Copy the visibility block to host memory. */
+    d = &(h->d[device_id]);
+    oskar_timer_resume(d->tmr_compute);
+    oskar_timer_resume(d->tmr_copy);
+    oskar_vis_block_copy(d->vis_block_cpu[block_index % 2],
+            d->vis_block, status);
+    oskar_timer_pause(d->tmr_copy);
+    oskar_timer_pause(d->tmr_compute);
+}
+
+
+static int num_times_in_block(const oskar_Interferometer* h, int block_index)
+{
+    int time_index_start, time_index_end;
+    time_index_start = block_index * h->max_times_per_block;
+    time_index_end = time_index_start + h->max_times_per_block - 1;
+    if (time_index_end >= h->num_time_steps)
+        time_index_end = h->num_time_steps - 1;
+    return 1 + time_index_end - time_index_start;
+}
+
+
+static int channels_per_unit(const oskar_Interferometer* h,
+        int num_times_block)
+{
+    /* Put as many channels as possible into each work unit, so that
+     * quantities that do not depend on frequency are evaluated only once,
+     * but keep enough units in the block to balance the load across all
+     * devices, and limit the length of the Jones K recurrence. */
+    int num_units, num_groups, n;
+    num_units = h->num_sky_chunks * num_times_block;
+    if (num_units < 1) num_units = 1;
+    num_groups = (4 * h->num_devices + num_units - 1) / num_units;
+    if (num_groups < 1) num_groups = 1;
+    n = (h->num_channels + num_groups - 1) / num_groups;
+    if (n > MAX_CHANNELS_PER_UNIT) n = MAX_CHANNELS_PER_UNIT;
+    return n > 0 ? n : 1;
+}
+
+
+static int beam_time_index(const oskar_Interferometer* h, int time_index)
+{
+    /* Return the time index at which to evaluate station beams.
+     * If the station beam cache is enabled, times are divided into
+     * intervals no longer than twice the tolerance, and the beams are
+     * evaluated at the middle of each interval. */
+    int half, len, t;
+    if (h->beam_cache_tol_sec <= 0.0 || h->time_inc_sec <= 0.0)
+        return time_index;
+    half = (int) floor(h->beam_cache_tol_sec / h->time_inc_sec);
+    len = 2 * half + 1;
+    t = (time_index / len) * len + half;
+    return t < h->num_time_steps ? t : h->num_time_steps - 1;
+}
+
+
+static int chunk_below_horizon(const oskar_Interferometer* h, int chunk_index,
+        int block_index)
+{
+    /* Return true if the bounding cap of the chunk is below the horizon of
+     * every station at all the times the chunk is clipped in the block. */
+    int i, t0, t1, num_stations;
+    double ra, dec, radius, dt_days, gast0, span, sin_dec, cos_dec;
+    if (!h->apply_horizon_clip || !h->sky_index || !h->tel) return 0;
+    oskar_sky_index_bounding_cap(h->sky_index[chunk_index],
+            &ra, &dec, &radius);
+    if (radius >= M_PI / 2) return 0;
+
+    /* Get the range of hour angles covered by the block. */
+    t0 = block_index * h->max_times_per_block;
+    t1 = t0 + num_times_in_block(h, block_index) - 1;
+    t0 = beam_time_index(h, t0);
+    t1 = beam_time_index(h, t1);
+    dt_days = h->time_inc_sec / 86400.0;
+    gast0 = oskar_convert_mjd_to_gast_fast(
+            h->time_start_mjd_utc + dt_days * (t0 + 0.5));
+    span = oskar_convert_mjd_to_gast_fast(
+            h->time_start_mjd_utc + dt_days * (t1 + 0.5)) - gast0;
+    while (span < 0.0) span += 2.0 * M_PI;
+    if ((t1 - t0) * dt_days > 0.9) return 0;
+
+    /* Find the highest altitude of the cap centre for each station. */
+    sin_dec = sin(dec);
+    cos_dec = cos(dec);
+    num_stations = oskar_telescope_num_stations(h->tel);
+    for (i = 0; i < num_stations; ++i)
+    {
+        double ha, cos_ha_max, sin_alt;
+        const oskar_Station* s = oskar_telescope_station_const(h->tel, i);
+        const double lat = oskar_station_lat_rad(s);
+        ha = fmod(gast0 + oskar_station_lon_rad(s) - ra, 2.0 * M_PI);
+        if (ha > M_PI) ha -= 2.0 * M_PI;
+        if (ha < -M_PI) ha += 2.0 * M_PI;
+        if (ha <= 0.0 && ha + span >= 0.0) cos_ha_max = 1.0;
+        else if (ha + span >= 2.0 * M_PI) cos_ha_max = 1.0;
+        else cos_ha_max = cos(ha) > cos(ha + span) ? cos(ha) : cos(ha + span);
+        sin_alt = sin_dec * sin(lat) + cos_dec * cos(lat) * cos_ha_max;
+        if (asin(sin_alt > 1.0 ? 1.0 : sin_alt) + radius > -1e-3) return 0;
+    }
+    return 1;
+}
+
+
 static void sim_baselines(oskar_Interferometer* h, DeviceData* d,
-        oskar_Sky* sky, int channel_index_block, int time_index_block,
-        int time_index_simulation, int* status)
+        oskar_Sky* sky, int channel_index_start, int num_channels_unit,
+        int time_index_block, int time_index_simulation, int* status)
 {
-    int num_baselines, num_stations, num_src, num_times_block, num_channels;
-    double dt_dump_days, t_start, t_dump, gast, frequency, ra0, dec0;
+    int i, num_baselines, num_stations, num_src, num_times_block;
+    int num_channels, filter, time_index_beam, cached;
+    double dt_dump_days, t_start, t_dump, gast, gast_beam, frequency;
+    double ra0, dec0;
     const oskar_Mem *x, *y, *z;
+    const oskar_Jones* J;
+    oskar_Jones* E;
     oskar_Mem* alias = 0;
 
     /* Get dimensions. */
@@ -978,15 +1330,14 @@ static void sim_baselines(oskar_Interferometer* h, DeviceData* d,
      * or if block time index requested is outside the valid range. */
     if (num_src == 0 || time_index_block >= num_times_block) return;
 
-    /* Get the time and frequency of the visibility slice being simulated. */
+    /* Get the time of the visibility slice being simulated. */
     dt_dump_days = h->time_inc_sec / 86400.0;
     t_start = h->time_start_mjd_utc;
     t_dump = t_start + dt_dump_days * (time_index_simulation + 0.5);
     gast = oskar_convert_mjd_to_gast_fast(t_dump);
-    frequency = h->freq_start_hz + channel_index_block * h->freq_inc_hz;
-
-    /* Scale source fluxes with spectral index and rotation measure. */
-    oskar_sky_scale_flux_with_frequency(sky, frequency, status);
+    time_index_beam = beam_time_index(h, time_index_simulation);
+    gast_beam = oskar_convert_mjd_to_gast_fast(
+            t_start + dt_dump_days * (time_index_beam + 0.5));
 
     /* Evaluate station u,v,w coordinates. */
     ra0 = oskar_telescope_phase_centre_ra_rad(d->tel);
@@ -1002,87 +1353,199 @@ static void sim_baselines(oskar_Interferometer* h, DeviceData* d,
         oskar_jones_set_size(d->R, num_stations, num_src, status);
     if (d->Z)
         oskar_jones_set_size(d->Z, num_stations, num_src, status);
-    oskar_jones_set_size(d->J, num_stations, num_src, status);
+    if (d->J)
+        oskar_jones_set_size(d->J, num_stations, num_src, status);
+    if (d->K)
+        oskar_jones_set_size(d->K, num_stations, num_src, status);
+    if (d->K_inc)
+        oskar_jones_set_size(d->K_inc, num_stations, num_src, status);
     oskar_jones_set_size(d->E, num_stations, num_src, status);
-    oskar_jones_set_size(d->K, num_stations, num_src, status);
-
-    /* Evaluate station beam (Jones E: may be matrix). */
-    oskar_timer_resume(d->tmr_E);
-    oskar_evaluate_jones_E(d->E, num_src, OSKAR_RELATIVE_DIRECTIONS,
-            oskar_sky_l(sky), oskar_sky_m(sky), oskar_sky_n(sky), d->tel,
-            gast, frequency, d->station_work, time_index_simulation, status);
-    oskar_timer_pause(d->tmr_E);
-
-#if 0
-    /* Evaluate ionospheric phase (Jones Z: scalar) and join with Jones E.
-     * NOTE this is currently only a CPU implementation. */
-    if (d->Z)
-    {
-        oskar_evaluate_jones_Z(d->Z, num_src, sky, d->tel,
-                &settings->ionosphere, gast, frequency, &(d->workJonesZ),
-                status);
-        oskar_timer_resume(d->tmr_join);
-        oskar_jones_join(d->E, d->Z, d->E, status);
-        oskar_timer_pause(d->tmr_join);
-    }
-#endif
 
-    /* Evaluate parallactic angle (Jones R: matrix), and join with Jones Z*E.
+    /* Evaluate parallactic angle (Jones R: matrix).
+     * This does not depend on frequency, so is done once for all channels.
      * TODO Move this into station beam evaluation instead. */
     if (d->R)
     {
         oskar_timer_resume(d->tmr_E);
         oskar_evaluate_jones_R(d->R, num_src, oskar_sky_ra_rad_const(sky),
-                oskar_sky_dec_rad_const(sky), d->tel, gast, status);
+                oskar_sky_dec_rad_const(sky), d->tel, gast_beam, status);
         oskar_timer_pause(d->tmr_E);
-        oskar_timer_resume(d->tmr_join);
-        oskar_jones_join(d->R, d->E, d->R, status);
-        oskar_timer_pause(d->tmr_join);
     }
 
-    /* Evaluate interferometer phase (Jones K: scalar). */
-    oskar_timer_resume(d->tmr_K);
-    oskar_evaluate_jones_K(d->K, num_src, oskar_sky_l_const(sky),
-            oskar_sky_m_const(sky), oskar_sky_n_const(sky), d->u, d->v, d->w,
-            frequency, oskar_sky_I_const(sky),
-            h->source_min_jy, h->source_max_jy, status);
-    oskar_timer_pause(d->tmr_K);
-
-    /* Join Jones K with Jones Z*E. */
-    oskar_timer_resume(d->tmr_join);
-    oskar_jones_join(d->J, d->K, d->R ? d->R : d->E, status);
-    oskar_timer_pause(d->tmr_join);
+    /* Jones K can only be updated by a phase rotation between channels
+     * if the sources are not filtered by their (frequency-dependent) flux. */
+    filter = (h->source_min_jy > -DBL_MAX || h->source_max_jy < DBL_MAX);
 
     /* Create alias for auto/cross-correlations. */
-    oskar_timer_resume(d->tmr_correlate);
     alias = oskar_mem_create_alias(0, 0, 0, status);
 
-    /* Auto-correlate for this time and channel. */
-    if (oskar_vis_block_has_auto_correlations(d->vis_block))
+    /* Loop over channels in the work unit. */
+    for (i = 0; i < num_channels_unit; ++i)
     {
-        oskar_mem_set_alias(alias,
-                oskar_vis_block_auto_correlations(d->vis_block),
-                num_stations *
-                (num_channels * time_index_block + channel_index_block),
-                num_stations, status);
-        oskar_auto_correlate(alias, num_src, d->J, sky, status);
-    }
+        const int channel_index_block = channel_index_start + i;
+        if (*status) break;
+        frequency = h->freq_start_hz + channel_index_block * h->freq_inc_hz;
+
+        /* Scale source fluxes with spectral index and rotation measure. */
+        oskar_sky_scale_flux_with_frequency(sky, frequency, status);
+
+        /* Evaluate station beam (Jones E: may be matrix), unless it is
+         * already in the cache for this chunk, time interval and channel.
+         * A cache entry holds the beam after the join with Jones R,
+         * which is also evaluated at the beam time, and is used in place. */
+        E = d->E;
+        cached = 0;
+        if (i < d->num_E_cache)
+        {
+            BeamCacheEntry* e = &d->E_cache[i];
+            E = e->E;
+            if (e->chunk_index == d->previous_chunk_index &&
+                    e->time_index == time_index_beam &&
+                    e->channel_index == channel_index_block &&
+                    e->beam_key == d->beam_key &&
+                    oskar_jones_num_sources(E) == num_src)
+            {
+                cached = 1;
+                d->E_cache_hits++;
+            }
+            else
+            {
+                oskar_jones_set_size(E, num_stations, num_src, status);
+                e->chunk_index = d->previous_chunk_index;
+                e->time_index = time_index_beam;
+                e->channel_index = channel_index_block;
+                e->beam_key = d->beam_key;
+                d->E_cache_misses++;
+            }
+        }
+        if (!cached)
+        {
+            oskar_timer_resume(d->tmr_E);
+            oskar_evaluate_jones_E(E, num_src, OSKAR_RELATIVE_DIRECTIONS,
+                    oskar_sky_l(sky), oskar_sky_m(sky), oskar_sky_n(sky),
+                    d->tel, gast_beam, frequency, d->station_work,
+                    time_index_beam, status);
+            oskar_timer_pause(d->tmr_E);
+        }
 
-    /* Cross-correlate for this time and channel. */
-    if (oskar_vis_block_has_cross_correlations(d->vis_block))
-    {
-        oskar_mem_set_alias(alias,
-                oskar_vis_block_cross_correlations(d->vis_block),
-                num_baselines *
-                (num_channels * time_index_block + channel_index_block),
-                num_baselines, status);
-        oskar_cross_correlate(alias, num_src, d->J, sky, d->tel,
-                d->u, d->v, d->w, gast, frequency, status);
+#if 0
+        /* Evaluate ionospheric phase (Jones Z: scalar) and join with Jones E.
+         * NOTE this is currently only a CPU implementation. */
+        if (d->Z)
+        {
+            oskar_evaluate_jones_Z(d->Z, num_src, sky, d->tel,
+                    &settings->ionosphere, gast, frequency, &(d->workJonesZ),
+                    status);
+            oskar_timer_resume(d->tmr_join);
+            oskar_jones_join(E, d->Z, E, status);
+            oskar_timer_pause(d->tmr_join);
+        }
+#endif
+
+        /* Join parallactic angle with Jones Z*E. */
+        if (d->R && !cached)
+        {
+            oskar_timer_resume(d->tmr_join);
+            oskar_jones_join(E, E, d->R, status);
+            oskar_timer_pause(d->tmr_join);
+        }
+
+        /* Evaluate interferometer phase (Jones K: scalar) and join with
+         * Z*E, unless this is done inside the correlator.
+         * For adjacent channels, the phase is rotated by a constant
+         * increment for each source and station, so Jones K is updated
+         * by multiplication instead of being evaluated from scratch. */
+        if (d->fused)
+        {
+            J = E;
+        }
+        else
+        {
+            oskar_timer_resume(d->tmr_K);
+            if (i == 0 || filter)
+            {
+                oskar_evaluate_jones_K(d->K, num_src, oskar_sky_l_const(sky),
+                        oskar_sky_m_const(sky), oskar_sky_n_const(sky),
+                        d->u, d->v, d->w, frequency, oskar_sky_I_const(sky),
+                        h->source_min_jy, h->source_max_jy, status);
+            }
+            else
+            {
+                if (i == 1)
+                    oskar_evaluate_jones_K(d->K_inc, num_src,
+                            oskar_sky_l_const(sky), oskar_sky_m_const(sky),
+                            oskar_sky_n_const(sky), d->u, d->v, d->w,
+                            h->freq_inc_hz, oskar_sky_I_const(sky),
+                            -DBL_MAX, DBL_MAX, status);
+                oskar_jones_join(d->K, d->K, d->K_inc, status);
+            }
+            oskar_timer_pause(d->tmr_K);
+            oskar_timer_resume(d->tmr_join);
+            oskar_jones_join(d->J, d->K, E, status);
+            oskar_timer_pause(d->tmr_join);
+            J = d->J;
+        }
+
+        /* Auto-correlate for this time and channel. */
+        oskar_timer_resume(d->tmr_correlate);
+        if (oskar_vis_block_has_auto_correlations(d->vis_block))
+        {
+            oskar_Mem* block = oskar_vis_block_auto_correlations(d->vis_block);
+            const size_t offset = num_stations *
+                    (num_channels * time_index_block + channel_index_block);
+            oskar_Mem* vis = vis_slice_get(d, alias, block, offset,
+                    num_stations, status);
+            oskar_auto_correlate(vis, num_src, J, sky, status);
+            vis_slice_put(d, block, offset, num_stations, status);
+        }
+
+        /* Cross-correlate for this time and channel. */
+        if (oskar_vis_block_has_cross_correlations(d->vis_block))
+        {
+            oskar_Mem* block = oskar_vis_block_cross_correlations(d->vis_block);
+            const size_t offset = num_baselines *
+                    (num_channels * time_index_block + channel_index_block);
+            oskar_Mem* vis = vis_slice_get(d, alias, block, offset,
+                    num_baselines, status);
+            if (d->fused)
+                oskar_cross_correlate_fused(vis, num_src, J, sky, d->tel,
+                        d->u, d->v, d->w, gast, frequency,
+                        h->source_min_jy, h->source_max_jy, status);
+            else
+                oskar_cross_correlate(vis, num_src, J, sky, d->tel,
+                        d->u, d->v, d->w, gast, frequency, status);
+            vis_slice_put(d, block, offset, num_baselines, status);
+        }
+        oskar_timer_pause(d->tmr_correlate);
     }
 
     /* Free alias for auto/cross-correlations. */
     oskar_mem_free(alias, status);
-    oskar_timer_pause(d->tmr_correlate);
+}
+
+
+/* Returns the memory to use for a slice of the visibility block.
+ * This is an alias of the block, or a copy of it if using OpenCL. */
+static oskar_Mem* vis_slice_get(DeviceData* d, oskar_Mem* alias,
+        oskar_Mem* block, size_t offset, size_t length, int* status)
+{
+    if (!d->vis_slice)
+    {
+        oskar_mem_set_alias(alias, block, offset, length, status);
+        return alias;
+    }
+    oskar_mem_copy_contents(d->vis_slice, block, 0, offset, length, status);
+    return d->vis_slice;
+}
+
+
+/* Copies a slice back to the visibility block, if it is not an alias. */
+static void vis_slice_put(DeviceData* d, oskar_Mem* block, size_t offset,
+        size_t length, int* status)
+{
+    if (d->vis_slice)
+        oskar_mem_copy_contents(block, d->vis_slice, offset, 0, length,
+                status);
 }
 
 
@@ -1156,7 +1619,8 @@ static void set_up_vis_header(oskar_Interferometer* h, int* status)
 
 static void set_up_device_data(oskar_Interferometer* h, int* status)
 {
-    int i, dev_loc, complx, vistype, num_stations, num_src;
+    int i, j, dev_loc, complx, vistype, num_stations, num_src;
+    int filter_flux, filter_autos, group_channels;
     if (*status) return;
 
     /* Get local variables. */
@@ -1167,21 +1631,38 @@ static void set_up_device_data(oskar_Interferometer* h, int* status)
     if (oskar_telescope_pol_mode(h->tel) == OSKAR_POL_MODE_FULL)
         vistype |= OSKAR_MATRIX;
 
+    /* Auto-correlations use the joined Jones matrices directly, so Jones K
+     * must be stored if it is needed to filter sources by flux. */
+    filter_flux = (h->source_min_jy > -DBL_MAX || h->source_max_jy < DBL_MAX);
+    filter_autos = h->correlation_type != 'C' && filter_flux;
+
+    /* Free any cached station beams if the observation has changed. */
+    if (h->beam_cache_stale)
+    {
+        free_beam_cache(h, status);
+        h->beam_cache_stale = 0;
+    }
+
     /* Expand the number of devices to the number of selected GPUs,
      * if required. */
     if (h->num_devices < h->num_gpus)
         oskar_interferometer_set_num_devices(h, h->num_gpus);
 
+    /* Jones K is applied inside the correlator only if it cannot be
+     * updated more cheaply between the channels in a work unit. */
+    group_channels = channels_per_unit(h, num_times_in_block(h, 0)) > 1;
+
     for (i = 0; i < h->num_devices; ++i)
     {
         DeviceData* d = &h->d[i];
         d->previous_chunk_index = -1;
+        d->previous_time_index = -1;
 
         /* Select the device. */
         if (i < h->num_gpus)
         {
-            oskar_device_set(h->gpu_ids[i], status);
-            dev_loc = OSKAR_GPU;
+            set_gpu(h, i, status);
+            dev_loc = h->gpu_location;
         }
         else
         {
@@ -1216,6 +1697,17 @@ static void set_up_device_data(oskar_Interferometer* h, int* status)
         oskar_vis_block_clear(d->vis_block_cpu[0], status);
         oskar_vis_block_clear(d->vis_block_cpu[1], status);
 
+        /* OpenCL sub-buffers must be aligned to the device base address,
+         * so the correlators write to a separate buffer instead of to
+         * an alias of the visibility block. */
+        if (dev_loc == OSKAR_CL && !d->vis_slice)
+        {
+            const int num_baselines = oskar_telescope_num_baselines(h->tel);
+            d->vis_slice = oskar_mem_create(vistype, dev_loc,
+                    num_baselines > num_stations ?
+                            num_baselines : num_stations, status);
+        }
+
         /* Device scratch memory. */
         if (!d->tel)
         {
@@ -1225,19 +1717,90 @@ static void set_up_device_data(oskar_Interferometer* h, int* status)
             d->chunk = oskar_sky_create(h->prec, dev_loc, num_src, status);
             d->chunk_clip = oskar_sky_create(h->prec, dev_loc, num_src, status);
             d->tel = oskar_telescope_create_copy(h->tel, dev_loc, status);
-            d->J = oskar_jones_create(vistype, dev_loc, num_stations, num_src,
-                    status);
+            d->beam_key = beam_key(h->tel);
+            d->fused = (dev_loc == OSKAR_CPU &&
+                    oskar_type_is_matrix(vistype) && !filter_autos &&
+                    (!group_channels || filter_flux));
+            d->J = d->fused ? 0 : oskar_jones_create(vistype, dev_loc,
+                    num_stations, num_src, status);
             d->R = oskar_type_is_matrix(vistype) ? oskar_jones_create(vistype,
                     dev_loc, num_stations, num_src, status) : 0;
             d->E = oskar_jones_create(vistype, dev_loc, num_stations, num_src,
                     status);
-            d->K = oskar_jones_create(complx, dev_loc, num_stations, num_src,
-                    status);
+            d->K = d->fused ? 0 : oskar_jones_create(complx, dev_loc,
+                    num_stations, num_src, status);
+            d->K_inc = d->fused ? 0 : oskar_jones_create(complx, dev_loc,
+                    num_stations, num_src, status);
             d->Z = 0;
             d->station_work = oskar_station_work_create(h->prec, dev_loc,
                     status);
         }
+
+        /* Station beam cache, with one entry per channel in a work unit,
+         * up to the memory limit. */
+        if (h->beam_cache_tol_sec > 0.0 && !d->E_cache)
+        {
+            const double entry_mb = (double) num_stations * num_src *
+                    oskar_mem_element_size(vistype) / (1024.0 * 1024.0);
+            d->num_E_cache = channels_per_unit(h, num_times_in_block(h, 0));
+            if (h->beam_cache_max_mb > 0.0 &&
+                    d->num_E_cache * entry_mb > h->beam_cache_max_mb)
+                d->num_E_cache = (int) (h->beam_cache_max_mb / entry_mb);
+            if (d->num_E_cache > 0)
+                d->E_cache = (BeamCacheEntry*) calloc(d->num_E_cache,
+                        sizeof(BeamCacheEntry));
+            for (j = 0; j < d->num_E_cache; ++j)
+                d->E_cache[j].E = oskar_jones_create(vistype, dev_loc,
+                        num_stations, num_src, status);
+        }
+        for (j = 0; j < d->num_E_cache; ++j)
+            d->E_cache[j].chunk_index = -1;
+        d->E_cache_hits = d->E_cache_misses = 0;
+        d->mem_heap_allocs = d->mem_reused = 0;
+    }
+}
+
+
+static void free_beam_cache(oskar_Interferometer* h, int* status)
+{
+    int i, j;
+    if (!h->d) return;
+    for (i = 0; i < h->num_devices; ++i)
+    {
+        DeviceData* d = &(h->d[i]);
+        if (!d->E_cache) continue;
+        if (i < h->num_gpus)
+            set_gpu(h, i, status);
+        for (j = 0; j < d->num_E_cache; ++j)
+            oskar_jones_free(d->E_cache[j].E, status);
+        free(d->E_cache);
+        d->E_cache = 0;
+        d->num_E_cache = 0;
+    }
+}
+
+
+static unsigned long long int beam_key(const oskar_Telescope* tel)
+{
+    /* Return a hash of the station types and beam directions (FNV-1a),
+     * which, with the sky, time and frequency, determine the beams. */
+    int i, j, num_stations;
+    unsigned long long int key = 14695981039346656037ULL;
+    num_stations = oskar_telescope_num_stations(tel);
+    for (i = 0; i < num_stations; ++i)
+    {
+        unsigned char b[2 * sizeof(int) + 2 * sizeof(double)];
+        const oskar_Station* s = oskar_telescope_station_const(tel, i);
+        const int type[] = {oskar_station_type(s),
+                oskar_station_beam_coord_type(s)};
+        const double dir[] = {oskar_station_beam_lon_rad(s),
+                oskar_station_beam_lat_rad(s)};
+        memcpy(b, type, sizeof(type));
+        memcpy(b + sizeof(type), dir, sizeof(dir));
+        for (j = 0; j < (int) sizeof(b); ++j)
+            key = (key ^ b[j]) * 1099511628211ULL;
     }
+    return key;
 }
 
 
@@ -1245,12 +1808,13 @@ static void free_device_data(oskar_Interferometer* h, int* status)
 {
     int i;
     if (!h->d) return;
+    free_beam_cache(h, status);
     for (i = 0; i < h->num_devices; ++i)
     {
         DeviceData* d = &(h->d[i]);
         if (!d) continue;
         if (i < h->num_gpus)
-            oskar_device_set(h->gpu_ids[i], status);
+            set_gpu(h, i, status);
         oskar_timer_free(d->tmr_compute);
         oskar_timer_free(d->tmr_copy);
         oskar_timer_free(d->tmr_clip);
@@ -1261,6 +1825,7 @@ static void free_device_data(oskar_Interferometer* h, int* status)
         oskar_vis_block_free(d->vis_block_cpu[0], status);
         oskar_vis_block_free(d->vis_block_cpu[1], status);
         oskar_vis_block_free(d->vis_block, status);
+        oskar_mem_free(d->vis_slice, status);
         oskar_mem_free(d->u, status);
         oskar_mem_free(d->v, status);
         oskar_mem_free(d->w, status);
@@ -1271,18 +1836,41 @@ static void free_device_data(oskar_Interferometer* h, int* status)
         oskar_jones_free(d->J, status);
         oskar_jones_free(d->E, status);
         oskar_jones_free(d->K, status);
+        oskar_jones_free(d->K_inc, status);
         oskar_jones_free(d->R, status);
         memset(d, 0, sizeof(DeviceData));
     }
 }
 
 
+static void set_gpu(const oskar_Interferometer* h, int i, int* status)
+{
+    if (h->gpu_location == OSKAR_CL)
+        oskar_cl_set_device((unsigned int) h->gpu_ids[i], status);
+    else
+        oskar_device_set(h->gpu_ids[i], status);
+}
+
+
+static void free_sky_index(oskar_Interferometer* h)
+{
+    int i;
+    if (!h->sky_index) return;
+    for (i = 0; i < h->num_sky_chunks; ++i)
+        oskar_sky_index_free(h->sky_index[i]);
+    free(h->sky_index);
+    h->sky_index = 0;
+}
+
+
 static void record_timing(oskar_Interferometer* h)
 {
     /* Obtain component times. */
     int i;
     double t_copy = 0., t_clip = 0., t_E = 0., t_K = 0., t_join = 0.;
     double t_correlate = 0., t_compute = 0., t_components = 0.;
+    unsigned long long int cache_hits = 0, cache_misses = 0;
+    unsigned long long int mem_heap_allocs = 0, mem_reused = 0;
     double *compute_times;
     compute_times = (double*) calloc(h->num_devices, sizeof(double));
     for (i = 0; i < h->num_devices; ++i)
@@ -1295,6 +1883,10 @@ static void record_timing(oskar_Interferometer* h)
         t_K += oskar_timer_elapsed(h->d[i].tmr_K);
         t_correlate += oskar_timer_elapsed(h->d[i].tmr_correlate);
         t_compute += compute_times[i];
+        cache_hits += h->d[i].E_cache_hits;
+        cache_misses += h->d[i].E_cache_misses;
+        mem_heap_allocs += h->d[i].mem_heap_allocs;
+        mem_reused += h->d[i].mem_reused;
     }
     t_components = t_copy + t_clip + t_E + t_K + t_join + t_correlate;
 
@@ -1322,6 +1914,21 @@ static void record_timing(oskar_Interferometer* h)
             (t_correlate / t_compute) * 100.0);
     oskar_log_value(h->log, 'M', 1, "Other", "%4.1f%%",
             ((t_compute - t_components) / t_compute) * 100.0);
+    if (h->beam_cache_tol_sec > 0.0)
+    {
+        oskar_log_message(h->log, 'M', 0, "Station beam cache:");
+        oskar_log_value(h->log, 'M', 1, "Channels per device", "%d",
+                h->d[0].num_E_cache);
+        oskar_log_value(h->log, 'M', 1, "Hits", "%llu", cache_hits);
+        oskar_log_value(h->log, 'M', 1, "Misses", "%llu", cache_misses);
+    }
+    oskar_log_message(h->log, 'M', 0, "Memory allocations:");
+    oskar_log_value(h->log, 'M', 1, "Heap", "%llu", mem_heap_allocs);
+    oskar_log_value(h->log, 'M', 1, "Reused handles", "%llu", mem_reused);
+    if (h->num_chunks_skipped > 0)
+        oskar_log_value(h->log, 'M', 0, "Chunks below horizon", "%d of %d",
+                h->num_chunks_skipped, h->num_sky_chunks *
+                oskar_interferometer_num_vis_blocks(h));
     free(compute_times);
 }
 
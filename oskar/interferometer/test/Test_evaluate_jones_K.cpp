@@ -36,13 +36,14 @@
 
 #include <cstdio>
 
-static void run_test(int type, double tol)
-{
 #ifdef OSKAR_HAVE_CUDA
-    int location = OSKAR_GPU;
+static int device_loc = OSKAR_GPU;
 #else
-    int location = OSKAR_CPU;
+static int device_loc = OSKAR_CPU;
 #endif
+
+static void run_test(int type, int location, double tol)
+{
     int num_sources = 1000;
     int num_stations = 100;
     int n_tries = 30;
@@ -120,10 +121,22 @@ static void run_test(int type, double tol)
 
 TEST(Jones_K, test_single)
 {
-    run_test(OSKAR_SINGLE, 1e-5);
+    run_test(OSKAR_SINGLE, device_loc, 1e-5);
 }
 
 TEST(Jones_K, test_double)
 {
-    run_test(OSKAR_DOUBLE, 1e-8);
+    run_test(OSKAR_DOUBLE, device_loc, 1e-8);
+}
+
+#ifdef OSKAR_HAVE_OPENCL
+TEST(Jones_K, test_single_CL)
+{
+    run_test(OSKAR_SINGLE, OSKAR_CL, 1e-5);
 }
+
+TEST(Jones_K, test_double_CL)
+{
+    run_test(OSKAR_DOUBLE, OSKAR_CL, 1e-8);
+}
+#endif
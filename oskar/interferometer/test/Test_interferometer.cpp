@@ -0,0 +1,352 @@
+/*
+ * Copyright (c) 2018, The University of Oxford
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the University of Oxford nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "binary/oskar_binary.h"
+#include "convert/oskar_convert_mjd_to_gast_fast.h"
+#include "interferometer/oskar_interferometer.h"
+#include "math/oskar_cmath.h"
+#include "sky/oskar_sky.h"
+#include "telescope/oskar_telescope.h"
+#include "utility/oskar_dir.h"
+#include "utility/oskar_get_error_string.h"
+#include "vis/oskar_vis.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+static const double lon_deg = 21.44, lat_deg = -30.71, mjd_start = 57000.5;
+
+static void write_telescope(const char* dir, int num_stations,
+        int num_elements)
+{
+    FILE* f;
+    char* path;
+    char station_name[32];
+
+    if (oskar_dir_exists(dir)) oskar_dir_remove(dir);
+    oskar_dir_mkpath(dir);
+    path = oskar_dir_get_path(dir, "position.txt");
+    f = fopen(path, "w");
+    fprintf(f, "%.2f,%.2f\n", lon_deg, lat_deg);
+    fclose(f);
+    free(path);
+    path = oskar_dir_get_path(dir, "layout.txt");
+    f = fopen(path, "w");
+    for (int i = 0; i < num_stations; ++i)
+        fprintf(f, "%.1f,%.1f\n", 230.0 * cos(1.3 * i) * (i + 1),
+                170.0 * sin(0.7 * i) * (i + 1));
+    fclose(f);
+    free(path);
+    for (int i = 0; i < num_stations; ++i)
+    {
+        sprintf(station_name, "station%03d", i);
+        char* station_dir = oskar_dir_get_path(dir, station_name);
+        oskar_dir_mkpath(station_dir);
+        path = oskar_dir_get_path(station_dir, "layout.txt");
+        f = fopen(path, "w");
+        for (int j = 0; j < num_elements; ++j)
+            fprintf(f, "%.2f,%.2f\n", (j % 4) * 1.5 + 0.1 * i, (j / 4) * 1.5);
+        fclose(f);
+        free(path);
+        free(station_dir);
+    }
+}
+
+static oskar_Telescope* load_telescope(const char* dir, int type,
+        double ra0_rad, double dec0_rad, int* status,
+        const char* pol_mode = "Scalar")
+{
+    oskar_Telescope* tel = oskar_telescope_create(type, OSKAR_CPU, 0, status);
+    oskar_telescope_set_enable_numerical_patterns(tel, 0);
+    oskar_telescope_load(tel, dir, NULL, status);
+    oskar_telescope_set_pol_mode(tel, pol_mode, status);
+    oskar_telescope_set_phase_centre(tel,
+            OSKAR_SPHERICAL_TYPE_EQUATORIAL, ra0_rad, dec0_rad);
+    return tel;
+}
+
+static oskar_Sky* create_sky(int type, int num_sources,
+        double ra0_rad, double dec0_rad, int* status)
+{
+    oskar_Sky* sky = oskar_sky_create(type, OSKAR_CPU, num_sources, status);
+    for (int i = 0; i < num_sources; ++i)
+    {
+        const double r = 0.002 * (i + 1);
+        oskar_sky_set_source(sky, i, ra0_rad + r * cos(2.4 * i),
+                dec0_rad + r * sin(2.4 * i), 1.0 + 0.1 * i, 0.0, 0.0, 0.0,
+                100e6, -0.7, 0.0, 0.0, 0.0, 0.0, status);
+    }
+    return sky;
+}
+
+static oskar_Vis* simulate(const oskar_Telescope* tel, const oskar_Sky* sky,
+        int type, double freq_start_hz, double freq_inc_hz, int num_channels,
+        int num_times, double cache_tol_sec, double cache_max_mb,
+        const char* filename, int* status, int use_opencl = 0)
+{
+    const int gpu_ids[] = {0};
+    oskar_Vis* vis = 0;
+    oskar_Interferometer* h = oskar_interferometer_create(type, status);
+    if (use_opencl)
+        oskar_interferometer_set_use_opencl(h, 1, status);
+    oskar_interferometer_set_gpus(h, use_opencl ? 1 : 0, gpu_ids, status);
+    oskar_interferometer_set_num_devices(h, 1);
+    oskar_interferometer_set_max_times_per_block(h, num_times);
+    oskar_interferometer_set_observation_frequency(h,
+            freq_start_hz, freq_inc_hz, num_channels);
+    oskar_interferometer_set_observation_time(h, mjd_start, 60.0, num_times);
+    oskar_interferometer_set_station_beam_cache_tolerance(h, cache_tol_sec,
+            status);
+    oskar_interferometer_set_station_beam_cache_max_memory_mb(h,
+            cache_max_mb, status);
+    oskar_interferometer_set_correlation_type(h, "Cross-correlations", status);
+    oskar_interferometer_set_telescope_model(h, tel, status);
+    oskar_interferometer_set_sky_model(h, sky, status);
+    oskar_interferometer_set_output_vis_file(h, filename);
+    oskar_interferometer_run(h, status);
+    oskar_interferometer_free(h, status);
+    if (!*status)
+    {
+        oskar_Binary* file = oskar_binary_create(filename, 'r', status);
+        vis = oskar_vis_read(file, status);
+        oskar_binary_free(file);
+    }
+    remove(filename);
+    return vis;
+}
+
+static void grouped_channels_test(const char* pol_mode)
+{
+    // Use enough time samples per block that all channels form one unit
+    // of the maximum size.
+    const int num_channels = 64, num_times = 4;
+    const double freq_start_hz = 100e6, freq_inc_hz = 200e3;
+    const char* tel_dir = "temp_test_interferometer_grouped";
+    int status = 0;
+    double ra0 = oskar_convert_mjd_to_gast_fast(mjd_start) +
+            lon_deg * M_PI / 180.0;
+    double dec0 = lat_deg * M_PI / 180.0;
+    write_telescope(tel_dir, 8, 16);
+    oskar_Telescope* tel = load_telescope(tel_dir, OSKAR_SINGLE,
+            ra0, dec0, &status, pol_mode);
+    oskar_Telescope* tel_d = load_telescope(tel_dir, OSKAR_DOUBLE,
+            ra0, dec0, &status, pol_mode);
+    oskar_Sky* sky = create_sky(OSKAR_SINGLE, 20, ra0, dec0, &status);
+    oskar_Sky* sky_d = create_sky(OSKAR_DOUBLE, 20, ra0, dec0, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+    // Simulate all channels together in single precision.
+    oskar_Vis* vis = simulate(tel, sky, OSKAR_SINGLE, freq_start_hz,
+            freq_inc_hz, num_channels, num_times, 0.0, 0.0,
+            "temp_test_grouped.vis", &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    ASSERT_EQ(num_channels, oskar_vis_num_channels(vis));
+    const oskar_Mem* amp_grouped = oskar_vis_amplitude_const(vis);
+    const int block = num_times * oskar_vis_num_baselines(vis) *
+            (oskar_mem_is_matrix(amp_grouped) ? 4 : 1);
+    const float2* grouped = (const float2*)
+            oskar_mem_void_const(amp_grouped);
+
+    // Simulate each channel on its own, in single and double precision.
+    double max_err_grouped = 0.0, max_err_single = 0.0, max_amp = 0.0;
+    for (int c = 0; c < num_channels; ++c)
+    {
+        const double freq_hz = freq_start_hz + c * freq_inc_hz;
+        oskar_Vis* ref_f = simulate(tel, sky, OSKAR_SINGLE, freq_hz,
+                freq_inc_hz, 1, num_times, 0.0, 0.0,
+                "temp_test_per_channel.vis", &status);
+        oskar_Vis* ref_d = simulate(tel_d, sky_d, OSKAR_DOUBLE, freq_hz,
+                freq_inc_hz, 1, num_times, 0.0, 0.0,
+                "temp_test_per_channel.vis", &status);
+        ASSERT_EQ(0, status) << oskar_get_error_string(status);
+        const float2* single = (const float2*)
+                oskar_mem_void_const(oskar_vis_amplitude_const(ref_f));
+        const double2* exact = (const double2*)
+                oskar_mem_void_const(oskar_vis_amplitude_const(ref_d));
+        for (int i = 0; i < block; ++i)
+        {
+            const float2 a = grouped[c * block + i], b = single[i];
+            const double2 e = exact[i];
+            const double err_a = sqrt(pow(a.x - e.x, 2) + pow(a.y - e.y, 2));
+            const double err_b = sqrt(pow(b.x - e.x, 2) + pow(b.y - e.y, 2));
+            const double amp = sqrt(e.x * e.x + e.y * e.y);
+            if (err_a > max_err_grouped) max_err_grouped = err_a;
+            if (err_b > max_err_single) max_err_single = err_b;
+            if (amp > max_amp) max_amp = amp;
+        }
+        oskar_vis_free(ref_f, &status);
+        oskar_vis_free(ref_d, &status);
+    }
+
+    // The grouped result should be as accurate as per-channel evaluation.
+    EXPECT_GT(max_amp, 0.0);
+    EXPECT_LT(max_err_grouped, 2.0 * max_err_single + 1e-6 * max_amp);
+    EXPECT_LT(max_err_grouped, 2e-3 * max_amp);
+
+    // Clean up.
+    oskar_vis_free(vis, &status);
+    oskar_sky_free(sky, &status);
+    oskar_sky_free(sky_d, &status);
+    oskar_telescope_free(tel, &status);
+    oskar_telescope_free(tel_d, &status);
+    oskar_dir_remove(tel_dir);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+}
+
+TEST(interferometer, grouped_channels_match_per_channel)
+{
+    grouped_channels_test("Scalar");
+}
+
+TEST(interferometer, grouped_channels_match_per_channel_polarised)
+{
+    grouped_channels_test("Full");
+}
+
+
+static double max_diff(const oskar_Vis* a, const oskar_Vis* b,
+        double* max_amp, int* status)
+{
+    const oskar_Mem* mem_a = oskar_vis_amplitude_const(a);
+    const oskar_Mem* mem_b = oskar_vis_amplitude_const(b);
+    const float2* p_a = oskar_mem_float2_const(mem_a, status);
+    const float2* p_b = oskar_mem_float2_const(mem_b, status);
+    const size_t n = oskar_mem_length(mem_a);
+    double max_abs_diff = 0.0;
+    *max_amp = 0.0;
+    if (*status || n != oskar_mem_length(mem_b)) return -1.0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        const double diff = sqrt(pow(p_a[i].x - p_b[i].x, 2) +
+                pow(p_a[i].y - p_b[i].y, 2));
+        const double amp = sqrt(p_b[i].x * p_b[i].x + p_b[i].y * p_b[i].y);
+        if (diff > max_abs_diff) max_abs_diff = diff;
+        if (amp > *max_amp) *max_amp = amp;
+    }
+    return max_abs_diff;
+}
+
+TEST(interferometer, station_beam_cache)
+{
+    // Beams are evaluated once per three time samples with this tolerance.
+    const int type = OSKAR_SINGLE, num_channels = 8, num_times = 6;
+    const double freq_start_hz = 100e6, freq_inc_hz = 1e6, tol_sec = 90.0;
+    const char* tel_dir = "temp_test_interferometer_beam_cache";
+    int status = 0;
+    double diff, max_amp = 0.0;
+    double ra0 = oskar_convert_mjd_to_gast_fast(mjd_start) +
+            lon_deg * M_PI / 180.0;
+    double dec0 = lat_deg * M_PI / 180.0;
+    write_telescope(tel_dir, 8, 16);
+    oskar_Telescope* tel = load_telescope(tel_dir, type, ra0, dec0, &status);
+    oskar_Sky* sky = create_sky(type, 20, ra0, dec0, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+    // Simulate with all channels cached, with some channels cached,
+    // and with a memory limit too small to cache any beams.
+    // Each cache entry for this telescope and chunk size needs 1 MB.
+    oskar_Vis* vis_all = simulate(tel, sky, type, freq_start_hz, freq_inc_hz,
+            num_channels, num_times, tol_sec, 0.0, "temp_test_cache.vis",
+            &status);
+    oskar_Vis* vis_some = simulate(tel, sky, type, freq_start_hz,
+            freq_inc_hz, num_channels, num_times, tol_sec, 3.5,
+            "temp_test_cache.vis", &status);
+    oskar_Vis* vis_none = simulate(tel, sky, type, freq_start_hz,
+            freq_inc_hz, num_channels, num_times, tol_sec, 0.5,
+            "temp_test_cache.vis", &status);
+    oskar_Vis* vis_exact = simulate(tel, sky, type, freq_start_hz,
+            freq_inc_hz, num_channels, num_times, 0.0, 0.0,
+            "temp_test_cache.vis", &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+    // Beams reused from the cache must match those evaluated directly
+    // at the same beam time.
+    diff = max_diff(vis_all, vis_none, &max_amp, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    EXPECT_GT(max_amp, 0.0);
+    EXPECT_LE(diff, 1e-6 * max_amp);
+    diff = max_diff(vis_some, vis_none, &max_amp, &status);
+    EXPECT_LE(diff, 1e-6 * max_amp);
+
+    // The beams change only slightly over the cache interval.
+    diff = max_diff(vis_all, vis_exact, &max_amp, &status);
+    EXPECT_GT(diff, 0.0);
+    EXPECT_LT(diff, 1e-2 * max_amp);
+
+    // Clean up.
+    oskar_vis_free(vis_all, &status);
+    oskar_vis_free(vis_some, &status);
+    oskar_vis_free(vis_none, &status);
+    oskar_vis_free(vis_exact, &status);
+    oskar_sky_free(sky, &status);
+    oskar_telescope_free(tel, &status);
+    oskar_dir_remove(tel_dir);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+}
+
+#ifdef OSKAR_HAVE_OPENCL
+TEST(interferometer, simulate_singleCL_singleCPU)
+{
+    const int type = OSKAR_SINGLE, num_channels = 4, num_times = 3;
+    const double freq_start_hz = 100e6, freq_inc_hz = 1e6;
+    const char* tel_dir = "temp_test_interferometer_opencl";
+    int status = 0;
+    double diff, max_amp = 0.0;
+    double ra0 = oskar_convert_mjd_to_gast_fast(mjd_start) +
+            lon_deg * M_PI / 180.0;
+    double dec0 = lat_deg * M_PI / 180.0;
+    write_telescope(tel_dir, 8, 16);
+    oskar_Telescope* tel = load_telescope(tel_dir, type, ra0, dec0, &status);
+    oskar_Sky* sky = create_sky(type, 20, ra0, dec0, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+    // Simulate on the CPU and on an OpenCL CPU device.
+    oskar_Vis* vis_cpu = simulate(tel, sky, type, freq_start_hz, freq_inc_hz,
+            num_channels, num_times, 0.0, 0.0, "temp_test_opencl.vis",
+            &status, 0);
+    oskar_Vis* vis_cl = simulate(tel, sky, type, freq_start_hz, freq_inc_hz,
+            num_channels, num_times, 0.0, 0.0, "temp_test_opencl.vis",
+            &status, 1);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    diff = max_diff(vis_cl, vis_cpu, &max_amp, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    EXPECT_GT(max_amp, 0.0);
+    EXPECT_LE(diff, 1e-4 * max_amp);
+
+    // Clean up.
+    oskar_vis_free(vis_cpu, &status);
+    oskar_vis_free(vis_cl, &status);
+    oskar_sky_free(sky, &status);
+    oskar_telescope_free(tel, &status);
+    oskar_dir_remove(tel_dir);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+}
+#endif
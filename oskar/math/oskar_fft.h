@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2018, The University of Oxford
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the University of Oxford nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef OSKAR_FFT_H_
+#define OSKAR_FFT_H_
+
+/**
+ * @file oskar_fft.h
+ */
+
+#include <oskar_global.h>
+#include <mem/oskar_mem.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct oskar_FFT;
+#ifndef OSKAR_FFT_TYPEDEF_
+#define OSKAR_FFT_TYPEDEF_
+typedef struct oskar_FFT oskar_FFT;
+#endif /* OSKAR_FFT_TYPEDEF_ */
+
+enum OSKAR_FFT_BACKEND
+{
+    OSKAR_FFT_DEFAULT,
+    OSKAR_FFT_FFTPACK,
+    OSKAR_FFT_FFTPACK_THREADED,
+    OSKAR_FFT_FFTW,
+    OSKAR_FFT_CUFFT
+};
+
+/**
+ * @brief Creates a plan for a square two-dimensional complex FFT.
+ *
+ * @details
+ * Creates a plan for an in-place forward complex-to-complex FFT
+ * of a square grid, with the specified side length.
+ *
+ * The backend is an enumerated value from the following list:
+ *
+ * - OSKAR_FFT_DEFAULT: Choose the fastest available backend at run time
+ *   for the given location. This is cuFFT for GPU memory, FFTW if OSKAR
+ *   was compiled with it, otherwise the multi-threaded FFTPACK backend.
+ * - OSKAR_FFT_FFTPACK: Use the single-threaded FFTPACK transform.
+ * - OSKAR_FFT_FFTPACK_THREADED: Use FFTPACK to transform blocks of rows
+ *   in parallel, transposing the grid between the row and column passes.
+ * - OSKAR_FFT_FFTW: Use FFTW, if OSKAR was compiled with it.
+ * - OSKAR_FFT_CUFFT: Use cuFFT, if OSKAR was compiled with CUDA.
+ *
+ * If FFTW fails to create a plan, the multi-threaded FFTPACK backend
+ * is used instead.
+ *
+ * @param[in] precision    Enumerated precision (OSKAR_SINGLE or OSKAR_DOUBLE).
+ * @param[in] location     Enumerated location (OSKAR_CPU or OSKAR_GPU).
+ * @param[in] grid_size    Side length of the grid.
+ * @param[in] backend      Enumerated backend type, as above.
+ * @param[in,out] status   Status return code.
+ *
+ * @return A handle to the FFT plan.
+ */
+OSKAR_EXPORT
+oskar_FFT* oskar_fft_create(int precision, int location, int grid_size,
+        int backend, int* status);
+
+/**
+ * @brief Returns the backend used by an FFT plan.
+ *
+ * @details
+ * Returns the enumerated backend type used by the FFT plan.
+ * This will never be OSKAR_FFT_DEFAULT.
+ *
+ * @param[in] h  Handle to FFT plan.
+ */
+OSKAR_EXPORT
+int oskar_fft_backend(const oskar_FFT* h);
+
+/**
+ * @brief Returns the name of the backend used by an FFT plan.
+ *
+ * @details
+ * Returns a human-readable name for the backend used by the FFT plan.
+ *
+ * @param[in] h  Handle to FFT plan.
+ */
+OSKAR_EXPORT
+const char* oskar_fft_backend_name(const oskar_FFT* h);
+
+/**
+ * @brief Performs a forward FFT in place.
+ *
+ * @details
+ * Performs an unnormalised forward FFT of the data, in place.
+ * No shifts are applied.
+ *
+ * Data in CPU memory are copied to and from the GPU if the plan uses cuFFT.
+ *
+ * Plans using CPU backends may be executed concurrently by multiple
+ * threads on different arrays.
+ *
+ * @param[in] h            Handle to FFT plan.
+ * @param[in,out] data     Complex grid of length grid_size * grid_size.
+ * @param[in,out] status   Status return code.
+ */
+OSKAR_EXPORT
+void oskar_fft_exec(oskar_FFT* h, oskar_Mem* data, int* status);
+
+/**
+ * @brief Destroys an FFT plan.
+ *
+ * @details
+ * Destroys an FFT plan and releases all resources held by it.
+ *
+ * @param[in] h  Handle to FFT plan.
+ */
+OSKAR_EXPORT
+void oskar_fft_free(oskar_FFT* h);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OSKAR_FFT_H_ */
@@ -50,6 +50,10 @@ void oskar_fftpack_cfft2f_f(const int ldim, const int l, const int m,
 OSKAR_EXPORT
 void oskar_fftpack_cfft2i_f(const int l, const int m, float *wsave);
 
+OSKAR_EXPORT
+void oskar_fftpack_cfftmf_f(const int lot, const int jump, const int n,
+        const int inc, float *c, float *wsave, float *work);
+
 #ifdef __cplusplus
 }
 #endif
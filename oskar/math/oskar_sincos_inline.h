@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2018, The University of Oxford
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the University of Oxford nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef OSKAR_SINCOS_INLINE_H_
+#define OSKAR_SINCOS_INLINE_H_
+
+/**
+ * @file oskar_sincos_inline.h
+ */
+
+#include <oskar_global.h>
+#include <math.h>
+
+/*
+ * Sine and cosine are evaluated together using a three-part Cody-Waite
+ * reduction of the argument to the range [-pi/4, pi/4], followed by
+ * minimax polynomials (from Cephes) of the degree needed for each precision.
+ * Apart from the check on the size of the argument, these functions contain
+ * no branches or library calls, so they can be inlined into loops that the
+ * compiler vectorises.
+ *
+ * The reduction is only accurate for |x| < OSKAR_SINCOS_MAX_ARG, so larger
+ * arguments (and infinities or NaNs) are passed to the library functions.
+ *
+ * Accuracy can be selected separately for each precision:
+ * oskar_sincos_f() reduces the argument in double precision, so it is as
+ * accurate as evaluating sin() and cos() of the single-precision argument
+ * in double precision. oskar_sincos_fast_f() does the reduction in single
+ * precision, which is faster, for |x| < 8192.
+ */
+
+/* Largest argument for which the range reduction is accurate (2^30). */
+#define OSKAR_SINCOS_MAX_ARG 1073741824.0
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief
+ * Evaluates sine and cosine of an angle (single precision).
+ *
+ * @details
+ * Evaluates sine and cosine of an angle, in radians.
+ *
+ * The argument is reduced in double precision, and the polynomials are
+ * evaluated in single precision. The maximum error is about 1e-7
+ * for all arguments.
+ *
+ * @param[in] x      Angle, in radians.
+ * @param[out] s     Sine of the angle.
+ * @param[out] c     Cosine of the angle.
+ */
+OSKAR_INLINE
+void oskar_sincos_f(const float x, float* s, float* c)
+{
+    const double dp1 = 7.85398125648498535156e-1;
+    const double dp2 = 3.77489470793079817668e-8;
+    const double dp3 = 2.69515142907905952645e-15;
+    const double four_over_pi = 1.27323954473516268615;
+    double ax, y;
+    float z, zz, ps, pc, s_, c_;
+    int j, q;
+
+    /* Reduce the argument to the range [-pi/4, pi/4] in quadrant q. */
+    ax = x < 0.0f ? -(double) x : (double) x;
+    if (!(ax < OSKAR_SINCOS_MAX_ARG))
+    {
+        *s = (float) sin((double) x);
+        *c = (float) cos((double) x);
+        return;
+    }
+    j = (int) (ax * four_over_pi);
+    j = (j + 1) & ~1;
+    y = (double) j;
+    z = (float) (((ax - y * dp1) - y * dp2) - y * dp3);
+    q = (j >> 1) & 3;
+
+    /* Evaluate the polynomials. */
+    zz = z * z;
+    ps = ((-1.9515295891e-4f * zz + 8.3321608736e-3f) * zz -
+            1.6666654611e-1f) * zz * z + z;
+    pc = ((2.443315711809948e-5f * zz - 1.388731625493765e-3f) * zz +
+            4.166664568298827e-2f) * zz * zz - 0.5f * zz + 1.0f;
+
+    /* Select and apply the signs for the quadrant. */
+    s_ = (q & 1) ? pc : ps;
+    c_ = (q & 1) ? ps : pc;
+    *s = (((q & 2) != 0) != (x < 0.0f)) ? -s_ : s_;
+    *c = (((q + 1) & 2) != 0) ? -c_ : c_;
+}
+
+/**
+ * @brief
+ * Evaluates sine and cosine of an angle (fast single precision).
+ *
+ * @details
+ * Evaluates sine and cosine of an angle, in radians,
+ * reducing the argument in single precision.
+ *
+ * The maximum error is a few units in the last place for |x| < 8192.
+ * Larger arguments are passed to oskar_sincos_f(), so this is only
+ * faster if the argument is known to be small.
+ *
+ * @param[in] x      Angle, in radians.
+ * @param[out] s     Sine of the angle.
+ * @param[out] c     Cosine of the angle.
+ */
+OSKAR_INLINE
+void oskar_sincos_fast_f(const float x, float* s, float* c)
+{
+    const float dp1 = 0.78515625f;
+    const float dp2 = 2.4187564849853515625e-4f;
+    const float dp3 = 3.77489497744594108e-8f;
+    const float four_over_pi = 1.27323954473516f;
+    float ax, y, z, zz, ps, pc, s_, c_;
+    int j, q;
+
+    /* Reduce the argument to the range [-pi/4, pi/4] in quadrant q. */
+    ax = x < 0.0f ? -x : x;
+    if (!(ax < 8192.0f))
+    {
+        oskar_sincos_f(x, s, c);
+        return;
+    }
+    j = (int) (ax * four_over_pi);
+    j = (j + 1) & ~1;
+    y = (float) j;
+    z = ((ax - y * dp1) - y * dp2) - y * dp3;
+    q = (j >> 1) & 3;
+
+    /* Evaluate the polynomials. */
+    zz = z * z;
+    ps = ((-1.9515295891e-4f * zz + 8.3321608736e-3f) * zz -
+            1.6666654611e-1f) * zz * z + z;
+    pc = ((2.443315711809948e-5f * zz - 1.388731625493765e-3f) * zz +
+            4.166664568298827e-2f) * zz * zz - 0.5f * zz + 1.0f;
+
+    /* Select and apply the signs for the quadrant. */
+    s_ = (q & 1) ? pc : ps;
+    c_ = (q & 1) ? ps : pc;
+    *s = (((q & 2) != 0) != (x < 0.0f)) ? -s_ : s_;
+    *c = (((q + 1) & 2) != 0) ? -c_ : c_;
+}
+
+/**
+ * @brief
+ * Evaluates sine and cosine of an angle (double precision).
+ *
+ * @details
+ * Evaluates sine and cosine of an angle, in radians.
+ *
+ * The maximum error is a few units in the last place for |x| < 2^30.
+ * Larger arguments are passed to sin() and cos().
+ *
+ * @param[in] x      Angle, in radians.
+ * @param[out] s     Sine of the angle.
+ * @param[out] c     Cosine of the angle.
+ */
+OSKAR_INLINE
+void oskar_sincos_d(const double x, double* s, double* c)
+{
+    const double dp1 = 7.85398125648498535156e-1;
+    const double dp2 = 3.77489470793079817668e-8;
+    const double dp3 = 2.69515142907905952645e-15;
+    const double four_over_pi = 1.27323954473516268615;
+    double ax, y, z, zz, ps, pc, s_, c_;
+    int j, q;
+
+    /* Reduce the argument to the range [-pi/4, pi/4] in quadrant q. */
+    ax = x < 0.0 ? -x : x;
+    if (!(ax < OSKAR_SINCOS_MAX_ARG))
+    {
+        *s = sin(x);
+        *c = cos(x);
+        return;
+    }
+    j = (int) (ax * four_over_pi);
+    j = (j + 1) & ~1;
+    y = (double) j;
+    z = ((ax - y * dp1) - y * dp2) - y * dp3;
+    q = (j >> 1) & 3;
+
+    /* Evaluate the polynomials. */
+    zz = z * z;
+    ps = (((((1.58962301576546568060e-10 * zz -
+            2.50507477628578072866e-8) * zz +
+            2.75573136213857245213e-6) * zz -
+            1.98412698295895385996e-4) * zz +
+            8.33333333332211858878e-3) * zz -
+            1.66666666666666307295e-1) * zz * z + z;
+    pc = (((((-1.13585365213876817300e-11 * zz +
+            2.08757008419747316778e-9) * zz -
+            2.75573141792967388112e-7) * zz +
+            2.48015872888517045348e-5) * zz -
+            1.38888888888730564116e-3) * zz +
+            4.16666666666665929218e-2) * zz * zz - 0.5 * zz + 1.0;
+
+    /* Select and apply the signs for the quadrant. */
+    s_ = (q & 1) ? pc : ps;
+    c_ = (q & 1) ? ps : pc;
+    *s = (((q & 2) != 0) != (x < 0.0)) ? -s_ : s_;
+    *c = (((q + 1) & 2) != 0) ? -c_ : c_;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OSKAR_SINCOS_INLINE_H_ */
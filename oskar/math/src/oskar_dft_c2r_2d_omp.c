@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2016, The University of Oxford
+ * Copyright (c) 2013-2018, The University of Oxford
  * All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
@@ -25,50 +25,121 @@
  * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
  * POSSIBILITY OF SUCH DAMAGE.
  */
-
 #include "math/oskar_dft_c2r_2d_omp.h"
+#include "math/oskar_sincos_inline.h"
+#include <float.h>
 #include <math.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/*
+ * Outputs are processed in runs of up to RUN_SIZE points. If all points in a
+ * run lie on a line of constant y and are evenly spaced in x (as they are for
+ * pixels along an image row), the phasor for each input point is evaluated
+ * only once for the run, and rotated from one output to the next using a
+ * complex multiply by the phasor of the pixel separation. Otherwise, each
+ * output point is evaluated directly.
+ */
+#define RUN_SIZE 32
+#define BLOCK_SIZE 256
+
 /* Single precision. */
 void oskar_dft_c2r_2d_omp_f(const int num_in, const float wavenumber,
         const float* x_in, const float* y_in, const float2* data_in,
         const float* weight_in, const int num_out, const float* x_out,
         const float* y_out, float* output)
 {
-    int i_out = 0;
+    int r = 0;
+    const int num_runs = (num_out + RUN_SIZE - 1) / RUN_SIZE;
 
-    /* Loop over output points. */
-    #pragma omp parallel for private(i_out)
-    for (i_out = 0; i_out < num_out; ++i_out)
+    /* Loop over runs of output points. */
+    #pragma omp parallel for private(r) schedule(dynamic, 1)
+    for (r = 0; r < num_runs; ++r)
     {
-        int i;
-        float xp_out, yp_out, out = 0.0f; /* Clear output value. */
+        int i, k, n, regular = 1;
+        float dx = 0.0f, out[RUN_SIZE];
+        const int o = r * RUN_SIZE;
+        const float x0 = x_out[o], y0 = y_out[o];
+        n = num_out - o;
+        if (n > RUN_SIZE) n = RUN_SIZE;
+
+        /* Check whether the output points are evenly spaced. */
+        if (n > 1) dx = (x_out[o + n - 1] - x0) / (n - 1);
+        for (k = 0; k < n; ++k)
+        {
+            const float x = x_out[o + k];
+            out[k] = 0.0f;
+            if (y_out[o + k] != y0 || !(fabsf(x - (x0 + k * dx)) <=
+                    4.0f * FLT_EPSILON * (fabsf(x0) + fabsf(x))))
+                regular = 0;
+        }
+
+        if (regular)
+        {
+            float c[BLOCK_SIZE], s[BLOCK_SIZE], dc[BLOCK_SIZE], ds[BLOCK_SIZE];
+            float re[BLOCK_SIZE], im[BLOCK_SIZE];
+            const float xp_out = wavenumber * x0, yp_out = wavenumber * y0;
+            const float xp_step = wavenumber * dx;
+            int b, block_size;
+            for (b = 0; b < num_in; b += BLOCK_SIZE)
+            {
+                block_size = num_in - b;
+                if (block_size > BLOCK_SIZE) block_size = BLOCK_SIZE;
 
-        /* Get the output position. */
-        xp_out = wavenumber * x_out[i_out];
-        yp_out = wavenumber * y_out[i_out];
+                /* Evaluate starting and step phasors for the block. */
+                #pragma omp simd
+                for (i = 0; i < block_size; ++i)
+                {
+                    const int j = b + i;
+                    oskar_sincos_f(-(x_in[j] * xp_out + y_in[j] * yp_out),
+                            &s[i], &c[i]);
+                    oskar_sincos_f(-x_in[j] * xp_step, &ds[i], &dc[i]);
+                    re[i] = data_in[j].x * weight_in[j];
+                    im[i] = data_in[j].y * weight_in[j];
+                }
 
-        /* Loop over input points. */
-        for (i = 0; i < num_in; ++i)
+                /* Accumulate each output, then rotate the phasors. */
+                for (k = 0; k < n; ++k)
+                {
+                    float sum = 0.0f;
+                    #pragma omp simd reduction(+:sum)
+                    for (i = 0; i < block_size; ++i)
+                    {
+                        const float t = c[i] * dc[i] - s[i] * ds[i];
+                        sum += re[i] * c[i] - im[i] * s[i];
+                        s[i] = s[i] * dc[i] + c[i] * ds[i];
+                        c[i] = t;
+                    }
+                    out[k] += sum;
+                }
+            }
+        }
+        else
         {
-            /* Calculate the complex DFT weight. */
-            float a, weight_x, weight_y;
-            a = -(x_in[i] * xp_out + y_in[i] * yp_out);
-            weight_x = cosf(a);
-            weight_y = sinf(a);
-
-            /* Perform complex multiply-accumulate.
-             * Output is real, so only evaluate the real part. */
-            out += data_in[i].x * weight_x * weight_in[i]; /* RE*RE */
-            out -= data_in[i].y * weight_y * weight_in[i]; /* IM*IM */
+            for (k = 0; k < n; ++k)
+            {
+                float sum = 0.0f;
+                const float xp_out = wavenumber * x_out[o + k];
+                const float yp_out = wavenumber * y_out[o + k];
+                #pragma omp simd reduction(+:sum)
+                for (i = 0; i < num_in; ++i)
+                {
+                    float weight_x, weight_y;
+                    oskar_sincos_f(-(x_in[i] * xp_out + y_in[i] * yp_out),
+                            &weight_y, &weight_x);
+
+                    /* Output is real, so only evaluate the real part. */
+                    sum += (data_in[i].x * weight_x -
+                            data_in[i].y * weight_y) * weight_in[i];
+                }
+                out[k] = sum;
+            }
         }
 
-        /* Store the output point. */
-        output[i_out] = out;
+        /* Store the output points. */
+        for (k = 0; k < n; ++k) output[o + k] = out[k];
     }
 }
 
@@ -78,36 +149,96 @@ void oskar_dft_c2r_2d_omp_d(const int num_in, const double wavenumber,
         const double* weight_in, const int num_out, const double* x_out,
         const double* y_out, double* output)
 {
-    int i_out = 0;
+    int r = 0;
+    const int num_runs = (num_out + RUN_SIZE - 1) / RUN_SIZE;
 
-    /* Loop over output points. */
-    #pragma omp parallel for private(i_out)
-    for (i_out = 0; i_out < num_out; ++i_out)
+    /* Loop over runs of output points. */
+    #pragma omp parallel for private(r) schedule(dynamic, 1)
+    for (r = 0; r < num_runs; ++r)
     {
-        int i;
-        double xp_out, yp_out, out = 0.0; /* Clear output value. */
+        int i, k, n, regular = 1;
+        double dx = 0.0, out[RUN_SIZE];
+        const int o = r * RUN_SIZE;
+        const double x0 = x_out[o], y0 = y_out[o];
+        n = num_out - o;
+        if (n > RUN_SIZE) n = RUN_SIZE;
 
-        /* Get the output position. */
-        xp_out = wavenumber * x_out[i_out];
-        yp_out = wavenumber * y_out[i_out];
+        /* Check whether the output points are evenly spaced. */
+        if (n > 1) dx = (x_out[o + n - 1] - x0) / (n - 1);
+        for (k = 0; k < n; ++k)
+        {
+            const double x = x_out[o + k];
+            out[k] = 0.0;
+            if (y_out[o + k] != y0 || !(fabs(x - (x0 + k * dx)) <=
+                    4.0 * DBL_EPSILON * (fabs(x0) + fabs(x))))
+                regular = 0;
+        }
 
-        /* Loop over input points. */
-        for (i = 0; i < num_in; ++i)
+        if (regular)
         {
-            /* Calculate the complex DFT weight. */
-            double a, weight_x, weight_y;
-            a = -(x_in[i] * xp_out + y_in[i] * yp_out);
-            weight_x = cos(a);
-            weight_y = sin(a);
-
-            /* Perform complex multiply-accumulate.
-             * Output is real, so only evaluate the real part. */
-            out += data_in[i].x * weight_x * weight_in[i]; /* RE*RE */
-            out -= data_in[i].y * weight_y * weight_in[i]; /* IM*IM */
+            double c[BLOCK_SIZE], s[BLOCK_SIZE];
+            double dc[BLOCK_SIZE], ds[BLOCK_SIZE];
+            double re[BLOCK_SIZE], im[BLOCK_SIZE];
+            const double xp_out = wavenumber * x0, yp_out = wavenumber * y0;
+            const double xp_step = wavenumber * dx;
+            int b, block_size;
+            for (b = 0; b < num_in; b += BLOCK_SIZE)
+            {
+                block_size = num_in - b;
+                if (block_size > BLOCK_SIZE) block_size = BLOCK_SIZE;
+
+                /* Evaluate starting and step phasors for the block. */
+                #pragma omp simd
+                for (i = 0; i < block_size; ++i)
+                {
+                    const int j = b + i;
+                    oskar_sincos_d(-(x_in[j] * xp_out + y_in[j] * yp_out),
+                            &s[i], &c[i]);
+                    oskar_sincos_d(-x_in[j] * xp_step, &ds[i], &dc[i]);
+                    re[i] = data_in[j].x * weight_in[j];
+                    im[i] = data_in[j].y * weight_in[j];
+                }
+
+                /* Accumulate each output, then rotate the phasors. */
+                for (k = 0; k < n; ++k)
+                {
+                    double sum = 0.0;
+                    #pragma omp simd reduction(+:sum)
+                    for (i = 0; i < block_size; ++i)
+                    {
+                        const double t = c[i] * dc[i] - s[i] * ds[i];
+                        sum += re[i] * c[i] - im[i] * s[i];
+                        s[i] = s[i] * dc[i] + c[i] * ds[i];
+                        c[i] = t;
+                    }
+                    out[k] += sum;
+                }
+            }
+        }
+        else
+        {
+            for (k = 0; k < n; ++k)
+            {
+                double sum = 0.0;
+                const double xp_out = wavenumber * x_out[o + k];
+                const double yp_out = wavenumber * y_out[o + k];
+                #pragma omp simd reduction(+:sum)
+                for (i = 0; i < num_in; ++i)
+                {
+                    double weight_x, weight_y;
+                    oskar_sincos_d(-(x_in[i] * xp_out + y_in[i] * yp_out),
+                            &weight_y, &weight_x);
+
+                    /* Output is real, so only evaluate the real part. */
+                    sum += (data_in[i].x * weight_x -
+                            data_in[i].y * weight_y) * weight_in[i];
+                }
+                out[k] = sum;
+            }
         }
 
-        /* Store the output point. */
-        output[i_out] = out;
+        /* Store the output points. */
+        for (k = 0; k < n; ++k) output[o + k] = out[k];
     }
 }
 
@@ -27,6 +27,7 @@
  */
 
 #include "math/oskar_dft_c2r_3d_omp.h"
+#include "math/oskar_sincos_inline.h"
 #include <math.h>
 
 #ifdef __cplusplus
@@ -55,13 +56,13 @@ void oskar_dft_c2r_3d_omp_f(const int num_in, const float wavenumber,
         zp_out = wavenumber * z_out[i_out];
 
         /* Loop over input points. */
+        #pragma omp simd reduction(+:out)
         for (i = 0; i < num_in; ++i)
         {
             /* Calculate the complex DFT weight. */
             float a, weight_x, weight_y;
             a = -(x_in[i] * xp_out + y_in[i] * yp_out + z_in[i] * zp_out);
-            weight_x = cosf(a);
-            weight_y = sinf(a);
+            oskar_sincos_f(a, &weight_y, &weight_x);
 
             /* Perform complex multiply-accumulate.
              * Output is real, so only evaluate the real part. */
@@ -96,13 +97,13 @@ void oskar_dft_c2r_3d_omp_d(const int num_in, const double wavenumber,
         zp_out = wavenumber * z_out[i_out];
 
         /* Loop over input points. */
+        #pragma omp simd reduction(+:out)
         for (i = 0; i < num_in; ++i)
         {
             /* Calculate the complex DFT weight. */
             double a, weight_x, weight_y;
             a = -(x_in[i] * xp_out + y_in[i] * yp_out + z_in[i] * zp_out);
-            weight_x = cos(a);
-            weight_y = sin(a);
+            oskar_sincos_d(a, &weight_y, &weight_x);
 
             /* Perform complex multiply-accumulate.
              * Output is real, so only evaluate the real part. */
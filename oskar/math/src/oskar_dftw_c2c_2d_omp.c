@@ -27,6 +27,7 @@
  */
 
 #include "math/oskar_dftw_c2c_2d_omp.h"
+#include "math/oskar_sincos_inline.h"
 #include <math.h>
 
 #ifdef __cplusplus
@@ -47,17 +48,18 @@ void oskar_dftw_c2c_2d_omp_f(const int n_in, const float wavenumber,
     {
         int i;
         float xp_out, yp_out;
-        float2 out;
+        float out_x, out_y;
 
         /* Clear output value. */
-        out.x = 0.0f;
-        out.y = 0.0f;
+        out_x = 0.0f;
+        out_y = 0.0f;
 
         /* Get the output position. */
         xp_out = wavenumber * x_out[i_out];
         yp_out = wavenumber * y_out[i_out];
 
         /* Loop over input points. */
+        #pragma omp simd reduction(+:out_x,out_y)
         for (i = 0; i < n_in; ++i)
         {
             float2 temp, w;
@@ -65,8 +67,7 @@ void oskar_dftw_c2c_2d_omp_f(const int n_in, const float wavenumber,
 
             /* Calculate the phase for the output position. */
             a = xp_out * x_in[i] + yp_out * y_in[i];
-            temp.x = cosf(a);
-            temp.y = sinf(a);
+            oskar_sincos_f(a, &temp.y, &temp.x);
 
             /* Multiply the supplied DFT weight by the computed phase. */
             w = weights_in[i];
@@ -78,14 +79,15 @@ void oskar_dftw_c2c_2d_omp_f(const int n_in, const float wavenumber,
 
             /* Perform complex multiply-accumulate. */
             temp = data[i * n_out + i_out];
-            out.x += w.x * temp.x;
-            out.x -= w.y * temp.y;
-            out.y += w.y * temp.x;
-            out.y += w.x * temp.y;
+            out_x += w.x * temp.x;
+            out_x -= w.y * temp.y;
+            out_y += w.y * temp.x;
+            out_y += w.x * temp.y;
         }
 
         /* Store the output point. */
-        output[i_out] = out;
+        output[i_out].x = out_x;
+        output[i_out].y = out_y;
     }
 }
 
@@ -103,17 +105,18 @@ void oskar_dftw_c2c_2d_omp_d(const int n_in, const double wavenumber,
     {
         int i;
         double xp_out, yp_out;
-        double2 out;
+        double out_x, out_y;
 
         /* Clear output value. */
-        out.x = 0.0;
-        out.y = 0.0;
+        out_x = 0.0;
+        out_y = 0.0;
 
         /* Get the output position. */
         xp_out = wavenumber * x_out[i_out];
         yp_out = wavenumber * y_out[i_out];
 
         /* Loop over input points. */
+        #pragma omp simd reduction(+:out_x,out_y)
         for (i = 0; i < n_in; ++i)
         {
             double2 temp, w;
@@ -121,8 +124,7 @@ void oskar_dftw_c2c_2d_omp_d(const int n_in, const double wavenumber,
 
             /* Calculate the phase for the output position. */
             a = xp_out * x_in[i] + yp_out * y_in[i];
-            temp.x = cos(a);
-            temp.y = sin(a);
+            oskar_sincos_d(a, &temp.y, &temp.x);
 
             /* Multiply the supplied DFT weight by the computed phase. */
             w = weights_in[i];
@@ -134,14 +136,15 @@ void oskar_dftw_c2c_2d_omp_d(const int n_in, const double wavenumber,
 
             /* Perform complex multiply-accumulate. */
             temp = data[i * n_out + i_out];
-            out.x += w.x * temp.x;
-            out.x -= w.y * temp.y;
-            out.y += w.y * temp.x;
-            out.y += w.x * temp.y;
+            out_x += w.x * temp.x;
+            out_x -= w.y * temp.y;
+            out_y += w.y * temp.x;
+            out_y += w.x * temp.y;
         }
 
         /* Store the output point. */
-        output[i_out] = out;
+        output[i_out].x = out_x;
+        output[i_out].y = out_y;
     }
 }
 
@@ -27,6 +27,7 @@
  */
 
 #include "math/oskar_dftw_c2c_3d_omp.h"
+#include "math/oskar_sincos_inline.h"
 #include <math.h>
 
 #ifdef __cplusplus
@@ -48,11 +49,11 @@ void oskar_dftw_c2c_3d_omp_f(const int n_in, const float wavenumber,
     {
         int i;
         float xp_out, yp_out, zp_out;
-        float2 out;
+        float out_x, out_y;
 
         /* Clear output value. */
-        out.x = 0.0f;
-        out.y = 0.0f;
+        out_x = 0.0f;
+        out_y = 0.0f;
 
         /* Get the output position. */
         xp_out = wavenumber * x_out[i_out];
@@ -60,6 +61,7 @@ void oskar_dftw_c2c_3d_omp_f(const int n_in, const float wavenumber,
         zp_out = wavenumber * z_out[i_out];
 
         /* Loop over input points. */
+        #pragma omp simd reduction(+:out_x,out_y)
         for (i = 0; i < n_in; ++i)
         {
             float2 temp, w;
@@ -67,8 +69,7 @@ void oskar_dftw_c2c_3d_omp_f(const int n_in, const float wavenumber,
 
             /* Calculate the phase for the output position. */
             a = xp_out * x_in[i] + yp_out * y_in[i] + zp_out * z_in[i];
-            temp.x = cosf(a);
-            temp.y = sinf(a);
+            oskar_sincos_f(a, &temp.y, &temp.x);
 
             /* Multiply the supplied DFT weight by the computed phase. */
             w = weights_in[i];
@@ -80,14 +81,15 @@ void oskar_dftw_c2c_3d_omp_f(const int n_in, const float wavenumber,
 
             /* Perform complex multiply-accumulate. */
             temp = data[i * n_out + i_out];
-            out.x += w.x * temp.x;
-            out.x -= w.y * temp.y;
-            out.y += w.y * temp.x;
-            out.y += w.x * temp.y;
+            out_x += w.x * temp.x;
+            out_x -= w.y * temp.y;
+            out_y += w.y * temp.x;
+            out_y += w.x * temp.y;
         }
 
         /* Store the output point. */
-        output[i_out] = out;
+        output[i_out].x = out_x;
+        output[i_out].y = out_y;
     }
 }
 
@@ -106,11 +108,11 @@ void oskar_dftw_c2c_3d_omp_d(const int n_in, const double wavenumber,
     {
         int i;
         double xp_out, yp_out, zp_out;
-        double2 out;
+        double out_x, out_y;
 
         /* Clear output value. */
-        out.x = 0.0;
-        out.y = 0.0;
+        out_x = 0.0;
+        out_y = 0.0;
 
         /* Get the output position. */
         xp_out = wavenumber * x_out[i_out];
@@ -118,6 +120,7 @@ void oskar_dftw_c2c_3d_omp_d(const int n_in, const double wavenumber,
         zp_out = wavenumber * z_out[i_out];
 
         /* Loop over input points. */
+        #pragma omp simd reduction(+:out_x,out_y)
         for (i = 0; i < n_in; ++i)
         {
             double2 temp, w;
@@ -125,8 +128,7 @@ void oskar_dftw_c2c_3d_omp_d(const int n_in, const double wavenumber,
 
             /* Calculate the phase for the output position. */
             a = xp_out * x_in[i] + yp_out * y_in[i] + zp_out * z_in[i];
-            temp.x = cos(a);
-            temp.y = sin(a);
+            oskar_sincos_d(a, &temp.y, &temp.x);
 
             /* Multiply the supplied DFT weight by the computed phase. */
             w = weights_in[i];
@@ -138,14 +140,15 @@ void oskar_dftw_c2c_3d_omp_d(const int n_in, const double wavenumber,
 
             /* Perform complex multiply-accumulate. */
             temp = data[i * n_out + i_out];
-            out.x += w.x * temp.x;
-            out.x -= w.y * temp.y;
-            out.y += w.y * temp.x;
-            out.y += w.x * temp.y;
+            out_x += w.x * temp.x;
+            out_x -= w.y * temp.y;
+            out_y += w.y * temp.x;
+            out_y += w.x * temp.y;
         }
 
         /* Store the output point. */
-        output[i_out] = out;
+        output[i_out].x = out_x;
+        output[i_out].y = out_y;
     }
 }
 
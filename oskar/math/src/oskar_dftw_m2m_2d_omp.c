@@ -27,6 +27,7 @@
  */
 
 #include "math/oskar_dftw_m2m_2d_omp.h"
+#include "math/oskar_sincos_inline.h"
 #include <math.h>
 
 #ifdef __cplusplus
@@ -47,23 +48,26 @@ void oskar_dftw_m2m_2d_omp_f(const int n_in, const float wavenumber,
     {
         int i;
         float xp_out, yp_out;
-        float4c out;
+        float out_a_x, out_a_y, out_b_x, out_b_y;
+        float out_c_x, out_c_y, out_d_x, out_d_y;
 
         /* Clear output value. */
-        out.a.x = 0.0f;
-        out.a.y = 0.0f;
-        out.b.x = 0.0f;
-        out.b.y = 0.0f;
-        out.c.x = 0.0f;
-        out.c.y = 0.0f;
-        out.d.x = 0.0f;
-        out.d.y = 0.0f;
+        out_a_x = 0.0f;
+        out_a_y = 0.0f;
+        out_b_x = 0.0f;
+        out_b_y = 0.0f;
+        out_c_x = 0.0f;
+        out_c_y = 0.0f;
+        out_d_x = 0.0f;
+        out_d_y = 0.0f;
 
         /* Get the output position. */
         xp_out = wavenumber * x_out[i_out];
         yp_out = wavenumber * y_out[i_out];
 
         /* Loop over input points. */
+        #pragma omp simd reduction(+:out_a_x,out_a_y,out_b_x,out_b_y) \
+                reduction(+:out_c_x,out_c_y,out_d_x,out_d_y)
         for (i = 0; i < n_in; ++i)
         {
             float2 weight;
@@ -75,8 +79,7 @@ void oskar_dftw_m2m_2d_omp_f(const int n_in, const float wavenumber,
 
                 /* Phase. */
                 t = xp_out * x_in[i] + yp_out * y_in[i];
-                weight.x = cosf(t);
-                weight.y = sinf(t);
+                oskar_sincos_f(t, &weight.y, &weight.x);
 
                 /* Multiply the supplied DFT weight by the computed phase. */
                 w = weights_in[i];
@@ -91,27 +94,34 @@ void oskar_dftw_m2m_2d_omp_f(const int n_in, const float wavenumber,
             {
                 float4c in;
                 in = data[i * n_out + i_out];
-                out.a.x += in.a.x * weight.x;
-                out.a.x -= in.a.y * weight.y;
-                out.a.y += in.a.y * weight.x;
-                out.a.y += in.a.x * weight.y;
-                out.b.x += in.b.x * weight.x;
-                out.b.x -= in.b.y * weight.y;
-                out.b.y += in.b.y * weight.x;
-                out.b.y += in.b.x * weight.y;
-                out.c.x += in.c.x * weight.x;
-                out.c.x -= in.c.y * weight.y;
-                out.c.y += in.c.y * weight.x;
-                out.c.y += in.c.x * weight.y;
-                out.d.x += in.d.x * weight.x;
-                out.d.x -= in.d.y * weight.y;
-                out.d.y += in.d.y * weight.x;
-                out.d.y += in.d.x * weight.y;
+                out_a_x += in.a.x * weight.x;
+                out_a_x -= in.a.y * weight.y;
+                out_a_y += in.a.y * weight.x;
+                out_a_y += in.a.x * weight.y;
+                out_b_x += in.b.x * weight.x;
+                out_b_x -= in.b.y * weight.y;
+                out_b_y += in.b.y * weight.x;
+                out_b_y += in.b.x * weight.y;
+                out_c_x += in.c.x * weight.x;
+                out_c_x -= in.c.y * weight.y;
+                out_c_y += in.c.y * weight.x;
+                out_c_y += in.c.x * weight.y;
+                out_d_x += in.d.x * weight.x;
+                out_d_x -= in.d.y * weight.y;
+                out_d_y += in.d.y * weight.x;
+                out_d_y += in.d.x * weight.y;
             }
         }
 
         /* Store the output point. */
-        output[i_out] = out;
+        output[i_out].a.x = out_a_x;
+        output[i_out].a.y = out_a_y;
+        output[i_out].b.x = out_b_x;
+        output[i_out].b.y = out_b_y;
+        output[i_out].c.x = out_c_x;
+        output[i_out].c.y = out_c_y;
+        output[i_out].d.x = out_d_x;
+        output[i_out].d.y = out_d_y;
     }
 }
 
@@ -129,23 +139,26 @@ void oskar_dftw_m2m_2d_omp_d(const int n_in, const double wavenumber,
     {
         int i;
         double xp_out, yp_out;
-        double4c out;
+        double out_a_x, out_a_y, out_b_x, out_b_y;
+        double out_c_x, out_c_y, out_d_x, out_d_y;
 
         /* Clear output value. */
-        out.a.x = 0.0;
-        out.a.y = 0.0;
-        out.b.x = 0.0;
-        out.b.y = 0.0;
-        out.c.x = 0.0;
-        out.c.y = 0.0;
-        out.d.x = 0.0;
-        out.d.y = 0.0;
+        out_a_x = 0.0;
+        out_a_y = 0.0;
+        out_b_x = 0.0;
+        out_b_y = 0.0;
+        out_c_x = 0.0;
+        out_c_y = 0.0;
+        out_d_x = 0.0;
+        out_d_y = 0.0;
 
         /* Get the output position. */
         xp_out = wavenumber * x_out[i_out];
         yp_out = wavenumber * y_out[i_out];
 
         /* Loop over input points. */
+        #pragma omp simd reduction(+:out_a_x,out_a_y,out_b_x,out_b_y) \
+                reduction(+:out_c_x,out_c_y,out_d_x,out_d_y)
         for (i = 0; i < n_in; ++i)
         {
             double2 weight;
@@ -157,8 +170,7 @@ void oskar_dftw_m2m_2d_omp_d(const int n_in, const double wavenumber,
 
                 /* Phase. */
                 t = xp_out * x_in[i] + yp_out * y_in[i];
-                weight.x = cos(t);
-                weight.y = sin(t);
+                oskar_sincos_d(t, &weight.y, &weight.x);
 
                 /* Multiply the supplied DFT weight by the computed phase. */
                 w = weights_in[i];
@@ -173,27 +185,34 @@ void oskar_dftw_m2m_2d_omp_d(const int n_in, const double wavenumber,
             {
                 double4c in;
                 in = data[i * n_out + i_out];
-                out.a.x += in.a.x * weight.x;
-                out.a.x -= in.a.y * weight.y;
-                out.a.y += in.a.y * weight.x;
-                out.a.y += in.a.x * weight.y;
-                out.b.x += in.b.x * weight.x;
-                out.b.x -= in.b.y * weight.y;
-                out.b.y += in.b.y * weight.x;
-                out.b.y += in.b.x * weight.y;
-                out.c.x += in.c.x * weight.x;
-                out.c.x -= in.c.y * weight.y;
-                out.c.y += in.c.y * weight.x;
-                out.c.y += in.c.x * weight.y;
-                out.d.x += in.d.x * weight.x;
-                out.d.x -= in.d.y * weight.y;
-                out.d.y += in.d.y * weight.x;
-                out.d.y += in.d.x * weight.y;
+                out_a_x += in.a.x * weight.x;
+                out_a_x -= in.a.y * weight.y;
+                out_a_y += in.a.y * weight.x;
+                out_a_y += in.a.x * weight.y;
+                out_b_x += in.b.x * weight.x;
+                out_b_x -= in.b.y * weight.y;
+                out_b_y += in.b.y * weight.x;
+                out_b_y += in.b.x * weight.y;
+                out_c_x += in.c.x * weight.x;
+                out_c_x -= in.c.y * weight.y;
+                out_c_y += in.c.y * weight.x;
+                out_c_y += in.c.x * weight.y;
+                out_d_x += in.d.x * weight.x;
+                out_d_x -= in.d.y * weight.y;
+                out_d_y += in.d.y * weight.x;
+                out_d_y += in.d.x * weight.y;
             }
         }
 
         /* Store the output point. */
-        output[i_out] = out;
+        output[i_out].a.x = out_a_x;
+        output[i_out].a.y = out_a_y;
+        output[i_out].b.x = out_b_x;
+        output[i_out].b.y = out_b_y;
+        output[i_out].c.x = out_c_x;
+        output[i_out].c.y = out_c_y;
+        output[i_out].d.x = out_d_x;
+        output[i_out].d.y = out_d_y;
     }
 }
 
@@ -27,6 +27,7 @@
  */
 
 #include "math/oskar_dftw_o2c_2d_omp.h"
+#include "math/oskar_sincos_inline.h"
 #include <math.h>
 
 #ifdef __cplusplus
@@ -110,17 +111,18 @@ void oskar_dftw_o2c_2d_omp_f(const int n_in, const float wavenumber,
     {
         int i;
         float xp_out, yp_out;
-        float2 out;
+        float out_x, out_y;
 
         /* Clear output value. */
-        out.x = 0.0f;
-        out.y = 0.0f;
+        out_x = 0.0f;
+        out_y = 0.0f;
 
         /* Get the output position. */
         xp_out = wavenumber * x_out[i_out];
         yp_out = wavenumber * y_out[i_out];
 
         /* Loop over input points. */
+        #pragma omp simd reduction(+:out_x,out_y)
         for (i = 0; i < n_in; ++i)
         {
             float signal_x, signal_y;
@@ -129,23 +131,23 @@ void oskar_dftw_o2c_2d_omp_f(const int n_in, const float wavenumber,
             {
                 float a;
                 a = xp_out * x_in[i] + yp_out * y_in[i];
-                signal_x = cosf(a);
-                signal_y = sinf(a);
+                oskar_sincos_f(a, &signal_y, &signal_x);
             }
 
             /* Perform complex multiply-accumulate. */
             {
                 float2 w;
                 w = weights_in[i];
-                out.x += signal_x * w.x;
-                out.x -= signal_y * w.y;
-                out.y += signal_y * w.x;
-                out.y += signal_x * w.y;
+                out_x += signal_x * w.x;
+                out_x -= signal_y * w.y;
+                out_y += signal_y * w.x;
+                out_y += signal_x * w.y;
             }
         }
 
         /* Store the output point. */
-        output[i_out] = out;
+        output[i_out].x = out_x;
+        output[i_out].y = out_y;
     }
 }
 
@@ -163,17 +165,18 @@ void oskar_dftw_o2c_2d_omp_d(const int n_in, const double wavenumber,
     {
         int i;
         double xp_out, yp_out;
-        double2 out;
+        double out_x, out_y;
 
         /* Clear output value. */
-        out.x = 0.0;
-        out.y = 0.0;
+        out_x = 0.0;
+        out_y = 0.0;
 
         /* Get the output position. */
         xp_out = wavenumber * x_out[i_out];
         yp_out = wavenumber * y_out[i_out];
 
         /* Loop over input points. */
+        #pragma omp simd reduction(+:out_x,out_y)
         for (i = 0; i < n_in; ++i)
         {
             double signal_x, signal_y;
@@ -182,23 +185,23 @@ void oskar_dftw_o2c_2d_omp_d(const int n_in, const double wavenumber,
             {
                 double a;
                 a = xp_out * x_in[i] + yp_out * y_in[i];
-                signal_x = cos(a);
-                signal_y = sin(a);
+                oskar_sincos_d(a, &signal_y, &signal_x);
             }
 
             /* Perform complex multiply-accumulate. */
             {
                 double2 w;
                 w = weights_in[i];
-                out.x += signal_x * w.x;
-                out.x -= signal_y * w.y;
-                out.y += signal_y * w.x;
-                out.y += signal_x * w.y;
+                out_x += signal_x * w.x;
+                out_x -= signal_y * w.y;
+                out_y += signal_y * w.x;
+                out_y += signal_x * w.y;
             }
         }
 
         /* Store the output point. */
-        output[i_out] = out;
+        output[i_out].x = out_x;
+        output[i_out].y = out_y;
     }
 }
 
@@ -0,0 +1,534 @@
+/*
+ * Copyright (c) 2018, The University of Oxford
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the University of Oxford nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef OSKAR_HAVE_CUDA
+#include <cufft.h>
+#endif
+
+#ifdef OSKAR_HAVE_FFTW
+#include <fftw3.h>
+#endif
+
+#include "math/oskar_fft.h"
+#include "math/oskar_fftpack_cfft.h"
+#include "math/oskar_fftpack_cfft_f.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MIN(a,b) ((a) < (b) ? (a) : (b))
+
+/* Number of rows transformed together by each call to FFTPACK. */
+#define ROWS_PER_BLOCK 16
+
+/* Side length of the tiles used for the transpose, in complex elements. */
+#define TILE_SIZE 32
+
+struct oskar_FFT
+{
+    int precision, location, grid_size, backend;
+    oskar_Mem* fftpack_wsave;
+#ifdef OSKAR_HAVE_CUDA
+    cufftHandle cufft_plan;
+#endif
+#ifdef OSKAR_HAVE_FFTW
+    /* Index 0 is multi-threaded, index 1 is used in parallel regions. */
+    fftw_plan fftw_plan_d[2];
+    fftwf_plan fftw_plan_f[2];
+#endif
+};
+
+#ifdef OSKAR_HAVE_FFTW
+static int create_fftw_plans(oskar_FFT* h);
+#endif
+static void exec_fftpack_threaded_d(const int n, double* c, double* wsave,
+        int* status);
+static void exec_fftpack_threaded_f(const int n, float* c, float* wsave,
+        int* status);
+static void transpose_d(const int n, double* restrict c);
+static void transpose_f(const int n, float* restrict c);
+
+oskar_FFT* oskar_fft_create(int precision, int location, int grid_size,
+        int backend, int* status)
+{
+    oskar_FFT* h = 0;
+    h = (oskar_FFT*) calloc(1, sizeof(oskar_FFT));
+    if (!h)
+    {
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+        return 0;
+    }
+    h->precision = precision;
+    h->location = location;
+    h->grid_size = grid_size;
+    if (*status) return h;
+    if (precision != OSKAR_SINGLE && precision != OSKAR_DOUBLE)
+    {
+        *status = OSKAR_ERR_BAD_DATA_TYPE;
+        return h;
+    }
+
+    /* Choose the backend if required. */
+    if (backend == OSKAR_FFT_DEFAULT)
+    {
+        if (location == OSKAR_GPU)
+            backend = OSKAR_FFT_CUFFT;
+        else
+        {
+#ifdef OSKAR_HAVE_FFTW
+            backend = OSKAR_FFT_FFTW;
+#else
+            backend = OSKAR_FFT_FFTPACK_THREADED;
+#endif
+        }
+    }
+    if ((location == OSKAR_GPU) != (backend == OSKAR_FFT_CUFFT))
+    {
+        *status = OSKAR_ERR_BAD_LOCATION;
+        return h;
+    }
+    h->backend = backend;
+
+    /* Create the plan. */
+    switch (backend)
+    {
+    case OSKAR_FFT_FFTPACK:
+    case OSKAR_FFT_FFTPACK_THREADED:
+        break;
+    case OSKAR_FFT_FFTW:
+#ifdef OSKAR_HAVE_FFTW
+        if (!create_fftw_plans(h))
+            h->backend = OSKAR_FFT_FFTPACK_THREADED;
+#else
+        *status = OSKAR_ERR_FUNCTION_NOT_AVAILABLE;
+#endif
+        break;
+    case OSKAR_FFT_CUFFT:
+#ifdef OSKAR_HAVE_CUDA
+        cufftPlan2d(&h->cufft_plan, grid_size, grid_size,
+                (precision == OSKAR_DOUBLE) ? CUFFT_Z2Z : CUFFT_C2C);
+#else
+        *status = OSKAR_ERR_CUDA_NOT_AVAILABLE;
+#endif
+        break;
+    default:
+        *status = OSKAR_ERR_INVALID_ARGUMENT;
+        break;
+    }
+
+    /* Initialise the FFTPACK work array if required.
+     * This holds factors for both dimensions, which are the same
+     * for a square grid. */
+    if (!*status && (h->backend == OSKAR_FFT_FFTPACK ||
+            h->backend == OSKAR_FFT_FFTPACK_THREADED))
+    {
+        const int len = 4 * grid_size +
+                2 * (int)(log((double)grid_size) / log(2.0)) + 8;
+        h->fftpack_wsave = oskar_mem_create(precision, OSKAR_CPU, len, status);
+        if (precision == OSKAR_DOUBLE)
+            oskar_fftpack_cfft2i(grid_size, grid_size,
+                    oskar_mem_double(h->fftpack_wsave, status));
+        else
+            oskar_fftpack_cfft2i_f(grid_size, grid_size,
+                    oskar_mem_float(h->fftpack_wsave, status));
+    }
+    return h;
+}
+
+int oskar_fft_backend(const oskar_FFT* h)
+{
+    return h->backend;
+}
+
+const char* oskar_fft_backend_name(const oskar_FFT* h)
+{
+    switch (h->backend)
+    {
+    case OSKAR_FFT_FFTPACK:          return "FFTPACK";
+    case OSKAR_FFT_FFTPACK_THREADED: return "FFTPACK (multi-threaded)";
+    case OSKAR_FFT_FFTW:             return "FFTW";
+    case OSKAR_FFT_CUFFT:            return "cuFFT";
+    default:                         return "";
+    }
+}
+
+void oskar_fft_exec(oskar_FFT* h, oskar_Mem* data, int* status)
+{
+    const int n = h->grid_size;
+    if (*status) return;
+    if (!oskar_mem_is_complex(data) || oskar_mem_precision(data) != h->precision)
+    {
+        *status = OSKAR_ERR_BAD_DATA_TYPE;
+        return;
+    }
+    if (oskar_mem_length(data) != (size_t)n * (size_t)n)
+    {
+        *status = OSKAR_ERR_DIMENSION_MISMATCH;
+        return;
+    }
+    if (h->backend != OSKAR_FFT_CUFFT && oskar_mem_location(data) != OSKAR_CPU)
+    {
+        *status = OSKAR_ERR_BAD_LOCATION;
+        return;
+    }
+    switch (h->backend)
+    {
+    case OSKAR_FFT_FFTPACK:
+    {
+        /* FFTPACK normalises the transform, so undo it afterwards. */
+        oskar_Mem* work = oskar_mem_create(h->precision, OSKAR_CPU,
+                2 * (size_t)n * (size_t)n, status);
+        if (h->precision == OSKAR_DOUBLE)
+            oskar_fftpack_cfft2f(n, n, n, oskar_mem_double(data, status),
+                    oskar_mem_double(h->fftpack_wsave, status),
+                    oskar_mem_double(work, status));
+        else
+            oskar_fftpack_cfft2f_f(n, n, n, oskar_mem_float(data, status),
+                    oskar_mem_float(h->fftpack_wsave, status),
+                    oskar_mem_float(work, status));
+        oskar_mem_free(work, status);
+        oskar_mem_scale_real(data, (double)n * (double)n, status);
+        break;
+    }
+    case OSKAR_FFT_FFTPACK_THREADED:
+        if (h->precision == OSKAR_DOUBLE)
+            exec_fftpack_threaded_d(n, oskar_mem_double(data, status),
+                    oskar_mem_double(h->fftpack_wsave, status), status);
+        else
+            exec_fftpack_threaded_f(n, oskar_mem_float(data, status),
+                    oskar_mem_float(h->fftpack_wsave, status), status);
+        break;
+#ifdef OSKAR_HAVE_FFTW
+    case OSKAR_FFT_FFTW:
+    {
+#ifdef _OPENMP
+        const int i = omp_in_parallel() ? 1 : 0;
+#else
+        const int i = 0;
+#endif
+        if (h->precision == OSKAR_DOUBLE)
+            fftw_execute_dft(h->fftw_plan_d[i],
+                    (fftw_complex*) oskar_mem_void(data),
+                    (fftw_complex*) oskar_mem_void(data));
+        else
+            fftwf_execute_dft(h->fftw_plan_f[i],
+                    (fftwf_complex*) oskar_mem_void(data),
+                    (fftwf_complex*) oskar_mem_void(data));
+        break;
+    }
+#endif
+#ifdef OSKAR_HAVE_CUDA
+    case OSKAR_FFT_CUFFT:
+    {
+        oskar_Mem *data_gpu = 0, *data_ptr = data;
+        if (oskar_mem_location(data) != OSKAR_GPU)
+        {
+            data_gpu = oskar_mem_create_copy(data, OSKAR_GPU, status);
+            data_ptr = data_gpu;
+        }
+        if (h->precision == OSKAR_DOUBLE)
+            cufftExecZ2Z(h->cufft_plan, oskar_mem_void(data_ptr),
+                    oskar_mem_void(data_ptr), CUFFT_FORWARD);
+        else
+            cufftExecC2C(h->cufft_plan, oskar_mem_void(data_ptr),
+                    oskar_mem_void(data_ptr), CUFFT_FORWARD);
+        if (oskar_mem_location(data) != OSKAR_GPU)
+            oskar_mem_copy(data, data_ptr, status);
+        oskar_mem_free(data_gpu, status);
+        break;
+    }
+#endif
+    default:
+        *status = OSKAR_ERR_FUNCTION_NOT_AVAILABLE;
+        break;
+    }
+}
+
+void oskar_fft_free(oskar_FFT* h)
+{
+    int status = 0;
+    if (!h) return;
+    oskar_mem_free(h->fftpack_wsave, &status);
+#ifdef OSKAR_HAVE_CUDA
+    if (h->backend == OSKAR_FFT_CUFFT)
+        cufftDestroy(h->cufft_plan);
+#endif
+#ifdef OSKAR_HAVE_FFTW
+    if (h->backend == OSKAR_FFT_FFTW)
+    {
+        int i;
+#pragma omp critical (oskar_fft_fftw_planner)
+        for (i = 0; i < 2; ++i)
+        {
+            if (h->fftw_plan_d[i]) fftw_destroy_plan(h->fftw_plan_d[i]);
+            if (h->fftw_plan_f[i]) fftwf_destroy_plan(h->fftw_plan_f[i]);
+        }
+    }
+#endif
+    free(h);
+}
+
+#ifdef OSKAR_HAVE_FFTW
+static int create_fftw_plans(oskar_FFT* h)
+{
+    int ok = 1;
+    void* buffer;
+    const int n = h->grid_size;
+    const unsigned int flags = FFTW_ESTIMATE | FFTW_UNALIGNED;
+
+    /* FFTW_ESTIMATE does not touch the arrays, so the pages of this
+     * temporary buffer are never committed. */
+    buffer = malloc(2 * (size_t)n * (size_t)n *
+            oskar_mem_element_size(h->precision));
+    if (!buffer) return 0;
+
+    /* The FFTW planner is not thread-safe. */
+#pragma omp critical (oskar_fft_fftw_planner)
+    {
+        int i;
+#ifdef OSKAR_HAVE_FFTW_THREADS
+        static int threads_initialised = 0;
+        if (!threads_initialised)
+        {
+            fftw_init_threads();
+            fftwf_init_threads();
+            threads_initialised = 1;
+        }
+#endif
+        for (i = 0; i < 2; ++i)
+        {
+#ifdef OSKAR_HAVE_FFTW_THREADS
+            int num_threads = 1;
+#ifdef _OPENMP
+            if (i == 0) num_threads = omp_get_max_threads();
+#endif
+            fftw_plan_with_nthreads(num_threads);
+            fftwf_plan_with_nthreads(num_threads);
+#endif
+            if (h->precision == OSKAR_DOUBLE)
+            {
+                h->fftw_plan_d[i] = fftw_plan_dft_2d(n, n,
+                        (fftw_complex*) buffer, (fftw_complex*) buffer,
+                        FFTW_FORWARD, flags);
+                if (!h->fftw_plan_d[i]) ok = 0;
+            }
+            else
+            {
+                h->fftw_plan_f[i] = fftwf_plan_dft_2d(n, n,
+                        (fftwf_complex*) buffer, (fftwf_complex*) buffer,
+                        FFTW_FORWARD, flags);
+                if (!h->fftw_plan_f[i]) ok = 0;
+            }
+        }
+        if (!ok)
+        {
+            for (i = 0; i < 2; ++i)
+            {
+                if (h->fftw_plan_d[i]) fftw_destroy_plan(h->fftw_plan_d[i]);
+                if (h->fftw_plan_f[i]) fftwf_destroy_plan(h->fftw_plan_f[i]);
+                h->fftw_plan_d[i] = 0;
+                h->fftw_plan_f[i] = 0;
+            }
+        }
+    }
+    free(buffer);
+    return ok;
+}
+#endif
+
+/*
+ * The multi-threaded FFTPACK backend transforms contiguous blocks of rows,
+ * so that each call to FFTPACK works on data that are adjacent in memory.
+ * The grid is transposed in square tiles before and after the first pass,
+ * so the column transforms are also done along rows. As in
+ * oskar_fftpack_cfft2f(), the columns are transformed first.
+ */
+
+static void exec_fftpack_threaded_d(const int n, double* c, double* wsave,
+        int* status)
+{
+    const double scale = (double)n * (double)n;
+    const size_t work_size = 2 * ROWS_PER_BLOCK * (size_t)n;
+    int num_threads = 1;
+    double* work_all;
+#ifdef _OPENMP
+    num_threads = omp_in_parallel() ? 1 : omp_get_max_threads();
+#endif
+
+    /* Allocate the work arrays for all threads up front. */
+    work_all = (double*) malloc(num_threads * work_size * sizeof(double));
+    if (!work_all)
+    {
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+        return;
+    }
+#pragma omp parallel num_threads(num_threads)
+    {
+        int i, thread_id = 0;
+        double* work;
+#ifdef _OPENMP
+        thread_id = omp_get_thread_num();
+#endif
+        work = work_all + thread_id * work_size;
+        transpose_d(n, c);
+#pragma omp for schedule(dynamic, 1)
+        for (i = 0; i < n; i += ROWS_PER_BLOCK)
+            oskar_fftpack_cfftmf(MIN(ROWS_PER_BLOCK, n - i), n, n, 1,
+                    c + 2 * (size_t)i * n, wsave, work);
+        transpose_d(n, c);
+#pragma omp for schedule(dynamic, 1)
+        for (i = 0; i < n; i += ROWS_PER_BLOCK)
+        {
+            size_t j;
+            const int num_rows = MIN(ROWS_PER_BLOCK, n - i);
+            double* block = c + 2 * (size_t)i * n;
+            oskar_fftpack_cfftmf(num_rows, n, n, 1, block, wsave, work);
+
+            /* FFTPACK normalises the transform, so undo it. */
+            for (j = 0; j < 2 * (size_t)num_rows * n; ++j) block[j] *= scale;
+        }
+    }
+    free(work_all);
+}
+
+static void exec_fftpack_threaded_f(const int n, float* c, float* wsave,
+        int* status)
+{
+    const float scale = (float) ((double)n * (double)n);
+    const size_t work_size = 2 * ROWS_PER_BLOCK * (size_t)n;
+    int num_threads = 1;
+    float* work_all;
+#ifdef _OPENMP
+    num_threads = omp_in_parallel() ? 1 : omp_get_max_threads();
+#endif
+
+    /* Allocate the work arrays for all threads up front. */
+    work_all = (float*) malloc(num_threads * work_size * sizeof(float));
+    if (!work_all)
+    {
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+        return;
+    }
+#pragma omp parallel num_threads(num_threads)
+    {
+        int i, thread_id = 0;
+        float* work;
+#ifdef _OPENMP
+        thread_id = omp_get_thread_num();
+#endif
+        work = work_all + thread_id * work_size;
+        transpose_f(n, c);
+#pragma omp for schedule(dynamic, 1)
+        for (i = 0; i < n; i += ROWS_PER_BLOCK)
+            oskar_fftpack_cfftmf_f(MIN(ROWS_PER_BLOCK, n - i), n, n, 1,
+                    c + 2 * (size_t)i * n, wsave, work);
+        transpose_f(n, c);
+#pragma omp for schedule(dynamic, 1)
+        for (i = 0; i < n; i += ROWS_PER_BLOCK)
+        {
+            size_t j;
+            const int num_rows = MIN(ROWS_PER_BLOCK, n - i);
+            float* block = c + 2 * (size_t)i * n;
+            oskar_fftpack_cfftmf_f(num_rows, n, n, 1, block, wsave, work);
+
+            /* FFTPACK normalises the transform, so undo it. */
+            for (j = 0; j < 2 * (size_t)num_rows * n; ++j) block[j] *= scale;
+        }
+    }
+    free(work_all);
+}
+
+/* Transposes a square complex matrix in place, one pair of tiles at a time.
+ * Must be called by all threads in a parallel region. */
+static void transpose_d(const int n, double* restrict c)
+{
+    int ti;
+#pragma omp for schedule(dynamic, 1)
+    for (ti = 0; ti < n; ti += TILE_SIZE)
+    {
+        int tj, i, j;
+        const int i_end = MIN(ti + TILE_SIZE, n);
+        for (tj = ti; tj < n; tj += TILE_SIZE)
+        {
+            const int j_end = MIN(tj + TILE_SIZE, n);
+            for (i = ti; i < i_end; ++i)
+            {
+                for (j = (ti == tj) ? i + 1 : tj; j < j_end; ++j)
+                {
+                    const size_t a = 2 * ((size_t)i * n + j);
+                    const size_t b = 2 * ((size_t)j * n + i);
+                    const double re = c[a], im = c[a + 1];
+                    c[a]     = c[b];
+                    c[a + 1] = c[b + 1];
+                    c[b]     = re;
+                    c[b + 1] = im;
+                }
+            }
+        }
+    }
+}
+
+static void transpose_f(const int n, float* restrict c)
+{
+    int ti;
+#pragma omp for schedule(dynamic, 1)
+    for (ti = 0; ti < n; ti += TILE_SIZE)
+    {
+        int tj, i, j;
+        const int i_end = MIN(ti + TILE_SIZE, n);
+        for (tj = ti; tj < n; tj += TILE_SIZE)
+        {
+            const int j_end = MIN(tj + TILE_SIZE, n);
+            for (i = ti; i < i_end; ++i)
+            {
+                for (j = (ti == tj) ? i + 1 : tj; j < j_end; ++j)
+                {
+                    const size_t a = 2 * ((size_t)i * n + j);
+                    const size_t b = 2 * ((size_t)j * n + i);
+                    const float re = c[a], im = c[a + 1];
+                    c[a]     = c[b];
+                    c[a + 1] = c[b + 1];
+                    c[b]     = re;
+                    c[b + 1] = im;
+                }
+            }
+        }
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -167,6 +167,13 @@ void oskar_fftpack_cfft2i(const int l, const int m, double *wsave)
 }
 
 
+void oskar_fftpack_cfftmf(const int lot, const int jump, const int n,
+        const int inc, double *c, double *wsave, double *work)
+{
+    cfftmf(lot, jump, n, inc, c, wsave, work);
+}
+
+
 void cfftmb(const int lot, const int jump, const int n, const int inc,
         double *c, double *wsave, double *work)
 {
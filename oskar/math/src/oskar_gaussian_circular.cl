@@ -1,4 +1,4 @@
-kernel void gaussian_2d_complex_REAL(const int n,
+kernel void gaussian_circular_complex_REAL(const int n,
         global const REAL* restrict x, global const REAL* restrict y,
         const REAL inv_2_var, global REAL2* restrict z)
 {
@@ -11,7 +11,7 @@ kernel void gaussian_2d_complex_REAL(const int n,
     z[i].y = (REAL) 0.0;
 }
 
-kernel void gaussian_2d_matrix_REAL(const int n,
+kernel void gaussian_circular_matrix_REAL(const int n,
         global const REAL* restrict x, global const REAL* restrict y,
         const REAL inv_2_var, global REAL8* restrict z)
 {
@@ -123,3 +123,64 @@ TEST(dft, c2r)
     oskar_mem_free(v, &status);
     oskar_mem_free(w, &status);
 }
+
+TEST(dft, c2r_accuracy)
+{
+    int side = 70, status = 0;
+    int num_pixels = side * side, num_baselines = 600;
+    double wavenumber = 2 * M_PI * 100e6 / 299792458.;
+    double fov = 4.0 * M_PI / 180.0;
+    oskar_Mem *l, *m, *n, *u, *v, *amp, *wt, *out;
+    int type = OSKAR_DOUBLE;
+    l = oskar_mem_create(type, OSKAR_CPU, num_pixels, &status);
+    m = oskar_mem_create(type, OSKAR_CPU, num_pixels, &status);
+    n = oskar_mem_create(type, OSKAR_CPU, num_pixels, &status);
+    u = oskar_mem_create(type, OSKAR_CPU, num_baselines, &status);
+    v = oskar_mem_create(type, OSKAR_CPU, num_baselines, &status);
+    amp = oskar_mem_create(type | OSKAR_COMPLEX, OSKAR_CPU,
+            num_baselines, &status);
+    wt = oskar_mem_create(type, OSKAR_CPU, num_baselines, &status);
+    out = oskar_mem_create(type, OSKAR_CPU, num_pixels, &status);
+    oskar_evaluate_image_lmn_grid(side, side, fov, fov, 0, l, m, n, &status);
+    oskar_mem_random_range(u, -1000., 1000., &status);
+    oskar_mem_random_range(v, -1000., 1000., &status);
+    oskar_mem_random_range(amp, -1., 1., &status);
+    oskar_mem_random_range(wt, 0.5, 1., &status);
+
+    /* Disturb the grid for the last row, to check the direct path. */
+    double* l_ = oskar_mem_double(l, &status);
+    for (int i = num_pixels - side; i < num_pixels; i += 3) l_[i] *= 1.01;
+    oskar_dft_c2r(num_baselines, wavenumber, u, v, 0, amp, wt,
+            num_pixels, l, m, 0, out, &status);
+    ASSERT_EQ(0, status);
+
+    /* Compare with a direct evaluation. */
+    const double *m_ = oskar_mem_double_const(m, &status);
+    const double *u_ = oskar_mem_double_const(u, &status);
+    const double *v_ = oskar_mem_double_const(v, &status);
+    const double *a_ = oskar_mem_double_const(amp, &status);
+    const double *w_ = oskar_mem_double_const(wt, &status);
+    const double *o_ = oskar_mem_double_const(out, &status);
+    double max_err = 0.0, max_val = 0.0;
+    for (int p = 0; p < num_pixels; ++p)
+    {
+        double sum = 0.0;
+        for (int i = 0; i < num_baselines; ++i)
+        {
+            double phase = -wavenumber * (u_[i] * l_[p] + v_[i] * m_[p]);
+            sum += w_[i] * (a_[2*i] * cos(phase) - a_[2*i+1] * sin(phase));
+        }
+        if (fabs(sum - o_[p]) > max_err) max_err = fabs(sum - o_[p]);
+        if (fabs(sum) > max_val) max_val = fabs(sum);
+    }
+    EXPECT_LT(max_err / max_val, 1e-12);
+
+    oskar_mem_free(l, &status);
+    oskar_mem_free(m, &status);
+    oskar_mem_free(n, &status);
+    oskar_mem_free(u, &status);
+    oskar_mem_free(v, &status);
+    oskar_mem_free(amp, &status);
+    oskar_mem_free(wt, &status);
+    oskar_mem_free(out, &status);
+}
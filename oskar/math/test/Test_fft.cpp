@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2018, The University of Oxford
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the University of Oxford nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "math/oskar_fft.h"
+#include "utility/oskar_get_error_string.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+// Returns the maximum difference between an FFT and a direct evaluation.
+static double check_fft(int precision, int backend, int n)
+{
+    int status = 0;
+    const int type = precision | OSKAR_COMPLEX;
+    oskar_Mem* data = oskar_mem_create(type, OSKAR_CPU, n * n, &status);
+    std::vector<double> in(2 * n * n);
+    srand(2);
+    for (int i = 0; i < 2 * n * n; ++i)
+        in[i] = rand() / (double)RAND_MAX - 0.5;
+    for (int i = 0; i < 2 * n * n; ++i)
+    {
+        if (precision == OSKAR_DOUBLE)
+            oskar_mem_double(data, &status)[i] = in[i];
+        else
+            oskar_mem_float(data, &status)[i] = (float) in[i];
+    }
+    oskar_FFT* fft = oskar_fft_create(precision, OSKAR_CPU, n, backend,
+            &status);
+    oskar_fft_exec(fft, data, &status);
+    EXPECT_EQ(0, status) << oskar_get_error_string(status);
+    if (backend != OSKAR_FFT_DEFAULT)
+    {
+        EXPECT_EQ(backend, oskar_fft_backend(fft));
+    }
+
+    // Compare a selection of output points with a direct evaluation of the
+    // unnormalised forward transform.
+    double max_diff = 0.0;
+    for (int k = 0; k < n * n; k += 1 + n / 3)
+    {
+        const int ky = k / n, kx = k % n;
+        double re = 0.0, im = 0.0;
+        for (int y = 0; y < n; ++y)
+        {
+            for (int x = 0; x < n; ++x)
+            {
+                const double a = -2.0 * M_PI *
+                        ((double)(kx * x) / n + (double)(ky * y) / n);
+                const double c = cos(a), s = sin(a);
+                const double v_re = in[2 * (y * n + x)];
+                const double v_im = in[2 * (y * n + x) + 1];
+                re += v_re * c - v_im * s;
+                im += v_re * s + v_im * c;
+            }
+        }
+        double out_re, out_im;
+        if (precision == OSKAR_DOUBLE)
+        {
+            out_re = oskar_mem_double(data, &status)[2 * k];
+            out_im = oskar_mem_double(data, &status)[2 * k + 1];
+        }
+        else
+        {
+            out_re = oskar_mem_float(data, &status)[2 * k];
+            out_im = oskar_mem_float(data, &status)[2 * k + 1];
+        }
+        max_diff = std::max(max_diff, fabs(out_re - re));
+        max_diff = std::max(max_diff, fabs(out_im - im));
+    }
+    oskar_fft_free(fft);
+    oskar_mem_free(data, &status);
+    return max_diff;
+}
+
+TEST(fft, fftpack)
+{
+    EXPECT_LT(check_fft(OSKAR_DOUBLE, OSKAR_FFT_FFTPACK, 48), 1e-10);
+    EXPECT_LT(check_fft(OSKAR_SINGLE, OSKAR_FFT_FFTPACK, 48), 1e-3);
+}
+
+TEST(fft, fftpack_threaded)
+{
+    // Use sizes that are not multiples of the block sizes.
+    EXPECT_LT(check_fft(OSKAR_DOUBLE, OSKAR_FFT_FFTPACK_THREADED, 70), 1e-10);
+    EXPECT_LT(check_fft(OSKAR_SINGLE, OSKAR_FFT_FFTPACK_THREADED, 70), 1e-3);
+    EXPECT_LT(check_fft(OSKAR_DOUBLE, OSKAR_FFT_FFTPACK_THREADED, 5), 1e-10);
+}
+
+TEST(fft, default_backend)
+{
+    EXPECT_LT(check_fft(OSKAR_DOUBLE, OSKAR_FFT_DEFAULT, 64), 1e-10);
+    EXPECT_LT(check_fft(OSKAR_SINGLE, OSKAR_FFT_DEFAULT, 64), 1e-3);
+}
+
+#ifdef OSKAR_HAVE_FFTW
+TEST(fft, fftw)
+{
+    EXPECT_LT(check_fft(OSKAR_DOUBLE, OSKAR_FFT_FFTW, 70), 1e-10);
+    EXPECT_LT(check_fft(OSKAR_SINGLE, OSKAR_FFT_FFTW, 70), 1e-3);
+    EXPECT_LT(check_fft(OSKAR_DOUBLE, OSKAR_FFT_FFTW, 5), 1e-10);
+}
+
+TEST(fft, fftw_in_parallel_region)
+{
+    // Transforms run from inside a parallel region use the single-threaded
+    // plan, and must agree with the multi-threaded one.
+    const int n = 64, num_grids = 4;
+    int status = 0;
+    oskar_FFT* fft = oskar_fft_create(OSKAR_DOUBLE, OSKAR_CPU, n,
+            OSKAR_FFT_FFTW, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    ASSERT_EQ((int)OSKAR_FFT_FFTW, oskar_fft_backend(fft));
+    std::vector<oskar_Mem*> grids(num_grids);
+    srand(3);
+    for (int g = 0; g < num_grids; ++g)
+    {
+        grids[g] = oskar_mem_create(OSKAR_DOUBLE_COMPLEX, OSKAR_CPU,
+                n * n, &status);
+        double* d = oskar_mem_double(grids[g], &status);
+        for (int i = 0; i < 2 * n * n; ++i)
+            d[i] = rand() / (double)RAND_MAX - 0.5;
+    }
+    oskar_Mem* ref = oskar_mem_create_copy(grids[0], OSKAR_CPU, &status);
+    oskar_fft_exec(fft, ref, &status);
+#pragma omp parallel for
+    for (int g = 0; g < num_grids; ++g)
+    {
+        int thread_status = 0;
+        oskar_fft_exec(fft, grids[g], &thread_status);
+        if (thread_status)
+        {
+#pragma omp critical
+            status = thread_status;
+        }
+    }
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    double max_diff = 0.0;
+    const double* a = oskar_mem_double_const(ref, &status);
+    const double* b = oskar_mem_double_const(grids[0], &status);
+    for (int i = 0; i < 2 * n * n; ++i)
+        max_diff = std::max(max_diff, fabs(a[i] - b[i]));
+    EXPECT_LT(max_diff, 1e-10);
+    for (int g = 0; g < num_grids; ++g)
+        oskar_mem_free(grids[g], &status);
+    oskar_mem_free(ref, &status);
+    oskar_fft_free(fft);
+}
+#endif
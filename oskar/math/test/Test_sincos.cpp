@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2018, The University of Oxford
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the University of Oxford nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "math/oskar_sincos_inline.h"
+
+#include <cmath>
+#include <cstdlib>
+
+TEST(sincos, single_precision)
+{
+    double max_err = 0.0;
+    for (int i = -200000; i <= 200000; ++i)
+    {
+        float s, c;
+        const float x = (float) (i * 0.0409);
+        oskar_sincos_f(x, &s, &c);
+        const double err_s = fabs(s - sin((double) x));
+        const double err_c = fabs(c - cos((double) x));
+        if (err_s > max_err) max_err = err_s;
+        if (err_c > max_err) max_err = err_c;
+    }
+    EXPECT_LT(max_err, 2e-7);
+}
+
+TEST(sincos, double_precision)
+{
+    double max_err = 0.0;
+    srand(1);
+    for (int i = 0; i < 400000; ++i)
+    {
+        double s, c;
+        const double x = 2e4 * ((double) rand() / RAND_MAX - 0.5);
+        oskar_sincos_d(x, &s, &c);
+        const double err_s = fabs(s - sin(x));
+        const double err_c = fabs(c - cos(x));
+        if (err_s > max_err) max_err = err_s;
+        if (err_c > max_err) max_err = err_c;
+    }
+    EXPECT_LT(max_err, 1e-15);
+}
+
+TEST(sincos, single_precision_large)
+{
+    // Phases on long baselines at high frequency can be ~1e6 radians.
+    double max_err = 0.0;
+    srand(2);
+    for (int i = 0; i < 400000; ++i)
+    {
+        float s, c;
+        const float x = (float) (2e7 * ((double) rand() / RAND_MAX - 0.5));
+        oskar_sincos_f(x, &s, &c);
+        const double err_s = fabs(s - sin((double) x));
+        const double err_c = fabs(c - cos((double) x));
+        if (err_s > max_err) max_err = err_s;
+        if (err_c > max_err) max_err = err_c;
+    }
+    EXPECT_LT(max_err, 2e-7);
+}
+
+TEST(sincos, fast_single_precision)
+{
+    double max_err = 0.0;
+    srand(3);
+    for (int i = 0; i < 400000; ++i)
+    {
+        float s, c;
+        const float x = (float) (2e7 * ((double) rand() / RAND_MAX - 0.5));
+        oskar_sincos_fast_f(i % 2 ? x : x * 1e-3f, &s, &c);
+        const double t = (double) (i % 2 ? x : x * 1e-3f);
+        const double err_s = fabs(s - sin(t));
+        const double err_c = fabs(c - cos(t));
+        if (err_s > max_err) max_err = err_s;
+        if (err_c > max_err) max_err = err_c;
+    }
+    EXPECT_LT(max_err, 2e-7);
+}
+
+TEST(sincos, double_precision_large)
+{
+    double max_err = 0.0;
+    srand(4);
+    for (int i = 0; i < 400000; ++i)
+    {
+        double s, c;
+        const double x = 2e7 * ((double) rand() / RAND_MAX - 0.5);
+        oskar_sincos_d(x, &s, &c);
+        const double err_s = fabs(s - sin(x));
+        const double err_c = fabs(c - cos(x));
+        if (err_s > max_err) max_err = err_s;
+        if (err_c > max_err) max_err = err_c;
+    }
+    EXPECT_LT(max_err, 1e-15);
+}
+
+TEST(sincos, special_values)
+{
+    const double inf = HUGE_VAL, nan = inf - inf;
+    const double x[] = {nan, inf, -inf, 1e10, -3e12, 1e30};
+    for (size_t i = 0; i < sizeof(x) / sizeof(double); ++i)
+    {
+        float s_f, c_f, s_ff, c_ff;
+        double s_d, c_d;
+        oskar_sincos_f((float) x[i], &s_f, &c_f);
+        oskar_sincos_fast_f((float) x[i], &s_ff, &c_ff);
+        oskar_sincos_d(x[i], &s_d, &c_d);
+        if (std::isfinite(x[i]))
+        {
+            const double xf = (double) (float) x[i];
+            EXPECT_NEAR(sin(xf), s_f, 2e-7);
+            EXPECT_NEAR(cos(xf), c_f, 2e-7);
+            EXPECT_NEAR(sin(xf), s_ff, 2e-7);
+            EXPECT_NEAR(cos(xf), c_ff, 2e-7);
+            EXPECT_NEAR(sin(x[i]), s_d, 1e-15);
+            EXPECT_NEAR(cos(x[i]), c_d, 1e-15);
+        }
+        else
+        {
+            EXPECT_TRUE(std::isnan(s_f) && std::isnan(c_f));
+            EXPECT_TRUE(std::isnan(s_ff) && std::isnan(c_ff));
+            EXPECT_TRUE(std::isnan(s_d) && std::isnan(c_d));
+        }
+    }
+}
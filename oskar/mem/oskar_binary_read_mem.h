@@ -83,6 +83,37 @@ void oskar_binary_read_mem_ext(oskar_Binary* handle, oskar_Mem* mem,
         const char* name_group, const char* name_tag, int user_index,
         int* status);
 
+/**
+ * @brief
+ * Returns an OSKAR memory block for data in an OSKAR binary file.
+ *
+ * @details
+ * This function returns a new memory block in CPU memory that holds the
+ * contents of a chunk in a binary file, without copying it if possible.
+ *
+ * If the file can be memory-mapped, and the payload is suitably aligned,
+ * the returned block is an alias of the payload in the mapped file
+ * (see oskar_binary_map_block()). The binary file handle must then not be
+ * freed while the block is in use. Otherwise, the data are read into a
+ * new block that owns its memory.
+ *
+ * The block must be freed using oskar_mem_free() when no longer required.
+ *
+ * @param[in,out] handle   Binary file handle.
+ * @param[in] type         Type of the memory (as in oskar_Mem).
+ * @param[in] id_group     Tag group identifier.
+ * @param[in] id_tag       Tag identifier.
+ * @param[in] user_index   User-defined index.
+ * @param[in] check_crc    If set, check the CRC code of a mapped chunk.
+ * @param[in,out] status   Status return code.
+ *
+ * @return A handle to the memory block.
+ */
+OSKAR_EXPORT
+oskar_Mem* oskar_binary_map_mem(oskar_Binary* handle, int type,
+        unsigned char id_group, unsigned char id_tag, int user_index,
+        int check_crc, int* status);
+
 #ifdef __cplusplus
 }
 #endif
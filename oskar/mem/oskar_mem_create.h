@@ -64,6 +64,29 @@ OSKAR_EXPORT
 oskar_Mem* oskar_mem_create(int type, int location, size_t num_elements,
         int* status);
 
+/**
+ * @brief
+ * Creates a memory block without clearing its contents.
+ *
+ * @details
+ * This is the same as oskar_mem_create(), except that memory allocated on
+ * the host is not set to zero. It should be used only if the contents
+ * will be overwritten straight away.
+ *
+ * The memory must be deallocated using oskar_mem_free() when it is
+ * no longer required.
+ *
+ * @param[in] type          Enumerated data type of memory contents.
+ * @param[in] location      Either OSKAR_CPU or OSKAR_GPU.
+ * @param[in] num_elements  Number of elements of type \p type in the array.
+ * @param[in,out]  status   Status return code.
+ *
+ * @return A handle to the memory block structure.
+ */
+OSKAR_EXPORT
+oskar_Mem* oskar_mem_create_no_clear(int type, int location,
+        size_t num_elements, int* status);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2018, The University of Oxford
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the University of Oxford nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef OSKAR_MEM_POOL_H_
+#define OSKAR_MEM_POOL_H_
+
+/**
+ * @file oskar_mem_pool.h
+ */
+
+#include <oskar_global.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief
+ * Releases memory handles cached by the calling thread.
+ *
+ * @details
+ * Handles freed using oskar_mem_free() are kept in a pool belonging to
+ * the calling thread, so that they can be reused by subsequent calls to
+ * oskar_mem_create() and oskar_mem_create_alias() without going back
+ * to the heap.
+ *
+ * This function returns the cached handles to the heap, and should be
+ * called by a thread before it exits if it has freed any memory.
+ */
+OSKAR_EXPORT
+void oskar_mem_pool_clear(void);
+
+/**
+ * @brief
+ * Returns memory allocation counts for the calling thread.
+ *
+ * @details
+ * Returns the number of heap allocations made for memory handles and
+ * host memory blocks, and the number of handles reused from the pool,
+ * since the calling thread started.
+ *
+ * @param[out] num_heap_allocs  Number of heap allocations made.
+ * @param[out] num_reused       Number of handles reused from the pool.
+ */
+OSKAR_EXPORT
+void oskar_mem_pool_stats(unsigned long long* num_heap_allocs,
+        unsigned long long* num_reused);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OSKAR_MEM_POOL_H_ */
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2018, The University of Oxford
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the University of Oxford nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef OSKAR_MEM_TRANSPOSE_H_
+#define OSKAR_MEM_TRANSPOSE_H_
+
+/**
+ * @file oskar_mem_transpose.h
+ */
+
+#include <oskar_global.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief
+ * Transposes a stack of matrices held in memory.
+ *
+ * @details
+ * This function transposes each matrix in a stack of matrices, so that
+ * an input array with dimensions (num_matrices, num_rows, num_cols, block_len)
+ * is written to an output array with dimensions
+ * (num_matrices, num_cols, num_rows, block_len), where block_len is the
+ * fastest-varying dimension. Each entry in a matrix is a contiguous block of
+ * \p block_len elements, which is copied as a unit.
+ *
+ * This can be used to swap the channel and baseline dimensions of
+ * visibility data, for example.
+ *
+ * The transpose is done in square tiles to make good use of the cache,
+ * and the tiles are shared between threads if OpenMP is available.
+ *
+ * Both arrays must be of the same data type, and in CPU memory.
+ * The output array is resized if necessary.
+ *
+ * @param[in]  in            Input array.
+ * @param[out] out           Output array. Must not overlap \p in.
+ * @param[in]  num_matrices  Number of matrices in the stack.
+ * @param[in]  num_rows      Number of rows in each input matrix.
+ * @param[in]  num_cols      Number of columns in each input matrix.
+ * @param[in]  block_len     Number of elements in each matrix entry.
+ * @param[in,out]  status    Status return code.
+ */
+OSKAR_EXPORT
+void oskar_mem_transpose(const oskar_Mem* in, oskar_Mem* out,
+        size_t num_matrices, size_t num_rows, size_t num_cols,
+        size_t block_len, int* status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OSKAR_MEM_TRANSPOSE_H_ */
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2018, The University of Oxford
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the University of Oxford nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef OSKAR_PRIVATE_MEM_POOL_H_
+#define OSKAR_PRIVATE_MEM_POOL_H_
+
+#include <stddef.h> /* For size_t */
+
+#include <oskar_global.h>
+#include <mem/private_mem.h>
+
+/* Alignment of host memory blocks, in bytes. */
+#define OSKAR_MEM_HOST_ALIGNMENT 64
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Returns a handle with all bits zero, from the pool if possible. */
+oskar_Mem* oskar_mem_pool_handle_get(void);
+
+/* Returns a handle to the pool of the calling thread. */
+void oskar_mem_pool_handle_put(oskar_Mem* mem);
+
+/* Allocates an aligned block of host memory, optionally cleared. */
+void* oskar_mem_pool_host_alloc(size_t bytes, int clear);
+
+/* Resizes an aligned block of host memory, clearing any new space. */
+void* oskar_mem_pool_host_realloc(void* ptr, size_t old_bytes,
+        size_t new_bytes);
+
+/* Frees an aligned block of host memory. */
+void oskar_mem_pool_host_free(void* ptr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OSKAR_PRIVATE_MEM_POOL_H_ */
@@ -116,6 +116,40 @@ void oskar_binary_read_mem_ext(oskar_Binary* handle, oskar_Mem* mem,
     oskar_mem_free(temp, status);
 }
 
+oskar_Mem* oskar_binary_map_mem(oskar_Binary* handle, int type,
+        unsigned char id_group, unsigned char id_tag, int user_index,
+        int check_crc, int* status)
+{
+    int chunk_index;
+    oskar_Mem* mem = 0;
+    void* data = 0;
+    size_t size_bytes = 0, element_size = 0;
+
+    /* Check if safe to proceed. */
+    if (*status) return 0;
+
+    /* Find the chunk, and try to map it. */
+    chunk_index = oskar_binary_query(handle, (unsigned char)type,
+            id_group, id_tag, user_index, &size_bytes, status);
+    data = oskar_binary_map_block(handle, chunk_index, check_crc, status);
+    if (*status) return 0;
+
+    /* Alias the mapped payload only if it is aligned for the data type.
+     * (Complex types are aligned to the size of a complex number.) */
+    element_size = oskar_mem_element_size(type);
+    if (data && ((size_t)data %
+            oskar_mem_element_size(type & ~OSKAR_MATRIX)) == 0)
+        return oskar_mem_create_alias_from_raw(data, type, OSKAR_CPU,
+                size_bytes / element_size, status);
+
+    /* Otherwise, read a copy. */
+    mem = oskar_mem_create_no_clear(type, OSKAR_CPU,
+            size_bytes / element_size, status);
+    oskar_binary_read_block(handle, chunk_index, size_bytes,
+            oskar_mem_void(mem), status);
+    return mem;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -35,6 +35,10 @@ extern "C" {
 
 int oskar_mem_allocated(const oskar_Mem* mem)
 {
+#ifdef OSKAR_HAVE_OPENCL
+    if (mem->location & OSKAR_CL)
+        return mem->buffer ? 1 : 0;
+#endif
     return mem->data ? 1 : 0;
 }
 
@@ -75,7 +75,8 @@ oskar_Mem* oskar_mem_convert_precision(const oskar_Mem* input,
         type |= OSKAR_MATRIX;
         num_elements *= 4;
     }
-    output = oskar_mem_create(type, OSKAR_CPU, oskar_mem_length(in), status);
+    output = oskar_mem_create_no_clear(type, OSKAR_CPU,
+            oskar_mem_length(in), status);
 
     /* Convert the data. */
     if (input_precision == OSKAR_SINGLE &&
@@ -32,6 +32,7 @@
 
 #include "mem/oskar_mem.h"
 #include "mem/private_mem.h"
+#include "mem/private_mem_pool.h"
 #include "utility/oskar_cl_utils.h"
 #include "utility/oskar_device_utils.h"
 
@@ -41,14 +42,14 @@
 extern "C" {
 #endif
 
-oskar_Mem* oskar_mem_create(int type, int location, size_t num_elements,
-         int* status)
+static oskar_Mem* mem_create(int type, int location, size_t num_elements,
+        int clear, int* status)
 {
     oskar_Mem* mem = 0;
     size_t element_size, bytes;
 
     /* Create the structure. */
-    mem = (oskar_Mem*) calloc(1, sizeof(oskar_Mem));
+    mem = oskar_mem_pool_handle_get();
     if (!mem)
     {
         *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
@@ -80,8 +81,8 @@ oskar_Mem* oskar_mem_create(int type, int location, size_t num_elements,
     mem->num_elements = num_elements;
     if (location == OSKAR_CPU)
     {
-        /* Allocate host memory. */
-        mem->data = calloc(bytes, 1);
+        /* Allocate aligned host memory. */
+        mem->data = oskar_mem_pool_host_alloc(bytes, clear);
         if (mem->data == NULL)
             *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
     }
@@ -119,6 +120,18 @@ oskar_Mem* oskar_mem_create(int type, int location, size_t num_elements,
     return mem;
 }
 
+oskar_Mem* oskar_mem_create(int type, int location, size_t num_elements,
+         int* status)
+{
+    return mem_create(type, location, num_elements, 1, status);
+}
+
+oskar_Mem* oskar_mem_create_no_clear(int type, int location,
+        size_t num_elements, int* status)
+{
+    return mem_create(type, location, num_elements, 0, status);
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -28,6 +28,7 @@
 
 #include "mem/oskar_mem.h"
 #include "mem/private_mem.h"
+#include "mem/private_mem_pool.h"
 
 #include <stdlib.h>
 
@@ -40,8 +41,10 @@ oskar_Mem* oskar_mem_create_alias(const oskar_Mem* src, size_t offset,
 {
     oskar_Mem* mem = 0;
 
-    /* Create the structure, initialised with all bits zero. */
-    mem = (oskar_Mem*) calloc(1, sizeof(oskar_Mem));
+    /* Create the structure, initialised with all bits zero.
+     * Handles are reused from the pool for the calling thread, so that
+     * aliases can be created and freed in loops without heap allocation. */
+    mem = oskar_mem_pool_handle_get();
     if (!mem)
     {
         *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
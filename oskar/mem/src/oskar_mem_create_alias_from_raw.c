@@ -28,6 +28,7 @@
 
 #include "mem/oskar_mem.h"
 #include "mem/private_mem.h"
+#include "mem/private_mem_pool.h"
 
 #include <stdlib.h>
 
@@ -41,7 +42,7 @@ oskar_Mem* oskar_mem_create_alias_from_raw(void* ptr, int type, int location,
     oskar_Mem* mem = 0;
 
     /* Create the structure. */
-    mem = (oskar_Mem*) calloc(1, sizeof(oskar_Mem));
+    mem = oskar_mem_pool_handle_get();
     if (!mem)
     {
         *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
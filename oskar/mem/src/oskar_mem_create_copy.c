@@ -41,7 +41,7 @@ oskar_Mem* oskar_mem_create_copy(const oskar_Mem* src, int location,
     if (*status) return 0;
 
     /* Create the new structure. */
-    mem = oskar_mem_create(oskar_mem_type(src), location,
+    mem = oskar_mem_create_no_clear(oskar_mem_type(src), location,
             oskar_mem_length(src), status);
     if (!mem || *status)
         return mem;
@@ -32,6 +32,7 @@
 
 #include "mem/oskar_mem.h"
 #include "mem/private_mem.h"
+#include "mem/private_mem_pool.h"
 #include "utility/oskar_device_utils.h"
 
 #include <stdlib.h>
@@ -67,7 +68,7 @@ void oskar_mem_free(oskar_Mem* mem, int* status)
         if (mem->location == OSKAR_CPU)
         {
             /* Free host memory. */
-            free(mem->data);
+            oskar_mem_pool_host_free(mem->data);
         }
         else if (mem->location == OSKAR_GPU)
         {
@@ -81,8 +82,8 @@ void oskar_mem_free(oskar_Mem* mem, int* status)
         }
     }
 
-    /* Free the structure itself. */
-    free(mem);
+    /* Return the structure itself to the pool. */
+    oskar_mem_pool_handle_put(mem);
 }
 
 #ifdef __cplusplus
@@ -32,11 +32,24 @@
 
 #include "mem/oskar_mem.h"
 #include "mem/private_mem.h"
+#include "utility/oskar_cl_utils.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#ifdef OSKAR_HAVE_OPENCL
+static void read_cl_element(const oskar_Mem* mem, size_t index,
+        size_t element_size, void* val, int* status)
+{
+    const cl_int error = clEnqueueReadBuffer(oskar_cl_command_queue(),
+            mem->buffer, CL_TRUE, index * element_size, element_size,
+            val, 0, NULL, NULL);
+    if (error != CL_SUCCESS)
+        *status = OSKAR_ERR_MEMORY_COPY_FAILURE;
+}
+#endif
+
 double oskar_mem_get_element(const oskar_Mem* mem, size_t index, int* status)
 {
     int precision, location;
@@ -85,6 +98,30 @@ double oskar_mem_get_element(const oskar_Mem* mem, size_t index, int* status)
         }
 #else
         *status = OSKAR_ERR_CUDA_NOT_AVAILABLE;
+#endif
+    }
+    else if (location & OSKAR_CL)
+    {
+#ifdef OSKAR_HAVE_OPENCL
+        switch (precision)
+        {
+        case OSKAR_DOUBLE:
+        {
+            double val = 0.0;
+            read_cl_element(mem, index, sizeof(double), &val, status);
+            return val;
+        }
+        case OSKAR_SINGLE:
+        {
+            float val = 0.0f;
+            read_cl_element(mem, index, sizeof(float), &val, status);
+            return val;
+        }
+        default:
+            *status = OSKAR_ERR_BAD_DATA_TYPE;
+        }
+#else
+        *status = OSKAR_ERR_OPENCL_NOT_AVAILABLE;
 #endif
     }
     else
@@ -153,6 +190,29 @@ double2 oskar_mem_get_element_complex(const oskar_Mem* mem, size_t index,
             *status = OSKAR_ERR_BAD_DATA_TYPE;
 #else
         *status = OSKAR_ERR_CUDA_NOT_AVAILABLE;
+#endif
+    }
+    else if (location & OSKAR_CL)
+    {
+#ifdef OSKAR_HAVE_OPENCL
+        if (type == OSKAR_DOUBLE_COMPLEX)
+        {
+            read_cl_element(mem, index, sizeof(double2), &val, status);
+            return val;
+        }
+        else if (type == OSKAR_SINGLE_COMPLEX)
+        {
+            float2 temp;
+            temp.x = temp.y = 0.0f;
+            read_cl_element(mem, index, sizeof(float2), &temp, status);
+            val.x = (double) temp.x;
+            val.y = (double) temp.y;
+            return val;
+        }
+        else
+            *status = OSKAR_ERR_BAD_DATA_TYPE;
+#else
+        *status = OSKAR_ERR_OPENCL_NOT_AVAILABLE;
 #endif
     }
     else
@@ -241,6 +301,35 @@ double4c oskar_mem_get_element_matrix(const oskar_Mem* mem, size_t index,
             *status = OSKAR_ERR_BAD_DATA_TYPE;
 #else
         *status = OSKAR_ERR_CUDA_NOT_AVAILABLE;
+#endif
+    }
+    else if (location & OSKAR_CL)
+    {
+#ifdef OSKAR_HAVE_OPENCL
+        if (type == OSKAR_DOUBLE_COMPLEX_MATRIX)
+        {
+            read_cl_element(mem, index, sizeof(double4c), &val, status);
+            return val;
+        }
+        else if (type == OSKAR_SINGLE_COMPLEX_MATRIX)
+        {
+            float4c temp;
+            read_cl_element(mem, index, sizeof(float4c), &temp, status);
+            if (*status) return val;
+            val.a.x = (double) temp.a.x;
+            val.a.y = (double) temp.a.y;
+            val.b.x = (double) temp.b.x;
+            val.b.y = (double) temp.b.y;
+            val.c.x = (double) temp.c.x;
+            val.c.y = (double) temp.c.y;
+            val.d.x = (double) temp.d.x;
+            val.d.y = (double) temp.d.y;
+            return val;
+        }
+        else
+            *status = OSKAR_ERR_BAD_DATA_TYPE;
+#else
+        *status = OSKAR_ERR_OPENCL_NOT_AVAILABLE;
 #endif
     }
     else
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2018, The University of Oxford
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the University of Oxford nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/oskar_mem.h"
+#include "mem/oskar_mem_pool.h"
+#include "mem/private_mem_pool.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef OSKAR_OS_WIN
+#define OSKAR_THREAD_LOCAL __declspec(thread)
+#else
+#define OSKAR_THREAD_LOCAL __thread
+#endif
+
+/* Maximum number of handles cached by each thread. */
+#define MAX_POOL_HANDLES 256
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Free handles are linked through their data pointers. */
+static OSKAR_THREAD_LOCAL oskar_Mem* pool_head_ = 0;
+static OSKAR_THREAD_LOCAL int pool_size_ = 0;
+static OSKAR_THREAD_LOCAL unsigned long long num_heap_allocs_ = 0;
+static OSKAR_THREAD_LOCAL unsigned long long num_reused_ = 0;
+
+oskar_Mem* oskar_mem_pool_handle_get(void)
+{
+    oskar_Mem* mem = pool_head_;
+    if (mem)
+    {
+        pool_head_ = (oskar_Mem*) mem->data;
+        pool_size_--;
+        num_reused_++;
+        memset(mem, 0, sizeof(oskar_Mem));
+        return mem;
+    }
+    num_heap_allocs_++;
+    return (oskar_Mem*) calloc(1, sizeof(oskar_Mem));
+}
+
+void oskar_mem_pool_handle_put(oskar_Mem* mem)
+{
+    if (!mem) return;
+    if (pool_size_ >= MAX_POOL_HANDLES)
+    {
+        free(mem);
+        return;
+    }
+    mem->data = pool_head_;
+    pool_head_ = mem;
+    pool_size_++;
+}
+
+void* oskar_mem_pool_host_alloc(size_t bytes, int clear)
+{
+    char *raw, *ptr;
+    const size_t extra = OSKAR_MEM_HOST_ALIGNMENT + sizeof(void*);
+
+    /* Over-allocate, and store the original pointer just before the
+     * aligned block so that it can be freed later. */
+    num_heap_allocs_++;
+    raw = (char*) (clear ? calloc(bytes + extra, 1) : malloc(bytes + extra));
+    if (!raw) return 0;
+    ptr = (char*) (((uintptr_t) (raw + extra)) &
+            ~((uintptr_t) (OSKAR_MEM_HOST_ALIGNMENT - 1)));
+    ((void**) ptr)[-1] = raw;
+    return ptr;
+}
+
+void* oskar_mem_pool_host_realloc(void* ptr, size_t old_bytes,
+        size_t new_bytes)
+{
+    void* ptr_new;
+    if (new_bytes == 0)
+    {
+        oskar_mem_pool_host_free(ptr);
+        return 0;
+    }
+    ptr_new = oskar_mem_pool_host_alloc(new_bytes, 0);
+    if (!ptr_new) return 0;
+    if (ptr)
+        memcpy(ptr_new, ptr, old_bytes < new_bytes ? old_bytes : new_bytes);
+    else
+        old_bytes = 0;
+    if (new_bytes > old_bytes)
+        memset((char*) ptr_new + old_bytes, 0, new_bytes - old_bytes);
+    oskar_mem_pool_host_free(ptr);
+    return ptr_new;
+}
+
+void oskar_mem_pool_host_free(void* ptr)
+{
+    if (ptr) free(((void**) ptr)[-1]);
+}
+
+void oskar_mem_pool_clear(void)
+{
+    while (pool_head_)
+    {
+        oskar_Mem* mem = pool_head_;
+        pool_head_ = (oskar_Mem*) mem->data;
+        free(mem);
+    }
+    pool_size_ = 0;
+}
+
+void oskar_mem_pool_stats(unsigned long long* num_heap_allocs,
+        unsigned long long* num_reused)
+{
+    if (num_heap_allocs) *num_heap_allocs = num_heap_allocs_;
+    if (num_reused) *num_reused = num_reused_;
+}
+
+#ifdef __cplusplus
+}
+#endif
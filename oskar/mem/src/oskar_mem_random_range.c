@@ -58,7 +58,8 @@ void oskar_mem_random_range(oskar_Mem* mem, double lo, double hi, int* status)
     ptr = mem;
     if (location != OSKAR_CPU)
     {
-        temp = oskar_mem_create(type, OSKAR_CPU, num_elements, status);
+        temp = oskar_mem_create_no_clear(type, OSKAR_CPU, num_elements,
+                status);
         if (*status)
         {
             oskar_mem_free(temp, status);
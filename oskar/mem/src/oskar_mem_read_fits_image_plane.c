@@ -211,7 +211,8 @@ oskar_Mem* oskar_mem_read_fits_image_plane(const char* filename, int i_time,
     }
 
     /* Read image pixel data. */
-    data = oskar_mem_create(type_oskar, OSKAR_CPU, num_pixels, status);
+    data = oskar_mem_create_no_clear(type_oskar, OSKAR_CPU, num_pixels,
+            status);
     fits_read_pix(fptr, type_fits, firstpix, num_pixels,
             &nul, oskar_mem_void(data), &anynul, status);
     fits_close_file(fptr, status);
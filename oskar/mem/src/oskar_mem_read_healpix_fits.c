@@ -130,7 +130,8 @@ oskar_Mem* oskar_mem_read_healpix_fits(const char* filename,
     }
 
     /* Read the FITS binary table into memory, and close the file. */
-    data = oskar_mem_create(type_oskar, OSKAR_CPU, num_pixels, status);
+    data = oskar_mem_create_no_clear(type_oskar, OSKAR_CPU, num_pixels,
+            status);
     fits_read_col(fptr, type_fits, col_index, 1, 1, num_pixels, 0,
             oskar_mem_void(data), 0, status);
     fits_close_file(fptr, status);
@@ -32,6 +32,7 @@
 
 #include "mem/oskar_mem.h"
 #include "mem/private_mem.h"
+#include "mem/private_mem_pool.h"
 #include "utility/oskar_cl_utils.h"
 #include "utility/oskar_device_utils.h"
 
@@ -74,19 +75,16 @@ void oskar_mem_realloc(oskar_Mem* mem, size_t num_elements, int* status)
     /* Check memory location. */
     if (mem->location == OSKAR_CPU)
     {
-        /* Reallocate the memory. */
+        /* Reallocate the memory.
+         * The new memory is initialised if it's larger than the old block. */
         void* mem_new = NULL;
-        mem_new = realloc(mem->data, new_size);
+        mem_new = oskar_mem_pool_host_realloc(mem->data, old_size, new_size);
         if (!mem_new && (new_size > 0))
         {
             *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
             return;
         }
 
-        /* Initialise the new memory if it's larger than the old block. */
-        if (new_size > old_size)
-            memset((char*)mem_new + old_size, 0, new_size - old_size);
-
         /* Set the new meta-data. */
         mem->data = (new_size > 0) ? mem_new : 0;
         mem->num_elements = num_elements;
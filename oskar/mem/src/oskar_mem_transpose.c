@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2018, The University of Oxford
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the University of Oxford nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/oskar_mem.h"
+#include "mem/private_mem.h"
+
+#include <string.h>
+
+/* Side length of the tiles used for the transpose, in matrix entries. */
+#define TILE_SIZE 32
+
+#define MIN(A, B) ((A) < (B) ? (A) : (B))
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void oskar_mem_transpose(const oskar_Mem* in, oskar_Mem* out,
+        size_t num_matrices, size_t num_rows, size_t num_cols,
+        size_t block_len, int* status)
+{
+    size_t entry_bytes, num_elements, tiles_per_row, tiles_per_col;
+    long int i, num_tiles;
+    const char* src;
+    char* dst;
+
+    /* Check if safe to proceed. */
+    if (*status) return;
+
+    /* Check the data types and locations. */
+    if (in->type != out->type)
+    {
+        *status = OSKAR_ERR_TYPE_MISMATCH;
+        return;
+    }
+    if (in->location != OSKAR_CPU || out->location != OSKAR_CPU)
+    {
+        *status = OSKAR_ERR_BAD_LOCATION;
+        return;
+    }
+
+    /* Check the data dimensions. */
+    num_elements = num_matrices * num_rows * num_cols * block_len;
+    if (num_elements == 0) return;
+    if (num_elements > in->num_elements)
+    {
+        *status = OSKAR_ERR_OUT_OF_RANGE;
+        return;
+    }
+    if (out->num_elements < num_elements)
+        oskar_mem_realloc(out, num_elements, status);
+    if (*status) return;
+
+    /* Transpose the matrices in square tiles.
+     * Tiles are independent, so they can be shared between threads. */
+    entry_bytes = block_len * oskar_mem_element_size(in->type);
+    tiles_per_row = (num_cols + TILE_SIZE - 1) / TILE_SIZE;
+    tiles_per_col = (num_rows + TILE_SIZE - 1) / TILE_SIZE;
+    num_tiles = (long int) (num_matrices * tiles_per_row * tiles_per_col);
+    src = (const char*) in->data;
+    dst = (char*) out->data;
+#pragma omp parallel for schedule(static)
+    for (i = 0; i < num_tiles; ++i)
+    {
+        size_t m, r, c, r0, c0, r_end, c_end, tile;
+        const char* src_m;
+        char* dst_m;
+        m = (size_t) i / (tiles_per_row * tiles_per_col);
+        tile = (size_t) i % (tiles_per_row * tiles_per_col);
+        r0 = (tile / tiles_per_row) * TILE_SIZE;
+        c0 = (tile % tiles_per_row) * TILE_SIZE;
+        r_end = MIN(r0 + TILE_SIZE, num_rows);
+        c_end = MIN(c0 + TILE_SIZE, num_cols);
+        src_m = src + m * num_rows * num_cols * entry_bytes;
+        dst_m = dst + m * num_rows * num_cols * entry_bytes;
+        for (c = c0; c < c_end; ++c)
+            for (r = r0; r < r_end; ++r)
+                memcpy(dst_m + (c * num_rows + r) * entry_bytes,
+                        src_m + (r * num_cols + c) * entry_bytes,
+                        entry_bytes);
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
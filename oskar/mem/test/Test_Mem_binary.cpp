@@ -284,3 +284,109 @@ TEST(binary_file, binary_read_write_mem)
     ASSERT_EQ(0, status) << oskar_get_error_string(status);
 }
 
+
+TEST(binary_file, binary_map_mem)
+{
+    const char filename[] = "temp_test_mem_binary_map.dat";
+    const int num = 1000;
+    int status = 0, num_aliases = 0;
+
+    // Write arrays with different alignments in the file.
+    oskar_Binary* h = oskar_binary_create(filename, 'w', &status);
+    oskar_Mem* mem = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU, num, &status);
+    double* data = oskar_mem_double(mem, &status);
+    for (int j = 0; j < 2; ++j)
+    {
+        for (int i = 0; i < num; ++i) data[i] = i * 2.5 + j;
+        oskar_binary_write_mem(h, mem, 1, 2, j, 0, &status);
+        oskar_binary_write_int(h, 3, 4, j, j, &status);
+    }
+    oskar_mem_free(mem, &status);
+    oskar_binary_free(h);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+    // Map the arrays, and check the contents.
+    h = oskar_binary_create(filename, 'r', &status);
+    for (int j = 0; j < 2; ++j)
+    {
+        mem = oskar_binary_map_mem(h, OSKAR_DOUBLE, 1, 2, j, 1, &status);
+        ASSERT_EQ(0, status) << oskar_get_error_string(status);
+        ASSERT_EQ(num, (int)oskar_mem_length(mem));
+        data = oskar_mem_double(mem, &status);
+        if ((char*)data >= h->map_data &&
+                (char*)data < h->map_data + h->map_size)
+            num_aliases++;
+        for (int i = 0; i < num; ++i)
+            EXPECT_DOUBLE_EQ(i * 2.5 + j, data[i]);
+
+        // Changes to mapped data must not affect the file.
+        data[0] = -1.0;
+        oskar_mem_free(mem, &status);
+    }
+    EXPECT_EQ(1, num_aliases);
+    mem = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU, 0, &status);
+    oskar_binary_read_mem(h, mem, 1, 2, 0, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    EXPECT_DOUBLE_EQ(0.0, oskar_mem_double(mem, &status)[0]);
+    oskar_mem_free(mem, &status);
+    oskar_binary_free(h);
+    remove(filename);
+}
+
+
+TEST(binary_file, binary_map_mem_crc)
+{
+    const char filename[] = "temp_test_mem_binary_map_crc.dat";
+    const int num = 1000;
+    int status = 0;
+
+    // Write two arrays.
+    oskar_Binary* h = oskar_binary_create(filename, 'w', &status);
+    oskar_Mem* mem = oskar_mem_create(OSKAR_INT, OSKAR_CPU, num, &status);
+    int* data = oskar_mem_int(mem, &status);
+    for (int i = 0; i < num; ++i) data[i] = i;
+    oskar_binary_write_mem(h, mem, 1, 2, 0, 0, &status);
+    oskar_binary_write_mem(h, mem, 1, 2, 1, 0, &status);
+    oskar_mem_free(mem, &status);
+    oskar_binary_free(h);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+    // Corrupt the second array in the file.
+    h = oskar_binary_create(filename, 'r', &status);
+    const int chunk = oskar_binary_query(h, 0, 1, 2, 1, 0, &status);
+    const long offset = h->payload_offset_bytes[chunk];
+    oskar_binary_free(h);
+    FILE* f = fopen(filename, "r+b");
+    ASSERT_TRUE(f != 0);
+    fseek(f, offset, SEEK_SET);
+    fputc(0x55, f);
+    fclose(f);
+
+    // Check the corrupted chunk is only rejected if its CRC is checked.
+    h = oskar_binary_create(filename, 'r', &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    void* p = oskar_binary_map_block(h, chunk, 0, &status);
+    if (!p)
+    {
+        // The file could not be mapped on this system.
+        oskar_binary_free(h);
+        remove(filename);
+        return;
+    }
+    EXPECT_EQ(0, status) << oskar_get_error_string(status);
+    EXPECT_TRUE(oskar_binary_map_block(h, chunk, 1, &status) == 0);
+    EXPECT_EQ((int) OSKAR_ERR_BINARY_CRC_FAIL, status);
+    status = 0;
+
+    // Check the intact chunk is checked once, and then remembered.
+    const int chunk0 = oskar_binary_query(h, 0, 1, 2, 0, 0, &status);
+    data = (int*) oskar_binary_map_block(h, chunk0, 1, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    EXPECT_EQ(1, h->map_crc_checked[chunk0]);
+    EXPECT_EQ(0, h->map_crc_checked[chunk]);
+    EXPECT_EQ(num - 1, data[num - 1]);
+    oskar_binary_map_block(h, chunk0, 1, &status);
+    EXPECT_EQ(0, status) << oskar_get_error_string(status);
+    oskar_binary_free(h);
+    remove(filename);
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2018, The University of Oxford
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the University of Oxford nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "utility/oskar_get_error_string.h"
+#include "mem/oskar_mem.h"
+
+#include <stdint.h>
+
+TEST(Mem, pool_alignment)
+{
+    int i, status = 0;
+    for (i = 1; i < 20; ++i)
+    {
+        oskar_Mem *mem = oskar_mem_create(OSKAR_SINGLE, OSKAR_CPU,
+                i * 7, &status);
+        ASSERT_EQ(0, status) << oskar_get_error_string(status);
+        EXPECT_EQ(0u, ((uintptr_t) oskar_mem_void(mem)) % 64);
+        EXPECT_EQ(0.0f, oskar_mem_float(mem, &status)[i * 7 - 1]);
+        oskar_mem_realloc(mem, i * 13, &status);
+        ASSERT_EQ(0, status) << oskar_get_error_string(status);
+        EXPECT_EQ(0u, ((uintptr_t) oskar_mem_void(mem)) % 64);
+        EXPECT_EQ(0.0f, oskar_mem_float(mem, &status)[i * 13 - 1]);
+        oskar_mem_free(mem, &status);
+        mem = oskar_mem_create_no_clear(OSKAR_DOUBLE, OSKAR_CPU,
+                i * 5, &status);
+        ASSERT_EQ(0, status) << oskar_get_error_string(status);
+        ASSERT_EQ((size_t) (i * 5), oskar_mem_length(mem));
+        EXPECT_EQ(0u, ((uintptr_t) oskar_mem_void(mem)) % 64);
+        oskar_mem_free(mem, &status);
+    }
+}
+
+TEST(Mem, pool_reuse_alias)
+{
+    int i, status = 0;
+    unsigned long long allocs0 = 0, allocs1 = 0, reused0 = 0, reused1 = 0;
+    oskar_Mem *mem = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU, 100, &status);
+    oskar_mem_free(oskar_mem_create_alias(0, 0, 0, &status), &status);
+    oskar_mem_pool_stats(&allocs0, &reused0);
+    for (i = 0; i < 100; ++i)
+    {
+        oskar_Mem *alias = oskar_mem_create_alias(mem, i, 1, &status);
+        ASSERT_EQ(0, status) << oskar_get_error_string(status);
+        EXPECT_EQ(oskar_mem_double(mem, &status) + i,
+                oskar_mem_double(alias, &status));
+        oskar_mem_free(alias, &status);
+    }
+    oskar_mem_pool_stats(&allocs1, &reused1);
+    EXPECT_EQ(allocs0, allocs1);
+    EXPECT_EQ(reused0 + 100, reused1);
+    oskar_mem_free(mem, &status);
+    oskar_mem_pool_clear();
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2018, The University of Oxford
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the University of Oxford nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "utility/oskar_get_error_string.h"
+#include "mem/oskar_mem.h"
+
+TEST(Mem, transpose)
+{
+    // Use sizes that are not multiples of the tile size.
+    int status = 0;
+    const size_t num_matrices = 3, num_rows = 37, num_cols = 70, block = 4;
+    size_t m, r, c, p, n = num_matrices * num_rows * num_cols * block;
+    oskar_Mem *in, *out;
+
+    // Create test array and fill with data.
+    in = oskar_mem_create(OSKAR_SINGLE_COMPLEX, OSKAR_CPU, n, &status);
+    out = oskar_mem_create(OSKAR_SINGLE_COMPLEX, OSKAR_CPU, 0, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    float2* in_ = oskar_mem_float2(in, &status);
+    for (size_t i = 0; i < n; ++i)
+    {
+        in_[i].x = (float) i;
+        in_[i].y = -(float) i;
+    }
+
+    // Transpose and check the result.
+    oskar_mem_transpose(in, out, num_matrices, num_rows, num_cols, block,
+            &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    ASSERT_EQ(n, oskar_mem_length(out));
+    const float2* out_ = oskar_mem_float2_const(out, &status);
+    for (m = 0; m < num_matrices; ++m)
+        for (r = 0; r < num_rows; ++r)
+            for (c = 0; c < num_cols; ++c)
+                for (p = 0; p < block; ++p)
+                {
+                    size_t i = ((m * num_rows + r) * num_cols + c) * block + p;
+                    size_t j = ((m * num_cols + c) * num_rows + r) * block + p;
+                    ASSERT_EQ(in_[i].x, out_[j].x);
+                    ASSERT_EQ(in_[i].y, out_[j].y);
+                }
+
+    // Check that mismatched types are rejected.
+    oskar_Mem* out_d = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU, n, &status);
+    oskar_mem_transpose(in, out_d, num_matrices, num_rows, num_cols, block,
+            &status);
+    EXPECT_EQ((int) OSKAR_ERR_TYPE_MISMATCH, status);
+    status = 0;
+
+    // Free memory.
+    oskar_mem_free(in, &status);
+    oskar_mem_free(out, &status);
+    oskar_mem_free(out_d, &status);
+}
@@ -87,9 +87,11 @@ enum OSKAR_SKY_TAGS
 #include <sky/oskar_sky_generate_grid.h>
 #include <sky/oskar_sky_generate_random_power_law.h>
 #include <sky/oskar_sky_horizon_clip.h>
+#include <sky/oskar_sky_index.h>
 #include <sky/oskar_sky_load.h>
 #include <sky/oskar_sky_override_polarisation.h>
 #include <sky/oskar_sky_read.h>
+#include <sky/oskar_sky_read_columnar.h>
 #include <sky/oskar_sky_resize.h>
 #include <sky/oskar_sky_rotate_to_position.h>
 #include <sky/oskar_sky_save.h>
@@ -97,7 +99,9 @@ enum OSKAR_SKY_TAGS
 #include <sky/oskar_sky_set_gaussian_parameters.h>
 #include <sky/oskar_sky_set_source.h>
 #include <sky/oskar_sky_set_spectral_index.h>
+#include <sky/oskar_sky_sort_by_position.h>
 #include <sky/oskar_sky_write.h>
+#include <sky/oskar_sky_write_columnar.h>
 
 
 #endif /* OSKAR_SKY_H_ */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011-2014, The University of Oxford
+ * Copyright (c) 2011-2018, The University of Oxford
  * All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
@@ -35,6 +35,7 @@
 
 #include <oskar_global.h>
 #include <telescope/oskar_telescope.h>
+#include <sky/oskar_sky_index.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -52,6 +53,7 @@ extern "C" {
  * @param[out] out          The output sky model.
  * @param[in]  in           The input sky model.
  * @param[in]  telescope    The telescope model.
+ * @param[in]  gast         The Greenwich Apparent Sidereal Time, in radians.
  * @param[in]  work         Work arrays.
  * @param[in,out]  status   Status return code.
  */
@@ -60,6 +62,32 @@ void oskar_sky_horizon_clip(oskar_Sky* out, const oskar_Sky* in,
         const oskar_Telescope* telescope, double gast,
         oskar_StationWork* work, int* status);
 
+/**
+ * @brief
+ * Compacts a sky model into another one by removing sources below the
+ * horizon of all stations, using a spatial index.
+ *
+ * @details
+ * This is the same as oskar_sky_horizon_clip(), except that the horizon
+ * mask is found on the host using a spatial index of the input sky model,
+ * which must have been created from a copy of the input sky model
+ * using oskar_sky_index_create().
+ *
+ * If the index is NULL, this is equivalent to oskar_sky_horizon_clip().
+ *
+ * @param[out] out          The output sky model.
+ * @param[in]  in           The input sky model.
+ * @param[in]  index        Spatial index of the input sky model.
+ * @param[in]  telescope    The telescope model.
+ * @param[in]  gast         The Greenwich Apparent Sidereal Time, in radians.
+ * @param[in]  work         Work arrays.
+ * @param[in,out]  status   Status return code.
+ */
+OSKAR_EXPORT
+void oskar_sky_horizon_clip_index(oskar_Sky* out, const oskar_Sky* in,
+        const oskar_SkyIndex* index, const oskar_Telescope* telescope,
+        double gast, oskar_StationWork* work, int* status);
+
 #ifdef __cplusplus
 }
 #endif
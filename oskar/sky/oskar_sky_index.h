@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2018, The University of Oxford
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the University of Oxford nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef OSKAR_SKY_INDEX_H_
+#define OSKAR_SKY_INDEX_H_
+
+/**
+ * @file oskar_sky_index.h
+ */
+
+#include <oskar_global.h>
+#include <telescope/oskar_telescope.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct oskar_SkyIndex;
+#ifndef OSKAR_SKY_INDEX_TYPEDEF_
+#define OSKAR_SKY_INDEX_TYPEDEF_
+typedef struct oskar_SkyIndex oskar_SkyIndex;
+#endif /* OSKAR_SKY_INDEX_TYPEDEF_ */
+
+/**
+ * @brief
+ * Creates a spatial index for the sources in a sky model.
+ *
+ * @details
+ * Builds a binary tree of bounding cones over the source positions,
+ * so that sources above the horizon can be found without testing every
+ * source individually.
+ *
+ * The index holds its own copy of the source coordinates, so the sky model
+ * is not needed by the query functions. Because the horizon test uses the
+ * relative direction cosines of the sources, the index must be created
+ * after oskar_sky_evaluate_relative_directions() has been called, and it
+ * must be recreated if the sky model is modified.
+ *
+ * The sky model must be in CPU memory.
+ *
+ * @param[in] sky          The sky model to index.
+ * @param[in,out] status   Status return code.
+ *
+ * @return A handle to the new index.
+ */
+OSKAR_EXPORT
+oskar_SkyIndex* oskar_sky_index_create(const oskar_Sky* sky, int* status);
+
+/**
+ * @brief
+ * Frees memory held by a sky index.
+ *
+ * @param[in] index        The index to free.
+ */
+OSKAR_EXPORT
+void oskar_sky_index_free(oskar_SkyIndex* index);
+
+/**
+ * @brief
+ * Returns the number of sources in the index.
+ *
+ * @param[in] index        The sky index.
+ */
+OSKAR_EXPORT
+int oskar_sky_index_num_sources(const oskar_SkyIndex* index);
+
+/**
+ * @brief
+ * Returns a cap on the sky that contains all sources in the index.
+ *
+ * @details
+ * If the index is empty, or the sources cover most of the sky,
+ * the radius of the cap is pi.
+ *
+ * @param[in] index        The sky index.
+ * @param[out] ra_rad      Right Ascension of the cap centre, in radians.
+ * @param[out] dec_rad     Declination of the cap centre, in radians.
+ * @param[out] radius_rad  Angular radius of the cap, in radians.
+ */
+OSKAR_EXPORT
+void oskar_sky_index_bounding_cap(const oskar_SkyIndex* index,
+        double* ra_rad, double* dec_rad, double* radius_rad);
+
+/**
+ * @brief
+ * Marks sources that are above the horizon of any station.
+ *
+ * @details
+ * Sets elements of the mask to 1 for each source that is above the
+ * horizon of at least one station. Other elements are left unchanged.
+ *
+ * The result is identical to calling oskar_update_horizon_mask() for
+ * every station in the telescope model, but tree nodes that are wholly
+ * above or below the horizon are accepted or rejected without testing
+ * their sources.
+ *
+ * @param[in] index        The sky index.
+ * @param[in] telescope    The telescope model.
+ * @param[in] gast_rad     The Greenwich Apparent Sidereal Time, in radians.
+ * @param[in,out] mask     Horizon mask, in CPU memory, in source order.
+ * @param[in,out] status   Status return code.
+ */
+OSKAR_EXPORT
+void oskar_sky_index_horizon_mask(const oskar_SkyIndex* index,
+        const oskar_Telescope* telescope, double gast_rad, int* mask,
+        int* status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OSKAR_SKY_INDEX_H_ */
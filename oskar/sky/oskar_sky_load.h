@@ -84,6 +84,12 @@ extern "C" {
  * - Lines containing 10 or 13 or more columns set the status flag to
  *   indicate an error, and abort the load.
  *
+ * The file is memory-mapped where possible, and large files are parsed
+ * in parallel in line-aligned sections. Sources are returned in file order.
+ *
+ * Files written by oskar_sky_write_columnar() are also recognised, and are
+ * opened using oskar_sky_read_columnar().
+ *
  * @param[in]  filename  Path to a source list text file.
  * @param[in]  type      Required data type (OSKAR_SINGLE or OSKAR_DOUBLE).
  * @param[in,out] status Status return code.
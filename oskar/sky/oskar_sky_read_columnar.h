@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2018, The University of Oxford
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the University of Oxford nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef OSKAR_SKY_READ_COLUMNAR_H_
+#define OSKAR_SKY_READ_COLUMNAR_H_
+
+/**
+ * @file oskar_sky_read_columnar.h
+ */
+
+#include <oskar_global.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Opens a sky model stored in a columnar binary file.
+ *
+ * @details
+ * Opens a sky model file written by oskar_sky_write_columnar().
+ *
+ * The file is memory-mapped, and if the data in the file already have the
+ * requested precision, the source parameter arrays of the returned sky
+ * model point directly into the mapping, so no data are read until they
+ * are used. The mapping is private, so changes made to the sky model are
+ * never written back to the file. The mapping is released when the
+ * sky model is resized or freed.
+ *
+ * If the precision differs, the data are converted to a new copy.
+ *
+ * @param[in] filename    Input filename.
+ * @param[in] type        Required precision (OSKAR_SINGLE or OSKAR_DOUBLE).
+ * @param[in,out] status  Status return code.
+ *
+ * @return A handle to the sky model structure, or NULL if an error occurred.
+ */
+OSKAR_EXPORT
+oskar_Sky* oskar_sky_read_columnar(const char* filename, int type,
+        int* status);
+
+/**
+ * @brief Reads the chunk directory of a columnar sky model file.
+ *
+ * @details
+ * Returns the range of sources in each chunk of a file written by
+ * oskar_sky_write_columnar(), and the centre and angular radius of the
+ * spherical cap that bounds the positions of those sources.
+ *
+ * The arrays are resized to the number of chunks, and must be in CPU
+ * memory. The first two must be of type OSKAR_INT, and the rest of type
+ * OSKAR_DOUBLE.
+ *
+ * @param[in] filename      Input filename.
+ * @param[out] offset       Index of the first source in each chunk.
+ * @param[out] num_sources  Number of sources in each chunk.
+ * @param[out] cap_ra_rad   Right ascension of each cap centre, in radians.
+ * @param[out] cap_dec_rad  Declination of each cap centre, in radians.
+ * @param[out] cap_radius_rad Angular radius of each cap, in radians.
+ * @param[in,out] status    Status return code.
+ */
+OSKAR_EXPORT
+void oskar_sky_read_columnar_chunks(const char* filename, oskar_Mem* offset,
+        oskar_Mem* num_sources, oskar_Mem* cap_ra_rad, oskar_Mem* cap_dec_rad,
+        oskar_Mem* cap_radius_rad, int* status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OSKAR_SKY_READ_COLUMNAR_H_ */
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2018, The University of Oxford
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the University of Oxford nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef OSKAR_SKY_SORT_BY_POSITION_H_
+#define OSKAR_SKY_SORT_BY_POSITION_H_
+
+/**
+ * @file oskar_sky_sort_by_position.h
+ */
+
+#include <oskar_global.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief
+ * Sorts sources in a sky model so that nearby sources are stored together.
+ *
+ * @details
+ * This function sorts sources along the space-filling curve given by
+ * their HEALPix pixel index in the NESTED scheme, at the finest resolution
+ * (nside = 8192). Sources in the same pixel keep their original order.
+ *
+ * If the sorted sky model is split into chunks, each chunk covers
+ * a compact region of sky.
+ *
+ * The sky model must be in CPU memory.
+ *
+ * @param[in,out] sky      Pointer to sky model.
+ * @param[in,out] status   Status return code.
+ */
+OSKAR_EXPORT
+void oskar_sky_sort_by_position(oskar_Sky* sky, int* status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OSKAR_SKY_SORT_BY_POSITION_H_ */
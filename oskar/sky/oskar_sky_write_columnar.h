@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2018, The University of Oxford
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the University of Oxford nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef OSKAR_SKY_WRITE_COLUMNAR_H_
+#define OSKAR_SKY_WRITE_COLUMNAR_H_
+
+/**
+ * @file oskar_sky_write_columnar.h
+ */
+
+#include <oskar_global.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Writes a sky model to a columnar binary file.
+ *
+ * @details
+ * Writes the source parameters of a sky model to a file that can be
+ * memory-mapped by oskar_sky_read_columnar(), so that it can be opened
+ * without parsing or copying any data.
+ *
+ * The sources are divided into chunks of at most \p max_chunk_size sources,
+ * in their current order, and the spherical cap that bounds each chunk is
+ * stored in a directory in the file. Sort the sky model using
+ * oskar_sky_sort_by_position() first to make these caps small.
+ *
+ * @param[in] filename        Output filename.
+ * @param[in] sky             Sky model to write.
+ * @param[in] max_chunk_size  Maximum number of sources in each chunk.
+ * @param[in,out] status      Status return code.
+ */
+OSKAR_EXPORT
+void oskar_sky_write_columnar(const char* filename, const oskar_Sky* sky,
+        int max_chunk_size, int* status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OSKAR_SKY_WRITE_COLUMNAR_H_ */
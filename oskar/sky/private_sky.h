@@ -34,6 +34,7 @@
  */
 
 #include <mem/oskar_mem.h>
+#include <utility/oskar_mapped_file.h>
 
 /**
  * @struct oskar_Sky
@@ -73,6 +74,8 @@ struct oskar_Sky
     oskar_Mem* gaussian_a;     /**< Gaussian source width parameter */
     oskar_Mem* gaussian_b;     /**< Gaussian source width parameter */
     oskar_Mem* gaussian_c;     /**< Gaussian source width parameter */
+
+    oskar_MappedFile* mapped_file; /**< File aliased by source columns, if any. */
 };
 
 #ifndef OSKAR_SKY_TYPEDEF_
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2018, The University of Oxford
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the University of Oxford nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef OSKAR_PRIVATE_SKY_COLUMNAR_H_
+#define OSKAR_PRIVATE_SKY_COLUMNAR_H_
+
+/**
+ * @file private_sky_columnar.h
+ *
+ * @brief Layout of the columnar sky model file format.
+ *
+ * @details
+ * All values are stored in the byte order of the machine that wrote the
+ * file, which is recorded by the byte order mark in the header.
+ *
+ * The file starts with a fixed-size header:
+ *
+ * Offset | Type       | Contents
+ * ------ | ---------- | -----------------------------------------------------
+ *      0 | char[8]    | Magic string "OSKARSKY"
+ *      8 | uint32     | Format version
+ *     12 | uint32     | Byte order mark (0x01020304)
+ *     16 | int32      | Precision (OSKAR_SINGLE or OSKAR_DOUBLE)
+ *     20 | int32      | Number of columns
+ *     24 | int64      | Number of sources
+ *     32 | int64      | Number of chunks
+ *     40 | int64      | Byte offset of chunk directory
+ *     48 | int64[12]  | Byte offset of each column
+ *    144 | int32      | Flag set if the model contains extended sources
+ *    152 | double     | Reference right ascension, in radians
+ *    160 | double     | Reference declination, in radians
+ *
+ * Each entry in the chunk directory describes a contiguous range of
+ * sources, and the spherical cap that bounds them:
+ *
+ * Offset | Type       | Contents
+ * ------ | ---------- | -----------------------------------------------------
+ *      0 | int64      | Index of first source in chunk
+ *      8 | int64      | Number of sources in chunk
+ *     16 | double     | Right ascension of cap centre, in radians
+ *     24 | double     | Declination of cap centre, in radians
+ *     32 | double     | Angular radius of cap, in radians
+ *
+ * Columns are stored in the order RA, Dec, I, Q, U, V, reference frequency,
+ * spectral index, rotation measure, FWHM major, FWHM minor and position
+ * angle, in the same units as the sky model structure. Each column starts
+ * on a multiple of OSKAR_SKY_COLUMNAR_ALIGNMENT bytes.
+ */
+
+#define OSKAR_SKY_COLUMNAR_MAGIC          "OSKARSKY"
+#define OSKAR_SKY_COLUMNAR_VERSION        1
+#define OSKAR_SKY_COLUMNAR_BYTE_ORDER     0x01020304u
+#define OSKAR_SKY_COLUMNAR_NUM_COLUMNS    12
+#define OSKAR_SKY_COLUMNAR_ALIGNMENT      64
+#define OSKAR_SKY_COLUMNAR_HEADER_SIZE    192
+#define OSKAR_SKY_COLUMNAR_CHUNK_SIZE     40
+
+/* Header field offsets. */
+#define OSKAR_SKY_COLUMNAR_OFF_VERSION       8
+#define OSKAR_SKY_COLUMNAR_OFF_BYTE_ORDER    12
+#define OSKAR_SKY_COLUMNAR_OFF_PRECISION     16
+#define OSKAR_SKY_COLUMNAR_OFF_NUM_COLUMNS   20
+#define OSKAR_SKY_COLUMNAR_OFF_NUM_SOURCES   24
+#define OSKAR_SKY_COLUMNAR_OFF_NUM_CHUNKS    32
+#define OSKAR_SKY_COLUMNAR_OFF_CHUNKS        40
+#define OSKAR_SKY_COLUMNAR_OFF_COLUMNS       48
+#define OSKAR_SKY_COLUMNAR_OFF_EXTENDED      144
+#define OSKAR_SKY_COLUMNAR_OFF_REF_RA        152
+#define OSKAR_SKY_COLUMNAR_OFF_REF_DEC       160
+
+#endif /* OSKAR_PRIVATE_SKY_COLUMNAR_H_ */
@@ -65,6 +65,7 @@ oskar_Sky* oskar_sky_create(int type, int location, int num_sources,
     model->use_extended = OSKAR_FALSE;
     model->reference_ra_rad = 0.0;
     model->reference_dec_rad = 0.0;
+    model->mapped_file = 0;
 
     /* Initialise the memory. */
     model->ra_rad = oskar_mem_create(type, location, capacity, status);
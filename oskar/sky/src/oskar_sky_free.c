@@ -58,6 +58,7 @@ void oskar_sky_free(oskar_Sky* model, int* status)
     oskar_mem_free(model->gaussian_a, status);
     oskar_mem_free(model->gaussian_b, status);
     oskar_mem_free(model->gaussian_c, status);
+    oskar_mapped_file_free(model->mapped_file);
 
     /* Free the structure itself. */
     free(model);
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011-2017, The University of Oxford
+ * Copyright (c) 2011-2018, The University of Oxford
  * All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
@@ -40,6 +40,13 @@ static double ha0(double longitude, double ra0, double gast);
 void oskar_sky_horizon_clip(oskar_Sky* out, const oskar_Sky* in,
         const oskar_Telescope* telescope, double gast,
         oskar_StationWork* work, int* status)
+{
+    oskar_sky_horizon_clip_index(out, in, 0, telescope, gast, work, status);
+}
+
+void oskar_sky_horizon_clip_index(oskar_Sky* out, const oskar_Sky* in,
+        const oskar_SkyIndex* index, const oskar_Telescope* telescope,
+        double gast, oskar_StationWork* work, int* status)
 {
     int i, num_stations, location, num_in;
     oskar_Mem *horizon_mask, *source_indices;
@@ -85,15 +92,39 @@ void oskar_sky_horizon_clip(oskar_Sky* out, const oskar_Sky* in,
         oskar_mem_realloc(source_indices, num_in, status);
 
     /* Create the horizon mask. */
-    oskar_mem_clear_contents(horizon_mask, status);
-    num_stations = oskar_telescope_num_stations(telescope);
-    for (i = 0; i < num_stations; ++i)
+    if (index)
+    {
+        oskar_Mem* mask_cpu = horizon_mask;
+        if (oskar_sky_index_num_sources(index) != num_in)
+        {
+            *status = OSKAR_ERR_DIMENSION_MISMATCH;
+            return;
+        }
+        if (location != OSKAR_CPU)
+            mask_cpu = oskar_mem_create(OSKAR_INT, OSKAR_CPU, num_in, status);
+        oskar_mem_clear_contents(mask_cpu, status);
+        oskar_sky_index_horizon_mask(index, telescope, gast,
+                oskar_mem_int(mask_cpu, status), status);
+        if (mask_cpu != horizon_mask)
+        {
+            oskar_mem_copy_contents(horizon_mask, mask_cpu, 0, 0, num_in,
+                    status);
+            oskar_mem_free(mask_cpu, status);
+        }
+    }
+    else
     {
-        const oskar_Station* s = oskar_telescope_station_const(telescope, i);
-        oskar_update_horizon_mask(num_in, oskar_sky_l_const(in),
-                oskar_sky_m_const(in), oskar_sky_n_const(in),
-                ha0(oskar_station_lon_rad(s), ra0, gast), dec0,
-                oskar_station_lat_rad(s), horizon_mask, status);
+        oskar_mem_clear_contents(horizon_mask, status);
+        num_stations = oskar_telescope_num_stations(telescope);
+        for (i = 0; i < num_stations; ++i)
+        {
+            const oskar_Station* s =
+                    oskar_telescope_station_const(telescope, i);
+            oskar_update_horizon_mask(num_in, oskar_sky_l_const(in),
+                    oskar_sky_m_const(in), oskar_sky_n_const(in),
+                    ha0(oskar_station_lon_rad(s), ra0, gast), dec0,
+                    oskar_station_lat_rad(s), horizon_mask, status);
+        }
     }
 
     /* Apply exclusive prefix sum to mask to get source output indices. */
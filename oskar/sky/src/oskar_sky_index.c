@@ -0,0 +1,515 @@
+/*
+ * Copyright (c) 2018, The University of Oxford
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the University of Oxford nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sky/oskar_sky.h"
+#include "sky/oskar_sky_index.h"
+#include "math/oskar_cmath.h"
+
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Maximum number of sources in a leaf node. */
+#define LEAF_SIZE 32
+
+/* Angular margin used when classifying whole nodes, in radians.
+ * This is much larger than the rounding error in the source coordinates,
+ * so nodes are only accepted or rejected if every source in them would
+ * give the same result when tested individually. */
+#define MARGIN 1e-4
+
+typedef struct
+{
+    double x, y, z;        /* Unit vector to centre of bounding cone. */
+    double radius;         /* Angular radius of bounding cone. */
+    int begin, end;        /* Range of sources, in tree order. */
+    int child;             /* Index of first child node, or -1 if a leaf. */
+} SkyIndexNode;
+
+struct oskar_SkyIndex
+{
+    int precision, num_sources, num_nodes, capacity, depth;
+    double ra0, dec0;      /* Reference position for l, m, n. */
+    int* order;            /* Original index of each source in tree order. */
+    double *x, *y, *z;     /* Equatorial unit vectors, in tree order. */
+    oskar_Mem *ra, *dec;   /* Source coordinates, in tree order. */
+    oskar_Mem *l, *m, *n;  /* Direction cosines, in tree order. */
+    SkyIndexNode* nodes;
+};
+
+typedef struct
+{
+    double x, y, z;        /* Unit vector to station zenith. */
+    double ll, mm, nn;     /* Zenith direction relative to reference. */
+} Horizon;
+
+static double angle(double x1, double y1, double z1,
+        double x2, double y2, double z2)
+{
+    double d = x1 * x2 + y1 * y2 + z1 * z2;
+    if (d > 1.0) d = 1.0;
+    if (d < -1.0) d = -1.0;
+    return acos(d);
+}
+
+/* Partially sorts the range so that element nth is in its sorted place. */
+static void select_nth(int* order, const double* key, int begin, int end,
+        int nth)
+{
+    while (end - begin > 1)
+    {
+        int i = begin, j = end - 1, t;
+        const double pivot = key[order[begin + (end - begin) / 2]];
+        while (i <= j)
+        {
+            while (key[order[i]] < pivot) ++i;
+            while (key[order[j]] > pivot) --j;
+            if (i <= j)
+            {
+                t = order[i]; order[i] = order[j]; order[j] = t;
+                ++i; --j;
+            }
+        }
+        if (nth <= j) end = j + 1;
+        else if (nth >= i) begin = i;
+        else return;
+    }
+}
+
+static int add_nodes(oskar_SkyIndex* h, int num, int* status)
+{
+    const int first = h->num_nodes;
+    if (h->num_nodes + num > h->capacity)
+    {
+        SkyIndexNode* t;
+        h->capacity = 2 * h->capacity + num;
+        t = (SkyIndexNode*) realloc(h->nodes,
+                h->capacity * sizeof(SkyIndexNode));
+        if (!t)
+        {
+            *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+            return -1;
+        }
+        h->nodes = t;
+    }
+    h->num_nodes += num;
+    return first;
+}
+
+static void build(oskar_SkyIndex* h, int node, int begin, int end,
+        int depth, int* status)
+{
+    int i, child;
+    double sx = 0.0, sy = 0.0, sz = 0.0, norm, min_dot = 1.0;
+    SkyIndexNode* p;
+    if (*status) return;
+    if (depth > h->depth) h->depth = depth;
+
+    /* Find the bounding cone of the sources in the node. */
+    for (i = begin; i < end; ++i)
+    {
+        const int j = h->order[i];
+        sx += h->x[j]; sy += h->y[j]; sz += h->z[j];
+    }
+    norm = sqrt(sx * sx + sy * sy + sz * sz);
+    p = &h->nodes[node];
+    p->begin = begin;
+    p->end = end;
+    p->child = -1;
+    if (norm < 1e-9 * (end - begin))
+    {
+        p->x = 0.0; p->y = 0.0; p->z = 1.0;
+        p->radius = M_PI;
+    }
+    else
+    {
+        p->x = sx / norm; p->y = sy / norm; p->z = sz / norm;
+        for (i = begin; i < end; ++i)
+        {
+            const int j = h->order[i];
+            const double d = p->x * h->x[j] + p->y * h->y[j] + p->z * h->z[j];
+            if (d < min_dot) min_dot = d;
+        }
+        p->radius = acos(min_dot < -1.0 ? -1.0 : min_dot);
+    }
+    if (end - begin <= LEAF_SIZE) return;
+
+    /* Split the sources at the median along the axis of largest extent. */
+    {
+        double lo[3] = {2.0, 2.0, 2.0}, hi[3] = {-2.0, -2.0, -2.0};
+        const double* key[3];
+        int axis = 0;
+        key[0] = h->x; key[1] = h->y; key[2] = h->z;
+        for (i = begin; i < end; ++i)
+        {
+            int k;
+            const int j = h->order[i];
+            for (k = 0; k < 3; ++k)
+            {
+                if (key[k][j] < lo[k]) lo[k] = key[k][j];
+                if (key[k][j] > hi[k]) hi[k] = key[k][j];
+            }
+        }
+        if (hi[1] - lo[1] > hi[axis] - lo[axis]) axis = 1;
+        if (hi[2] - lo[2] > hi[axis] - lo[axis]) axis = 2;
+        select_nth(h->order, key[axis], begin, end, begin + (end - begin) / 2);
+    }
+    child = add_nodes(h, 2, status);
+    if (*status) return;
+    h->nodes[node].child = child;
+    build(h, child, begin, begin + (end - begin) / 2, depth + 1, status);
+    build(h, child + 1, begin + (end - begin) / 2, end, depth + 1, status);
+}
+
+static void reorder(const oskar_Mem* src, oskar_Mem* dst, const int* order,
+        int num, int* status)
+{
+    int i;
+    if (*status) return;
+    if (oskar_mem_type(src) == OSKAR_DOUBLE)
+    {
+        const double* s = oskar_mem_double_const(src, status);
+        double* d = oskar_mem_double(dst, status);
+        for (i = 0; i < num; ++i) d[i] = s[order[i]];
+    }
+    else
+    {
+        const float* s = oskar_mem_float_const(src, status);
+        float* d = oskar_mem_float(dst, status);
+        for (i = 0; i < num; ++i) d[i] = s[order[i]];
+    }
+}
+
+oskar_SkyIndex* oskar_sky_index_create(const oskar_Sky* sky, int* status)
+{
+    int i, num;
+    double *t;
+    oskar_SkyIndex* h = 0;
+    if (*status) return 0;
+    if (oskar_sky_mem_location(sky) != OSKAR_CPU)
+    {
+        *status = OSKAR_ERR_BAD_LOCATION;
+        return 0;
+    }
+
+    /* Create the index and copy the source coordinates. */
+    h = (oskar_SkyIndex*) calloc(1, sizeof(oskar_SkyIndex));
+    num = oskar_sky_num_sources(sky);
+    h->precision = oskar_sky_precision(sky);
+    h->num_sources = num;
+    h->ra0 = oskar_sky_reference_ra_rad(sky);
+    h->dec0 = oskar_sky_reference_dec_rad(sky);
+    h->order = (int*) calloc(num > 0 ? num : 1, sizeof(int));
+    h->x = (double*) calloc(num > 0 ? num : 1, sizeof(double));
+    h->y = (double*) calloc(num > 0 ? num : 1, sizeof(double));
+    h->z = (double*) calloc(num > 0 ? num : 1, sizeof(double));
+    h->ra = oskar_mem_create(h->precision, OSKAR_CPU, num, status);
+    h->dec = oskar_mem_create(h->precision, OSKAR_CPU, num, status);
+    h->l = oskar_mem_create(h->precision, OSKAR_CPU, num, status);
+    h->m = oskar_mem_create(h->precision, OSKAR_CPU, num, status);
+    h->n = oskar_mem_create(h->precision, OSKAR_CPU, num, status);
+    if (!h->order || !h->x || !h->y || !h->z)
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+    if (*status) return h;
+    for (i = 0; i < num; ++i)
+    {
+        double ra, dec;
+        if (h->precision == OSKAR_DOUBLE)
+        {
+            ra = oskar_mem_double_const(oskar_sky_ra_rad_const(sky),
+                    status)[i];
+            dec = oskar_mem_double_const(oskar_sky_dec_rad_const(sky),
+                    status)[i];
+        }
+        else
+        {
+            ra = oskar_mem_float_const(oskar_sky_ra_rad_const(sky),
+                    status)[i];
+            dec = oskar_mem_float_const(oskar_sky_dec_rad_const(sky),
+                    status)[i];
+        }
+        h->x[i] = cos(dec) * cos(ra);
+        h->y[i] = cos(dec) * sin(ra);
+        h->z[i] = sin(dec);
+        h->order[i] = i;
+    }
+
+    /* Build the tree. */
+    add_nodes(h, 1, status);
+    build(h, 0, 0, num, 0, status);
+
+    /* Store the source data in tree order. */
+    reorder(oskar_sky_ra_rad_const(sky), h->ra, h->order, num, status);
+    reorder(oskar_sky_dec_rad_const(sky), h->dec, h->order, num, status);
+    reorder(oskar_sky_l_const(sky), h->l, h->order, num, status);
+    reorder(oskar_sky_m_const(sky), h->m, h->order, num, status);
+    reorder(oskar_sky_n_const(sky), h->n, h->order, num, status);
+    t = (double*) malloc((num > 0 ? num : 1) * sizeof(double));
+    if (!t)
+    {
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+        return h;
+    }
+    for (i = 0; i < num; ++i) t[i] = h->x[h->order[i]];
+    for (i = 0; i < num; ++i) h->x[i] = t[i];
+    for (i = 0; i < num; ++i) t[i] = h->y[h->order[i]];
+    for (i = 0; i < num; ++i) h->y[i] = t[i];
+    for (i = 0; i < num; ++i) t[i] = h->z[h->order[i]];
+    for (i = 0; i < num; ++i) h->z[i] = t[i];
+    free(t);
+    return h;
+}
+
+void oskar_sky_index_free(oskar_SkyIndex* index)
+{
+    int status = 0;
+    if (!index) return;
+    oskar_mem_free(index->ra, &status);
+    oskar_mem_free(index->dec, &status);
+    oskar_mem_free(index->l, &status);
+    oskar_mem_free(index->m, &status);
+    oskar_mem_free(index->n, &status);
+    free(index->order);
+    free(index->x);
+    free(index->y);
+    free(index->z);
+    free(index->nodes);
+    free(index);
+}
+
+int oskar_sky_index_num_sources(const oskar_SkyIndex* index)
+{
+    return index->num_sources;
+}
+
+void oskar_sky_index_bounding_cap(const oskar_SkyIndex* index,
+        double* ra_rad, double* dec_rad, double* radius_rad)
+{
+    const SkyIndexNode* p = &index->nodes[0];
+    *ra_rad = atan2(p->y, p->x);
+    *dec_rad = asin(p->z > 1.0 ? 1.0 : p->z);
+    *radius_rad = index->num_sources > 0 ? p->radius : M_PI;
+}
+
+static void set_range(const oskar_SkyIndex* h, const SkyIndexNode* p,
+        int value, int* mask)
+{
+    int i;
+    for (i = p->begin; i < p->end; ++i) mask[h->order[i]] = value;
+}
+
+/* Returns true if the source is above the horizon,
+ * using the same arithmetic as oskar_update_horizon_mask(). */
+static int above_horizon(const oskar_SkyIndex* h, int i, const Horizon* z)
+{
+    if (h->precision == OSKAR_DOUBLE)
+    {
+        const double *l_, *m_, *n_;
+        l_ = (const double*) oskar_mem_void_const(h->l);
+        m_ = (const double*) oskar_mem_void_const(h->m);
+        n_ = (const double*) oskar_mem_void_const(h->n);
+        return ((l_[i] * z->ll + m_[i] * z->mm + n_[i] * z->nn) > 0.);
+    }
+    else
+    {
+        const float *l_, *m_, *n_;
+        const float ll_ = (float) z->ll, mm_ = (float) z->mm;
+        const float nn_ = (float) z->nn;
+        l_ = (const float*) oskar_mem_void_const(h->l);
+        m_ = (const float*) oskar_mem_void_const(h->m);
+        n_ = (const float*) oskar_mem_void_const(h->n);
+        return ((l_[i] * ll_ + m_[i] * mm_ + n_[i] * nn_) > 0.f);
+    }
+}
+
+static void visit_horizon(const oskar_SkyIndex* h, const SkyIndexNode* p,
+        const Horizon* horizons, const Horizon* mean, double spread,
+        double src_limit, const int* active, int num_active, int* work,
+        int* mask)
+{
+    int a, i, num_next = 0;
+    const double r = p->radius;
+    double t;
+
+    /* Check against the cone containing all station zeniths. */
+    t = angle(p->x, p->y, p->z, mean->x, mean->y, mean->z);
+    if (t + r + spread < M_PI / 2 - MARGIN)
+    {
+        set_range(h, p, 1, mask);
+        return;
+    }
+    if (t - r - spread > M_PI / 2 + MARGIN) return;
+
+    /* Check against each station horizon that is still undecided. */
+    for (a = 0; a < num_active; ++a)
+    {
+        const Horizon* z = &horizons[active[a]];
+        t = angle(p->x, p->y, p->z, z->x, z->y, z->z);
+        if (t + r < M_PI / 2 - MARGIN)
+        {
+            set_range(h, p, 1, mask);
+            return;
+        }
+        if (t - r <= M_PI / 2 + MARGIN)
+            work[num_next++] = active[a];
+    }
+    if (num_next == 0) return;
+
+    /* Descend the tree, or test each source in a leaf. */
+    if (p->child >= 0)
+    {
+        visit_horizon(h, &h->nodes[p->child], horizons, mean, spread,
+                src_limit, work, num_next, work + num_next, mask);
+        visit_horizon(h, &h->nodes[p->child + 1], horizons, mean, spread,
+                src_limit, work, num_next, work + num_next, mask);
+        return;
+    }
+    for (i = p->begin; i < p->end; ++i)
+    {
+        const double d = h->x[i] * mean->x + h->y[i] * mean->y +
+                h->z[i] * mean->z;
+        if (mask[h->order[i]] || d < -src_limit) continue;
+        if (d > src_limit)
+        {
+            mask[h->order[i]] = 1;
+            continue;
+        }
+        for (a = 0; a < num_next; ++a)
+        {
+            if (above_horizon(h, i, &horizons[work[a]]))
+            {
+                mask[h->order[i]] = 1;
+                break;
+            }
+        }
+    }
+}
+
+void oskar_sky_index_horizon_mask(const oskar_SkyIndex* index,
+        const oskar_Telescope* telescope, double gast_rad, int* mask,
+        int* status)
+{
+    int i, j, num_stations, num_horizons = 0, *active = 0;
+    double sx = 0.0, sy = 0.0, sz = 0.0, norm, spread = 0.0, src_limit = 2.0;
+    Horizon *horizons = 0, mean;
+    if (*status || index->num_sources == 0) return;
+
+    /* Find the distinct station horizons. */
+    num_stations = oskar_telescope_num_stations(telescope);
+    horizons = (Horizon*) calloc(num_stations > 0 ? num_stations : 1,
+            sizeof(Horizon));
+    active = (int*) calloc((num_stations > 0 ? num_stations : 1) *
+            (index->depth + 2), sizeof(int));
+    if (!horizons || !active)
+    {
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+        free(horizons);
+        free(active);
+        return;
+    }
+    for (i = 0; i < num_stations; ++i)
+    {
+        const oskar_Station* s = oskar_telescope_station_const(telescope, i);
+        const double lon = oskar_station_lon_rad(s);
+        const double lat = oskar_station_lat_rad(s);
+        const double lst = gast_rad + lon;
+        const double ha0_rad = (gast_rad + lon) - index->ra0;
+        double cos_ha0, sin_dec0, cos_dec0, sin_lat, cos_lat;
+        Horizon* z = &horizons[num_horizons];
+        z->x = cos(lat) * cos(lst);
+        z->y = cos(lat) * sin(lst);
+        z->z = sin(lat);
+        for (j = 0; j < num_horizons; ++j)
+            if (horizons[j].x == z->x && horizons[j].y == z->y &&
+                    horizons[j].z == z->z) break;
+        if (j < num_horizons) continue;
+
+        /* Same as oskar_update_horizon_mask(). */
+        cos_ha0  = cos(ha0_rad);
+        sin_dec0 = sin(index->dec0);
+        cos_dec0 = cos(index->dec0);
+        sin_lat  = sin(lat);
+        cos_lat  = cos(lat);
+        z->ll = cos_lat * sin(ha0_rad);
+        z->mm = sin_lat * cos_dec0 - cos_lat * cos_ha0 * sin_dec0;
+        z->nn = sin_lat * sin_dec0 + cos_lat * cos_ha0 * cos_dec0;
+        sx += z->x; sy += z->y; sz += z->z;
+        num_horizons++;
+    }
+    if (num_horizons == 0)
+    {
+        free(horizons);
+        free(active);
+        return;
+    }
+
+    /* Find the cone containing all station zeniths. */
+    norm = sqrt(sx * sx + sy * sy + sz * sz);
+    if (norm < 1e-9 * num_horizons)
+    {
+        mean.x = 0.0; mean.y = 0.0; mean.z = 1.0;
+        spread = M_PI;
+    }
+    else
+    {
+        mean.x = sx / norm; mean.y = sy / norm; mean.z = sz / norm;
+        for (i = 0; i < num_horizons; ++i)
+        {
+            const double t = angle(mean.x, mean.y, mean.z,
+                    horizons[i].x, horizons[i].y, horizons[i].z);
+            if (t > spread) spread = t;
+        }
+    }
+    if (spread + MARGIN < M_PI / 2)
+        src_limit = sin(spread + MARGIN);
+
+    /* Test the most representative horizons first. */
+    for (i = 1; i < num_horizons; ++i)
+    {
+        Horizon t = horizons[i];
+        const double d = t.x * mean.x + t.y * mean.y + t.z * mean.z;
+        for (j = i; j > 0; --j)
+        {
+            const Horizon* p = &horizons[j - 1];
+            if (p->x * mean.x + p->y * mean.y + p->z * mean.z >= d) break;
+            horizons[j] = *p;
+        }
+        horizons[j] = t;
+    }
+    for (i = 0; i < num_horizons; ++i) active[i] = i;
+    visit_horizon(index, &index->nodes[0], horizons, &mean, spread,
+            src_limit, active, num_horizons, active + num_horizons, mask);
+    free(horizons);
+    free(active);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011-2015, The University of Oxford
+ * Copyright (c) 2011-2018, The University of Oxford
  * All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
@@ -27,11 +27,17 @@
  */
 
 #include "sky/oskar_sky.h"
-#include "utility/oskar_getline.h"
-#include "utility/oskar_string_to_array.h"
+#include "sky/private_sky_columnar.h"
+#include "utility/oskar_mapped_file.h"
 
+#include <float.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -40,97 +46,314 @@ extern "C" {
 static const double deg2rad = 1.74532925199432957692369e-2;
 static const double arcsec2rad = 4.84813681109535993589914e-6;
 
-oskar_Sky* oskar_sky_load(const char* filename, int type, int* status)
+/* RA, Dec, I, Q, U, V, freq0, spix, RM, FWHM maj, FWHM min, PA */
+#define NUM_PARAMS 12
+
+/* Minimum number of bytes of file to give to each thread. */
+#define MIN_BYTES_PER_THREAD 1048576
+
+typedef struct
 {
-    int n = 0;
-    FILE* file;
-    char* line = 0;
-    size_t bufsize = 0;
-    oskar_Sky* sky;
+    int type, num, capacity, error;
+    void* col[NUM_PARAMS];
+} SourceList;
 
-    /* Check if safe to proceed. */
-    if (*status) return 0;
+static int is_delimiter(char c)
+{
+    return (c == ',' || c == ' ' || c == '\t');
+}
 
-    /* Get the data type. */
-    if (type != OSKAR_SINGLE && type != OSKAR_DOUBLE)
+/*
+ * Converts a token to a double, returning 1 if successful or 0 if not.
+ *
+ * Plain decimal numbers with up to 19 significant digits and a small
+ * exponent are converted directly (Clinger's fast path), which is exact
+ * because both the mantissa and the power of ten are exactly representable.
+ * Anything else is passed to sscanf(), so the result is always the same
+ * as oskar_string_to_array_d().
+ */
+static int parse_number(const char* s, size_t len, double* value)
+{
+    static const double pow10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+            1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18,
+            1e19, 1e20, 1e21, 1e22};
+    char buffer[128], *t;
+    int ok;
+#if FLT_EVAL_METHOD == 0
     {
-        *status = OSKAR_ERR_BAD_DATA_TYPE;
-        return 0;
+        unsigned long long m = 0;
+        int neg = 0, num_digits = 0, num_sig = 0, exp10 = 0;
+        size_t i = 0;
+        if (i < len && (s[i] == '+' || s[i] == '-')) neg = (s[i++] == '-');
+        for (; i < len && s[i] >= '0' && s[i] <= '9'; ++i, ++num_digits)
+        {
+            if (m == 0 && s[i] == '0') continue;
+            m = 10 * m + (s[i] - '0');
+            num_sig++;
+        }
+        if (i < len && s[i] == '.')
+        {
+            for (++i; i < len && s[i] >= '0' && s[i] <= '9'; ++i, ++num_digits)
+            {
+                exp10--;
+                if (m == 0 && s[i] == '0') continue;
+                m = 10 * m + (s[i] - '0');
+                num_sig++;
+            }
+        }
+        if (num_digits > 0 && i < len && (s[i] == 'e' || s[i] == 'E'))
+        {
+            int e = 0, e_neg = 0, e_digits = 0;
+            ++i;
+            if (i < len && (s[i] == '+' || s[i] == '-'))
+                e_neg = (s[i++] == '-');
+            for (; i < len && s[i] >= '0' && s[i] <= '9' && e < 10000; ++i)
+            {
+                e = 10 * e + (s[i] - '0');
+                e_digits++;
+            }
+            if (e_digits == 0) i = len + 1; /* Not a plain number. */
+            exp10 += e_neg ? -e : e;
+        }
+        if (i == len && num_digits > 0 && num_sig <= 19 &&
+                m <= (1ULL << 53) && exp10 >= -22 && exp10 <= 22)
+        {
+            double v = (double) m;
+            v = (exp10 < 0) ? v / pow10[-exp10] : v * pow10[exp10];
+            *value = neg ? -v : v;
+            return 1;
+        }
     }
+#endif
+    t = (len < sizeof(buffer)) ? buffer : (char*) malloc(len + 1);
+    if (!t) return 0;
+    memcpy(t, s, len);
+    t[len] = '\0';
+    ok = (sscanf(t, "%lf", value) > 0);
+    if (t != buffer) free(t);
+    return ok;
+}
 
-    /* Open the file. */
-    file = fopen(filename, "r");
-    if (!file)
+/* Reads up to NUM_PARAMS numbers from a line, as oskar_string_to_array_d(). */
+static int parse_line(const char* p, const char* end, double* par)
+{
+    int n = 0;
+    while (n < NUM_PARAMS)
     {
-        *status = OSKAR_ERR_FILE_IO;
-        return 0;
+        const char* start;
+        while (p < end && is_delimiter(*p)) ++p;
+        if (p == end || *p == '\0' || *p == '#') break;
+        start = p;
+        while (p < end && *p != '\0' && !is_delimiter(*p)) ++p;
+        if (parse_number(start, p - start, &par[n])) n++;
+        if (p < end && *p == '\0') break;
     }
+    return n;
+}
 
-    /* Initialise the sky model. */
-    sky = oskar_sky_create(type, OSKAR_CPU, 0, status);
+static void append_source(SourceList* list, const double* par)
+{
+    int i;
+    if (list->num == list->capacity)
+    {
+        const int capacity = 2 * list->capacity + 1024;
+        const size_t size = (list->type == OSKAR_DOUBLE) ?
+                sizeof(double) : sizeof(float);
+        for (i = 0; i < NUM_PARAMS; ++i)
+        {
+            void* t = realloc(list->col[i], capacity * size);
+            if (!t)
+            {
+                list->error = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+                return;
+            }
+            list->col[i] = t;
+        }
+        list->capacity = capacity;
+    }
+    if (list->type == OSKAR_DOUBLE)
+        for (i = 0; i < NUM_PARAMS; ++i)
+            ((double*) list->col[i])[list->num] = par[i];
+    else
+        for (i = 0; i < NUM_PARAMS; ++i)
+            ((float*) list->col[i])[list->num] = (float) par[i];
+    list->num++;
+}
 
-    /* Loop over lines in file. */
-    while (oskar_getline(&line, &bufsize, file) != OSKAR_ERR_EOF)
+static void parse_range(const char* p, const char* end, SourceList* list)
+{
+    while (p < end && !list->error)
     {
         /* Set defaults. */
-        /* RA, Dec, I, Q, U, V, freq0, spix, RM, FWHM maj, FWHM min, PA */
         double par[] = {0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0.};
-        size_t num_param = sizeof(par) / sizeof(double);
-        size_t num_required = 3, num_read = 0;
+        double out[NUM_PARAMS];
+        const char* line_end = (const char*) memchr(p, '\n', end - p);
+        int num_read;
+        if (!line_end) line_end = end;
 
         /* Load source parameters (require at least RA, Dec, Stokes I). */
-        num_read = oskar_string_to_array_d(line, num_param, par);
-        if (num_read < num_required)
+        num_read = parse_line(p, line_end, par);
+        p = line_end + 1;
+        if (num_read < 3)
             continue;
 
-        /* Ensure enough space in arrays. */
-        if (oskar_sky_num_sources(sky) <= n)
-        {
-            oskar_sky_resize(sky, n + 100, status);
-            if (*status)
-                break;
-        }
-
+        /* Convert units, as in oskar_sky_set_source() calls. */
+        out[0] = par[0] * deg2rad;
+        out[1] = par[1] * deg2rad;
+        out[2] = par[2];
+        out[3] = par[3];
+        out[4] = par[4];
+        out[5] = par[5];
+        out[6] = par[6];
+        out[7] = par[7];
         if (num_read <= 9)
         {
             /* RA, Dec, I, Q, U, V, freq0, spix, RM */
-            oskar_sky_set_source(sky, n, par[0] * deg2rad,
-                    par[1] * deg2rad, par[2], par[3], par[4], par[5],
-                    par[6], par[7], par[8], 0.0, 0.0, 0.0, status);
+            out[8] = par[8];
+            out[9] = out[10] = out[11] = 0.0;
         }
         else if (num_read == 11)
         {
             /* Old format, with no rotation measure. */
             /* RA, Dec, I, Q, U, V, freq0, spix, FWHM maj, FWHM min, PA */
-            oskar_sky_set_source(sky, n, par[0] * deg2rad,
-                    par[1] * deg2rad, par[2], par[3], par[4], par[5],
-                    par[6], par[7], 0.0, par[8] * arcsec2rad,
-                    par[9] * arcsec2rad, par[10] * deg2rad, status);
+            out[8] = 0.0;
+            out[9] = par[8] * arcsec2rad;
+            out[10] = par[9] * arcsec2rad;
+            out[11] = par[10] * deg2rad;
         }
         else if (num_read == 12)
         {
             /* New format. */
             /* RA, Dec, I, Q, U, V, freq0, spix, RM, FWHM maj, FWHM min, PA */
-            oskar_sky_set_source(sky, n, par[0] * deg2rad,
-                    par[1] * deg2rad, par[2], par[3], par[4], par[5],
-                    par[6], par[7], par[8], par[9] * arcsec2rad,
-                    par[10] * arcsec2rad, par[11] * deg2rad, status);
+            out[8] = par[8];
+            out[9] = par[9] * arcsec2rad;
+            out[10] = par[10] * arcsec2rad;
+            out[11] = par[11] * deg2rad;
         }
         else
         {
             /* Error. */
-            *status = OSKAR_ERR_BAD_SKY_FILE;
+            list->error = OSKAR_ERR_BAD_SKY_FILE;
             break;
         }
-        ++n;
+        append_source(list, out);
     }
+}
+
+/* Returns the start of the first line that begins at or after offset. */
+static size_t line_start(const char* data, size_t size, size_t offset)
+{
+    if (offset == 0 || offset >= size) return offset < size ? offset : size;
+    if (data[offset - 1] == '\n') return offset;
+    while (offset < size && data[offset] != '\n') ++offset;
+    return offset < size ? offset + 1 : size;
+}
+
+oskar_Sky* oskar_sky_load(const char* filename, int type, int* status)
+{
+    int i, j, num_threads = 1, num_sources = 0;
+    size_t size;
+    const char* data;
+    oskar_MappedFile* file;
+    SourceList* lists;
+    oskar_Sky* sky = 0;
+    oskar_Mem* cols[NUM_PARAMS];
+
+    /* Check if safe to proceed. */
+    if (*status) return 0;
 
-    /* Set the size to be the actual number of elements loaded. */
-    oskar_sky_resize(sky, n, status);
+    /* Get the data type. */
+    if (type != OSKAR_SINGLE && type != OSKAR_DOUBLE)
+    {
+        *status = OSKAR_ERR_BAD_DATA_TYPE;
+        return 0;
+    }
+
+    /* Map the file. */
+    file = oskar_mapped_file_create(filename, status);
+    if (*status) return 0;
+    data = oskar_mapped_file_data(file);
+    size = oskar_mapped_file_size(file);
+
+    /* Open columnar binary files directly. */
+    if (size >= 8 && !memcmp(data, OSKAR_SKY_COLUMNAR_MAGIC, 8))
+    {
+        oskar_mapped_file_free(file);
+        return oskar_sky_read_columnar(filename, type, status);
+    }
+
+    /* Split the file into line-aligned ranges, one per thread. */
+#ifdef _OPENMP
+    num_threads = omp_get_max_threads();
+#endif
+    if ((size_t) num_threads > size / MIN_BYTES_PER_THREAD)
+        num_threads = (int) (size / MIN_BYTES_PER_THREAD);
+    if (num_threads < 1) num_threads = 1;
+    lists = (SourceList*) calloc(num_threads, sizeof(SourceList));
+    if (!lists)
+    {
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+        oskar_mapped_file_free(file);
+        return 0;
+    }
+
+    /* Parse each range. */
+#pragma omp parallel for num_threads(num_threads) schedule(static, 1)
+    for (i = 0; i < num_threads; ++i)
+    {
+        const size_t a = line_start(data, size, (size / num_threads) * i);
+        const size_t b = (i == num_threads - 1) ? size :
+                line_start(data, size, (size / num_threads) * (i + 1));
+        lists[i].type = type;
+        parse_range(data + a, data + b, &lists[i]);
+    }
+    oskar_mapped_file_free(file);
+
+    /* Report the first error, in file order. */
+    for (i = 0; i < num_threads; ++i)
+    {
+        if (lists[i].error)
+        {
+            *status = lists[i].error;
+            break;
+        }
+        num_sources += lists[i].num;
+    }
+
+    /* Assemble the sky model columns. */
+    if (!*status)
+        sky = oskar_sky_create(type, OSKAR_CPU, num_sources, status);
+    if (sky && !*status)
+    {
+        const size_t element_size = oskar_mem_element_size(type);
+        size_t offset = 0;
+        cols[0] = oskar_sky_ra_rad(sky);
+        cols[1] = oskar_sky_dec_rad(sky);
+        cols[2] = oskar_sky_I(sky);
+        cols[3] = oskar_sky_Q(sky);
+        cols[4] = oskar_sky_U(sky);
+        cols[5] = oskar_sky_V(sky);
+        cols[6] = oskar_sky_reference_freq_hz(sky);
+        cols[7] = oskar_sky_spectral_index(sky);
+        cols[8] = oskar_sky_rotation_measure_rad(sky);
+        cols[9] = oskar_sky_fwhm_major_rad(sky);
+        cols[10] = oskar_sky_fwhm_minor_rad(sky);
+        cols[11] = oskar_sky_position_angle_rad(sky);
+        for (i = 0; i < num_threads; ++i)
+        {
+            for (j = 0; j < NUM_PARAMS; ++j)
+                if (lists[i].num > 0)
+                    memcpy((char*) oskar_mem_void(cols[j]) + offset,
+                            lists[i].col[j], lists[i].num * element_size);
+            offset += lists[i].num * element_size;
+        }
+    }
 
-    /* Free the line buffer and close the file. */
-    if (line) free(line);
-    fclose(file);
+    /* Free the thread buffers. */
+    for (i = 0; i < num_threads; ++i)
+        for (j = 0; j < NUM_PARAMS; ++j)
+            free(lists[i].col[j]);
+    free(lists);
 
     /* Check if an error occurred. */
     if (*status)
@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2018, The University of Oxford
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the University of Oxford nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sky/private_sky.h"
+#include "sky/private_sky_columnar.h"
+#include "sky/oskar_sky.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+static int32_t get_i32(const char* buffer, int offset)
+{
+    int32_t value;
+    memcpy(&value, buffer + offset, sizeof(int32_t));
+    return value;
+}
+
+static uint32_t get_u32(const char* buffer, int offset)
+{
+    uint32_t value;
+    memcpy(&value, buffer + offset, sizeof(uint32_t));
+    return value;
+}
+
+static int64_t get_i64(const char* buffer, int offset)
+{
+    int64_t value;
+    memcpy(&value, buffer + offset, sizeof(int64_t));
+    return value;
+}
+
+static double get_f64(const char* buffer, int offset)
+{
+    double value;
+    memcpy(&value, buffer + offset, sizeof(double));
+    return value;
+}
+
+static void replace(oskar_Mem** mem, int type, int num, int* status)
+{
+    oskar_mem_free(*mem, status);
+    *mem = oskar_mem_create(type, OSKAR_CPU, num, status);
+}
+
+/* Checks the header, and that all the data it refers to are in the file. */
+static void check_header(const char* header, size_t file_size, int* status)
+{
+    int i;
+    int64_t num_sources, num_chunks, chunks, element_size;
+    if (*status) return;
+    if (file_size < OSKAR_SKY_COLUMNAR_HEADER_SIZE ||
+            memcmp(header, OSKAR_SKY_COLUMNAR_MAGIC, 8) ||
+            get_u32(header, OSKAR_SKY_COLUMNAR_OFF_VERSION) !=
+                    OSKAR_SKY_COLUMNAR_VERSION ||
+            get_u32(header, OSKAR_SKY_COLUMNAR_OFF_BYTE_ORDER) !=
+                    OSKAR_SKY_COLUMNAR_BYTE_ORDER ||
+            get_i32(header, OSKAR_SKY_COLUMNAR_OFF_NUM_COLUMNS) !=
+                    OSKAR_SKY_COLUMNAR_NUM_COLUMNS)
+    {
+        *status = OSKAR_ERR_BAD_SKY_FILE;
+        return;
+    }
+    switch (get_i32(header, OSKAR_SKY_COLUMNAR_OFF_PRECISION))
+    {
+    case OSKAR_SINGLE:
+        element_size = sizeof(float);
+        break;
+    case OSKAR_DOUBLE:
+        element_size = sizeof(double);
+        break;
+    default:
+        *status = OSKAR_ERR_BAD_SKY_FILE;
+        return;
+    }
+    num_sources = get_i64(header, OSKAR_SKY_COLUMNAR_OFF_NUM_SOURCES);
+    num_chunks = get_i64(header, OSKAR_SKY_COLUMNAR_OFF_NUM_CHUNKS);
+    chunks = get_i64(header, OSKAR_SKY_COLUMNAR_OFF_CHUNKS);
+    if (num_sources < 0 || num_sources > INT32_MAX || num_chunks < 0 ||
+            num_chunks > INT32_MAX || chunks < 0 ||
+            (uint64_t) (chunks + num_chunks * OSKAR_SKY_COLUMNAR_CHUNK_SIZE) >
+                    file_size)
+    {
+        *status = OSKAR_ERR_BAD_SKY_FILE;
+        return;
+    }
+    for (i = 0; i < OSKAR_SKY_COLUMNAR_NUM_COLUMNS; ++i)
+    {
+        const int64_t column = get_i64(header,
+                OSKAR_SKY_COLUMNAR_OFF_COLUMNS + 8 * i);
+        if (column < 0 || column % element_size != 0 ||
+                (uint64_t) (column + num_sources * element_size) > file_size)
+        {
+            *status = OSKAR_ERR_BAD_SKY_FILE;
+            return;
+        }
+    }
+}
+
+oskar_Sky* oskar_sky_read_columnar(const char* filename, int type,
+        int* status)
+{
+    int i, num_sources, file_type;
+    char* data;
+    oskar_MappedFile* file;
+    oskar_Sky* sky;
+    oskar_Mem** cols[OSKAR_SKY_COLUMNAR_NUM_COLUMNS];
+
+    /* Check if safe to proceed. */
+    if (*status) return 0;
+
+    /* Map the file and check the header. */
+    file = oskar_mapped_file_create(filename, status);
+    if (*status) return 0;
+    data = oskar_mapped_file_data(file);
+    check_header(data, oskar_mapped_file_size(file), status);
+    if (*status)
+    {
+        oskar_mapped_file_free(file);
+        return 0;
+    }
+    file_type = get_i32(data, OSKAR_SKY_COLUMNAR_OFF_PRECISION);
+    num_sources = (int) get_i64(data, OSKAR_SKY_COLUMNAR_OFF_NUM_SOURCES);
+
+    /* Create an empty sky model, and allocate the derived arrays. */
+    sky = oskar_sky_create(type, OSKAR_CPU, 0, status);
+    if (*status)
+    {
+        oskar_mapped_file_free(file);
+        return 0;
+    }
+    sky->num_sources = num_sources;
+    sky->capacity = num_sources;
+    replace(&sky->l, type, num_sources, status);
+    replace(&sky->m, type, num_sources, status);
+    replace(&sky->n, type, num_sources, status);
+    replace(&sky->gaussian_a, type, num_sources, status);
+    replace(&sky->gaussian_b, type, num_sources, status);
+    replace(&sky->gaussian_c, type, num_sources, status);
+    sky->use_extended = get_i32(data, OSKAR_SKY_COLUMNAR_OFF_EXTENDED);
+    sky->reference_ra_rad = get_f64(data, OSKAR_SKY_COLUMNAR_OFF_REF_RA);
+    sky->reference_dec_rad = get_f64(data, OSKAR_SKY_COLUMNAR_OFF_REF_DEC);
+
+    /* Replace the source parameter arrays with views of the file. */
+    cols[0] = &sky->ra_rad;
+    cols[1] = &sky->dec_rad;
+    cols[2] = &sky->I;
+    cols[3] = &sky->Q;
+    cols[4] = &sky->U;
+    cols[5] = &sky->V;
+    cols[6] = &sky->reference_freq_hz;
+    cols[7] = &sky->spectral_index;
+    cols[8] = &sky->rm_rad;
+    cols[9] = &sky->fwhm_major_rad;
+    cols[10] = &sky->fwhm_minor_rad;
+    cols[11] = &sky->pa_rad;
+    for (i = 0; i < OSKAR_SKY_COLUMNAR_NUM_COLUMNS; ++i)
+    {
+        oskar_Mem* alias;
+        alias = oskar_mem_create_alias_from_raw(data + get_i64(data,
+                OSKAR_SKY_COLUMNAR_OFF_COLUMNS + 8 * i), file_type,
+                OSKAR_CPU, num_sources, status);
+        oskar_mem_free(*cols[i], status);
+        if (file_type == type)
+            *cols[i] = alias;
+        else
+        {
+            *cols[i] = oskar_mem_convert_precision(alias, type, status);
+            oskar_mem_free(alias, status);
+        }
+    }
+    if (file_type == type)
+        sky->mapped_file = file;
+    else
+        oskar_mapped_file_free(file);
+
+    /* Check if an error occurred. */
+    if (*status)
+    {
+        oskar_sky_free(sky, status);
+        sky = 0;
+    }
+    return sky;
+}
+
+void oskar_sky_read_columnar_chunks(const char* filename, oskar_Mem* offset,
+        oskar_Mem* num_sources, oskar_Mem* cap_ra_rad, oskar_Mem* cap_dec_rad,
+        oskar_Mem* cap_radius_rad, int* status)
+{
+    int i, num_chunks, *offset_, *num_;
+    double *ra_, *dec_, *radius_;
+    const char* data;
+    oskar_MappedFile* file;
+
+    /* Check if safe to proceed. */
+    if (*status) return;
+
+    /* Check types. */
+    if (oskar_mem_type(offset) != OSKAR_INT ||
+            oskar_mem_type(num_sources) != OSKAR_INT ||
+            oskar_mem_type(cap_ra_rad) != OSKAR_DOUBLE ||
+            oskar_mem_type(cap_dec_rad) != OSKAR_DOUBLE ||
+            oskar_mem_type(cap_radius_rad) != OSKAR_DOUBLE)
+    {
+        *status = OSKAR_ERR_BAD_DATA_TYPE;
+        return;
+    }
+
+    /* Map the file and check the header. */
+    file = oskar_mapped_file_create(filename, status);
+    if (*status) return;
+    data = oskar_mapped_file_data(file);
+    check_header(data, oskar_mapped_file_size(file), status);
+    if (*status)
+    {
+        oskar_mapped_file_free(file);
+        return;
+    }
+
+    /* Copy out the directory. */
+    num_chunks = (int) get_i64(data, OSKAR_SKY_COLUMNAR_OFF_NUM_CHUNKS);
+    data += get_i64(data, OSKAR_SKY_COLUMNAR_OFF_CHUNKS);
+    oskar_mem_realloc(offset, num_chunks, status);
+    oskar_mem_realloc(num_sources, num_chunks, status);
+    oskar_mem_realloc(cap_ra_rad, num_chunks, status);
+    oskar_mem_realloc(cap_dec_rad, num_chunks, status);
+    oskar_mem_realloc(cap_radius_rad, num_chunks, status);
+    offset_ = oskar_mem_int(offset, status);
+    num_ = oskar_mem_int(num_sources, status);
+    ra_ = oskar_mem_double(cap_ra_rad, status);
+    dec_ = oskar_mem_double(cap_dec_rad, status);
+    radius_ = oskar_mem_double(cap_radius_rad, status);
+    for (i = 0; i < num_chunks && !*status; ++i)
+    {
+        const char* entry = data + i * OSKAR_SKY_COLUMNAR_CHUNK_SIZE;
+        offset_[i] = (int) get_i64(entry, 0);
+        num_[i] = (int) get_i64(entry, 8);
+        ra_[i] = get_f64(entry, 16);
+        dec_[i] = get_f64(entry, 24);
+        radius_[i] = get_f64(entry, 32);
+    }
+    oskar_mapped_file_free(file);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -35,6 +35,13 @@
 extern "C" {
 #endif
 
+static void copy_alias(oskar_Mem** mem, int* status)
+{
+    oskar_Mem* t = oskar_mem_create_copy(*mem, OSKAR_CPU, status);
+    oskar_mem_free(*mem, status);
+    *mem = t;
+}
+
 void oskar_sky_resize(oskar_Sky* sky, int num_sources, int* status)
 {
     int capacity;
@@ -42,6 +49,26 @@ void oskar_sky_resize(oskar_Sky* sky, int num_sources, int* status)
     /* Check if safe to proceed. */
     if (*status) return;
 
+    /* Take a copy of any columns that alias a mapped file. */
+    if (sky->mapped_file)
+    {
+        copy_alias(&sky->ra_rad, status);
+        copy_alias(&sky->dec_rad, status);
+        copy_alias(&sky->I, status);
+        copy_alias(&sky->Q, status);
+        copy_alias(&sky->U, status);
+        copy_alias(&sky->V, status);
+        copy_alias(&sky->reference_freq_hz, status);
+        copy_alias(&sky->spectral_index, status);
+        copy_alias(&sky->rm_rad, status);
+        copy_alias(&sky->fwhm_major_rad, status);
+        copy_alias(&sky->fwhm_minor_rad, status);
+        copy_alias(&sky->pa_rad, status);
+        if (*status) return;
+        oskar_mapped_file_free(sky->mapped_file);
+        sky->mapped_file = 0;
+    }
+
     capacity = num_sources + 1;
     sky->capacity = capacity;
     sky->num_sources = num_sources;
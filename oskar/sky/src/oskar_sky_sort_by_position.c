@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2018, The University of Oxford
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the University of Oxford nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sky/private_sky.h"
+#include "sky/oskar_sky.h"
+#include "convert/oskar_convert_theta_phi_to_healpix_nest.h"
+#include "math/oskar_cmath.h"
+
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct
+{
+    long key;
+    int index;
+} SortItem;
+
+static int compare_items(const void* a, const void* b)
+{
+    const SortItem *x = (const SortItem*) a, *y = (const SortItem*) b;
+    if (x->key != y->key) return (x->key < y->key) ? -1 : 1;
+    return (x->index < y->index) ? -1 : (x->index > y->index);
+}
+
+static void reorder(oskar_Mem* mem, const SortItem* items, int num,
+        oskar_Mem* temp, int* status)
+{
+    int i;
+    if (*status) return;
+    oskar_mem_copy_contents(temp, mem, 0, 0, num, status);
+    if (oskar_mem_type(mem) == OSKAR_DOUBLE)
+    {
+        const double* src = oskar_mem_double_const(temp, status);
+        double* dst = oskar_mem_double(mem, status);
+        for (i = 0; i < num; ++i) dst[i] = src[items[i].index];
+    }
+    else
+    {
+        const float* src = oskar_mem_float_const(temp, status);
+        float* dst = oskar_mem_float(mem, status);
+        for (i = 0; i < num; ++i) dst[i] = src[items[i].index];
+    }
+}
+
+void oskar_sky_sort_by_position(oskar_Sky* sky, int* status)
+{
+    int i, num_sources;
+    SortItem* items;
+    oskar_Mem* temp;
+    const long nside = 8192;
+
+    /* Check if safe to proceed. */
+    if (*status) return;
+    if (sky->mem_location != OSKAR_CPU)
+    {
+        *status = OSKAR_ERR_BAD_LOCATION;
+        return;
+    }
+    num_sources = sky->num_sources;
+    if (num_sources < 2) return;
+
+    /* Find the HEALPix pixel containing each source. */
+    items = (SortItem*) malloc(num_sources * sizeof(SortItem));
+    if (!items)
+    {
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+        return;
+    }
+    for (i = 0; i < num_sources; ++i)
+    {
+        double ra, dec;
+        if (sky->precision == OSKAR_DOUBLE)
+        {
+            ra = oskar_mem_double(sky->ra_rad, status)[i];
+            dec = oskar_mem_double(sky->dec_rad, status)[i];
+        }
+        else
+        {
+            ra = oskar_mem_float(sky->ra_rad, status)[i];
+            dec = oskar_mem_float(sky->dec_rad, status)[i];
+        }
+        oskar_convert_theta_phi_to_healpix_nest(nside, M_PI / 2.0 - dec,
+                ra, &items[i].key);
+        items[i].index = i;
+    }
+    qsort(items, num_sources, sizeof(SortItem), compare_items);
+
+    /* Reorder all source parameters. */
+    temp = oskar_mem_create(sky->precision, OSKAR_CPU, num_sources, status);
+    reorder(sky->ra_rad, items, num_sources, temp, status);
+    reorder(sky->dec_rad, items, num_sources, temp, status);
+    reorder(sky->I, items, num_sources, temp, status);
+    reorder(sky->Q, items, num_sources, temp, status);
+    reorder(sky->U, items, num_sources, temp, status);
+    reorder(sky->V, items, num_sources, temp, status);
+    reorder(sky->reference_freq_hz, items, num_sources, temp, status);
+    reorder(sky->spectral_index, items, num_sources, temp, status);
+    reorder(sky->rm_rad, items, num_sources, temp, status);
+    reorder(sky->l, items, num_sources, temp, status);
+    reorder(sky->m, items, num_sources, temp, status);
+    reorder(sky->n, items, num_sources, temp, status);
+    reorder(sky->fwhm_major_rad, items, num_sources, temp, status);
+    reorder(sky->fwhm_minor_rad, items, num_sources, temp, status);
+    reorder(sky->pa_rad, items, num_sources, temp, status);
+    reorder(sky->gaussian_a, items, num_sources, temp, status);
+    reorder(sky->gaussian_b, items, num_sources, temp, status);
+    reorder(sky->gaussian_c, items, num_sources, temp, status);
+    oskar_mem_free(temp, status);
+    free(items);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2018, The University of Oxford
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the University of Oxford nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sky/oskar_sky.h"
+#include "sky/private_sky_columnar.h"
+#include "math/oskar_cmath.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+static void set_i32(char* buffer, int offset, int32_t value)
+{
+    memcpy(buffer + offset, &value, sizeof(int32_t));
+}
+
+static void set_u32(char* buffer, int offset, uint32_t value)
+{
+    memcpy(buffer + offset, &value, sizeof(uint32_t));
+}
+
+static void set_i64(char* buffer, int offset, int64_t value)
+{
+    memcpy(buffer + offset, &value, sizeof(int64_t));
+}
+
+static void set_f64(char* buffer, int offset, double value)
+{
+    memcpy(buffer + offset, &value, sizeof(double));
+}
+
+static size_t align(size_t offset)
+{
+    const size_t a = OSKAR_SKY_COLUMNAR_ALIGNMENT;
+    return ((offset + a - 1) / a) * a;
+}
+
+/* Finds the centre and radius of a cap that bounds a range of sources. */
+static void bounding_cap(const oskar_Mem* ra_rad, const oskar_Mem* dec_rad,
+        int offset, int num, double* cap_ra, double* cap_dec,
+        double* cap_radius, int* status)
+{
+    int i;
+    double x = 0.0, y = 0.0, z = 0.0, len, min_dot = 1.0;
+    const int type = oskar_mem_precision(ra_rad);
+    const void *ra = oskar_mem_void_const(ra_rad);
+    const void *dec = oskar_mem_void_const(dec_rad);
+    if (*status) return;
+#define RA(I)  (type == OSKAR_DOUBLE ? ((const double*)ra)[I] : \
+        (double) ((const float*)ra)[I])
+#define DEC(I) (type == OSKAR_DOUBLE ? ((const double*)dec)[I] : \
+        (double) ((const float*)dec)[I])
+    for (i = offset; i < offset + num; ++i)
+    {
+        const double cos_dec = cos(DEC(i));
+        x += cos_dec * cos(RA(i));
+        y += cos_dec * sin(RA(i));
+        z += sin(DEC(i));
+    }
+    len = sqrt(x*x + y*y + z*z);
+    if (len < 1e-9 * num)
+    {
+        /* Sources are spread over the whole sphere. */
+        *cap_ra = 0.0;
+        *cap_dec = M_PI / 2.0;
+        *cap_radius = M_PI;
+        return;
+    }
+    x /= len; y /= len; z /= len;
+    for (i = offset; i < offset + num; ++i)
+    {
+        const double cos_dec = cos(DEC(i));
+        const double dot = x * cos_dec * cos(RA(i)) +
+                y * cos_dec * sin(RA(i)) + z * sin(DEC(i));
+        if (dot < min_dot) min_dot = dot;
+    }
+#undef RA
+#undef DEC
+    *cap_ra = atan2(y, x);
+    *cap_dec = atan2(z, sqrt(x*x + y*y));
+    *cap_radius = acos(min_dot < -1.0 ? -1.0 : min_dot) + 1e-9;
+}
+
+void oskar_sky_write_columnar(const char* filename, const oskar_Sky* sky,
+        int max_chunk_size, int* status)
+{
+    int c, i, num_chunks, num_sources, type;
+    size_t element_size, offset, column_offset[OSKAR_SKY_COLUMNAR_NUM_COLUMNS];
+    char header[OSKAR_SKY_COLUMNAR_HEADER_SIZE];
+    char *chunks = 0, padding[OSKAR_SKY_COLUMNAR_ALIGNMENT];
+    const oskar_Mem* cols[OSKAR_SKY_COLUMNAR_NUM_COLUMNS];
+    FILE* file;
+
+    /* Check if safe to proceed. */
+    if (*status) return;
+
+    /* Data in GPU memory cannot be written directly. */
+    if (oskar_sky_mem_location(sky) != OSKAR_CPU)
+    {
+        *status = OSKAR_ERR_BAD_LOCATION;
+        return;
+    }
+    if (max_chunk_size < 1)
+    {
+        *status = OSKAR_ERR_INVALID_ARGUMENT;
+        return;
+    }
+    type = oskar_sky_precision(sky);
+    num_sources = oskar_sky_num_sources(sky);
+    num_chunks = (num_sources + max_chunk_size - 1) / max_chunk_size;
+    element_size = oskar_mem_element_size(type);
+    cols[0] = oskar_sky_ra_rad_const(sky);
+    cols[1] = oskar_sky_dec_rad_const(sky);
+    cols[2] = oskar_sky_I_const(sky);
+    cols[3] = oskar_sky_Q_const(sky);
+    cols[4] = oskar_sky_U_const(sky);
+    cols[5] = oskar_sky_V_const(sky);
+    cols[6] = oskar_sky_reference_freq_hz_const(sky);
+    cols[7] = oskar_sky_spectral_index_const(sky);
+    cols[8] = oskar_sky_rotation_measure_rad_const(sky);
+    cols[9] = oskar_sky_fwhm_major_rad_const(sky);
+    cols[10] = oskar_sky_fwhm_minor_rad_const(sky);
+    cols[11] = oskar_sky_position_angle_rad_const(sky);
+
+    /* Build the chunk directory. */
+    chunks = (char*) calloc(num_chunks > 0 ? num_chunks : 1,
+            OSKAR_SKY_COLUMNAR_CHUNK_SIZE);
+    if (!chunks)
+    {
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+        return;
+    }
+    for (c = 0; c < num_chunks; ++c)
+    {
+        double cap_ra = 0.0, cap_dec = 0.0, cap_radius = 0.0;
+        char* entry = chunks + c * OSKAR_SKY_COLUMNAR_CHUNK_SIZE;
+        const int start = c * max_chunk_size;
+        const int num = (num_sources - start < max_chunk_size) ?
+                num_sources - start : max_chunk_size;
+        bounding_cap(cols[0], cols[1], start, num,
+                &cap_ra, &cap_dec, &cap_radius, status);
+        set_i64(entry, 0, start);
+        set_i64(entry, 8, num);
+        set_f64(entry, 16, cap_ra);
+        set_f64(entry, 24, cap_dec);
+        set_f64(entry, 32, cap_radius);
+    }
+
+    /* Lay out the columns after the directory. */
+    offset = align(OSKAR_SKY_COLUMNAR_HEADER_SIZE +
+            (size_t) num_chunks * OSKAR_SKY_COLUMNAR_CHUNK_SIZE);
+    for (i = 0; i < OSKAR_SKY_COLUMNAR_NUM_COLUMNS; ++i)
+    {
+        column_offset[i] = offset;
+        offset = align(offset + (size_t) num_sources * element_size);
+    }
+
+    /* Fill in the header. */
+    memset(header, 0, sizeof(header));
+    memcpy(header, OSKAR_SKY_COLUMNAR_MAGIC, 8);
+    set_u32(header, OSKAR_SKY_COLUMNAR_OFF_VERSION,
+            OSKAR_SKY_COLUMNAR_VERSION);
+    set_u32(header, OSKAR_SKY_COLUMNAR_OFF_BYTE_ORDER,
+            OSKAR_SKY_COLUMNAR_BYTE_ORDER);
+    set_i32(header, OSKAR_SKY_COLUMNAR_OFF_PRECISION, type);
+    set_i32(header, OSKAR_SKY_COLUMNAR_OFF_NUM_COLUMNS,
+            OSKAR_SKY_COLUMNAR_NUM_COLUMNS);
+    set_i64(header, OSKAR_SKY_COLUMNAR_OFF_NUM_SOURCES, num_sources);
+    set_i64(header, OSKAR_SKY_COLUMNAR_OFF_NUM_CHUNKS, num_chunks);
+    set_i64(header, OSKAR_SKY_COLUMNAR_OFF_CHUNKS,
+            OSKAR_SKY_COLUMNAR_HEADER_SIZE);
+    for (i = 0; i < OSKAR_SKY_COLUMNAR_NUM_COLUMNS; ++i)
+        set_i64(header, OSKAR_SKY_COLUMNAR_OFF_COLUMNS + 8 * i,
+                (int64_t) column_offset[i]);
+    set_i32(header, OSKAR_SKY_COLUMNAR_OFF_EXTENDED,
+            oskar_sky_use_extended(sky));
+    set_f64(header, OSKAR_SKY_COLUMNAR_OFF_REF_RA,
+            oskar_sky_reference_ra_rad(sky));
+    set_f64(header, OSKAR_SKY_COLUMNAR_OFF_REF_DEC,
+            oskar_sky_reference_dec_rad(sky));
+
+    /* Write the file. */
+    file = fopen(filename, "wb");
+    if (!file)
+    {
+        *status = OSKAR_ERR_FILE_IO;
+        free(chunks);
+        return;
+    }
+    memset(padding, 0, sizeof(padding));
+    offset = OSKAR_SKY_COLUMNAR_HEADER_SIZE +
+            (size_t) num_chunks * OSKAR_SKY_COLUMNAR_CHUNK_SIZE;
+    if (fwrite(header, 1, sizeof(header), file) != sizeof(header) ||
+            fwrite(chunks, OSKAR_SKY_COLUMNAR_CHUNK_SIZE, num_chunks, file) !=
+                    (size_t) num_chunks)
+        *status = OSKAR_ERR_FILE_IO;
+    for (i = 0; i < OSKAR_SKY_COLUMNAR_NUM_COLUMNS && !*status; ++i)
+    {
+        const size_t bytes = (size_t) num_sources * element_size;
+        if (fwrite(padding, 1, column_offset[i] - offset, file) !=
+                column_offset[i] - offset ||
+                fwrite(oskar_mem_void_const(cols[i]), 1, bytes, file) != bytes)
+            *status = OSKAR_ERR_FILE_IO;
+        offset = column_offset[i] + bytes;
+    }
+    fclose(file);
+    free(chunks);
+}
+
+#ifdef __cplusplus
+}
+#endif
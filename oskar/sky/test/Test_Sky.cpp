@@ -31,6 +31,7 @@
 #include "telescope/oskar_telescope.h"
 #include "sky/oskar_sky.h"
 #include "convert/oskar_convert_lon_lat_to_relative_directions.h"
+#include "math/oskar_angular_distance.h"
 #include "utility/oskar_get_error_string.h"
 #include "utility/oskar_timer.h"
 #include "utility/oskar_cl_utils.h"
@@ -566,6 +567,207 @@ TEST(SkyModel, horizon_clip)
 }
 
 
+TEST(SkyModel, horizon_clip_index)
+{
+    int status = 0;
+    const double deg2rad = M_PI / 180.0;
+    for (int t = 0; t < 2; ++t)
+    {
+        int type = t ? OSKAR_DOUBLE : OSKAR_SINGLE;
+        int n_sources = 20000, n_stations = 40;
+
+        // Generate random sources over the whole sky.
+        oskar_Sky* sky = oskar_sky_create(type, OSKAR_CPU, n_sources, &status);
+        srand(2);
+        for (int i = 0; i < n_sources; ++i)
+        {
+            double ra = 2.0 * M_PI * rand() / (double)RAND_MAX;
+            double dec = asin(2.0 * rand() / (double)RAND_MAX - 1.0);
+            oskar_sky_set_source(sky, i, ra, dec, 1.0, 0.0, 0.0, 0.0,
+                    100e6, 0.0, 0.0, 0.0, 0.0, 0.0, &status);
+        }
+        oskar_sky_evaluate_relative_directions(sky, 0.3, -0.5, &status);
+        oskar_SkyIndex* index = oskar_sky_index_create(sky, &status);
+        ASSERT_EQ(0, status) << oskar_get_error_string(status);
+        ASSERT_EQ(n_sources, oskar_sky_index_num_sources(index));
+
+        // Check compact and widely-spread arrays.
+        for (int spread = 0; spread < 2; ++spread)
+        {
+            oskar_Telescope* telescope = oskar_telescope_create(type,
+                    OSKAR_CPU, n_stations, &status);
+            for (int i = 0; i < n_stations; ++i)
+            {
+                double lon = spread ? i * 7.0 : 116.6 + 0.001 * (i % 5);
+                double lat = spread ? 80.0 - i * 4.0 : -26.7 + 0.001 * i;
+                oskar_station_set_position(
+                        oskar_telescope_station(telescope, i),
+                        lon * deg2rad, lat * deg2rad, 0.0);
+            }
+            for (int k = 0; k < 3; ++k)
+            {
+                double gast = k * 2.1;
+                oskar_StationWork* work = oskar_station_work_create(type,
+                        OSKAR_CPU, &status);
+                oskar_Sky* out1 = oskar_sky_create(type, OSKAR_CPU, 0, &status);
+                oskar_Sky* out2 = oskar_sky_create(type, OSKAR_CPU, 0, &status);
+                oskar_sky_horizon_clip(out1, sky, telescope, gast,
+                        work, &status);
+                oskar_sky_horizon_clip_index(out2, sky, index, telescope,
+                        gast, work, &status);
+                ASSERT_EQ(0, status) << oskar_get_error_string(status);
+                int n = oskar_sky_num_sources(out1);
+                ASSERT_EQ(n, oskar_sky_num_sources(out2));
+                EXPECT_GT(n, 0);
+                EXPECT_LE(n, spread ? n_sources : n_sources - 1);
+                EXPECT_EQ(0, oskar_mem_different(oskar_sky_ra_rad_const(out1),
+                        oskar_sky_ra_rad_const(out2), n, &status));
+                EXPECT_EQ(0, oskar_mem_different(oskar_sky_dec_rad_const(out1),
+                        oskar_sky_dec_rad_const(out2), n, &status));
+                oskar_sky_free(out1, &status);
+                oskar_sky_free(out2, &status);
+                oskar_station_work_free(work, &status);
+            }
+            oskar_telescope_free(telescope, &status);
+        }
+
+        oskar_sky_index_free(index);
+        oskar_sky_free(sky, &status);
+    }
+}
+
+
+TEST(SkyModel, sort_by_position)
+{
+    int status = 0, num_sources = 5000;
+    oskar_Sky* sky = oskar_sky_create(OSKAR_DOUBLE, OSKAR_CPU,
+            num_sources, &status);
+    srand(3);
+    for (int i = 0; i < num_sources; ++i)
+    {
+        double ra = 2.0 * M_PI * rand() / (double)RAND_MAX;
+        double dec = asin(2.0 * rand() / (double)RAND_MAX - 1.0);
+        oskar_sky_set_source(sky, i, ra, dec, ra + dec, 0.0, 0.0, 0.0,
+                100e6, 0.0, 0.0, 0.0, 0.0, 0.0, &status);
+    }
+    oskar_sky_sort_by_position(sky, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    ASSERT_EQ(num_sources, oskar_sky_num_sources(sky));
+
+    // Check that source parameters stay together, and that sources
+    // in each block of 64 are close together.
+    const double* ra = oskar_mem_double_const(
+            oskar_sky_ra_rad_const(sky), &status);
+    const double* dec = oskar_mem_double_const(
+            oskar_sky_dec_rad_const(sky), &status);
+    const double* I = oskar_mem_double_const(
+            oskar_sky_I_const(sky), &status);
+    double total_dist = 0.0;
+    for (int i = 0; i < num_sources; ++i)
+    {
+        EXPECT_DOUBLE_EQ(ra[i] + dec[i], I[i]);
+        if (i % 64 != 0)
+            total_dist += oskar_angular_distance(ra[i], ra[i - 1],
+                    dec[i], dec[i - 1]);
+    }
+
+    // Mean separation of neighbours is much less than for random order.
+    EXPECT_LT(total_dist / num_sources, 0.1);
+    oskar_sky_free(sky, &status);
+}
+
+
+TEST(SkyModel, read_write_columnar)
+{
+    int status = 0, num_sources = 3000;
+    const char* filename = "temp_sky_columnar.osm";
+    oskar_Sky* sky = oskar_sky_create(OSKAR_DOUBLE, OSKAR_CPU,
+            num_sources, &status);
+    srand(4);
+    for (int i = 0; i < num_sources; ++i)
+    {
+        double ra = 2.0 * M_PI * rand() / (double)RAND_MAX;
+        double dec = asin(2.0 * rand() / (double)RAND_MAX - 1.0);
+        oskar_sky_set_source(sky, i, ra, dec, 1.0 + i, 0.1, 0.2, 0.3,
+                100e6, -0.7, 1.5, (i % 3) * 1e-4, (i % 3) * 5e-5, 0.5,
+                &status);
+    }
+    oskar_sky_sort_by_position(sky, &status);
+    oskar_sky_write_columnar(filename, sky, 32, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+    // Read it back, both directly and through the generic loader.
+    oskar_Sky* sky2 = oskar_sky_read_columnar(filename, OSKAR_DOUBLE, &status);
+    oskar_Sky* sky3 = oskar_sky_load(filename, OSKAR_SINGLE, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    ASSERT_EQ(num_sources, oskar_sky_num_sources(sky2));
+    ASSERT_EQ(num_sources, oskar_sky_num_sources(sky3));
+    EXPECT_EQ(oskar_sky_use_extended(sky), oskar_sky_use_extended(sky2));
+    EXPECT_EQ((int)OSKAR_SINGLE, oskar_sky_precision(sky3));
+    EXPECT_FALSE(oskar_mem_different(oskar_sky_ra_rad(sky),
+            oskar_sky_ra_rad(sky2), num_sources, &status));
+    EXPECT_FALSE(oskar_mem_different(oskar_sky_I(sky),
+            oskar_sky_I(sky2), num_sources, &status));
+    EXPECT_FALSE(oskar_mem_different(oskar_sky_position_angle_rad(sky),
+            oskar_sky_position_angle_rad(sky2), num_sources, &status));
+    EXPECT_FLOAT_EQ((float) oskar_mem_double(oskar_sky_fwhm_major_rad(sky),
+            &status)[num_sources - 1], oskar_mem_float(
+                    oskar_sky_fwhm_major_rad(sky3), &status)[num_sources - 1]);
+
+    // Check that every source lies in the cap of its chunk.
+    oskar_Mem* offset = oskar_mem_create(OSKAR_INT, OSKAR_CPU, 0, &status);
+    oskar_Mem* num = oskar_mem_create(OSKAR_INT, OSKAR_CPU, 0, &status);
+    oskar_Mem* cap_ra = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU, 0, &status);
+    oskar_Mem* cap_dec = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU, 0, &status);
+    oskar_Mem* cap_r = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU, 0, &status);
+    oskar_sky_read_columnar_chunks(filename, offset, num,
+            cap_ra, cap_dec, cap_r, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    const int num_chunks = (int)oskar_mem_length(offset);
+    ASSERT_EQ((num_sources + 31) / 32, num_chunks);
+    const double* ra = oskar_mem_double_const(
+            oskar_sky_ra_rad_const(sky), &status);
+    const double* dec = oskar_mem_double_const(
+            oskar_sky_dec_rad_const(sky), &status);
+    int total = 0;
+    double mean_radius = 0.0;
+    for (int c = 0; c < num_chunks; ++c)
+    {
+        const int start = oskar_mem_int(offset, &status)[c];
+        const int n = oskar_mem_int(num, &status)[c];
+        ASSERT_EQ(total, start);
+        total += n;
+        const double r = oskar_mem_double(cap_r, &status)[c];
+        mean_radius += r / num_chunks;
+        for (int i = start; i < start + n; ++i)
+            EXPECT_LE(oskar_angular_distance(ra[i],
+                    oskar_mem_double(cap_ra, &status)[c], dec[i],
+                    oskar_mem_double(cap_dec, &status)[c]), r);
+    }
+    EXPECT_EQ(num_sources, total);
+    EXPECT_LT(mean_radius, 0.7);
+
+    // Filtering makes a private copy, leaving the file untouched.
+    oskar_sky_filter_by_flux(sky2, 0.0, 100.0, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    EXPECT_EQ(100, oskar_sky_num_sources(sky2));
+    oskar_sky_free(sky3, &status);
+    sky3 = oskar_sky_read_columnar(filename, OSKAR_DOUBLE, &status);
+    ASSERT_EQ(num_sources, oskar_sky_num_sources(sky3));
+    EXPECT_FALSE(oskar_mem_different(oskar_sky_I(sky),
+            oskar_sky_I(sky3), num_sources, &status));
+
+    oskar_mem_free(offset, &status);
+    oskar_mem_free(num, &status);
+    oskar_mem_free(cap_ra, &status);
+    oskar_mem_free(cap_dec, &status);
+    oskar_mem_free(cap_r, &status);
+    oskar_sky_free(sky, &status);
+    oskar_sky_free(sky2, &status);
+    oskar_sky_free(sky3, &status);
+    remove(filename);
+}
+
 TEST(SkyModel, resize)
 {
     int status = 0;
@@ -1138,6 +1340,110 @@ TEST(SkyModel, load_ascii)
 }
 
 
+TEST(SkyModel, load_ascii_formats)
+{
+    int status = 0;
+    const double deg2rad = 1.74532925199432957692369e-2;
+    const double arcsec2rad = 4.84813681109535993589914e-6;
+    const char* filename = "temp_sources_formats.osm";
+
+    // Mix of column counts, delimiters, comments and line endings.
+    {
+        FILE* file = fopen(filename, "w");
+        if (!file) FAIL() << "Unable to create test file";
+        fprintf(file, "# RA, Dec, I\n\n   \n");
+        fprintf(file, "10.5, -30.25, 1.5e-3\r\n");
+        fprintf(file, "\t1 2 3 4 5 6 1e8 -0.7 0.5 # trailing comment\n");
+        fprintf(file, "1,2,3,4,5,6,1e8,-0.7,30,20,45\n");
+        fprintf(file, "1 2 junk 3 4 5 6 1e8 -0.7 0.5 30 20 45 99\n");
+        fprintf(file, "0.1234567890123456789 -7E-2 .5");
+        fclose(file);
+
+        oskar_Sky* sky = oskar_sky_load(filename, OSKAR_DOUBLE, &status);
+        ASSERT_EQ(0, status) << oskar_get_error_string(status);
+        ASSERT_EQ(5, oskar_sky_num_sources(sky));
+        const double* ra = oskar_mem_double_const(
+                oskar_sky_ra_rad_const(sky), &status);
+        const double* dec = oskar_mem_double_const(
+                oskar_sky_dec_rad_const(sky), &status);
+        const double* I = oskar_mem_double_const(
+                oskar_sky_I_const(sky), &status);
+        const double* rm = oskar_mem_double_const(
+                oskar_sky_rotation_measure_rad_const(sky), &status);
+        const double* maj = oskar_mem_double_const(
+                oskar_sky_fwhm_major_rad_const(sky), &status);
+        const double* pa = oskar_mem_double_const(
+                oskar_sky_position_angle_rad_const(sky), &status);
+        EXPECT_EQ(10.5 * deg2rad, ra[0]);
+        EXPECT_EQ(-30.25 * deg2rad, dec[0]);
+        EXPECT_EQ(strtod("1.5e-3", 0), I[0]);
+        EXPECT_EQ(0.5, rm[1]);
+        EXPECT_EQ(0.0, maj[1]);
+        EXPECT_EQ(0.0, rm[2]);
+        EXPECT_EQ(30.0 * arcsec2rad, maj[2]);
+        EXPECT_EQ(45.0 * deg2rad, pa[2]);
+        EXPECT_EQ(0.5, rm[3]);
+        EXPECT_EQ(30.0 * arcsec2rad, maj[3]);
+        EXPECT_EQ(45.0 * deg2rad, pa[3]);
+        EXPECT_EQ(strtod("0.1234567890123456789", 0) * deg2rad, ra[4]);
+        EXPECT_EQ(strtod("-7E-2", 0) * deg2rad, dec[4]);
+        EXPECT_EQ(0.5, I[4]);
+        oskar_sky_free(sky, &status);
+        remove(filename);
+    }
+
+    // Large file: values must be identical to strtod() and in file order.
+    {
+        FILE* file = fopen(filename, "w");
+        if (!file) FAIL() << "Unable to create test file";
+        const int num_sources = 100000;
+        srand(2);
+        for (int i = 0; i < num_sources; ++i)
+        {
+            if (i % 1000 == 0) fprintf(file, "# comment\n");
+            double r = 360.0 * rand() / (double)RAND_MAX;
+            double d = 180.0 * rand() / (double)RAND_MAX - 90.0;
+            fprintf(file, "%.17g %.6e %d\n", r, d, i);
+        }
+        fclose(file);
+
+        oskar_Sky* sky = oskar_sky_load(filename, OSKAR_DOUBLE, &status);
+        ASSERT_EQ(0, status) << oskar_get_error_string(status);
+        ASSERT_EQ(num_sources, oskar_sky_num_sources(sky));
+        const double* ra = oskar_mem_double_const(
+                oskar_sky_ra_rad_const(sky), &status);
+        const double* dec = oskar_mem_double_const(
+                oskar_sky_dec_rad_const(sky), &status);
+        const double* I = oskar_mem_double_const(
+                oskar_sky_I_const(sky), &status);
+        srand(2);
+        for (int i = 0; i < num_sources; ++i)
+        {
+            char buffer[64];
+            sprintf(buffer, "%.17g", 360.0 * rand() / (double)RAND_MAX);
+            ASSERT_EQ(strtod(buffer, 0) * deg2rad, ra[i]);
+            sprintf(buffer, "%.6e", 180.0 * rand() / (double)RAND_MAX - 90.0);
+            ASSERT_EQ(strtod(buffer, 0) * deg2rad, dec[i]);
+            ASSERT_EQ((double)i, I[i]);
+        }
+        oskar_sky_free(sky, &status);
+        remove(filename);
+    }
+
+    // Ten columns is an error.
+    {
+        FILE* file = fopen(filename, "w");
+        if (!file) FAIL() << "Unable to create test file";
+        fprintf(file, "1 2 3 4 5 6 7 8 9 10\n");
+        fclose(file);
+        oskar_Sky* sky = oskar_sky_load(filename, OSKAR_SINGLE, &status);
+        EXPECT_EQ((int)OSKAR_ERR_BAD_SKY_FILE, status);
+        EXPECT_TRUE(sky == 0);
+        status = 0;
+        remove(filename);
+    }
+}
+
 TEST(SkyModel, read_write)
 {
     oskar_Sky *sky, *sky2;
@@ -0,0 +1,79 @@
+/* Copyright (c) 2018, The University of Oxford. See LICENSE file. */
+
+/* Evaluates the non-zero bicubic B-splines at t[l] <= x < t[l+1]
+ * using the recurrence relation of de Boor and Cox (from fpbspl). */
+void oskar_dierckx_fpbspl_bicubic_REAL(global const REAL* restrict t,
+        const REAL x, const int l, REAL* h)
+{
+    REAL f, hh[3];
+    int i, j, li, lj;
+
+    h[0] = (REAL) 1;
+    for (j = 1; j <= 3; ++j)
+    {
+        for (i = 0; i < j; ++i) hh[i] = h[i];
+        h[0] = (REAL) 0;
+        for (i = 0; i < j; ++i)
+        {
+            li = l + i;
+            lj = li - j;
+            f = hh[i] / (t[li] - t[lj]);
+            h[i] += f * (t[li] - x);
+            h[i + 1] = f * (x - t[lj]);
+        }
+    }
+}
+
+kernel void dierckx_bispev_bicubic_REAL(global const REAL* restrict tx,
+        const int nx, global const REAL* restrict ty, const int ny,
+        global const REAL* restrict c, const int n,
+        global const REAL* restrict x, global const REAL* restrict y,
+        const int offset, const int stride, global REAL* restrict z)
+{
+    int j, l, l1, l2, nk1, lx;
+    REAL wx[4], wy[4], t, x_, y_;
+    const int i = get_global_id(0);
+    if (i >= n) return;
+    x_ = x[i];
+    y_ = y[i];
+
+    /* Do x. */
+    nk1 = nx - 4;
+    if (x_ < tx[3]) x_ = tx[3];
+    if (x_ > tx[nk1]) x_ = tx[nk1];
+    l = 4;
+    while (!(x_ < tx[l] || l == nk1)) l++;
+    oskar_dierckx_fpbspl_bicubic_REAL(tx, x_, l, wx);
+    lx = l - 4;
+
+    /* Do y. */
+    nk1 = ny - 4;
+    if (y_ < ty[3]) y_ = ty[3];
+    if (y_ > ty[nk1]) y_ = ty[nk1];
+    l = 4;
+    while (!(y_ < ty[l] || l == nk1)) l++;
+    oskar_dierckx_fpbspl_bicubic_REAL(ty, y_, l, wy);
+    l1 = lx * nk1 + (l - 4);
+
+    /* Evaluate surface using coefficients. */
+    t = (REAL) 0;
+    for (l = 0; l <= 3; ++l)
+    {
+        l2 = l1;
+        for (j = 0; j <= 3; ++j)
+        {
+            t += c[l2] * wx[l] * wy[j];
+            ++l2;
+        }
+        l1 += nk1;
+    }
+    z[offset + i * stride] = t;
+}
+
+kernel void dierckx_bispev_zeros_REAL(const int n, const int offset,
+        const int stride, global REAL* restrict z)
+{
+    const int i = get_global_id(0);
+    if (i >= n) return;
+    z[offset + i * stride] = (REAL) 0;
+}
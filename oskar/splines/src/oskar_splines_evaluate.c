@@ -30,6 +30,7 @@
 #include "splines/oskar_dierckx_bispev_bicubic_cuda.h"
 #include "splines/oskar_splines.h"
 #include "utility/oskar_device_utils.h"
+#include "utility/oskar_cl_utils.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -67,7 +68,89 @@ void oskar_splines_evaluate(oskar_Mem* output, int offset, int stride,
     ny = oskar_splines_num_knots_y_phi(spline);
 
     /* Check data type. */
-    if (type == OSKAR_SINGLE)
+    if (location & OSKAR_CL)
+    {
+#ifdef OSKAR_HAVE_OPENCL
+        cl_kernel k = 0;
+        cl_int error, n, off, str, nx_, ny_;
+        cl_uint arg = 0;
+        size_t global_size, local_size;
+        const oskar_Mem *tx, *ty, *coeff;
+        const int is_dbl = (type == OSKAR_DOUBLE);
+        int zeros;
+        if (type != OSKAR_SINGLE && type != OSKAR_DOUBLE)
+        {
+            *status = OSKAR_ERR_BAD_DATA_TYPE;
+            return;
+        }
+        tx = oskar_splines_knots_x_theta_const(spline);
+        ty = oskar_splines_knots_y_phi_const(spline);
+        coeff = oskar_splines_coeff_const(spline);
+        zeros = (nx == 0 || ny == 0 || !oskar_mem_allocated(tx) ||
+                !oskar_mem_allocated(ty) || !oskar_mem_allocated(coeff));
+        if (zeros)
+            k = oskar_cl_kernel(is_dbl ?
+                    "dierckx_bispev_zeros_double" :
+                    "dierckx_bispev_zeros_float");
+        else
+            k = oskar_cl_kernel(is_dbl ?
+                    "dierckx_bispev_bicubic_double" :
+                    "dierckx_bispev_bicubic_float");
+        if (!k)
+        {
+            *status = OSKAR_ERR_FUNCTION_NOT_AVAILABLE;
+            return;
+        }
+
+        /* Set kernel arguments. */
+        n = (cl_int) num_points;
+        off = (cl_int) offset;
+        str = (cl_int) stride;
+        nx_ = (cl_int) nx;
+        ny_ = (cl_int) ny;
+        if (zeros)
+        {
+            error = clSetKernelArg(k, arg++, sizeof(cl_int), &n);
+        }
+        else
+        {
+            error = clSetKernelArg(k, arg++, sizeof(cl_mem),
+                    oskar_mem_cl_buffer_const(tx, status));
+            error |= clSetKernelArg(k, arg++, sizeof(cl_int), &nx_);
+            error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                    oskar_mem_cl_buffer_const(ty, status));
+            error |= clSetKernelArg(k, arg++, sizeof(cl_int), &ny_);
+            error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                    oskar_mem_cl_buffer_const(coeff, status));
+            error |= clSetKernelArg(k, arg++, sizeof(cl_int), &n);
+            error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                    oskar_mem_cl_buffer_const(x, status));
+            error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                    oskar_mem_cl_buffer_const(y, status));
+        }
+        error |= clSetKernelArg(k, arg++, sizeof(cl_int), &off);
+        error |= clSetKernelArg(k, arg++, sizeof(cl_int), &str);
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer(output, status));
+        if (*status) return;
+        if (error != CL_SUCCESS)
+        {
+            *status = OSKAR_ERR_INVALID_ARGUMENT;
+            return;
+        }
+
+        /* Launch kernel on current command queue. */
+        local_size = oskar_cl_is_gpu() ? 256 : 128;
+        global_size = ((n + local_size - 1) / local_size) * local_size;
+        error = clEnqueueNDRangeKernel(oskar_cl_command_queue(), k, 1, NULL,
+                &global_size, &local_size, 0, NULL, NULL);
+        if (error != CL_SUCCESS)
+            *status = OSKAR_ERR_KERNEL_LAUNCH_FAILURE;
+#else
+        *status = OSKAR_ERR_OPENCL_NOT_AVAILABLE;
+#endif
+    }
+    else if (type == OSKAR_SINGLE)
     {
         const float *tx, *ty, *coeff, *x_, *y_;
         float *out;
@@ -315,6 +315,48 @@ int oskar_telescope_num_stations(const oskar_Telescope* model);
 OSKAR_EXPORT
 int oskar_telescope_identical_stations(const oskar_Telescope* model);
 
+/**
+ * @brief
+ * Returns the number of classes of identical stations.
+ *
+ * @details
+ * Returns the number of classes of identical stations.
+ *
+ * Stations in the same class have the same layout, element types,
+ * orientations, apodisation and errors, and therefore the same beam.
+ *
+ * Note that this value is only valid after calling
+ * oskar_telescope_analyse(). If the model has not been analysed,
+ * each station is in its own class.
+ *
+ * @param[in] model Pointer to telescope model.
+ *
+ * @return The number of station classes.
+ */
+OSKAR_EXPORT
+int oskar_telescope_num_station_classes(const oskar_Telescope* model);
+
+/**
+ * @brief
+ * Returns the class of the given station.
+ *
+ * @details
+ * Returns the index of the first station that is identical to the given
+ * station. This is the station index itself if no earlier station is
+ * identical to it.
+ *
+ * Note that this value is only valid after calling
+ * oskar_telescope_analyse().
+ *
+ * @param[in] model         Pointer to telescope model.
+ * @param[in] station_index Zero-based station index.
+ *
+ * @return The index of the first station in the same class.
+ */
+OSKAR_EXPORT
+int oskar_telescope_station_class(const oskar_Telescope* model,
+        int station_index);
+
 /**
  * @brief
  * Returns the flag specifying whether station beam duplication is enabled.
@@ -344,6 +386,21 @@ int oskar_telescope_allow_station_beam_duplication(
 OSKAR_EXPORT
 int oskar_telescope_enable_numerical_patterns(const oskar_Telescope* model);
 
+/**
+ * @brief
+ * Returns the number of threads used to load station directories.
+ *
+ * @details
+ * Returns the number of threads used by oskar_telescope_load() to load
+ * station directories. A value less than 1 means one thread per processor.
+ *
+ * @param[in] model   Pointer to telescope model.
+ *
+ * @return The number of threads.
+ */
+OSKAR_EXPORT
+int oskar_telescope_num_load_threads(const oskar_Telescope* model);
+
 /**
  * @brief
  * Returns the maximum number of elements in a station.
@@ -837,6 +894,21 @@ OSKAR_EXPORT
 void oskar_telescope_set_enable_numerical_patterns(oskar_Telescope* model,
         int value);
 
+/**
+ * @brief
+ * Sets the number of threads used to load station directories.
+ *
+ * @details
+ * Sets the number of threads used by oskar_telescope_load() to load
+ * station directories. A value less than 1 means one thread per processor.
+ * The loaded model does not depend on the number of threads.
+ *
+ * @param[in] model    Pointer to telescope model.
+ * @param[in] value    Number of threads to use.
+ */
+OSKAR_EXPORT
+void oskar_telescope_set_num_load_threads(oskar_Telescope* model, int value);
+
 /**
  * @brief
  * Sets the Gaussian station beam parameters.
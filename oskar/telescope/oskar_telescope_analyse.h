@@ -48,6 +48,9 @@ extern "C" {
  * stations are identical and whether element errors and/or weights
  * should be applied. The relevant flags within the structure are updated.
  *
+ * Stations are also grouped into classes of identical stations, so that
+ * station beams need to be evaluated only once per class.
+ *
  * @param[in,out] model Telescope model structure to analyse.
  * @param[in,out]  status   Status return code.
  */
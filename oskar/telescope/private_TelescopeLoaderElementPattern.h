@@ -30,7 +30,10 @@
 #define OSKAR_TELESCOPE_LOADER_ELEMENT_PATTERN_H_
 
 #include <telescope/oskar_TelescopeLoadAbstract.h>
+#include <utility/oskar_thread.h>
 
+#include <map>
+#include <string>
 #include <vector>
 
 class TelescopeLoaderElementPattern : public oskar_TelescopeLoadAbstract
@@ -49,6 +52,8 @@ public:
 private:
     void load_element_patterns(oskar_Station* station,
             const std::map<std::string, std::string>& filemap, int* status);
+    static void copy_element_patterns(oskar_Station* dst,
+            const oskar_Station* src, int* status);
     void load_fitted_data(int port, oskar_Station* station,
             const std::vector<std::string>& keys,
             const std::vector<std::string>& paths, int* status);
@@ -68,6 +73,11 @@ private:
     std::string root_x;
     std::string root_y;
     oskar_Telescope* telescope_;
+
+    // Stations already loaded, keyed by the list of files they used.
+    // Stations may be loaded concurrently, so this is guarded by the mutex.
+    std::map<std::string, const oskar_Station*> loaded_;
+    oskar_Mutex* mutex_;
 };
 
 #endif /* OSKAR_TELESCOPE_LOADER_ELEMENT_PATTERN_H_ */
@@ -74,8 +74,11 @@ struct oskar_Telescope
     int max_station_size;                             /* Maximum station size (number of elements) */
     int max_station_depth;                            /* Maximum station depth. */
     int identical_stations;                           /* True if all stations are identical. */
+    int num_station_classes;                          /* Number of classes of identical stations. */
+    int* station_class;                               /* Index of the first identical station, for each station. */
     int allow_station_beam_duplication;               /* True if station beam duplication is allowed. */
     int enable_numerical_patterns;                    /* True if numerical element patterns are enabled. */
+    int num_load_threads;                             /* Number of threads used to load stations (0 = auto). */
 };
 
 #ifndef OSKAR_TELESCOPE_TYPEDEF_
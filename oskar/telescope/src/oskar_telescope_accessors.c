@@ -134,6 +134,19 @@ int oskar_telescope_identical_stations(const oskar_Telescope* model)
     return model->identical_stations;
 }
 
+int oskar_telescope_num_station_classes(const oskar_Telescope* model)
+{
+    return model->station_class ?
+            model->num_station_classes : model->num_stations;
+}
+
+int oskar_telescope_station_class(const oskar_Telescope* model,
+        int station_index)
+{
+    return model->station_class ?
+            model->station_class[station_index] : station_index;
+}
+
 int oskar_telescope_allow_station_beam_duplication(
         const oskar_Telescope* model)
 {
@@ -145,6 +158,11 @@ int oskar_telescope_enable_numerical_patterns(const oskar_Telescope* model)
     return model->enable_numerical_patterns;
 }
 
+int oskar_telescope_num_load_threads(const oskar_Telescope* model)
+{
+    return model->num_load_threads;
+}
+
 int oskar_telescope_max_station_size(const oskar_Telescope* model)
 {
     return model->max_station_size;
@@ -342,6 +360,11 @@ void oskar_telescope_set_enable_numerical_patterns(oskar_Telescope* model,
     model->enable_numerical_patterns = value;
 }
 
+void oskar_telescope_set_num_load_threads(oskar_Telescope* model, int value)
+{
+    model->num_load_threads = value;
+}
+
 static void oskar_telescope_set_gaussian_station_beam_p(oskar_Station* station,
         double fwhm_rad, double ref_freq_hz)
 {
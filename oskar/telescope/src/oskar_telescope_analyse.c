@@ -27,11 +27,14 @@
  */
 
 #include "telescope/private_telescope.h"
+#include "telescope/station/private_station.h"
 #include "telescope/oskar_telescope.h"
 
 #include "telescope/station/oskar_station_analyse.h"
 #include "telescope/station/oskar_station_different.h"
 
+#include <stdlib.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -76,6 +79,120 @@ static void set_child_station_locations(oskar_Station* s,
 }
 
 
+#define FNV_OFFSET 2166136261u
+#define FNV_PRIME 16777619u
+
+static unsigned int hash_bytes(unsigned int h, const void* data, size_t size)
+{
+    size_t i;
+    const unsigned char* p = (const unsigned char*) data;
+    for (i = 0; i < size; ++i)
+    {
+        h ^= p[i];
+        h *= FNV_PRIME;
+    }
+    return h;
+}
+
+
+static unsigned int hash_mem(unsigned int h, const oskar_Mem* mem,
+        size_t num_elements)
+{
+    size_t length;
+    if (!mem) return h;
+    length = oskar_mem_length(mem);
+    if (num_elements > length) num_elements = length;
+    return hash_bytes(h, oskar_mem_void_const(mem),
+            num_elements * oskar_mem_element_size(oskar_mem_type(mem)));
+}
+
+
+/*
+ * Hashes the properties of the station that affect its beam.
+ * Identical stations always have the same hash, so the hash is used to
+ * find candidates for oskar_station_different() to check.
+ */
+static unsigned int hash_station(unsigned int h, const oskar_Station* s)
+{
+    int i, v[5];
+    const size_t n = (size_t) s->num_elements;
+    v[0] = s->station_type;
+    v[1] = s->num_elements;
+    v[2] = s->num_element_types;
+    v[3] = oskar_station_has_child(s);
+    v[4] = s->apply_element_errors;
+    h = hash_bytes(h, v, sizeof(v));
+    h = hash_mem(h, s->element_measured_x_enu_metres, n);
+    h = hash_mem(h, s->element_measured_y_enu_metres, n);
+    h = hash_mem(h, s->element_measured_z_enu_metres, n);
+    h = hash_mem(h, s->element_true_x_enu_metres, n);
+    h = hash_mem(h, s->element_true_y_enu_metres, n);
+    h = hash_mem(h, s->element_true_z_enu_metres, n);
+    h = hash_mem(h, s->element_gain, n);
+    h = hash_mem(h, s->element_phase_offset_rad, n);
+    h = hash_mem(h, s->element_weight, n);
+    h = hash_mem(h, s->element_x_alpha_cpu, n);
+    h = hash_mem(h, s->element_x_beta_cpu, n);
+    h = hash_mem(h, s->element_x_gamma_cpu, n);
+    h = hash_mem(h, s->element_y_alpha_cpu, n);
+    h = hash_mem(h, s->element_y_beta_cpu, n);
+    h = hash_mem(h, s->element_y_gamma_cpu, n);
+    h = hash_mem(h, s->element_types_cpu, n);
+    h = hash_mem(h, s->element_mount_types_cpu, n);
+    if (oskar_station_has_child(s))
+    {
+        for (i = 0; i < s->num_elements; ++i)
+            h = hash_station(h, oskar_station_child_const(s, i));
+    }
+    return h;
+}
+
+
+static void find_station_classes(oskar_Telescope* model,
+        int all_different, int* status)
+{
+    int i, j, num_classes = 0, num_stations;
+    unsigned int* hash;
+    num_stations = model->num_stations;
+    free(model->station_class);
+    model->station_class = (int*) calloc(num_stations, sizeof(int));
+    hash = (unsigned int*) calloc(num_stations, sizeof(unsigned int));
+    if (!model->station_class || !hash)
+    {
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+        free(hash);
+        return;
+    }
+
+    /* Each station is compared only with the first station of each class
+     * having the same hash. */
+    for (i = 0; i < num_stations; ++i)
+    {
+        const oskar_Station* s = oskar_telescope_station_const(model, i);
+        model->station_class[i] = i;
+        if (all_different)
+        {
+            num_classes++;
+            continue;
+        }
+        hash[i] = hash_station(FNV_OFFSET, s);
+        for (j = 0; j < i; ++j)
+        {
+            if (model->station_class[j] != j || hash[j] != hash[i]) continue;
+            if (!oskar_station_different(
+                    oskar_telescope_station_const(model, j), s, status))
+            {
+                model->station_class[i] = j;
+                break;
+            }
+        }
+        if (model->station_class[i] == i) num_classes++;
+    }
+    model->num_station_classes = num_classes;
+    free(hash);
+}
+
+
 void oskar_telescope_analyse(oskar_Telescope* model, int* status)
 {
     int i = 0, finished_identical_station_check = 0, num_stations;
@@ -106,24 +223,11 @@ void oskar_telescope_analyse(oskar_Telescope* model, int* status)
     /* Check if safe to proceed. */
     if (*status) return;
 
-    /* Check if we need to examine every station. */
-    if (finished_identical_station_check)
-    {
-        model->identical_stations = 0;
-    }
-    else
-    {
-        /* Check if the stations are different. */
-        for (i = 1; i < num_stations; ++i)
-        {
-            if (oskar_station_different(oskar_telescope_station(model, 0),
-                    oskar_telescope_station(model, i), status))
-            {
-                model->identical_stations = 0;
-                break;
-            }
-        }
-    }
+    /* Group the stations into classes of identical stations.
+     * If any station has random element errors, every station is
+     * different. */
+    find_station_classes(model, finished_identical_station_check, status);
+    if (model->num_station_classes > 1) model->identical_stations = 0;
 }
 
 #ifdef __cplusplus
@@ -69,8 +69,11 @@ oskar_Telescope* oskar_telescope_create(int type, int location,
     telescope->max_station_size = 0;
     telescope->max_station_depth = 1;
     telescope->identical_stations = 0;
+    telescope->num_station_classes = 0;
+    telescope->station_class = 0;
     telescope->allow_station_beam_duplication = 0;
     telescope->enable_numerical_patterns = 1;
+    telescope->num_load_threads = 0;
     telescope->lon_rad = 0.0;
     telescope->lat_rad = 0.0;
     telescope->alt_metres = 0.0;
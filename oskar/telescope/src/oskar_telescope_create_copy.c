@@ -30,6 +30,7 @@
 #include "telescope/oskar_telescope.h"
 
 #include <stdlib.h>
+#include <string.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -55,8 +56,22 @@ oskar_Telescope* oskar_telescope_create_copy(const oskar_Telescope* src,
     telescope->max_station_size = src->max_station_size;
     telescope->max_station_depth = src->max_station_depth;
     telescope->identical_stations = src->identical_stations;
+    telescope->num_station_classes = src->num_station_classes;
+    if (src->station_class)
+    {
+        telescope->station_class = (int*)
+                malloc(src->num_stations * sizeof(int));
+        if (!telescope->station_class)
+        {
+            *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+            return telescope;
+        }
+        memcpy(telescope->station_class, src->station_class,
+                src->num_stations * sizeof(int));
+    }
     telescope->allow_station_beam_duplication = src->allow_station_beam_duplication;
     telescope->enable_numerical_patterns = src->enable_numerical_patterns;
+    telescope->num_load_threads = src->num_load_threads;
     telescope->lon_rad = src->lon_rad;
     telescope->lat_rad = src->lat_rad;
     telescope->alt_metres = src->alt_metres;
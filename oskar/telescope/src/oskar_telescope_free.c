@@ -62,6 +62,7 @@ void oskar_telescope_free(oskar_Telescope* telescope, int* status)
 
     /* Free the station array. */
     free(telescope->station);
+    free(telescope->station_class);
 
     /* Free the structure itself. */
     free(telescope);
@@ -27,8 +27,11 @@
  */
 
 #include "telescope/oskar_telescope.h"
+#include "mem/oskar_mem.h"
 #include "utility/oskar_dir.h"
 #include "utility/oskar_get_error_string.h"
+#include "utility/oskar_get_num_procs.h"
+#include "utility/oskar_thread.h"
 #include "telescope/private_TelescopeLoaderApodisation.h"
 #include "telescope/private_TelescopeLoaderElementPattern.h"
 #include "telescope/private_TelescopeLoaderElementTypes.h"
@@ -52,7 +55,11 @@ using std::vector;
 static void load_directories(oskar_Telescope* telescope,
         const string& cwd, oskar_Station* station, int depth,
         const vector<oskar_TelescopeLoadAbstract*>& loaders,
-        map<string, string> filemap, oskar_Log* log, int* status);
+        map<string, string> filemap, string& error, int* status);
+static void load_stations(oskar_Telescope* telescope, const string& cwd,
+        int num_dirs, char** children,
+        const vector<oskar_TelescopeLoadAbstract*>& loaders,
+        const map<string, string>& filemap, string& error, int* status);
 
 extern "C"
 void oskar_telescope_load(oskar_Telescope* telescope, const char* path,
@@ -93,8 +100,11 @@ void oskar_telescope_load(oskar_Telescope* telescope, const char* path,
 
     // Load everything recursively from the telescope directory tree.
     map<string, string> filemap;
+    string error;
     load_directories(telescope, string(path), NULL, 0, loaders,
-            filemap, log, status);
+            filemap, error, status);
+    if (!error.empty())
+        oskar_log_error(log, "%s", error.c_str());
     if (*status)
     {
         oskar_log_error(log, "Failed to load telescope model (%s).",
@@ -118,7 +128,7 @@ void oskar_telescope_load(oskar_Telescope* telescope, const char* path,
 static void load_directories(oskar_Telescope* telescope,
         const string& cwd, oskar_Station* station, int depth,
         const vector<oskar_TelescopeLoadAbstract*>& loaders,
-        map<string, string> filemap, oskar_Log* log, int* status)
+        map<string, string> filemap, string& error, int* status)
 {
     int num_dirs = 0;
     char** children = 0;
@@ -138,9 +148,8 @@ static void load_directories(oskar_Telescope* telescope,
             loaders[i]->load(telescope, cwd, num_dirs, filemap, status);
             if (*status)
             {
-                string s = string("Error in ") + loaders[i]->name() +
+                error = string("Error in ") + loaders[i]->name() +
                         string(" in '") + cwd + string("'.");
-                oskar_log_error(log, "%s", s.c_str());
                 goto fail;
             }
         }
@@ -152,7 +161,7 @@ static void load_directories(oskar_Telescope* telescope,
             load_directories(telescope,
                     oskar_TelescopeLoadAbstract::get_path(cwd, children[0]),
                     oskar_telescope_station(telescope, 0), depth + 1,
-                    loaders, filemap, log, status);
+                    loaders, filemap, error, status);
 
             // Copy station 0 to all the others.
             oskar_telescope_duplicate_first_station(telescope, status);
@@ -166,15 +175,9 @@ static void load_directories(oskar_Telescope* telescope,
                 goto fail;
             }
 
-            // Loop over and descend into all stations.
-            for (int i = 0; i < num_dirs; ++i)
-            {
-                // Recursive call to load the station.
-                load_directories(telescope,
-                        oskar_TelescopeLoadAbstract::get_path(cwd, children[i]),
-                        oskar_telescope_station(telescope, i), depth + 1,
-                        loaders, filemap, log, status);
-            }
+            // Descend into all stations, using multiple threads.
+            load_stations(telescope, cwd, num_dirs, children, loaders,
+                    filemap, error, status);
         } // End check on number of directories.
     }
 
@@ -187,9 +190,8 @@ static void load_directories(oskar_Telescope* telescope,
             loaders[i]->load(station, cwd, num_dirs, depth, filemap, status);
             if (*status)
             {
-                string s = string("Error in ") + loaders[i]->name() +
+                error = string("Error in ") + loaders[i]->name() +
                         string(" in '") + cwd + string("'.");
-                oskar_log_error(log, "%s", s.c_str());
                 goto fail;
             }
         }
@@ -201,7 +203,7 @@ static void load_directories(oskar_Telescope* telescope,
             load_directories(telescope,
                     oskar_TelescopeLoadAbstract::get_path(cwd, children[0]),
                     oskar_station_child(station, 0), depth + 1, loaders,
-                    filemap, log, status);
+                    filemap, error, status);
 
             // Copy station 0 to all the others.
             oskar_station_duplicate_first_child(station, status);
@@ -222,7 +224,7 @@ static void load_directories(oskar_Telescope* telescope,
                 load_directories(telescope,
                         oskar_TelescopeLoadAbstract::get_path(cwd, children[i]),
                         oskar_station_child(station, i), depth + 1, loaders,
-                        filemap, log, status);
+                        filemap, error, status);
             }
         } // End check on number of directories.
     } // End check on depth.
@@ -231,3 +233,89 @@ fail:
     for (int i = 0; i < num_dirs; ++i) free(children[i]);
     free(children);
 }
+
+struct StationLoadArgs
+{
+    oskar_Telescope* telescope;
+    const string* cwd;
+    char** children;
+    const vector<oskar_TelescopeLoadAbstract*>* loaders;
+    const map<string, string>* filemap;
+    oskar_Mutex* mutex;
+    int num_dirs, next_dir, failed;
+    vector<string> error;
+    vector<int> status;
+};
+
+static void* load_stations_thread(void* arg)
+{
+    StationLoadArgs* a = (StationLoadArgs*) arg;
+    for (;;)
+    {
+        // Get the index of the next station directory to load.
+        oskar_mutex_lock(a->mutex);
+        const int i = a->failed ? a->num_dirs : a->next_dir++;
+        oskar_mutex_unlock(a->mutex);
+        if (i >= a->num_dirs) break;
+
+        // Recursive call to load the station.
+        load_directories(a->telescope,
+                oskar_TelescopeLoadAbstract::get_path(*a->cwd, a->children[i]),
+                oskar_telescope_station(a->telescope, i), 1, *a->loaders,
+                *a->filemap, a->error[i], &a->status[i]);
+        if (a->status[i])
+        {
+            oskar_mutex_lock(a->mutex);
+            a->failed = 1;
+            oskar_mutex_unlock(a->mutex);
+        }
+    }
+    oskar_mem_pool_clear();
+    return 0;
+}
+
+// Loads each top-level station directory into its own station model.
+// Directories are handed out in order, so the first failure (by index)
+// is the same one that a serial load would report.
+static void load_stations(oskar_Telescope* telescope, const string& cwd,
+        int num_dirs, char** children,
+        const vector<oskar_TelescopeLoadAbstract*>& loaders,
+        const map<string, string>& filemap, string& error, int* status)
+{
+    if (*status) return;
+    int num_threads = oskar_telescope_num_load_threads(telescope);
+    if (num_threads < 1) num_threads = oskar_get_num_procs();
+    if (num_threads > num_dirs) num_threads = num_dirs;
+    if (num_threads < 1) num_threads = 1;
+    StationLoadArgs args;
+    args.telescope = telescope;
+    args.cwd = &cwd;
+    args.children = children;
+    args.loaders = &loaders;
+    args.filemap = &filemap;
+    args.mutex = oskar_mutex_create();
+    args.num_dirs = num_dirs;
+    args.next_dir = 0;
+    args.failed = 0;
+    args.error.resize(num_dirs);
+    args.status.resize(num_dirs, 0);
+    vector<oskar_Thread*> threads(num_threads);
+    for (int i = 0; i < num_threads; ++i)
+        threads[i] = oskar_thread_create(load_stations_thread,
+                (void*)&args, 0);
+    for (int i = 0; i < num_threads; ++i)
+    {
+        oskar_thread_join(threads[i]);
+        oskar_thread_free(threads[i]);
+    }
+    oskar_mutex_free(args.mutex);
+    for (int i = 0; i < num_dirs; ++i)
+    {
+        if (args.status[i])
+        {
+            error = args.error[i];
+            *status = args.status[i];
+            break;
+        }
+    }
+}
@@ -108,6 +108,11 @@ void oskar_telescope_resize(oskar_Telescope* telescope, int size, int* status)
     oskar_mem_realloc(telescope->station_measured_z_enu_metres,
             size, status);
 
+    /* Station classes are no longer valid until the model is analysed. */
+    free(telescope->station_class);
+    telescope->station_class = 0;
+    telescope->num_station_classes = 0;
+
     /* Store the new size. */
     telescope->num_stations = size;
 }
@@ -48,10 +48,12 @@ TelescopeLoaderElementPattern::TelescopeLoaderElementPattern()
     fit_root_scalar = root_name + "_fit_scalar_";
     root_x = root_name + "_x_";
     root_y = root_name + "_y_";
+    mutex_ = oskar_mutex_create();
 }
 
 TelescopeLoaderElementPattern::~TelescopeLoaderElementPattern()
 {
+    oskar_mutex_free(mutex_);
 }
 
 void TelescopeLoaderElementPattern::load(oskar_Telescope* telescope,
@@ -151,8 +153,38 @@ void TelescopeLoaderElementPattern::load_element_patterns(
         }
     }
 
+    if (keys_fit_x.empty() && keys_fit_y.empty() && keys_fit_scalar.empty()
+            && keys_x.empty() && keys_y.empty())
+        return;
+
+    // Stations usually share the same files, inherited from a parent
+    // directory. If all the files used for this station have already been
+    // loaded for another one, copy the data from there instead.
+    const bool full_pol =
+            oskar_telescope_pol_mode(telescope_) == OSKAR_POL_MODE_FULL;
+    std::ostringstream signature;
+    signature << (full_pol ? "full" : "scalar") << '\n';
+    for (map<string, string>::const_iterator i = filemap.begin();
+            i != filemap.end(); ++i)
+    {
+        if (i->first.compare(0, root_name.size(), root_name) == 0)
+            signature << i->first << '\n' << i->second << '\n';
+    }
+    const oskar_Station* src = 0;
+    oskar_mutex_lock(mutex_);
+    map<string, const oskar_Station*>::const_iterator it =
+            loaded_.find(signature.str());
+    if (it != loaded_.end())
+        src = it->second;
+    oskar_mutex_unlock(mutex_);
+    if (src)
+    {
+        copy_element_patterns(station, src, status);
+        return;
+    }
+
     // Load fitted X, Y or scalar data.
-    if (oskar_telescope_pol_mode(telescope_) == OSKAR_POL_MODE_FULL)
+    if (full_pol)
     {
         load_fitted_data(1, station, keys_fit_x, paths_fit_x, status);
         load_fitted_data(2, station, keys_fit_y, paths_fit_y, status);
@@ -163,6 +195,24 @@ void TelescopeLoaderElementPattern::load_element_patterns(
     // Load functional data.
     load_functional_data(1, station, keys_x, paths_x, status);
     load_functional_data(2, station, keys_y, paths_y, status);
+    if (!*status)
+    {
+        oskar_mutex_lock(mutex_);
+        loaded_[signature.str()] = station;
+        oskar_mutex_unlock(mutex_);
+    }
+}
+
+void TelescopeLoaderElementPattern::copy_element_patterns(oskar_Station* dst,
+        const oskar_Station* src, int* status)
+{
+    const int num_types = oskar_station_num_element_types(src);
+    if (*status) return;
+    if (oskar_station_num_element_types(dst) < num_types)
+        oskar_station_resize_element_types(dst, num_types, status);
+    for (int i = 0; i < num_types; ++i)
+        oskar_element_copy(oskar_station_element(dst, i),
+                oskar_station_element_const(src, i), status);
 }
 
 void TelescopeLoaderElementPattern::load_fitted_data(int port,
@@ -139,8 +139,8 @@ void TelescopeLoaderNoise::set_noise_rms(oskar_Station* station,
     string filename;
     if (*status) return;
 
-    if (filemap.count(files_[RMS]))
-        filename = filemap.at(files_[RMS]);
+    if (filemap.count(files_.at(RMS)))
+        filename = filemap.at(files_.at(RMS));
 
     if (!filename.empty())
         oskar_mem_load_ascii(filename.c_str(), 1, status,
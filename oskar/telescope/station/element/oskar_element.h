@@ -92,6 +92,7 @@ enum OSKAR_ELEMENT_TAPER
 #include <telescope/station/element/oskar_element_different.h>
 #include <telescope/station/element/oskar_element_evaluate.h>
 #include <telescope/station/element/oskar_element_free.h>
+#include <telescope/station/element/oskar_element_fit_cache_path.h>
 #include <telescope/station/element/oskar_element_load.h>
 #include <telescope/station/element/oskar_element_load_cst.h>
 #include <telescope/station/element/oskar_element_load_scalar.h>
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2018, The University of Oxford
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the University of Oxford nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef OSKAR_ELEMENT_FIT_CACHE_PATH_H_
+#define OSKAR_ELEMENT_FIT_CACHE_PATH_H_
+
+/**
+ * @file oskar_element_fit_cache_path.h
+ */
+
+#include <oskar_global.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief
+ * Returns the name of a cache file for fitted element pattern data.
+ *
+ * @details
+ * Returns the pathname of a file in \p cache_dir that can be used to store
+ * the spline coefficients fitted to the element pattern data in
+ * \p filename.
+ *
+ * The file name is derived from the CRC-32C code of the contents of the
+ * input file, and from the parameters used for the fit, so any change to
+ * either of these will result in a different name. The cache file itself
+ * is written using oskar_element_write(), and read using
+ * oskar_element_read().
+ *
+ * The returned string must be freed using free() when no longer needed.
+ *
+ * @param[in]  cache_dir       Path to the cache directory.
+ * @param[in]  filename        Input data file name.
+ * @param[in]  port            Port number of the fitted data: 1 for X dipole;
+ *                             2 for Y dipole; 0 for scalar data.
+ * @param[in]  freq_hz         Frequency at which element data applies, in Hz.
+ * @param[in]  closeness       Target average fractional error of the fit.
+ * @param[in]  closeness_inc   Average fractional error factor increase.
+ * @param[in]  ignore_at_poles If set, data at the poles are ignored.
+ * @param[in]  ignore_below_horizon If set, data below the horizon are ignored.
+ * @param[in,out] status       Status return code.
+ *
+ * @return The pathname of the cache file.
+ */
+OSKAR_EXPORT
+char* oskar_element_fit_cache_path(const char* cache_dir,
+        const char* filename, int port, double freq_hz, double closeness,
+        double closeness_inc, int ignore_at_poles, int ignore_below_horizon,
+        int* status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OSKAR_ELEMENT_FIT_CACHE_PATH_H_ */
@@ -42,6 +42,20 @@ void oskar_element_copy(oskar_Element* dst, const oskar_Element* src,
     if (*status) return;
 
     dst->precision = src->precision;
+    dst->x_element_type = src->x_element_type;
+    dst->y_element_type = src->y_element_type;
+    dst->x_taper_type = src->x_taper_type;
+    dst->y_taper_type = src->y_taper_type;
+    dst->x_dipole_length_units = src->x_dipole_length_units;
+    dst->y_dipole_length_units = src->y_dipole_length_units;
+    dst->x_dipole_length = src->x_dipole_length;
+    dst->y_dipole_length = src->y_dipole_length;
+    dst->x_taper_cosine_power = src->x_taper_cosine_power;
+    dst->y_taper_cosine_power = src->y_taper_cosine_power;
+    dst->x_taper_gaussian_fwhm_rad = src->x_taper_gaussian_fwhm_rad;
+    dst->y_taper_gaussian_fwhm_rad = src->y_taper_gaussian_fwhm_rad;
+    dst->x_taper_ref_freq_hz = src->x_taper_ref_freq_hz;
+    dst->y_taper_ref_freq_hz = src->y_taper_ref_freq_hz;
     dst->element_type = src->element_type;
     dst->taper_type = src->taper_type;
     dst->cosine_power = src->cosine_power;
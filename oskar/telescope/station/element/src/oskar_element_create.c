@@ -38,7 +38,7 @@ oskar_Element* oskar_element_create(int precision, int location, int* status)
     oskar_Element* data = 0;
 
     /* Allocate and initialise the structure. */
-    data = (oskar_Element*) malloc(sizeof(oskar_Element));
+    data = (oskar_Element*) calloc(1, sizeof(oskar_Element));
     if (!data)
     {
         *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2018, The University of Oxford
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the University of Oxford nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "telescope/station/element/oskar_element.h"
+#include "binary/oskar_crc.h"
+#include "utility/oskar_dir.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BLOCK_SIZE 1048576
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+char* oskar_element_fit_cache_path(const char* cache_dir,
+        const char* filename, int port, double freq_hz, double closeness,
+        double closeness_inc, int ignore_at_poles, int ignore_below_horizon,
+        int* status)
+{
+    oskar_CRC* crc_data = 0;
+    unsigned long crc_file = 0, crc_par = 0;
+    size_t num_read, file_size = 0;
+    char *block = 0, par[256], name[64];
+    FILE* file;
+
+    /* Check if safe to proceed. */
+    if (*status) return 0;
+
+    /* Open the input file. */
+    file = fopen(filename, "rb");
+    if (!file)
+    {
+        *status = OSKAR_ERR_FILE_IO;
+        return 0;
+    }
+
+    /* Compute the CRC code of the file contents. */
+    crc_data = oskar_crc_create(OSKAR_CRC_32C);
+    block = (char*) malloc(BLOCK_SIZE);
+    if (!crc_data || !block)
+    {
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+        goto fail;
+    }
+    while ((num_read = fread(block, 1, BLOCK_SIZE, file)) > 0)
+    {
+        crc_file = (file_size == 0) ?
+                oskar_crc_compute(crc_data, block, num_read) :
+                oskar_crc_update(crc_data, crc_file, block, num_read);
+        file_size += num_read;
+    }
+
+    /* Compute the CRC code of the fit parameters.
+     * These are written as text, so the code does not depend on the
+     * byte order of the machine. */
+    sprintf(par, "%lu %d %.17g %.17g %.17g %d %d", (unsigned long) file_size,
+            port, freq_hz, closeness, closeness_inc,
+            ignore_at_poles, ignore_below_horizon);
+    crc_par = oskar_crc_compute(crc_data, par, strlen(par));
+
+    /* Construct the path name. */
+    sprintf(name, "element_fit_%08lx%08lx_%d.bin",
+            crc_file & 0xFFFFFFFFul, crc_par & 0xFFFFFFFFul, port);
+
+fail:
+    oskar_crc_free(crc_data);
+    free(block);
+    fclose(file);
+    return *status ? 0 : oskar_dir_get_path(cache_dir, name);
+}
+
+#ifdef __cplusplus
+}
+#endif
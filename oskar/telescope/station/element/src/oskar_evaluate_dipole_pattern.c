@@ -30,6 +30,7 @@
 #include "telescope/station/element/oskar_evaluate_dipole_pattern_cuda.h"
 #include "telescope/station/element/oskar_evaluate_dipole_pattern_inline.h"
 #include "utility/oskar_device_utils.h"
+#include "utility/oskar_cl_utils.h"
 #include "math/oskar_cmath.h"
 
 #define C_0 299792458.0
@@ -271,6 +272,81 @@ void oskar_evaluate_dipole_pattern(oskar_Mem* pattern, int num_points,
                     oskar_mem_double2(pattern, status) + offset);
         }
     }
+    else if (location & OSKAR_CL)
+    {
+#ifdef OSKAR_HAVE_OPENCL
+        cl_kernel k = 0;
+        cl_int error, num, off, str;
+        cl_uint i, arg = 0;
+        size_t global_size, local_size;
+        double par[2];
+        double kL;
+        if (type == OSKAR_SINGLE_COMPLEX_MATRIX)
+            k = oskar_cl_kernel("evaluate_dipole_pattern_float");
+        else if (type == OSKAR_DOUBLE_COMPLEX_MATRIX)
+            k = oskar_cl_kernel("evaluate_dipole_pattern_double");
+        else if (type == OSKAR_SINGLE_COMPLEX)
+            k = oskar_cl_kernel("evaluate_dipole_pattern_scalar_float");
+        else if (type == OSKAR_DOUBLE_COMPLEX)
+            k = oskar_cl_kernel("evaluate_dipole_pattern_scalar_double");
+        else
+        {
+            *status = OSKAR_ERR_BAD_DATA_TYPE;
+            return;
+        }
+        if (!k)
+        {
+            *status = OSKAR_ERR_FUNCTION_NOT_AVAILABLE;
+            return;
+        }
+
+        /* Set kernel arguments. */
+        kL = dipole_length_m * (M_PI * freq_hz / C_0);
+        off = (cl_int) offset;
+        str = (cl_int) stride;
+        num = (cl_int) num_points;
+        error = clSetKernelArg(k, arg++, sizeof(cl_int), &num);
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer_const(theta, status));
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer_const(phi, status));
+        par[0] = kL;
+        par[1] = cos(kL);
+        for (i = 0; i < 2; ++i)
+        {
+            if (precision == OSKAR_DOUBLE)
+            {
+                const cl_double t = (cl_double) par[i];
+                error |= clSetKernelArg(k, arg++, sizeof(cl_double), &t);
+            }
+            else
+            {
+                const cl_float t = (cl_float) par[i];
+                error |= clSetKernelArg(k, arg++, sizeof(cl_float), &t);
+            }
+        }
+        error |= clSetKernelArg(k, arg++, sizeof(cl_int), &off);
+        error |= clSetKernelArg(k, arg++, sizeof(cl_int), &str);
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer(pattern, status));
+        if (*status) return;
+        if (error != CL_SUCCESS)
+        {
+            *status = OSKAR_ERR_INVALID_ARGUMENT;
+            return;
+        }
+
+        /* Launch kernel on current command queue. */
+        local_size = oskar_cl_is_gpu() ? 256 : 128;
+        global_size = ((num + local_size - 1) / local_size) * local_size;
+        error = clEnqueueNDRangeKernel(oskar_cl_command_queue(), k, 1, NULL,
+                &global_size, &local_size, 0, NULL, NULL);
+        if (error != CL_SUCCESS)
+            *status = OSKAR_ERR_KERNEL_LAUNCH_FAILURE;
+#else
+        *status = OSKAR_ERR_OPENCL_NOT_AVAILABLE;
+#endif
+    }
 }
 
 #ifdef __cplusplus
@@ -0,0 +1,57 @@
+/* Copyright (c) 2018, The University of Oxford. See LICENSE file. */
+
+void oskar_dipole_pattern_inline_REAL(const REAL theta, const REAL phi,
+        const REAL kL, const REAL cos_kL, REAL2* E_theta, REAL2* E_phi)
+{
+    REAL sin_phi, cos_phi, sin_theta, cos_theta, t, denom;
+    sin_theta = sincos(theta, &cos_theta);
+    sin_phi = sincos(phi, &cos_phi);
+    denom = (REAL) 1 + cos_phi*cos_phi * (cos_theta*cos_theta - (REAL) 1);
+    if (denom == (REAL) 0)
+    {
+        /* Point is precisely at either end of the dipole. */
+        *E_theta = (REAL2)((REAL) 0, (REAL) 0);
+        *E_phi = (REAL2)((REAL) 0, (REAL) 0);
+        return;
+    }
+    t = (cos(kL * cos_phi * sin_theta) - cos_kL) / denom;
+    *E_theta = (REAL2)(-cos_phi * cos_theta * t, (REAL) 0);
+    *E_phi = (REAL2)(sin_phi * t, (REAL) 0);
+}
+
+kernel void evaluate_dipole_pattern_REAL(const int num_points,
+        global const REAL* restrict theta, global const REAL* restrict phi,
+        const REAL kL, const REAL cos_kL, const int offset, const int stride,
+        global REAL2* restrict pattern)
+{
+    REAL2 E_theta, E_phi;
+    const int i = get_global_id(0);
+    if (i >= num_points) return;
+    const int i_out = offset + i * stride;
+    oskar_dipole_pattern_inline_REAL(theta[i], phi[i], kL, cos_kL,
+            &E_theta, &E_phi);
+    pattern[i_out] = E_theta;
+    pattern[i_out + 1] = E_phi;
+}
+
+kernel void evaluate_dipole_pattern_scalar_REAL(const int num_points,
+        global const REAL* restrict theta, global const REAL* restrict phi,
+        const REAL kL, const REAL cos_kL, const int offset, const int stride,
+        global REAL2* restrict pattern)
+{
+    REAL2 a, b, c, d;
+    const int i = get_global_id(0);
+    if (i >= num_points) return;
+    const REAL theta_ = theta[i], phi_ = phi[i];
+
+    /* Evaluate E_theta, E_phi for both X and Y dipoles. */
+    oskar_dipole_pattern_inline_REAL(theta_, phi_, kL, cos_kL, &a, &b);
+    oskar_dipole_pattern_inline_REAL(theta_,
+            phi_ + (REAL) 1.57079632679489661923132169163975144,
+            kL, cos_kL, &c, &d);
+
+    /* Get sum of the diagonal of the autocorrelation matrix. */
+    const REAL amp = a.x * a.x + a.y * a.y + b.x * b.x + b.y * b.y +
+            c.x * c.x + c.y * c.y + d.x * d.x + d.y * d.y;
+    pattern[offset + i * stride] = (REAL2)(sqrt((REAL) 0.5 * amp), (REAL) 0);
+}
@@ -30,6 +30,7 @@
 #include "telescope/station/element/oskar_evaluate_geometric_dipole_pattern_cuda.h"
 #include "telescope/station/element/oskar_evaluate_geometric_dipole_pattern_inline.h"
 #include "utility/oskar_device_utils.h"
+#include "utility/oskar_cl_utils.h"
 #include "math/oskar_cmath.h"
 
 #ifdef __cplusplus
@@ -242,6 +243,65 @@ void oskar_evaluate_geometric_dipole_pattern(oskar_Mem* pattern, int num_points,
                     oskar_mem_double2(pattern, status) + offset);
         }
     }
+    else if (location & OSKAR_CL)
+    {
+#ifdef OSKAR_HAVE_OPENCL
+        cl_kernel k = 0;
+        cl_int error, num, off, str;
+        cl_uint arg = 0;
+        size_t global_size, local_size;
+        if (type == OSKAR_SINGLE_COMPLEX_MATRIX)
+            k = oskar_cl_kernel("evaluate_geometric_dipole_pattern_float");
+        else if (type == OSKAR_DOUBLE_COMPLEX_MATRIX)
+            k = oskar_cl_kernel("evaluate_geometric_dipole_pattern_double");
+        else if (type == OSKAR_SINGLE_COMPLEX)
+            k = oskar_cl_kernel(
+                    "evaluate_geometric_dipole_pattern_scalar_float");
+        else if (type == OSKAR_DOUBLE_COMPLEX)
+            k = oskar_cl_kernel(
+                    "evaluate_geometric_dipole_pattern_scalar_double");
+        else
+        {
+            *status = OSKAR_ERR_BAD_DATA_TYPE;
+            return;
+        }
+        if (!k)
+        {
+            *status = OSKAR_ERR_FUNCTION_NOT_AVAILABLE;
+            return;
+        }
+
+        /* Set kernel arguments. */
+        off = (cl_int) offset;
+        str = (cl_int) stride;
+        num = (cl_int) num_points;
+        error = clSetKernelArg(k, arg++, sizeof(cl_int), &num);
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer_const(theta, status));
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer_const(phi, status));
+        error |= clSetKernelArg(k, arg++, sizeof(cl_int), &off);
+        error |= clSetKernelArg(k, arg++, sizeof(cl_int), &str);
+        error |= clSetKernelArg(k, arg++, sizeof(cl_mem),
+                oskar_mem_cl_buffer(pattern, status));
+        if (*status) return;
+        if (error != CL_SUCCESS)
+        {
+            *status = OSKAR_ERR_INVALID_ARGUMENT;
+            return;
+        }
+
+        /* Launch kernel on current command queue. */
+        local_size = oskar_cl_is_gpu() ? 256 : 128;
+        global_size = ((num + local_size - 1) / local_size) * local_size;
+        error = clEnqueueNDRangeKernel(oskar_cl_command_queue(), k, 1, NULL,
+                &global_size, &local_size, 0, NULL, NULL);
+        if (error != CL_SUCCESS)
+            *status = OSKAR_ERR_KERNEL_LAUNCH_FAILURE;
+#else
+        *status = OSKAR_ERR_OPENCL_NOT_AVAILABLE;
+#endif
+    }
 }
 
 #ifdef __cplusplus
@@ -0,0 +1,46 @@
+/* Copyright (c) 2018, The University of Oxford. See LICENSE file. */
+
+void oskar_geometric_dipole_pattern_inline_REAL(const REAL theta,
+        const REAL phi, REAL2* E_theta, REAL2* E_phi)
+{
+    REAL sin_phi, cos_phi;
+    const REAL cos_theta = cos(theta);
+    sin_phi = sincos(phi, &cos_phi);
+    *E_theta = (REAL2)(cos_theta * cos_phi, (REAL) 0);
+    *E_phi = (REAL2)(-sin_phi, (REAL) 0);
+}
+
+kernel void evaluate_geometric_dipole_pattern_REAL(const int num_points,
+        global const REAL* restrict theta, global const REAL* restrict phi,
+        const int offset, const int stride, global REAL2* restrict pattern)
+{
+    REAL2 E_theta, E_phi;
+    const int i = get_global_id(0);
+    if (i >= num_points) return;
+    const int i_out = offset + i * stride;
+    oskar_geometric_dipole_pattern_inline_REAL(theta[i], phi[i],
+            &E_theta, &E_phi);
+    pattern[i_out] = E_theta;
+    pattern[i_out + 1] = E_phi;
+}
+
+kernel void evaluate_geometric_dipole_pattern_scalar_REAL(
+        const int num_points, global const REAL* restrict theta,
+        global const REAL* restrict phi, const int offset, const int stride,
+        global REAL2* restrict pattern)
+{
+    REAL2 a, b, c, d;
+    const int i = get_global_id(0);
+    if (i >= num_points) return;
+    const REAL theta_ = theta[i], phi_ = phi[i];
+
+    /* Evaluate E_theta, E_phi for both X and Y dipoles. */
+    oskar_geometric_dipole_pattern_inline_REAL(theta_, phi_, &a, &b);
+    oskar_geometric_dipole_pattern_inline_REAL(theta_,
+            phi_ + (REAL) 1.57079632679489661923132169163975144, &c, &d);
+
+    /* Get sum of the diagonal of the autocorrelation matrix. */
+    const REAL amp = a.x * a.x + a.y * a.y + b.x * b.x + b.y * b.y +
+            c.x * c.x + c.y * c.y + d.x * d.x + d.y * d.y;
+    pattern[offset + i * stride] = (REAL2)(sqrt((REAL) 0.5 * amp), (REAL) 0);
+}
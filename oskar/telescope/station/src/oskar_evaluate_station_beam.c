@@ -225,6 +225,12 @@ static void evaluate_station_beam_relative_directions(oskar_Mem* beam_pattern,
         }
         case OSKAR_STATION_TYPE_VLA_PBCOR:
         {
+            /* There is no OpenCL version of the VLA beam. */
+            if (oskar_mem_location(beam_pattern) & OSKAR_CL)
+            {
+                *status = OSKAR_ERR_FUNCTION_NOT_AVAILABLE;
+                break;
+            }
             oskar_evaluate_vla_beam_pbcor(beam_pattern, np, l, m, frequency_hz,
                     status);
             break;
@@ -276,6 +282,11 @@ static void evaluate_station_beam_enu_directions(oskar_Mem* beam_pattern,
         case OSKAR_STATION_TYPE_VLA_PBCOR:
         {
             oskar_Mem *l, *m, *n; /* Relative direction cosines */
+            if (oskar_mem_location(beam_pattern) & OSKAR_CL)
+            {
+                *status = OSKAR_ERR_FUNCTION_NOT_AVAILABLE;
+                break;
+            }
             l = oskar_station_work_enu_direction_x(work);
             m = oskar_station_work_enu_direction_y(work);
             n = oskar_station_work_enu_direction_z(work);
@@ -87,7 +87,9 @@ void oskar_evaluate_station_beam_aperture_array(oskar_Mem* beam,
             chunk_size = num_points - start;
             if (chunk_size > MAX_CHUNK_SIZE) chunk_size = MAX_CHUNK_SIZE;
 
-            /* Get pointers to start of chunk input data. */
+            /* Get pointers to start of chunk input data.
+             * Chunk offsets are multiples of 4096 bytes for any data type,
+             * so these aliases are also aligned OpenCL sub-buffers. */
             oskar_mem_set_alias(c_beam, beam, start, chunk_size, status);
             oskar_mem_set_alias(c_x, x, start, chunk_size, status);
             oskar_mem_set_alias(c_y, y, start, chunk_size, status);
@@ -196,7 +198,7 @@ static void oskar_evaluate_station_beam_aperture_array_private(oskar_Mem* beam,
         /* Can't separate array and element evaluation. */
         else
         {
-            int i, num_element_types;
+            int i, num_element_types, use_scratch;
             oskar_Mem *element_block = 0, *element = 0;
             const int* element_type_array = 0;
 
@@ -211,8 +213,16 @@ static void oskar_evaluate_station_beam_aperture_array_private(oskar_Mem* beam,
             element_block = oskar_station_work_beam(work, beam,
                     num_elements * num_points, 0, status);
 
-            /* Create alias into element block. */
-            element = oskar_mem_create_alias(element_block, 0, 0, status);
+            /* Create alias into element block.
+             * OpenCL sub-buffers must be aligned to the device base address,
+             * so for OpenCL memory each element response is evaluated into
+             * a scratch buffer and copied to its offset in the block. */
+            use_scratch = oskar_mem_location(element_block) & OSKAR_CL;
+            element = use_scratch ?
+                    oskar_mem_create(oskar_mem_type(element_block),
+                            oskar_mem_location(element_block), num_points,
+                            status) :
+                    oskar_mem_create_alias(element_block, 0, 0, status);
 
             /* Loop over elements and evaluate response for each. */
             element_type_array = oskar_station_element_types_cpu_const(s);
@@ -226,14 +236,18 @@ static void oskar_evaluate_station_beam_aperture_array_private(oskar_Mem* beam,
                     *status = OSKAR_ERR_OUT_OF_RANGE;
                     break;
                 }
-                oskar_mem_set_alias(element, element_block, i * num_points,
-                        num_points, status);
+                if (!use_scratch)
+                    oskar_mem_set_alias(element, element_block,
+                            i * num_points, num_points, status);
                 oskar_element_evaluate(
                         oskar_station_element_const(s, element_type_idx),
                         element,
                         oskar_station_element_x_alpha_rad(s, i) + M_PI/2.0, /* FIXME Will change: This matches the old convention. */
                         oskar_station_element_y_alpha_rad(s, i),
                         num_points, x, y, z, frequency_hz, theta, phi, status);
+                if (use_scratch)
+                    oskar_mem_copy_contents(element_block, element,
+                            i * num_points, 0, num_points, status);
             }
 
             /* Generate beamforming weights. */
@@ -249,7 +263,7 @@ static void oskar_evaluate_station_beam_aperture_array_private(oskar_Mem* beam,
                     weights, num_points, x, y, (is_3d ? z : 0),
                     element_block, beam, status);
 
-            /* Free element alias. */
+            /* Free element alias or scratch buffer. */
             oskar_mem_free(element, status);
 
             /* Normalise array response if required. */
@@ -301,21 +315,33 @@ static void oskar_evaluate_station_beam_aperture_array_private(oskar_Mem* beam,
         }
         else
         {
+            /* Set up the output buffer for each station.
+             * For OpenCL memory, use a scratch buffer, as sub-buffers
+             * must be aligned to the device base address. */
+            oskar_Mem* output;
+            const int use_scratch = oskar_mem_location(signal) & OSKAR_CL;
+            output = use_scratch ?
+                    oskar_mem_create(oskar_mem_type(signal),
+                            oskar_mem_location(signal), num_points, status) :
+                    oskar_mem_create_alias(0, 0, 0, status);
+
             /* Loop over child stations. */
             for (i = 0; i < num_elements; ++i)
             {
-                /* Set up the output buffer for this station. */
-                oskar_Mem* output;
-                output = oskar_mem_create_alias(signal, i * num_points,
-                        num_points, status);
+                if (!use_scratch)
+                    oskar_mem_set_alias(output, signal, i * num_points,
+                            num_points, status);
 
                 /* Recursive call. */
                 oskar_evaluate_station_beam_aperture_array_private(output,
                         oskar_station_child_const(s, i), num_points,
                         x, y, z, gast, frequency_hz, work, time_index,
                         depth + 1, status);
-                oskar_mem_free(output, status);
+                if (use_scratch)
+                    oskar_mem_copy_contents(signal, output, i * num_points,
+                            0, num_points, status);
             }
+            oskar_mem_free(output, status);
         }
 
         /* Generate beamforming weights and form beam from child stations. */
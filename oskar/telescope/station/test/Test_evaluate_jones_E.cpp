@@ -168,3 +168,174 @@ TEST(evaluate_jones_E, evaluate_e)
     ASSERT_EQ(0, error) << oskar_get_error_string(error);
 }
 
+
+
+TEST(evaluate_jones_E, station_classes)
+{
+    int error = 0;
+    const int num_stations = 6, num_antennas = 16, num_pts = 101;
+
+    // Construct a telescope model with two station layouts.
+    oskar_Telescope* tel = oskar_telescope_create(OSKAR_DOUBLE,
+            OSKAR_CPU, num_stations, &error);
+    for (int i = 0; i < num_stations; ++i)
+    {
+        oskar_Station* s = oskar_telescope_station(tel, i);
+        oskar_station_resize(s, num_antennas, &error);
+        oskar_station_resize_element_types(s, 1, &error);
+        oskar_station_set_position(s, 0.0, M_PI / 2.0, 0.0);
+        oskar_element_set_element_type(oskar_station_element(s, 0),
+                "Isotropic", &error);
+        double* x = oskar_mem_double(
+                oskar_station_element_measured_x_enu_metres(s), &error);
+        double* y = oskar_mem_double(
+                oskar_station_element_measured_y_enu_metres(s), &error);
+        for (int j = 0; j < num_antennas; ++j)
+        {
+            x[j] = 10.0 * (j % 4) * (1 + i % 2);
+            y[j] = 10.0 * (j / 4);
+        }
+    }
+    ASSERT_EQ(0, error) << oskar_get_error_string(error);
+    oskar_telescope_set_station_ids(tel);
+    oskar_telescope_set_phase_centre(tel,
+            OSKAR_SPHERICAL_TYPE_EQUATORIAL, 0.0, M_PI/2.0);
+    oskar_telescope_analyse(tel, &error);
+    ASSERT_EQ(0, error) << oskar_get_error_string(error);
+    EXPECT_FALSE(oskar_telescope_identical_stations(tel));
+    EXPECT_EQ(2, oskar_telescope_num_station_classes(tel));
+    for (int i = 0; i < num_stations; ++i)
+        EXPECT_EQ(i % 2, oskar_telescope_station_class(tel, i));
+
+    // Evaluate Jones E with and without station beam duplication.
+    oskar_Mem* l = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU, num_pts, &error);
+    oskar_Mem* m = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU, num_pts, &error);
+    oskar_Mem* n = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU, num_pts, &error);
+    oskar_evaluate_image_lmn_grid(10, 10, 30.0 * D2R, 30.0 * D2R,
+            0, l, m, n, &error);
+    oskar_Jones* E0 = oskar_jones_create(OSKAR_DOUBLE_COMPLEX_MATRIX,
+            OSKAR_CPU, num_stations, num_pts, &error);
+    oskar_Jones* E1 = oskar_jones_create(OSKAR_DOUBLE_COMPLEX_MATRIX,
+            OSKAR_CPU, num_stations, num_pts, &error);
+    oskar_StationWork* work = oskar_station_work_create(OSKAR_DOUBLE,
+            OSKAR_CPU, &error);
+    oskar_telescope_set_allow_station_beam_duplication(tel, OSKAR_FALSE);
+    oskar_evaluate_jones_E(E0, num_pts - 1, OSKAR_RELATIVE_DIRECTIONS,
+            l, m, n, tel, 0.0, 100e6, work, 0, &error);
+    oskar_telescope_set_allow_station_beam_duplication(tel, OSKAR_TRUE);
+    oskar_evaluate_jones_E(E1, num_pts - 1, OSKAR_RELATIVE_DIRECTIONS,
+            l, m, n, tel, 0.0, 100e6, work, 0, &error);
+    ASSERT_EQ(0, error) << oskar_get_error_string(error);
+    EXPECT_FALSE(oskar_mem_different(oskar_jones_mem(E0),
+            oskar_jones_mem(E1), 0, &error));
+
+    oskar_jones_free(E0, &error);
+    oskar_jones_free(E1, &error);
+    oskar_mem_free(l, &error);
+    oskar_mem_free(m, &error);
+    oskar_mem_free(n, &error);
+    oskar_station_work_free(work, &error);
+    oskar_telescope_free(tel, &error);
+    ASSERT_EQ(0, error) << oskar_get_error_string(error);
+}
+
+#ifdef OSKAR_HAVE_OPENCL
+TEST(evaluate_jones_E, hierarchical_multiple_types_CL)
+{
+    int error = 0;
+    const int num_stations = 3, num_tiles = 4, num_antennas = 8;
+    const int num_pts = 101;
+
+    // Construct a telescope model with non-identical tiles, each containing
+    // two element types.
+    oskar_Telescope* tel = oskar_telescope_create(OSKAR_DOUBLE,
+            OSKAR_CPU, num_stations, &error);
+    for (int i = 0; i < num_stations; ++i)
+    {
+        oskar_Station* s = oskar_telescope_station(tel, i);
+        oskar_station_resize(s, num_tiles, &error);
+        oskar_station_set_position(s, 0.0, M_PI / 2.0, 0.0);
+        oskar_station_create_child_stations(s, &error);
+        ASSERT_EQ(0, error) << oskar_get_error_string(error);
+        double* x = oskar_mem_double(
+                oskar_station_element_measured_x_enu_metres(s), &error);
+        for (int j = 0; j < num_tiles; ++j)
+        {
+            x[j] = 20.0 * j + 5.0 * i;
+            oskar_Station* c = oskar_station_child(s, j);
+            oskar_station_resize(c, num_antennas, &error);
+            oskar_station_resize_element_types(c, 2, &error);
+            ASSERT_EQ(0, error) << oskar_get_error_string(error);
+            oskar_element_set_element_type(oskar_station_element(c, 0),
+                    "Isotropic", &error);
+            oskar_element_set_element_type(oskar_station_element(c, 1),
+                    "Dipole", &error);
+            double* cx = oskar_mem_double(
+                    oskar_station_element_measured_x_enu_metres(c), &error);
+            double* cy = oskar_mem_double(
+                    oskar_station_element_measured_y_enu_metres(c), &error);
+            for (int k = 0; k < num_antennas; ++k)
+            {
+                cx[k] = 2.0 * (k % 4) + 0.5 * j;
+                cy[k] = 2.0 * (k / 4) * (1 + j % 2);
+                oskar_station_set_element_type(c, k, k % 2, &error);
+            }
+        }
+    }
+    ASSERT_EQ(0, error) << oskar_get_error_string(error);
+    oskar_telescope_set_station_ids(tel);
+    oskar_telescope_set_phase_centre(tel,
+            OSKAR_SPHERICAL_TYPE_EQUATORIAL, 0.0, M_PI/2.0);
+    oskar_telescope_analyse(tel, &error);
+    ASSERT_EQ(0, error) << oskar_get_error_string(error);
+    EXPECT_FALSE(oskar_station_identical_children(
+            oskar_telescope_station_const(tel, 0)));
+
+    // Evaluate Jones E on the CPU.
+    oskar_Mem* l = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU, num_pts, &error);
+    oskar_Mem* m = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU, num_pts, &error);
+    oskar_Mem* n = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU, num_pts, &error);
+    oskar_evaluate_image_lmn_grid(10, 10, 30.0 * D2R, 30.0 * D2R,
+            0, l, m, n, &error);
+    oskar_Jones* E = oskar_jones_create(OSKAR_DOUBLE_COMPLEX_MATRIX,
+            OSKAR_CPU, num_stations, num_pts, &error);
+    oskar_StationWork* work = oskar_station_work_create(OSKAR_DOUBLE,
+            OSKAR_CPU, &error);
+    oskar_evaluate_jones_E(E, num_pts - 1, OSKAR_RELATIVE_DIRECTIONS,
+            l, m, n, tel, 0.0, 100e6, work, 0, &error);
+    oskar_station_work_free(work, &error);
+    ASSERT_EQ(0, error) << oskar_get_error_string(error);
+
+    // Evaluate Jones E on the OpenCL device and compare.
+    oskar_Telescope* tel_cl = oskar_telescope_create_copy(tel,
+            OSKAR_CL, &error);
+    oskar_Mem* l_cl = oskar_mem_create_copy(l, OSKAR_CL, &error);
+    oskar_Mem* m_cl = oskar_mem_create_copy(m, OSKAR_CL, &error);
+    oskar_Mem* n_cl = oskar_mem_create_copy(n, OSKAR_CL, &error);
+    oskar_Jones* E_cl = oskar_jones_create(OSKAR_DOUBLE_COMPLEX_MATRIX,
+            OSKAR_CL, num_stations, num_pts, &error);
+    work = oskar_station_work_create(OSKAR_DOUBLE, OSKAR_CL, &error);
+    oskar_evaluate_jones_E(E_cl, num_pts - 1, OSKAR_RELATIVE_DIRECTIONS,
+            l_cl, m_cl, n_cl, tel_cl, 0.0, 100e6, work, 0, &error);
+    ASSERT_EQ(0, error) << oskar_get_error_string(error);
+    double max_err = 0.0, avg_err = 0.0;
+    oskar_mem_evaluate_relative_error(oskar_jones_mem_const(E_cl),
+            oskar_jones_mem_const(E), 0, &max_err, &avg_err, 0, &error);
+    ASSERT_EQ(0, error) << oskar_get_error_string(error);
+    EXPECT_LT(max_err, 1e-10);
+    EXPECT_LT(avg_err, 1e-10);
+    oskar_station_work_free(work, &error);
+    oskar_jones_free(E_cl, &error);
+    oskar_mem_free(l_cl, &error);
+    oskar_mem_free(m_cl, &error);
+    oskar_mem_free(n_cl, &error);
+    oskar_telescope_free(tel_cl, &error);
+
+    oskar_jones_free(E, &error);
+    oskar_mem_free(l, &error);
+    oskar_mem_free(m, &error);
+    oskar_mem_free(n, &error);
+    oskar_telescope_free(tel, &error);
+    ASSERT_EQ(0, error) << oskar_get_error_string(error);
+}
+#endif
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2018, The University of Oxford
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the University of Oxford nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "telescope/station/element/oskar_element.h"
+#include "utility/oskar_get_error_string.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+using std::string;
+
+static string cache_path(const char* filename, int port, double closeness)
+{
+    int status = 0;
+    char* p = oskar_element_fit_cache_path("cache", filename, port, 100e6,
+            closeness, 1.1, 0, 1, &status);
+    EXPECT_EQ(0, status) << oskar_get_error_string(status);
+    string s = p ? string(p) : string();
+    free(p);
+    return s;
+}
+
+TEST(element_fit_cache, path)
+{
+    const char* filename = "temp_test_element_fit_cache.txt";
+    FILE* f = fopen(filename, "w");
+    ASSERT_TRUE(f != NULL);
+    fprintf(f, "0 0 1 0\n90 0 0 0\n");
+    fclose(f);
+
+    // The same input must give the same name.
+    string a = cache_path(filename, 0, 0.005);
+    ASSERT_FALSE(a.empty());
+    EXPECT_EQ(a, cache_path(filename, 0, 0.005));
+
+    // Different fit parameters must give a different name.
+    EXPECT_NE(a, cache_path(filename, 1, 0.005));
+    EXPECT_NE(a, cache_path(filename, 0, 0.01));
+
+    // Different file contents must give a different name.
+    f = fopen(filename, "w");
+    ASSERT_TRUE(f != NULL);
+    fprintf(f, "0 0 1 0\n90 0 0.5 0\n");
+    fclose(f);
+    EXPECT_NE(a, cache_path(filename, 0, 0.005));
+    remove(filename);
+
+    // A missing file is an error.
+    int status = 0;
+    char* p = oskar_element_fit_cache_path("cache", filename, 0, 100e6,
+            0.005, 1.1, 0, 1, &status);
+    EXPECT_EQ((int) OSKAR_ERR_FILE_IO, status);
+    EXPECT_TRUE(p == NULL);
+}
@@ -30,9 +30,11 @@
 
 #include "utility/oskar_dir.h"
 #include "utility/oskar_get_error_string.h"
+#include "log/oskar_log.h"
 #include "mem/oskar_mem.h"
 #include "telescope/oskar_telescope.h"
 
+#include <cmath>
 #include <cstdio>
 #include <cstdlib>
 #include <vector>
@@ -41,6 +43,8 @@ using std::vector;
 
 static void generate_noisy_telescope(const char* dir, int num_stations,
         const vector<double>& freqs, const vector<double>& noise);
+static void generate_multi_station_telescope(const char* dir,
+        int num_stations, int num_elements);
 
 TEST(telescope_model_load_save, test_0_level)
 {
@@ -583,3 +587,163 @@ static void generate_noisy_telescope(const char* dir, int num_stations,
     }
 }
 
+
+static void write_element_fit(const char* dir, const char* name,
+        double scale)
+{
+    int err = 0;
+    const char* pattern_file = "temp_test_element_pattern.txt";
+    FILE* f = fopen(pattern_file, "w");
+    for (int theta = 0; theta <= 90; theta += 10)
+    {
+        for (int phi = 0; phi < 360; phi += 10)
+        {
+            const double amp = scale * cos(theta * M_PI / 180.0) *
+                    (1.0 + 0.1 * cos(phi * M_PI / 180.0));
+            fprintf(f, "%d %d %.6f 0\n", theta, phi, amp);
+        }
+    }
+    fclose(f);
+    oskar_Log* log = oskar_log_create(OSKAR_LOG_NONE, OSKAR_LOG_NONE);
+    oskar_log_set_keep_file(log, 0);
+    oskar_Element* e = oskar_element_create(OSKAR_DOUBLE, OSKAR_CPU, &err);
+    oskar_element_load_scalar(e, log, 100e6, pattern_file, 0.02, 2.0, 0, 0,
+            &err);
+    char* path = oskar_dir_get_path(dir, name);
+    oskar_element_write(e, log, path, 0, 100e6, &err);
+    ASSERT_EQ(0, err) << oskar_get_error_string(err);
+    free(path);
+    oskar_element_free(e, &err);
+    oskar_log_free(log);
+    remove(pattern_file);
+}
+
+
+static void generate_multi_station_telescope(const char* dir,
+        int num_stations, int num_elements)
+{
+    FILE* f;
+    char* path;
+    char station_name[32];
+
+    // Write the top-level files, with shared noise and element pattern data.
+    vector<double> freqs(3), noise(3);
+    for (int i = 0; i < 3; ++i)
+    {
+        freqs[i] = 100e6 + i * 10e6;
+        noise[i] = 1.0 + i * 0.5;
+    }
+    generate_noisy_telescope(dir, num_stations, freqs, noise);
+    path = oskar_dir_get_path(dir, "layout.txt");
+    f = fopen(path, "w");
+    for (int i = 0; i < num_stations; ++i)
+        fprintf(f, "%.1f,%.1f\n", 100.0 * i, 50.0 * (i % 3));
+    fclose(f);
+    free(path);
+    write_element_fit(dir, "element_pattern_fit_scalar_0_100.bin", 1.0);
+
+    // Write the station directories.
+    for (int i = 0; i < num_stations; ++i)
+    {
+        sprintf(station_name, "station%03d", i);
+        char* station_dir = oskar_dir_get_path(dir, station_name);
+        oskar_dir_mkpath(station_dir);
+        path = oskar_dir_get_path(station_dir, "layout.txt");
+        f = fopen(path, "w");
+        for (int j = 0; j < num_elements; ++j)
+            fprintf(f, "%.2f,%.2f\n", j * 1.5 + i * 0.1, (j % 4) * 2.0);
+        fclose(f);
+        free(path);
+        path = oskar_dir_get_path(station_dir, "gain_phase.txt");
+        f = fopen(path, "w");
+        for (int j = 0; j < num_elements; ++j)
+            fprintf(f, "%.3f,%.3f,%.3f,%.3f\n", 1.0 + 0.01 * (i + j),
+                    (double)(i * j % 7), 0.01 * (i % 2), 0.5 * (j % 3));
+        fclose(f);
+        free(path);
+
+        // Override the noise and the element pattern in some stations.
+        if (i % 3 == 1)
+        {
+            path = oskar_dir_get_path(station_dir, "rms.txt");
+            f = fopen(path, "w");
+            for (int j = 0; j < 3; ++j) fprintf(f, "%.2f\n", 2.0 + i + j);
+            fclose(f);
+            free(path);
+        }
+        if (i % 4 == 2)
+            write_element_fit(station_dir,
+                    "element_pattern_fit_scalar_0_100.bin", 0.5);
+        free(station_dir);
+    }
+}
+
+
+TEST(telescope_model_load_save, test_load_multi_threaded)
+{
+    const char* root = "temp_test_telescope_multi_threaded";
+    const int num_stations = 12, num_elements = 10;
+    const int num_threads[] = {1, 3, 16};
+    oskar_Telescope* tel[3];
+    int err = 0;
+    generate_multi_station_telescope(root, num_stations, num_elements);
+
+    // Load the model serially and using several threads.
+    for (int t = 0; t < 3; ++t)
+    {
+        tel[t] = oskar_telescope_create(OSKAR_DOUBLE, OSKAR_CPU, 0, &err);
+        oskar_telescope_set_pol_mode(tel[t], "Scalar", &err);
+        oskar_telescope_set_enable_noise(tel[t], 1, 1);
+        oskar_telescope_set_num_load_threads(tel[t], num_threads[t]);
+        EXPECT_EQ(num_threads[t], oskar_telescope_num_load_threads(tel[t]));
+        oskar_telescope_load(tel[t], root, NULL, &err);
+        ASSERT_EQ(0, err) << oskar_get_error_string(err);
+        ASSERT_EQ(num_stations, oskar_telescope_num_stations(tel[t]));
+    }
+
+    // Check the serially-loaded model has all the parts.
+    for (int i = 0; i < num_stations; ++i)
+    {
+        const oskar_Station* s = oskar_telescope_station_const(tel[0], i);
+        const oskar_Mem* rms = oskar_station_noise_rms_jy_const(s);
+        ASSERT_EQ(num_elements, oskar_station_num_elements(s));
+        ASSERT_EQ(3, (int)oskar_mem_length(rms));
+        EXPECT_DOUBLE_EQ((i % 3 == 1) ? 2.0 + i : 1.0,
+                oskar_mem_double_const(rms, &err)[0]);
+        ASSERT_TRUE(oskar_station_has_element(s));
+        EXPECT_EQ(1, oskar_element_num_freq(oskar_station_element_const(s, 0)));
+    }
+    EXPECT_TRUE(oskar_element_different(
+            oskar_station_element_const(
+                    oskar_telescope_station_const(tel[0], 0), 0),
+            oskar_station_element_const(
+                    oskar_telescope_station_const(tel[0], 2), 0), &err));
+
+    // Check the models loaded using several threads are identical.
+    for (int t = 1; t < 3; ++t)
+    {
+        EXPECT_FALSE(oskar_mem_different(
+                oskar_telescope_station_true_x_enu_metres_const(tel[0]),
+                oskar_telescope_station_true_x_enu_metres_const(tel[t]),
+                0, &err));
+        EXPECT_FALSE(oskar_mem_different(
+                oskar_telescope_station_true_y_enu_metres_const(tel[0]),
+                oskar_telescope_station_true_y_enu_metres_const(tel[t]),
+                0, &err));
+        for (int i = 0; i < num_stations; ++i)
+        {
+            const oskar_Station* a = oskar_telescope_station_const(tel[0], i);
+            const oskar_Station* b = oskar_telescope_station_const(tel[t], i);
+            EXPECT_FALSE(oskar_station_different(a, b, &err))
+                    << "Station " << i << ", " << num_threads[t] << " threads";
+            EXPECT_FALSE(oskar_element_different(
+                    oskar_station_element_const(a, 0),
+                    oskar_station_element_const(b, 0), &err))
+                    << "Station " << i << ", " << num_threads[t] << " threads";
+        }
+        ASSERT_EQ(0, err) << oskar_get_error_string(err);
+    }
+
+    for (int t = 0; t < 3; ++t) oskar_telescope_free(tel[t], &err);
+    oskar_dir_remove(root);
+}
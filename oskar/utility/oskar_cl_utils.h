@@ -89,6 +89,10 @@ unsigned int oskar_cl_get_device(void);
  * If either parameter is NULL, the values are checked from the
  * environment variables OSKAR_CL_DEVICE_TYPE and OSKAR_CL_DEVICE_VENDOR.
  *
+ * The devices are shared by all threads, so memory allocated by one thread
+ * can be used by another. The current device is selected separately
+ * in each thread using oskar_cl_set_device().
+ *
  * @param[in] device_type    String containing required device type
  *                           (GPU, CPU or Accelerator). May be NULL.
  * @param[in] device_vendor  String containing required device vendor name.
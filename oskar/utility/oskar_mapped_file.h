@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2018, The University of Oxford
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the University of Oxford nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef OSKAR_MAPPED_FILE_H_
+#define OSKAR_MAPPED_FILE_H_
+
+/**
+ * @file oskar_mapped_file.h
+ */
+
+#include <oskar_global.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct oskar_MappedFile;
+#ifndef OSKAR_MAPPED_FILE_TYPEDEF_
+#define OSKAR_MAPPED_FILE_TYPEDEF_
+typedef struct oskar_MappedFile oskar_MappedFile;
+#endif /* OSKAR_MAPPED_FILE_TYPEDEF_ */
+
+/**
+ * @brief Maps the contents of a file into memory.
+ *
+ * @details
+ * Maps the whole of the named file into memory. The file is opened
+ * read-only, but the mapping is private and writable (copy-on-write),
+ * so that arrays held in the file can be modified in place:
+ * pages are shared with the file system cache until they are modified,
+ * and modifications are never written back to the file.
+ * On systems without memory mapping, or if the mapping fails,
+ * the contents of the file are read into memory instead.
+ *
+ * @param[in] filename     Path of the file to open.
+ * @param[in,out] status   Status return code.
+ *
+ * @return A handle to the mapped file.
+ */
+OSKAR_EXPORT
+oskar_MappedFile* oskar_mapped_file_create(const char* filename, int* status);
+
+/**
+ * @brief Returns a pointer to the contents of a mapped file.
+ *
+ * @details
+ * The returned memory is not NUL-terminated. It may be modified, but
+ * changes are private to the process.
+ *
+ * @param[in] file  Handle to the mapped file.
+ */
+OSKAR_EXPORT
+char* oskar_mapped_file_data(const oskar_MappedFile* file);
+
+/**
+ * @brief Returns the size of a mapped file, in bytes.
+ *
+ * @param[in] file  Handle to the mapped file.
+ */
+OSKAR_EXPORT
+size_t oskar_mapped_file_size(const oskar_MappedFile* file);
+
+/**
+ * @brief Unmaps and closes a mapped file.
+ *
+ * @param[in] file  Handle to the mapped file.
+ */
+OSKAR_EXPORT
+void oskar_mapped_file_free(oskar_MappedFile* file);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OSKAR_MAPPED_FILE_H_ */
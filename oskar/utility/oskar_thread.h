@@ -42,9 +42,11 @@ extern "C" {
 struct oskar_Mutex;
 struct oskar_Thread;
 struct oskar_Barrier;
+struct oskar_Scheduler;
 typedef struct oskar_Mutex oskar_Mutex;
 typedef struct oskar_Thread oskar_Thread;
 typedef struct oskar_Barrier oskar_Barrier;
+typedef struct oskar_Scheduler oskar_Scheduler;
 
 /**
  * @brief Creates a mutex.
@@ -163,6 +165,137 @@ void oskar_barrier_set_num_threads(oskar_Barrier* barrier, int num_threads);
 OSKAR_EXPORT
 int oskar_barrier_wait(oskar_Barrier* barrier);
 
+/**
+ * @brief Creates a work-stealing task scheduler.
+ *
+ * @details
+ * Creates a work-stealing task scheduler.
+ *
+ * The work is divided into a sequence of blocks, each containing a number
+ * of tasks identified by their index within the block. When the scheduler
+ * is reset, the tasks in each block are divided into contiguous ranges,
+ * one per thread. Each thread takes tasks from the front of its own range,
+ * and when that is empty, it steals the back half of the range belonging
+ * to another thread, so that no thread is left idle while work remains
+ * in the block.
+ *
+ * The scheduler also tracks when each block has been finished by all
+ * threads, and when it has been released by its consumer, so that
+ * pipelined producer and consumer threads can be synchronised on a
+ * per-block basis instead of using a barrier.
+ *
+ * The scheduler contains no blocks until oskar_scheduler_reset() is called.
+ */
+OSKAR_EXPORT
+oskar_Scheduler* oskar_scheduler_create(void);
+
+/**
+ * @brief Destroys the scheduler.
+ *
+ * @details
+ * Destroys the scheduler.
+ *
+ * @param[in,out] scheduler Pointer to scheduler.
+ */
+OSKAR_EXPORT
+void oskar_scheduler_free(oskar_Scheduler* scheduler);
+
+/**
+ * @brief Resets the scheduler with a new set of tasks.
+ *
+ * @details
+ * Resets the scheduler with a new set of tasks, and divides the tasks in
+ * each block evenly between the threads.
+ *
+ * This must not be called while any thread is using the scheduler.
+ *
+ * @param[in,out] scheduler  Pointer to scheduler.
+ * @param[in] num_threads    Number of threads taking tasks.
+ * @param[in] num_blocks     Number of blocks.
+ * @param[in] num_tasks      Number of tasks in each block (length num_blocks).
+ */
+OSKAR_EXPORT
+void oskar_scheduler_reset(oskar_Scheduler* scheduler, int num_threads,
+        int num_blocks, const int* num_tasks);
+
+/**
+ * @brief Returns the next task in the block for the given thread.
+ *
+ * @details
+ * Returns the index of the next task in the block for the given thread,
+ * stealing tasks from other threads if necessary.
+ *
+ * Each task in a block is returned exactly once.
+ *
+ * @param[in,out] scheduler  Pointer to scheduler.
+ * @param[in] thread_id      Zero-based index of the calling thread.
+ * @param[in] block_index    Zero-based block index.
+ * @param[out] task_index    Index of the task within the block.
+ *
+ * @return 1 if a task was returned, or 0 if no tasks remain in the block.
+ */
+OSKAR_EXPORT
+int oskar_scheduler_next(oskar_Scheduler* scheduler, int thread_id,
+        int block_index, int* task_index);
+
+/**
+ * @brief Marks the block as finished by the calling thread.
+ *
+ * @details
+ * Marks the block as finished by the calling thread.
+ *
+ * This should be called once per thread for each block.
+ *
+ * @param[in,out] scheduler  Pointer to scheduler.
+ * @param[in] block_index    Zero-based block index.
+ */
+OSKAR_EXPORT
+void oskar_scheduler_finish_block(oskar_Scheduler* scheduler,
+        int block_index);
+
+/**
+ * @brief Waits until all threads have finished the block.
+ *
+ * @details
+ * Blocks the caller until oskar_scheduler_finish_block() has been called
+ * by all threads for the given block.
+ *
+ * @param[in,out] scheduler  Pointer to scheduler.
+ * @param[in] block_index    Zero-based block index.
+ */
+OSKAR_EXPORT
+void oskar_scheduler_wait_finished(oskar_Scheduler* scheduler,
+        int block_index);
+
+/**
+ * @brief Marks the block as released by its consumer.
+ *
+ * @details
+ * Marks the block, and all blocks before it, as released by its consumer.
+ *
+ * @param[in,out] scheduler  Pointer to scheduler.
+ * @param[in] block_index    Zero-based block index.
+ */
+OSKAR_EXPORT
+void oskar_scheduler_release_block(oskar_Scheduler* scheduler,
+        int block_index);
+
+/**
+ * @brief Waits until the block has been released by its consumer.
+ *
+ * @details
+ * Blocks the caller until oskar_scheduler_release_block() has been called
+ * for the given block (or a later one).
+ *
+ * Returns immediately if the block index is negative.
+ *
+ * @param[in,out] scheduler  Pointer to scheduler.
+ * @param[in] block_index    Zero-based block index.
+ */
+OSKAR_EXPORT
+void oskar_scheduler_wait_released(oskar_Scheduler* scheduler,
+        int block_index);
+
 #ifdef __cplusplus
 }
 #endif
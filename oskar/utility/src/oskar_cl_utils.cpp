@@ -57,7 +57,7 @@ string find_replace(string subject, const string& search, const string& replace)
 
 struct CLGlobal
 {
-    unsigned int current_device;
+    int initialised;
 
     struct CLDevice
     {
@@ -110,7 +110,7 @@ struct CLGlobal
     // Data stored per device.
     vector<CLDevice*> device;
 
-    CLGlobal() : current_device(0) {}
+    CLGlobal() : initialised(0) {}
 
     ~CLGlobal()
     {
@@ -130,18 +130,18 @@ struct CLGlobal
 
 using namespace oskar;
 
-// Thread-local OpenCL data.
-// This cannot be a non-pointer type.
+// OpenCL devices are shared by all threads, so that memory allocated
+// by one thread can be used by kernels launched from another (as for CUDA).
+static CLGlobal* oskar_cl_ = 0;
+
+// Thread-local index of the current device.
 static
 #ifdef OSKAR_OS_WIN
 __declspec(thread)
 #else
 __thread
 #endif
-CLGlobal* oskar_cl_ = 0;
-
-// Global pointers to all thread-local objects.
-static vector<oskar::CLGlobal*> oskar_cl_all_;
+unsigned int oskar_cl_current_device_ = 0;
 
 struct LocalMutex
 {
@@ -165,37 +165,46 @@ struct LocalMutex
 };
 static LocalMutex mutex;
 
+// Must be called with the mutex locked.
+static void oskar_cl_init_devices(const char* device_type,
+        const char* device_vendor);
+
 void oskar_cl_ensure(int no_init)
 {
+    mutex.lock();
     if (!oskar_cl_)
-    {
-        // Allocate structure and store a pointer to it so it can be
-        // accessed by oskar_cl_free().
         oskar_cl_ = new oskar::CLGlobal();
-        mutex.lock();
-        oskar_cl_all_.push_back(oskar_cl_);
-        mutex.unlock();
-    }
-    if (oskar_cl_->device.size() == 0 && !no_init)
-        oskar_cl_init(NULL, NULL);
+    if (!oskar_cl_->initialised && !no_init)
+        oskar_cl_init_devices(NULL, NULL);
+    mutex.unlock();
 }
 
 void oskar_cl_free(void)
 {
     mutex.lock();
-    for (size_t i = 0; i < oskar_cl_all_.size(); ++i)
-        delete oskar_cl_all_[i];
-    oskar_cl_all_.clear();
+    delete oskar_cl_;
+    oskar_cl_ = 0;
     mutex.unlock();
 }
 
 void oskar_cl_init(const char* device_type, const char* device_vendor)
 {
+    oskar_cl_ensure(1);
+    mutex.lock();
+    oskar_cl_init_devices(device_type, device_vendor);
+    mutex.unlock();
+}
+
+static void oskar_cl_init_devices(const char* device_type,
+        const char* device_vendor)
+{
+    // Clear any existing contexts.
+    oskar_cl_->clear();
+    oskar_cl_->initialised = 1;
 #ifdef OSKAR_HAVE_OPENCL
     cl_uint num_platforms = 0;
     cl_device_type dev_type = CL_DEVICE_TYPE_ALL;
     cl_int error = 0;
-    oskar_cl_ensure(1);
 
     // Get environment variables if parameters not given.
     if (!device_type || strlen(device_type) == 0)
@@ -233,14 +242,8 @@ void oskar_cl_init(const char* device_type, const char* device_vendor)
         }
     }
 
-    // Clear any existing contexts.
-    oskar_cl_->clear();
-
     // Get the OpenCL platform IDs.
-    // The first OpenCL call doesn't seem to be thread-safe.
-    mutex.lock();
     error = clGetPlatformIDs(0, 0, &num_platforms);
-    mutex.unlock();
     if (num_platforms == 0)
     {
         fprintf(stderr, "No OpenCL platforms found.\n");
@@ -432,28 +435,28 @@ void oskar_cl_init(const char* device_type, const char* device_vendor)
 cl_command_queue oskar_cl_command_queue(void)
 {
     oskar_cl_ensure(0);
-    unsigned int i = oskar_cl_->current_device;
+    unsigned int i = oskar_cl_current_device_;
     return i < oskar_cl_->device.size() ? oskar_cl_->device[i]->queue : 0;
 }
 
 cl_context oskar_cl_context(void)
 {
     oskar_cl_ensure(0);
-    unsigned int i = oskar_cl_->current_device;
+    unsigned int i = oskar_cl_current_device_;
     return i < oskar_cl_->device.size() ? oskar_cl_->device[i]->context : 0;
 }
 
 cl_device_id oskar_cl_device_id(void)
 {
     oskar_cl_ensure(0);
-    unsigned int i = oskar_cl_->current_device;
+    unsigned int i = oskar_cl_current_device_;
     return i < oskar_cl_->device.size() ? oskar_cl_->device[i]->id : 0;
 }
 
 cl_kernel oskar_cl_kernel(const char* name)
 {
     oskar_cl_ensure(0);
-    unsigned int i = oskar_cl_->current_device;
+    unsigned int i = oskar_cl_current_device_;
     if (i < oskar_cl_->device.size())
     {
         CLGlobal::CLDevice* device = oskar_cl_->device[i];
@@ -469,7 +472,7 @@ cl_kernel oskar_cl_kernel(const char* name)
 const char* oskar_cl_device_cl_version(void)
 {
     oskar_cl_ensure(0);
-    unsigned int i = oskar_cl_->current_device;
+    unsigned int i = oskar_cl_current_device_;
     return i < oskar_cl_->device.size() ?
             oskar_cl_->device[i]->cl_version.c_str() : 0;
 }
@@ -477,7 +480,7 @@ const char* oskar_cl_device_cl_version(void)
 const char* oskar_cl_device_driver_version(void)
 {
     oskar_cl_ensure(0);
-    unsigned int i = oskar_cl_->current_device;
+    unsigned int i = oskar_cl_current_device_;
     return i < oskar_cl_->device.size() ?
             oskar_cl_->device[i]->driver_version.c_str() : 0;
 }
@@ -485,7 +488,7 @@ const char* oskar_cl_device_driver_version(void)
 const char* oskar_cl_device_name(void)
 {
     oskar_cl_ensure(0);
-    unsigned int i = oskar_cl_->current_device;
+    unsigned int i = oskar_cl_current_device_;
     return i < oskar_cl_->device.size() ?
             oskar_cl_->device[i]->name.c_str() : 0;
 }
@@ -493,13 +496,13 @@ const char* oskar_cl_device_name(void)
 unsigned int oskar_cl_get_device(void)
 {
     oskar_cl_ensure(0);
-    return oskar_cl_->current_device;
+    return oskar_cl_current_device_;
 }
 
 int oskar_cl_is_gpu(void)
 {
     oskar_cl_ensure(0);
-    unsigned int i = oskar_cl_->current_device;
+    unsigned int i = oskar_cl_current_device_;
     return i < oskar_cl_->device.size() ? oskar_cl_->device[i]->is_gpu : 0;
 }
 
@@ -517,5 +520,5 @@ void oskar_cl_set_device(unsigned int device, int* status)
         *status = OSKAR_ERR_OUT_OF_RANGE;
         return;
     }
-    oskar_cl_->current_device = device;
+    oskar_cl_current_device_ = device;
 }
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2018, The University of Oxford
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the University of Oxford nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "utility/oskar_mapped_file.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifndef OSKAR_OS_WIN
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct oskar_MappedFile
+{
+    char* data;
+    size_t size;
+    int is_mapped;
+};
+
+static void read_file(oskar_MappedFile* h, const char* filename, int* status)
+{
+    FILE* stream;
+    long size;
+    stream = fopen(filename, "rb");
+    if (!stream)
+    {
+        *status = OSKAR_ERR_FILE_IO;
+        return;
+    }
+    fseek(stream, 0, SEEK_END);
+    size = ftell(stream);
+    fseek(stream, 0, SEEK_SET);
+    if (size < 0)
+    {
+        *status = OSKAR_ERR_FILE_IO;
+        fclose(stream);
+        return;
+    }
+    h->size = (size_t) size;
+    h->data = (char*) malloc(size > 0 ? h->size : 1);
+    if (!h->data)
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+    else if (fread(h->data, 1, h->size, stream) != h->size)
+        *status = OSKAR_ERR_FILE_IO;
+    fclose(stream);
+}
+
+oskar_MappedFile* oskar_mapped_file_create(const char* filename, int* status)
+{
+    oskar_MappedFile* h;
+    if (*status) return 0;
+    h = (oskar_MappedFile*) calloc(1, sizeof(oskar_MappedFile));
+    if (!h)
+    {
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+        return 0;
+    }
+#ifndef OSKAR_OS_WIN
+    {
+        struct stat st;
+        const int fd = open(filename, O_RDONLY);
+        if (fd < 0)
+        {
+            *status = OSKAR_ERR_FILE_IO;
+            free(h);
+            return 0;
+        }
+        if (fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            void* p = mmap(0, (size_t) st.st_size, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED)
+            {
+                h->data = (char*) p;
+                h->size = (size_t) st.st_size;
+                h->is_mapped = 1;
+#ifdef MADV_SEQUENTIAL
+                madvise(p, h->size, MADV_SEQUENTIAL);
+#endif
+            }
+        }
+        close(fd);
+    }
+#endif
+    if (!h->is_mapped)
+        read_file(h, filename, status);
+    if (*status)
+    {
+        oskar_mapped_file_free(h);
+        h = 0;
+    }
+    return h;
+}
+
+char* oskar_mapped_file_data(const oskar_MappedFile* file)
+{
+    return file->data;
+}
+
+size_t oskar_mapped_file_size(const oskar_MappedFile* file)
+{
+    return file->size;
+}
+
+void oskar_mapped_file_free(oskar_MappedFile* file)
+{
+    if (!file) return;
+#ifndef OSKAR_OS_WIN
+    if (file->is_mapped)
+        munmap(file->data, file->size);
+    else
+#endif
+        free(file->data);
+    free(file);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -302,6 +302,172 @@ int oskar_barrier_wait(oskar_Barrier* barrier)
     return 0;
 }
 
+
+/* =========================================================================
+ *  SCHEDULER
+ * =========================================================================*/
+
+struct oskar_TaskRange
+{
+    oskar_Mutex lock;
+    int begin, end;
+};
+typedef struct oskar_TaskRange oskar_TaskRange;
+
+struct oskar_Scheduler
+{
+    oskar_ConditionVar var;
+    int num_threads, num_blocks, num_released;
+    int* num_finished;
+    oskar_TaskRange* range; /* Indexed as [block][thread]. */
+};
+
+static void oskar_scheduler_clear(oskar_Scheduler* s)
+{
+    int i;
+    for (i = 0; i < s->num_blocks * s->num_threads; ++i)
+        oskar_mutex_uninit(&s->range[i].lock);
+    free(s->range);
+    free(s->num_finished);
+    s->range = 0;
+    s->num_finished = 0;
+    s->num_blocks = 0;
+    s->num_threads = 0;
+    s->num_released = 0;
+}
+
+oskar_Scheduler* oskar_scheduler_create(void)
+{
+    oskar_Scheduler* s;
+    s = (oskar_Scheduler*) calloc(1, sizeof(oskar_Scheduler));
+    oskar_condition_init(&s->var);
+    return s;
+}
+
+void oskar_scheduler_free(oskar_Scheduler* scheduler)
+{
+    if (!scheduler) return;
+    oskar_scheduler_clear(scheduler);
+    oskar_condition_uninit(&scheduler->var);
+    free(scheduler);
+}
+
+void oskar_scheduler_reset(oskar_Scheduler* scheduler, int num_threads,
+        int num_blocks, const int* num_tasks)
+{
+    int b, t;
+    oskar_scheduler_clear(scheduler);
+    if (num_threads < 1 || num_blocks < 1) return;
+    scheduler->num_threads = num_threads;
+    scheduler->num_blocks = num_blocks;
+    scheduler->num_finished = (int*) calloc(num_blocks, sizeof(int));
+    scheduler->range = (oskar_TaskRange*) calloc(
+            (size_t) num_blocks * num_threads, sizeof(oskar_TaskRange));
+    for (b = 0; b < num_blocks; ++b)
+    {
+        const long long int n = num_tasks[b];
+        for (t = 0; t < num_threads; ++t)
+        {
+            oskar_TaskRange* r = &scheduler->range[b * num_threads + t];
+            oskar_mutex_init(&r->lock);
+            r->begin = (int) ((n * t) / num_threads);
+            r->end   = (int) ((n * (t + 1)) / num_threads);
+        }
+    }
+}
+
+int oskar_scheduler_next(oskar_Scheduler* scheduler, int thread_id,
+        int block_index, int* task_index)
+{
+    int i, begin = 0, end = 0;
+    oskar_TaskRange *r, *own;
+    if (block_index < 0 || block_index >= scheduler->num_blocks ||
+            thread_id < 0 || thread_id >= scheduler->num_threads)
+        return 0;
+    r = &scheduler->range[block_index * scheduler->num_threads];
+    own = &r[thread_id];
+
+    /* Take the task at the front of this thread's own range. */
+    oskar_mutex_lock(&own->lock);
+    if (own->begin < own->end)
+        begin = (own->begin)++;
+    else
+        begin = -1;
+    oskar_mutex_unlock(&own->lock);
+    if (begin >= 0)
+    {
+        *task_index = begin;
+        return 1;
+    }
+
+    /* Otherwise, steal the back half of another thread's range. */
+    for (i = 1; i < scheduler->num_threads; ++i)
+    {
+        oskar_TaskRange* victim;
+        victim = &r[(thread_id + i) % scheduler->num_threads];
+        oskar_mutex_lock(&victim->lock);
+        begin = end = victim->end;
+        if (victim->begin < victim->end)
+        {
+            begin -= (victim->end - victim->begin + 1) / 2;
+            victim->end = begin;
+        }
+        oskar_mutex_unlock(&victim->lock);
+        if (begin < end)
+        {
+            oskar_mutex_lock(&own->lock);
+            own->begin = begin + 1;
+            own->end = end;
+            oskar_mutex_unlock(&own->lock);
+            *task_index = begin;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void oskar_scheduler_finish_block(oskar_Scheduler* scheduler,
+        int block_index)
+{
+    if (block_index < 0 || block_index >= scheduler->num_blocks) return;
+    oskar_condition_lock(&scheduler->var);
+    scheduler->num_finished[block_index]++;
+    oskar_condition_notify_all(&scheduler->var);
+    oskar_condition_unlock(&scheduler->var);
+}
+
+void oskar_scheduler_wait_finished(oskar_Scheduler* scheduler,
+        int block_index)
+{
+    if (block_index < 0 || block_index >= scheduler->num_blocks) return;
+    oskar_condition_lock(&scheduler->var);
+    /* Allow for spurious wake-ups. */
+    while (scheduler->num_finished[block_index] < scheduler->num_threads)
+        oskar_condition_wait(&scheduler->var);
+    oskar_condition_unlock(&scheduler->var);
+}
+
+void oskar_scheduler_release_block(oskar_Scheduler* scheduler,
+        int block_index)
+{
+    oskar_condition_lock(&scheduler->var);
+    if (block_index >= scheduler->num_released)
+        scheduler->num_released = block_index + 1;
+    oskar_condition_notify_all(&scheduler->var);
+    oskar_condition_unlock(&scheduler->var);
+}
+
+void oskar_scheduler_wait_released(oskar_Scheduler* scheduler,
+        int block_index)
+{
+    if (block_index < 0) return;
+    oskar_condition_lock(&scheduler->var);
+    /* Allow for spurious wake-ups. */
+    while (scheduler->num_released <= block_index)
+        oskar_condition_wait(&scheduler->var);
+    oskar_condition_unlock(&scheduler->var);
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -124,3 +124,80 @@ TEST(thread, barriers)
     free(args);
     free(threads);
 }
+
+struct SchedulerArgs
+{
+    int thread_id, num_blocks;
+    int* counts;
+    oskar_Scheduler* scheduler;
+};
+typedef struct SchedulerArgs SchedulerArgs;
+
+void* thread_scheduler(void* arg)
+{
+    SchedulerArgs* args = (SchedulerArgs*) arg;
+    for (int b = 0; b < args->num_blocks; ++b)
+    {
+        int task = 0;
+        while (oskar_scheduler_next(args->scheduler, args->thread_id, b, &task))
+        {
+            // Make thread 0 slow, so that other threads steal its work.
+            if (args->thread_id == 0)
+            {
+                oskar_Timer* tmr = oskar_timer_create(OSKAR_TIMER_NATIVE);
+                oskar_timer_start(tmr);
+                while (oskar_timer_elapsed(tmr) < 1e-4) {}
+                oskar_timer_free(tmr);
+            }
+            args->counts[b * 1000 + task]++;
+        }
+        oskar_scheduler_finish_block(args->scheduler, b);
+    }
+    return 0;
+}
+
+TEST(thread, scheduler)
+{
+    // Set up the tasks in each block.
+    const int num_threads = 8, num_blocks = 4;
+    int num_tasks[num_blocks] = {1000, 3, 0, 517};
+    oskar_Scheduler* scheduler = oskar_scheduler_create();
+    oskar_scheduler_reset(scheduler, num_threads, num_blocks, num_tasks);
+    int* counts = (int*) calloc(num_blocks * 1000, sizeof(int));
+
+    // Start all the threads.
+    oskar_Thread** threads = (oskar_Thread**)
+            calloc((size_t) num_threads, sizeof(oskar_Thread*));
+    SchedulerArgs* args = (SchedulerArgs*)
+            calloc((size_t) num_threads, sizeof(SchedulerArgs));
+    for (int i = 0; i < num_threads; ++i)
+    {
+        args[i].thread_id = i;
+        args[i].num_blocks = num_blocks;
+        args[i].counts = counts;
+        args[i].scheduler = scheduler;
+        threads[i] = oskar_thread_create(thread_scheduler,
+                (void*)(&args[i]), 0);
+    }
+
+    // Wait for each block to be finished, then check every task ran once.
+    for (int b = 0; b < num_blocks; ++b)
+    {
+        oskar_scheduler_wait_finished(scheduler, b);
+        for (int i = 0; i < 1000; ++i)
+            ASSERT_EQ(i < num_tasks[b] ? 1 : 0, counts[b * 1000 + i]);
+        oskar_scheduler_release_block(scheduler, b);
+    }
+    oskar_scheduler_wait_released(scheduler, num_blocks - 1);
+
+    // Clean up.
+    for (int i = 0; i < num_threads; ++i)
+    {
+        oskar_thread_join(threads[i]);
+        oskar_thread_free(threads[i]);
+    }
+    oskar_scheduler_free(scheduler);
+    free(counts);
+    free(args);
+    free(threads);
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2018, The University of Oxford
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the University of Oxford nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef OSKAR_CL_TEST_UTILS_H_
+#define OSKAR_CL_TEST_UTILS_H_
+
+/**
+ * @file oskar_cl_test_utils.h
+ */
+
+#include <gtest/gtest.h>
+#include "utility/oskar_cl_utils.h"
+
+#include <cstdio>
+#include <string>
+
+/**
+ * @brief
+ * Selects an OpenCL CPU device for the tests in this executable.
+ *
+ * @details
+ * Call this after InitGoogleTest(). If no OpenCL CPU device is found,
+ * tests with "CL" in their name are excluded by the test filter, so that
+ * they are listed as not run rather than reported as passed.
+ */
+static inline void oskar_cl_test_init(void)
+{
+#ifdef OSKAR_HAVE_OPENCL
+    oskar_cl_init("CPU", NULL);
+    if (oskar_cl_num_devices() > 0) return;
+    std::string& filter = ::testing::GTEST_FLAG(filter);
+    filter += (filter.find('-') == std::string::npos) ? "-*CL*" : ":*CL*";
+    printf("No OpenCL CPU devices found: skipping OpenCL tests.\n");
+#endif
+}
+
+#endif /* OSKAR_CL_TEST_UTILS_H_ */
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2018, The University of Oxford
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the University of Oxford nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef OSKAR_OMP_TEST_UTILS_H_
+#define OSKAR_OMP_TEST_UTILS_H_
+
+/**
+ * @file oskar_omp_test_utils.h
+ */
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/**
+ * @brief
+ * Sets the number of OpenMP threads used by a test.
+ *
+ * @details
+ * The number of threads in use when the object was created is restored
+ * when it goes out of scope, even if the test returns early because an
+ * assertion failed. This has no effect if OpenMP is not available.
+ */
+class oskar_OmpNumThreads
+{
+public:
+    oskar_OmpNumThreads() : num_threads_(1)
+    {
+#ifdef _OPENMP
+        num_threads_ = omp_get_max_threads();
+#endif
+    }
+
+    ~oskar_OmpNumThreads()
+    {
+        set(num_threads_);
+    }
+
+    void set(int num_threads)
+    {
+#ifdef _OPENMP
+        omp_set_num_threads(num_threads);
+#else
+        (void) num_threads;
+#endif
+    }
+
+    int original() const
+    {
+        return num_threads_;
+    }
+
+private:
+    int num_threads_;
+};
+
+#endif /* OSKAR_OMP_TEST_UTILS_H_ */
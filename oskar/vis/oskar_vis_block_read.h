@@ -59,6 +59,32 @@ OSKAR_EXPORT
 void oskar_vis_block_read(oskar_VisBlock* vis, const oskar_VisHeader* hdr,
         oskar_Binary* h, int block_index, int* status);
 
+/**
+ * @brief
+ * Fills a visibility structure with data mapped from the specified file.
+ *
+ * @details
+ * This function is like oskar_vis_block_read(), but avoids copying the
+ * visibility data where possible. The arrays in the block are replaced by
+ * aliases of the data in the memory-mapped file
+ * (see oskar_binary_map_mem()), so the file handle must not be freed while
+ * the block is in use. Arrays that cannot be mapped are read instead.
+ *
+ * Once mapped, the block may only be filled again using this function,
+ * as its arrays cannot be resized. If the block is not in CPU memory,
+ * the data are read using oskar_vis_block_read().
+ *
+ * @param[in,out] vis         The visibility block structure to fill.
+ * @param[in,out] hdr         The visibility header.
+ * @param[in,out] h           The OSKAR binary file handle, opened for read.
+ * @param[in]     block_index The visibility block index.
+ * @param[in]     check_crc   If set, check the CRC codes of the data.
+ * @param[in,out] status      Status return code.
+ */
+OSKAR_EXPORT
+void oskar_vis_block_map(oskar_VisBlock* vis, const oskar_VisHeader* hdr,
+        oskar_Binary* h, int block_index, int check_crc, int* status);
+
 #ifdef __cplusplus
 }
 #endif
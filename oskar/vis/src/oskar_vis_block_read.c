@@ -83,6 +83,67 @@ void oskar_vis_block_read(oskar_VisBlock* vis, const oskar_VisHeader* hdr,
     }
 }
 
+static void map_mem(oskar_Mem** mem, oskar_Binary* h, unsigned char id_tag,
+        int block_index, int check_crc, int* status)
+{
+    oskar_Mem* mapped;
+    mapped = oskar_binary_map_mem(h, oskar_mem_type(*mem),
+            OSKAR_TAG_GROUP_VIS_BLOCK, id_tag, block_index, check_crc, status);
+    if (!mapped) return;
+    oskar_mem_free(*mem, status);
+    *mem = mapped;
+}
+
+void oskar_vis_block_map(oskar_VisBlock* vis, const oskar_VisHeader* hdr,
+        oskar_Binary* h, int block_index, int check_crc, int* status)
+{
+    int num_tags_per_block;
+
+    /* Check if safe to proceed. */
+    if (*status) return;
+
+    /* Data can only be mapped into CPU memory. */
+    if (oskar_mem_location(vis->cross_correlations) != OSKAR_CPU)
+    {
+        oskar_vis_block_read(vis, hdr, h, block_index, status);
+        return;
+    }
+
+    /* Set query start index. */
+    num_tags_per_block = oskar_vis_header_num_tags_per_block(hdr);
+    oskar_binary_set_query_search_start(h, block_index * num_tags_per_block,
+            status);
+
+    /* Read visibility metadata. */
+    oskar_binary_read(h, OSKAR_INT,
+            OSKAR_TAG_GROUP_VIS_BLOCK,
+            OSKAR_VIS_BLOCK_TAG_DIM_START_AND_SIZE, block_index,
+            sizeof(int) * 6, vis->dim_start_size, status);
+
+    /* Map the auto-correlation data. */
+    if (oskar_vis_header_write_auto_correlations(hdr))
+        map_mem(&vis->auto_correlations,
+                h, OSKAR_VIS_BLOCK_TAG_AUTO_CORRELATIONS,
+                block_index, check_crc, status);
+
+    /* Map the cross-correlation data and baseline coordinates. */
+    if (oskar_vis_header_write_cross_correlations(hdr))
+    {
+        map_mem(&vis->cross_correlations,
+                h, OSKAR_VIS_BLOCK_TAG_CROSS_CORRELATIONS,
+                block_index, check_crc, status);
+        map_mem(&vis->baseline_uu_metres,
+                h, OSKAR_VIS_BLOCK_TAG_BASELINE_UU,
+                block_index, check_crc, status);
+        map_mem(&vis->baseline_vv_metres,
+                h, OSKAR_VIS_BLOCK_TAG_BASELINE_VV,
+                block_index, check_crc, status);
+        map_mem(&vis->baseline_ww_metres,
+                h, OSKAR_VIS_BLOCK_TAG_BASELINE_WW,
+                block_index, check_crc, status);
+    }
+}
+
 #ifdef __cplusplus
 }
 #endif
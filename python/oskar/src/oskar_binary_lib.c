@@ -256,9 +256,33 @@ static PyObject* read_data(PyObject* self, PyObject* args)
     }
     else
     {
-        /* Read an array. */
+        /* Return an array that points at the mapped file, if possible. */
+        void* mapped = 0;
         npy_intp dims[3] = {0, 2, 2};
         dims[0] = num_elements;
+        Py_BEGIN_ALLOW_THREADS
+        mapped = oskar_binary_map_block(h, i, 1, &status);
+        Py_END_ALLOW_THREADS
+        if (status) goto fail;
+        if (mapped && ((size_t)mapped %
+                oskar_mem_element_size(oskar_type_precision(dtype))) == 0)
+        {
+            array = PyArray_SimpleNewFromData(
+                    oskar_type_is_matrix(dtype) ? 3 : 1, dims,
+                    numpy_type_from_oskar(dtype), mapped);
+            if (!array) return 0;
+
+            /* The array keeps the file handle (and the mapping) alive. */
+            Py_INCREF(capsule);
+            if (PyArray_SetBaseObject((PyArrayObject*)array, capsule) < 0)
+            {
+                Py_DECREF(array);
+                return 0;
+            }
+            return Py_BuildValue("N", array);
+        }
+
+        /* Otherwise, read a copy of the array. */
         array = PyArray_SimpleNew(oskar_type_is_matrix(dtype) ? 3 : 1,
                 dims, numpy_type_from_oskar(dtype));
         Py_BEGIN_ALLOW_THREADS